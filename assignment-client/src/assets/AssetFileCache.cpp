@@ -0,0 +1,147 @@
+//
+//  AssetFileCache.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetFileCache.h"
+
+#include "AssetServerLogging.h"
+
+AssetFileCache::MappedFile::MappedFile(const QString& filePath, qint64 offset, qint64 size) : _file(filePath) {
+    if (!_file.open(QIODevice::ReadOnly)) {
+        _size = -1;
+        return;
+    }
+
+    auto fileSize = _file.size();
+    _size = size >= 0 ? size : fileSize - offset;
+    if (offset < 0 || _size < 0 || offset + _size > fileSize) {
+        _size = -1;
+    } else if (_size > 0) {
+        _data = _file.map(offset, _size);
+        if (!_data) {
+            qCWarning(asset_server) << "Could not map" << filePath << ":" << _file.errorString();
+            _size = -1;
+        }
+    }
+
+    // the mapping stays valid once the file is closed
+    _file.close();
+}
+
+AssetFileCache::MappedFile::~MappedFile() {
+    if (_data) {
+        _file.unmap(_data);
+    }
+}
+
+void AssetFileCache::setMaxCachedBytes(qint64 maxCachedBytes) {
+    QMutexLocker locker(&_mutex);
+    _maxCachedBytes = maxCachedBytes;
+    evict();
+}
+
+AssetFileCache::MappedFilePointer AssetFileCache::get(const QString& hexHash, const QString& filePath) {
+    return get(hexHash, [&filePath]() -> MappedFilePointer {
+        auto file = std::make_shared<MappedFile>(filePath);
+        return file->isValid() ? file : nullptr;
+    });
+}
+
+AssetFileCache::MappedFilePointer AssetFileCache::get(const QString& hexHash, const std::function<MappedFilePointer()>& mapFile) {
+    {
+        QMutexLocker locker(&_mutex);
+        auto it = _entriesByHash.find(hexHash);
+        if (it != _entriesByHash.end()) {
+            // move to the front of the LRU list
+            _entries.splice(_entries.begin(), _entries, it->second);
+            ++_hits;
+            return it->second->file;
+        }
+    }
+
+    ++_misses;
+
+    // map outside of the lock, the file system may be slow
+    auto file = mapFile();
+    if (!file) {
+        return nullptr;
+    }
+
+    QMutexLocker locker(&_mutex);
+
+    // files larger than the cache are served but not kept
+    if (file->getSize() > _maxCachedBytes) {
+        return file;
+    }
+
+    // another task may have mapped the same file in the meantime
+    auto it = _entriesByHash.find(hexHash);
+    if (it != _entriesByHash.end()) {
+        _entries.splice(_entries.begin(), _entries, it->second);
+        return it->second->file;
+    }
+
+    _entries.push_front({ hexHash, file });
+    _entriesByHash[hexHash] = _entries.begin();
+    _cachedBytes += file->getSize();
+
+    evict();
+
+    return file;
+}
+
+void AssetFileCache::remove(const QString& hexHash) {
+    QMutexLocker locker(&_mutex);
+    auto it = _entriesByHash.find(hexHash);
+    if (it != _entriesByHash.end()) {
+        _cachedBytes -= it->second->file->getSize();
+        _entries.erase(it->second);
+        _entriesByHash.erase(it);
+    }
+}
+
+void AssetFileCache::clear() {
+    QMutexLocker locker(&_mutex);
+    _evictions += _entries.size();
+    _entries.clear();
+    _entriesByHash.clear();
+    _cachedBytes = 0;
+}
+
+void AssetFileCache::evict() {
+    // called with _mutex held
+    while (_cachedBytes > _maxCachedBytes && !_entries.empty()) {
+        auto& entry = _entries.back();
+        _cachedBytes -= entry.file->getSize();
+        _entriesByHash.erase(entry.hexHash);
+        _entries.pop_back();
+        ++_evictions;
+    }
+}
+
+QJsonObject AssetFileCache::getStats() const {
+    QJsonObject stats;
+
+    uint64_t hits = _hits;
+    uint64_t misses = _misses;
+    uint64_t requests = hits + misses;
+
+    stats["1. Hits"] = (double)hits;
+    stats["2. Misses"] = (double)misses;
+    stats["3. Hit Rate (%)"] = requests > 0 ? (100.0 * hits / requests) : 0.0;
+    stats["4. Evictions"] = (double)_evictions;
+    stats["5. Bytes Served"] = (double)_bytesServed;
+
+    QMutexLocker locker(&_mutex);
+    stats["6. Cached Files"] = (int)_entries.size();
+    stats["7. Cached Bytes"] = (double)_cachedBytes;
+    stats["8. Max Cached Bytes"] = (double)_maxCachedBytes;
+
+    return stats;
+}
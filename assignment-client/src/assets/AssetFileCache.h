@@ -0,0 +1,89 @@
+//
+//  AssetFileCache.h
+//  assignment-client/src/assets
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetFileCache_h
+#define hifi_AssetFileCache_h
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+/// Size-bounded LRU cache of memory-mapped asset files, keyed by hash.
+/// Thread-safe, shared by the SendAssetTasks of an AssetServer.
+class AssetFileCache {
+public:
+    /// A read-only mapping of a whole asset file, or of the range of a pack segment holding an asset.
+    /// Stays valid for as long as it is referenced, even after it has been evicted from the cache.
+    class MappedFile {
+    public:
+        MappedFile(const QString& filePath, qint64 offset = 0, qint64 size = -1);
+        ~MappedFile();
+
+        bool isValid() const { return _data != nullptr || _size == 0; }
+        const char* getData() const { return reinterpret_cast<const char*>(_data); }
+        qint64 getSize() const { return _size; }
+
+    private:
+        QFile _file;
+        uchar* _data { nullptr };
+        qint64 _size { 0 };
+    };
+    using MappedFilePointer = std::shared_ptr<const MappedFile>;
+
+    static const qint64 DEFAULT_MAX_CACHED_BYTES = 256 * 1024 * 1024;
+
+    void setMaxCachedBytes(qint64 maxCachedBytes);
+
+    /// Returns the mapping for the asset, mapping it on a miss. Returns nullptr if the file can't be opened or mapped.
+    MappedFilePointer get(const QString& hexHash, const QString& filePath);
+
+    /// Same as above, with mapFile called on a miss to map the asset from wherever it is stored.
+    MappedFilePointer get(const QString& hexHash, const std::function<MappedFilePointer()>& mapFile);
+
+    /// Drops the cached mapping for an asset, must be called before the asset file is deleted.
+    void remove(const QString& hexHash);
+
+    /// Drops every cached mapping, so that the files backing them can be deleted.
+    void clear();
+
+    /// Records bytes sent from a mapping, for stats.
+    void addBytesServed(qint64 bytes) { _bytesServed += bytes; }
+
+    QJsonObject getStats() const;
+
+private:
+    void evict();
+
+    struct Entry {
+        QString hexHash;
+        MappedFilePointer file;
+    };
+    using EntryList = std::list<Entry>;
+
+    mutable QMutex _mutex;
+    EntryList _entries; // most recently used first
+    std::unordered_map<QString, EntryList::iterator> _entriesByHash;
+    qint64 _cachedBytes { 0 };
+    qint64 _maxCachedBytes { DEFAULT_MAX_CACHED_BYTES };
+
+    std::atomic<uint64_t> _hits { 0 };
+    std::atomic<uint64_t> _misses { 0 };
+    std::atomic<uint64_t> _evictions { 0 };
+    std::atomic<uint64_t> _bytesServed { 0 };
+};
+
+#endif // hifi_AssetFileCache_h
@@ -0,0 +1,594 @@
+//
+//  AssetPackStore.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetPackStore.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QSaveFile>
+
+#include "AssetServerLogging.h"
+
+static const quint32 RECORD_MAGIC = 0x4B504841; // "AHPK"
+static const quint32 INDEX_MAGIC = 0x49504841; // "AHPI"
+static const quint32 INDEX_VERSION = 1;
+
+static const QString SEGMENT_FILE_EXTENSION = ".pack";
+static const QString INDEX_FILE_NAME = "index";
+
+// bounds how many records have to be replayed when the store is opened after a crash
+static const int MAX_UNINDEXED_RECORDS = 1024;
+
+AssetPackStore::AssetPackStore(const QDir& directory) : _directory(directory) {
+    static_assert(sizeof(RecordHeader) == 16 + AssetUtils::SHA256_HASH_LENGTH, "RecordHeader must not be padded");
+}
+
+AssetPackStore::~AssetPackStore() {
+    close();
+}
+
+AssetPackStore::Hash AssetPackStore::toRawHash(const AssetUtils::AssetHash& hash) {
+    return QByteArray::fromHex(hash.toLatin1());
+}
+
+QString AssetPackStore::segmentFilePath(quint32 segment) const {
+    return _directory.absoluteFilePath(QString("%1%2").arg(segment, 8, 10, QChar('0')).arg(SEGMENT_FILE_EXTENSION));
+}
+
+QString AssetPackStore::indexFilePath() const {
+    return _directory.absoluteFilePath(INDEX_FILE_NAME);
+}
+
+bool AssetPackStore::open() {
+    QWriteLocker locker(&_lock);
+
+    if (!_directory.mkpath(".")) {
+        qCCritical(asset_server) << "Unable to create asset pack directory" << _directory.path();
+        return false;
+    }
+
+    // there are only a few segments, so listing them is cheap regardless of the number of assets
+    auto segmentFiles = _directory.entryInfoList({ "*" + SEGMENT_FILE_EXTENSION }, QDir::Files);
+    for (const auto& fileInfo : segmentFiles) {
+        bool ok;
+        quint32 segment = fileInfo.completeBaseName().toUInt(&ok);
+        if (ok) {
+            _segments[segment].length = fileInfo.size();
+        }
+    }
+
+    if (!loadIndex()) {
+        if (QFile::exists(indexFilePath())) {
+            qCWarning(asset_server) << "Asset pack index is out of date or damaged, rebuilding it from the segments.";
+        }
+
+        _entries.clear();
+        for (auto& pair : _segments) {
+            pair.second.liveBytes = 0;
+            pair.second.indexedLength = 0;
+        }
+    }
+
+    quint32 lastSegment = _segments.empty() ? 0 : _segments.rbegin()->first;
+    for (auto& pair : _segments) {
+        replaySegment(pair.first, pair.first == lastSegment);
+    }
+
+    quint32 activeSegment = lastSegment;
+    if (!_segments.empty() && _segments.rbegin()->second.length >= DEFAULT_MAX_SEGMENT_SIZE) {
+        ++activeSegment;
+    }
+
+    if (!openActiveSegment(activeSegment)) {
+        return false;
+    }
+
+    if (_replayedRecords > 0) {
+        writeIndex();
+    }
+
+    qCInfo(asset_server) << "Opened asset pack store with" << _entries.size() << "assets in" << _segments.size()
+        << "segments, replayed" << (uint64_t)_replayedRecords << "records.";
+
+    return true;
+}
+
+void AssetPackStore::close() {
+    QWriteLocker locker(&_lock);
+
+    if (_activeFile.isOpen()) {
+        if (_unindexedRecords > 0) {
+            writeIndex();
+        }
+        _activeFile.close();
+    }
+}
+
+bool AssetPackStore::loadIndex() {
+    QFile file { indexFilePath() };
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QByteArray data = file.readAll();
+    int position = 0;
+    auto readBytes = [&](void* destination, int size) {
+        if (position + size > data.size()) {
+            return false;
+        }
+        memcpy(destination, data.constData() + position, size);
+        position += size;
+        return true;
+    };
+
+    quint32 magic, version, numSegments, numEntries;
+    if (!readBytes(&magic, sizeof(magic)) || magic != INDEX_MAGIC ||
+        !readBytes(&version, sizeof(version)) || version != INDEX_VERSION ||
+        !readBytes(&numSegments, sizeof(numSegments))) {
+        return false;
+    }
+
+    for (quint32 i = 0; i < numSegments; i++) {
+        quint32 segment;
+        qint64 indexedLength;
+        if (!readBytes(&segment, sizeof(segment)) || !readBytes(&indexedLength, sizeof(indexedLength))) {
+            return false;
+        }
+
+        // a segment that went missing or shrank since the index was written can't be trusted
+        auto it = _segments.find(segment);
+        if (it == _segments.end() || it->second.length < indexedLength) {
+            return false;
+        }
+        it->second.indexedLength = indexedLength;
+    }
+
+    if (!readBytes(&numEntries, sizeof(numEntries))) {
+        return false;
+    }
+
+    _entries.reserve(numEntries);
+    for (quint32 i = 0; i < numEntries; i++) {
+        char hash[AssetUtils::SHA256_HASH_LENGTH];
+        Entry entry;
+        if (!readBytes(hash, sizeof(hash)) || !readBytes(&entry.segment, sizeof(entry.segment)) ||
+            !readBytes(&entry.offset, sizeof(entry.offset)) || !readBytes(&entry.size, sizeof(entry.size))) {
+            return false;
+        }
+
+        auto it = _segments.find(entry.segment);
+        if (it == _segments.end() || (qint64)(entry.offset + entry.size) > it->second.indexedLength) {
+            return false;
+        }
+        setEntry(Hash(hash, sizeof(hash)), entry);
+    }
+
+    return true;
+}
+
+bool AssetPackStore::writeIndex() {
+    const int SEGMENT_SIZE = sizeof(quint32) + sizeof(qint64);
+    const int ENTRY_SIZE = AssetUtils::SHA256_HASH_LENGTH + sizeof(quint32) + 2 * sizeof(quint64);
+
+    QByteArray data;
+    data.reserve(4 * sizeof(quint32) + (int)_segments.size() * SEGMENT_SIZE + _entries.size() * ENTRY_SIZE);
+    auto appendBytes = [&](const void* source, int size) {
+        data.append(reinterpret_cast<const char*>(source), size);
+    };
+
+    quint32 numSegments = (quint32)_segments.size();
+    quint32 numEntries = (quint32)_entries.size();
+
+    appendBytes(&INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    appendBytes(&INDEX_VERSION, sizeof(INDEX_VERSION));
+    appendBytes(&numSegments, sizeof(numSegments));
+    for (const auto& pair : _segments) {
+        appendBytes(&pair.first, sizeof(pair.first));
+        appendBytes(&pair.second.length, sizeof(pair.second.length));
+    }
+
+    appendBytes(&numEntries, sizeof(numEntries));
+    for (auto it = _entries.cbegin(); it != _entries.cend(); ++it) {
+        data.append(it.key());
+        appendBytes(&it->segment, sizeof(it->segment));
+        appendBytes(&it->offset, sizeof(it->offset));
+        appendBytes(&it->size, sizeof(it->size));
+    }
+
+    QSaveFile file { indexFilePath() };
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qCWarning(asset_server) << "Failed to write asset pack index:" << file.errorString();
+        return false;
+    }
+
+    for (auto& pair : _segments) {
+        pair.second.indexedLength = pair.second.length;
+    }
+    _unindexedRecords = 0;
+
+    return true;
+}
+
+void AssetPackStore::replaySegment(quint32 segment, bool isLast) {
+    auto& info = _segments[segment];
+    if (info.indexedLength >= info.length) {
+        return;
+    }
+
+    QFile file { segmentFilePath(segment) };
+    if (!file.open(QIODevice::ReadWrite) || !file.seek(info.indexedLength)) {
+        qCWarning(asset_server) << "Could not open asset pack segment" << file.fileName() << ":" << file.errorString();
+        return;
+    }
+
+    qint64 position = info.indexedLength;
+    while (position < info.length) {
+        RecordHeader header;
+        bool valid = position + (qint64)sizeof(header) <= info.length &&
+            file.read(reinterpret_cast<char*>(&header), sizeof(header)) == (qint64)sizeof(header) &&
+            header.magic == RECORD_MAGIC && (header.type == Put || header.type == Delete) &&
+            header.size <= (quint64)(info.length - position) - sizeof(header);
+
+        Hash hash;
+        if (valid) {
+            hash = Hash(header.hash, sizeof(header.hash));
+
+            if (header.type == Put) {
+                // a torn write leaves a record whose contents don't match its hash
+                QByteArray data = file.read(header.size);
+                valid = data.size() == (int)header.size &&
+                    QCryptographicHash::hash(data, QCryptographicHash::Sha256) == hash;
+            } else {
+                valid = header.size == 0;
+            }
+        }
+
+        if (!valid) {
+            if (isLast) {
+                qCWarning(asset_server) << "Truncating incomplete record at" << position << "in" << file.fileName();
+                file.resize(position);
+                info.length = position;
+            } else {
+                qCWarning(asset_server) << "Corrupt record at" << position << "in" << file.fileName()
+                    << ", the rest of the segment is ignored.";
+                ++_corruptRecords;
+            }
+            break;
+        }
+
+        if (header.type == Put) {
+            setEntry(hash, { segment, (quint64)position + sizeof(RecordHeader), header.size });
+        } else {
+            eraseEntry(hash);
+        }
+
+        position += recordSize(header.size);
+        ++_replayedRecords;
+    }
+}
+
+bool AssetPackStore::openActiveSegment(quint32 segment) {
+    if (_activeFile.isOpen()) {
+        _activeFile.close();
+    }
+
+    _activeFile.setFileName(segmentFilePath(segment));
+    if (!_activeFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qCCritical(asset_server) << "Could not open asset pack segment" << _activeFile.fileName() << "for writing:"
+            << _activeFile.errorString();
+        return false;
+    }
+
+    _activeSegment = segment;
+    _segments[segment].length = _activeFile.size();
+
+    return true;
+}
+
+bool AssetPackStore::appendRecord(RecordType type, const Hash& hash, const char* data, quint64 size) {
+    if (!_activeFile.isOpen()) {
+        return false;
+    }
+
+    // seal the active segment once it's full, a single large asset still gets a segment of its own
+    const auto& active = _segments[_activeSegment];
+    if (active.length > 0 && active.length + recordSize(size) > DEFAULT_MAX_SEGMENT_SIZE) {
+        if (!openActiveSegment(_activeSegment + 1)) {
+            return false;
+        }
+    }
+
+    auto& info = _segments[_activeSegment];
+
+    RecordHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = RECORD_MAGIC;
+    header.type = type;
+    header.size = size;
+    memcpy(header.hash, hash.constData(), sizeof(header.hash));
+
+    bool written = _activeFile.write(reinterpret_cast<const char*>(&header), sizeof(header)) == (qint64)sizeof(header) &&
+        (size == 0 || _activeFile.write(data, size) == (qint64)size) && _activeFile.flush();
+
+    if (!written) {
+        qCWarning(asset_server) << "Failed to append to asset pack segment" << _activeFile.fileName() << ":"
+            << _activeFile.errorString();
+        _activeFile.resize(info.length);
+        return false;
+    }
+
+    qint64 position = info.length;
+    info.length += recordSize(size);
+
+    if (type == Put) {
+        setEntry(hash, { _activeSegment, (quint64)position + sizeof(RecordHeader), size });
+    } else {
+        eraseEntry(hash);
+    }
+
+    if (++_unindexedRecords >= MAX_UNINDEXED_RECORDS) {
+        writeIndex();
+    }
+
+    return true;
+}
+
+void AssetPackStore::setEntry(const Hash& hash, const Entry& entry) {
+    auto it = _entries.find(hash);
+    if (it != _entries.end()) {
+        _segments[it->segment].liveBytes -= recordSize(it->size);
+        *it = entry;
+    } else {
+        _entries.insert(hash, entry);
+    }
+    _segments[entry.segment].liveBytes += recordSize(entry.size);
+}
+
+void AssetPackStore::eraseEntry(const Hash& hash) {
+    auto it = _entries.find(hash);
+    if (it != _entries.end()) {
+        _segments[it->segment].liveBytes -= recordSize(it->size);
+        _entries.erase(it);
+    }
+}
+
+void AssetPackStore::removeSegmentFile(quint32 segment) {
+    auto filePath = segmentFilePath(segment);
+    if (!QFile::remove(filePath) && QFile::exists(filePath)) {
+        _pendingRemovals << filePath;
+    }
+}
+
+QByteArray AssetPackStore::readEntry(const Entry& entry) const {
+    if (entry.size == 0) {
+        return QByteArray("");
+    }
+
+    QFile file { segmentFilePath(entry.segment) };
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(entry.offset)) {
+        return QByteArray();
+    }
+
+    QByteArray data = file.read(entry.size);
+    return data.size() == (int)entry.size ? data : QByteArray();
+}
+
+std::vector<AssetPackStore::Hash> AssetPackStore::hashesInSegment(quint32 segment) const {
+    std::vector<Hash> hashes;
+    for (auto it = _entries.cbegin(); it != _entries.cend(); ++it) {
+        if (it->segment == segment) {
+            hashes.push_back(it.key());
+        }
+    }
+    return hashes;
+}
+
+bool AssetPackStore::contains(const AssetUtils::AssetHash& hash) const {
+    QReadLocker locker(&_lock);
+    return _entries.contains(toRawHash(hash));
+}
+
+qint64 AssetPackStore::getSize(const AssetUtils::AssetHash& hash) const {
+    QReadLocker locker(&_lock);
+    auto it = _entries.find(toRawHash(hash));
+    return it != _entries.end() ? (qint64)it->size : -1;
+}
+
+AssetFileCache::MappedFilePointer AssetPackStore::map(const AssetUtils::AssetHash& hash) const {
+    // held while mapping, so that compaction can't remove the segment in between
+    QReadLocker locker(&_lock);
+    auto it = _entries.find(toRawHash(hash));
+    if (it == _entries.end()) {
+        return nullptr;
+    }
+
+    auto file = std::make_shared<AssetFileCache::MappedFile>(segmentFilePath(it->segment), it->offset, it->size);
+    return file->isValid() ? file : nullptr;
+}
+
+QByteArray AssetPackStore::read(const AssetUtils::AssetHash& hash) const {
+    QReadLocker locker(&_lock);
+    auto it = _entries.find(toRawHash(hash));
+    return it != _entries.end() ? readEntry(*it) : QByteArray();
+}
+
+bool AssetPackStore::extract(const AssetUtils::AssetHash& hash, const QString& filePath) const {
+    QByteArray data = read(hash);
+    if (data.isNull()) {
+        return false;
+    }
+
+    QFile file { filePath };
+    return file.open(QIODevice::WriteOnly) && file.write(data) == data.size();
+}
+
+bool AssetPackStore::write(const AssetUtils::AssetHash& hash, const QByteArray& data) {
+    Hash rawHash = toRawHash(hash);
+
+    QWriteLocker locker(&_lock);
+    if (_entries.contains(rawHash)) {
+        return true;
+    }
+    return appendRecord(Put, rawHash, data.constData(), data.size());
+}
+
+bool AssetPackStore::remove(const AssetUtils::AssetHash& hash) {
+    Hash rawHash = toRawHash(hash);
+
+    QWriteLocker locker(&_lock);
+    if (!_entries.contains(rawHash)) {
+        return false;
+    }
+    return appendRecord(Delete, rawHash, nullptr, 0);
+}
+
+std::vector<AssetUtils::AssetHash> AssetPackStore::getHashes() const {
+    QReadLocker locker(&_lock);
+
+    std::vector<AssetUtils::AssetHash> hashes;
+    hashes.reserve(_entries.size());
+    for (auto it = _entries.cbegin(); it != _entries.cend(); ++it) {
+        hashes.push_back(it.key().toHex());
+    }
+    return hashes;
+}
+
+int AssetPackStore::getNumAssets() const {
+    QReadLocker locker(&_lock);
+    return _entries.size();
+}
+
+int AssetPackStore::compact(float minLiveRatio) {
+    QWriteLocker locker(&_lock);
+
+    _pendingRemovals.erase(std::remove_if(_pendingRemovals.begin(), _pendingRemovals.end(), [](const QString& filePath) {
+        return QFile::remove(filePath) || !QFile::exists(filePath);
+    }), _pendingRemovals.end());
+
+    std::vector<quint32> candidates;
+    for (const auto& pair : _segments) {
+        const auto& info = pair.second;
+        if (pair.first != _activeSegment &&
+            (info.length == 0 || (float)info.liveBytes < minLiveRatio * (float)info.length)) {
+            candidates.push_back(pair.first);
+        }
+    }
+
+    if (candidates.empty()) {
+        return 0;
+    }
+
+    for (auto segment : candidates) {
+        for (const auto& hash : hashesInSegment(segment)) {
+            Entry entry = _entries.value(hash);
+            QByteArray data = readEntry(entry);
+
+            if (data.isNull() || QCryptographicHash::hash(data, QCryptographicHash::Sha256) != hash) {
+                qCWarning(asset_server) << "Dropping corrupt asset" << hash.toHex() << "from" << segmentFilePath(segment);
+                ++_corruptRecords;
+                eraseEntry(hash);
+                continue;
+            }
+
+            if (!appendRecord(Put, hash, data.constData(), entry.size)) {
+                // the assets copied so far stay where they were copied to, the segment is compacted next time
+                qCWarning(asset_server) << "Stopping asset pack compaction, could not copy" << hash.toHex();
+                writeIndex();
+                return 0;
+            }
+        }
+    }
+
+    for (auto segment : candidates) {
+        _segments.erase(segment);
+    }
+
+    // the removed segments are only deleted once the index no longer needs them. Should one of them hold the
+    // delete record of an asset still stored in an older segment, a rebuild of the index would bring the asset
+    // back, which is harmless since the asset server removes unmapped assets when it starts.
+    if (!writeIndex()) {
+        return 0;
+    }
+
+    for (auto segment : candidates) {
+        removeSegmentFile(segment);
+    }
+
+    _compactedSegments += candidates.size();
+    qCInfo(asset_server) << "Compacted" << candidates.size() << "asset pack segments.";
+
+    return (int)candidates.size();
+}
+
+int AssetPackStore::scrub() {
+    quint32 segment;
+    std::vector<Hash> corrupt;
+
+    {
+        QReadLocker locker(&_lock);
+
+        auto it = _segments.lower_bound(_nextScrubSegment);
+        if (it == _segments.end() || it->first == _activeSegment) {
+            it = _segments.begin();
+        }
+        if (it == _segments.end() || it->first == _activeSegment) {
+            return 0;
+        }
+        segment = it->first;
+
+        for (const auto& hash : hashesInSegment(segment)) {
+            QByteArray data = readEntry(_entries.value(hash));
+            if (data.isNull() || QCryptographicHash::hash(data, QCryptographicHash::Sha256) != hash) {
+                corrupt.push_back(hash);
+            }
+        }
+    }
+
+    _nextScrubSegment = segment + 1;
+
+    if (!corrupt.empty()) {
+        QWriteLocker locker(&_lock);
+        for (const auto& hash : corrupt) {
+            auto it = _entries.find(hash);
+            if (it != _entries.end() && it->segment == segment) {
+                qCWarning(asset_server) << "Dropping corrupt asset" << hash.toHex() << "from" << segmentFilePath(segment);
+                ++_corruptRecords;
+                appendRecord(Delete, hash, nullptr, 0);
+            }
+        }
+    }
+
+    return (int)corrupt.size();
+}
+
+QJsonObject AssetPackStore::getStats() const {
+    QJsonObject stats;
+
+    QReadLocker locker(&_lock);
+
+    qint64 liveBytes = 0;
+    qint64 totalBytes = 0;
+    for (const auto& pair : _segments) {
+        liveBytes += pair.second.liveBytes;
+        totalBytes += pair.second.length;
+    }
+
+    stats["1. Assets"] = _entries.size();
+    stats["2. Segments"] = (int)_segments.size();
+    stats["3. Live Bytes"] = (double)liveBytes;
+    stats["4. Total Bytes"] = (double)totalBytes;
+    stats["5. Replayed Records"] = (double)_replayedRecords;
+    stats["6. Compacted Segments"] = (double)_compactedSegments;
+    stats["7. Corrupt Records"] = (double)_corruptRecords;
+
+    return stats;
+}
@@ -0,0 +1,155 @@
+//
+//  AssetPackStore.h
+//  assignment-client/src/assets
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetPackStore_h
+#define hifi_AssetPackStore_h
+
+#include <atomic>
+#include <map>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QReadWriteLock>
+#include <QtCore/QStringList>
+
+#include <AssetUtils.h>
+
+#include "AssetFileCache.h"
+
+/// Content-addressed storage of asset files in a few large append-only segment files, instead of one file per hash.
+///
+/// Every upload or delete appends a record to the active segment. An index of where each live asset is
+/// (hash => segment, offset, size) is persisted next to the segments, along with how much of each segment
+/// it covers, so opening the store only has to replay the records appended since the index was written.
+/// Sealed segments are never modified: compaction copies the live records out of mostly dead segments and
+/// removes them, so backups of the directory only need to copy new segment files.
+///
+/// Asset contents are verified against their SHA-256 hash whenever records are replayed, compacted or scrubbed.
+///
+/// Thread-safe, reads are shared by the SendAssetTasks of an AssetServer.
+class AssetPackStore {
+public:
+    static const qint64 DEFAULT_MAX_SEGMENT_SIZE = 64 * 1024 * 1024;
+    static constexpr float DEFAULT_MIN_LIVE_RATIO = 0.5f;
+
+    AssetPackStore(const QDir& directory);
+    ~AssetPackStore();
+
+    /// Loads the index and replays the records appended after it was written. Returns false if the directory can't be used.
+    bool open();
+
+    /// Persists the index and closes the active segment.
+    void close();
+
+    bool contains(const AssetUtils::AssetHash& hash) const;
+
+    /// Returns the size of the asset, or -1 if it isn't in the store.
+    qint64 getSize(const AssetUtils::AssetHash& hash) const;
+
+    /// Maps the asset from its segment. Returns nullptr if it isn't in the store.
+    AssetFileCache::MappedFilePointer map(const AssetUtils::AssetHash& hash) const;
+
+    /// Reads the whole asset. Returns a null QByteArray if it isn't in the store.
+    QByteArray read(const AssetUtils::AssetHash& hash) const;
+
+    /// Copies the asset out of the store into a standalone file.
+    bool extract(const AssetUtils::AssetHash& hash, const QString& filePath) const;
+
+    /// Appends the asset, unless an asset with the same hash is already stored. The caller is trusted to pass
+    /// the hash of data.
+    bool write(const AssetUtils::AssetHash& hash, const QByteArray& data);
+
+    /// Appends a delete record for the asset. Returns false if it wasn't in the store.
+    bool remove(const AssetUtils::AssetHash& hash);
+
+    std::vector<AssetUtils::AssetHash> getHashes() const;
+    int getNumAssets() const;
+
+    /// Copies the live assets out of every sealed segment with less than minLiveRatio of its bytes live, then
+    /// deletes those segments. Returns the number of segments removed.
+    int compact(float minLiveRatio = DEFAULT_MIN_LIVE_RATIO);
+
+    /// Verifies the assets of the next sealed segment, round-robin, and drops those that don't match their hash.
+    /// Returns the number of corrupt assets found.
+    int scrub();
+
+    QJsonObject getStats() const;
+
+private:
+    enum RecordType : quint8 {
+        Put = 1,
+        Delete = 2
+    };
+
+    struct RecordHeader {
+        quint32 magic;
+        quint8 type;
+        quint8 reserved[3];
+        quint64 size;
+        char hash[AssetUtils::SHA256_HASH_LENGTH];
+    };
+
+    struct Entry {
+        quint32 segment;
+        quint64 offset;     // of the data, after the record header
+        quint64 size;
+    };
+
+    struct Segment {
+        qint64 length { 0 };
+        qint64 liveBytes { 0 };         // headers and data of the records still in the index
+        qint64 indexedLength { 0 };     // length covered by the persisted index
+    };
+
+    using Hash = QByteArray;            // raw SHA-256
+
+    static Hash toRawHash(const AssetUtils::AssetHash& hash);
+    static qint64 recordSize(quint64 dataSize) { return (qint64)sizeof(RecordHeader) + (qint64)dataSize; }
+
+    QString segmentFilePath(quint32 segment) const;
+    QString indexFilePath() const;
+
+    // called with _lock held for writing
+    bool loadIndex();
+    bool writeIndex();
+    void replaySegment(quint32 segment, bool isLast);
+    bool openActiveSegment(quint32 segment);
+    bool appendRecord(RecordType type, const Hash& hash, const char* data, quint64 size);
+    void setEntry(const Hash& hash, const Entry& entry);
+    void eraseEntry(const Hash& hash);
+    void removeSegmentFile(quint32 segment);
+
+    // called with _lock held for reading or writing
+    QByteArray readEntry(const Entry& entry) const;
+    std::vector<Hash> hashesInSegment(quint32 segment) const;
+
+    QDir _directory;
+
+    mutable QReadWriteLock _lock;
+    QHash<Hash, Entry> _entries;
+    std::map<quint32, Segment> _segments;
+    QFile _activeFile;
+    quint32 _activeSegment { 0 };
+    int _unindexedRecords { 0 };
+    quint32 _nextScrubSegment { 0 };
+
+    // segments that couldn't be deleted yet, because they are still mapped
+    QStringList _pendingRemovals;
+
+    std::atomic<uint64_t> _replayedRecords { 0 };
+    std::atomic<uint64_t> _compactedSegments { 0 };
+    std::atomic<uint64_t> _corruptRecords { 0 };
+};
+
+#endif // hifi_AssetPackStore_h
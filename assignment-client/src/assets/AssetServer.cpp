@@ -25,6 +25,7 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QSaveFile>
 #include <QtCore/QString>
+#include <QtCore/QTimer>
 #include <QtGui/QImageReader>
 #include <QtCore/QVector>
 #include <QtCore/QUrlQuery>
@@ -34,6 +35,8 @@
 #include <SharedUtil.h>
 #include <PathUtils.h>
 #include <image/TextureProcessing.h>
+#include <udt/BBRCC.h>
+#include <udt/TCPVegasCC.h>
 
 #include "AssetServerLogging.h"
 #include "BakeAssetTask.h"
@@ -117,7 +120,7 @@ void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetU
     qDebug() << "Starting bake for: " << assetPath << assetHash;
     auto it = _pendingBakes.find(assetHash);
     if (it == _pendingBakes.end()) {
-        auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath);
+        auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath, _packStore);
         task->setAutoDelete(false);
         _pendingBakes[assetHash] = task;
 
@@ -135,6 +138,45 @@ QString AssetServer::getPathToAssetHash(const AssetUtils::AssetHash& assetHash)
     return _filesDirectory.absoluteFilePath(assetHash);
 }
 
+bool AssetServer::assetFileExists(const AssetUtils::AssetHash& hash) {
+    if (_packStore) {
+        return _packStore->contains(hash);
+    }
+    return QFile::exists(_filesDirectory.absoluteFilePath(hash));
+}
+
+QByteArray AssetServer::readAssetFile(const AssetUtils::AssetHash& hash) {
+    if (_packStore) {
+        return _packStore->read(hash);
+    }
+
+    QFile file { _filesDirectory.absoluteFilePath(hash) };
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+bool AssetServer::writeAssetFile(const AssetUtils::AssetHash& hash, const QByteArray& data) {
+    if (_packStore) {
+        return _packStore->write(hash, data);
+    }
+
+    QFile file { _filesDirectory.absoluteFilePath(hash) };
+    return file.open(QIODevice::WriteOnly) && file.write(data) == data.size();
+}
+
+bool AssetServer::removeAssetFile(const AssetUtils::AssetHash& hash) {
+    _fileCache->remove(hash);
+
+    if (_packStore) {
+        return _packStore->remove(hash);
+    }
+
+    QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
+    return removeableFile.remove();
+}
+
 std::pair<AssetUtils::BakingStatus, QString> AssetServer::getAssetStatus(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash) {
     auto it = _pendingBakes.find(hash);
     if (it != _pendingBakes.end()) {
@@ -293,6 +335,7 @@ void updateConsumedCores() {
 
 AssetServer::AssetServer(ReceivedMessage& message) :
     ThreadedAssignment(message),
+    _fileCache(std::make_shared<AssetFileCache>()),
     _transferTaskPool(this),
     _bakingTaskPool(this),
     _filesizeLimit(AssetUtils::MAX_UPLOAD_SIZE)
@@ -331,6 +374,10 @@ void AssetServer::aboutToFinish() {
     // remove pending transfer tasks
     _transferTaskPool.clear();
 
+    if (_packStore) {
+        _packStore->close();
+    }
+
     // abort each of our still running bake tasks, remove pending bakes that were never put on the thread pool
     auto it = _pendingBakes.begin();
     while (it != _pendingBakes.end()) {
@@ -364,6 +411,7 @@ void AssetServer::run() {
 }
 
 static const QString ASSET_FILES_SUBDIR = "files";
+static const QString ASSET_PACKS_SUBDIR = "packs";
 
 void AssetServer::completeSetup() {
     auto nodeList = DependencyManager::get<NodeList>();
@@ -395,6 +443,18 @@ void AssetServer::completeSetup() {
                     " (" << maxBandwidth << "bits/s)";
     }
 
+    // connections made from here on, which are those of the clients pulling assets, use the chosen congestion control
+    static const QString CONGESTION_CONTROL_OPTION = "congestion_control";
+    static const QString BBR_CONGESTION_CONTROL = "bbr";
+    if (assetServerObject[CONGESTION_CONTROL_OPTION].toString() == BBR_CONGESTION_CONTROL) {
+        nodeList->setCongestionControlFactory(std::unique_ptr<udt::CongestionControlVirtualFactory>(
+            new udt::CongestionControlFactory<udt::BBRCC>()));
+        qCInfo(asset_server) << "Using BBR congestion control for client connections.";
+    } else {
+        nodeList->setCongestionControlFactory(std::unique_ptr<udt::CongestionControlVirtualFactory>(
+            new udt::CongestionControlFactory<udt::TCPVegasCC>()));
+    }
+
     // get the path to the asset folder from the domain server settings
     static const QString ASSETS_PATH_OPTION = "assets_path";
     auto assetsJSONValue = assetServerObject[ASSETS_PATH_OPTION];
@@ -427,17 +487,30 @@ void AssetServer::completeSetup() {
         return;
     }
 
+    // store the asset files in append-only segments instead of one file per hash, if enabled
+    static const QString ASSETS_PACK_STORAGE_OPTION = "assets_pack_storage";
+    if (!setupPackStore(assetServerObject[ASSETS_PACK_STORAGE_OPTION].toBool(false))) {
+        qCCritical(asset_server) << "Unable to set up the asset pack store. Stopping assignment.";
+        setFinished(true);
+        return;
+    }
+
     // load whatever mappings we currently have from the local file
     if (loadMappingsFromFile()) {
-        qCInfo(asset_server) << "Serving files from: " << _filesDirectory.path();
+        if (_packStore) {
+            qCInfo(asset_server) << "Serving files from asset packs in: " << _resourcesDirectory.absoluteFilePath(ASSET_PACKS_SUBDIR);
+            qCInfo(asset_server) << "There are" << _packStore->getNumAssets() << "asset files in the asset packs.";
+        } else {
+            qCInfo(asset_server) << "Serving files from: " << _filesDirectory.path();
 
-        // Check the asset directory to output some information about what we have
-        auto files = _filesDirectory.entryList(QDir::Files);
+            // Check the asset directory to output some information about what we have
+            auto files = _filesDirectory.entryList(QDir::Files);
 
-        QRegExp hashFileRegex { AssetUtils::ASSET_HASH_REGEX_STRING };
-        auto hashedFiles = files.filter(hashFileRegex);
+            QRegExp hashFileRegex { AssetUtils::ASSET_HASH_REGEX_STRING };
+            auto hashedFiles = files.filter(hashFileRegex);
 
-        qCInfo(asset_server) << "There are" << hashedFiles.size() << "asset files in the asset directory.";
+            qCInfo(asset_server) << "There are" << hashedFiles.size() << "asset files in the asset directory.";
+        }
 
         if (_fileMappings.size() > 0) {
             cleanupUnmappedFiles();
@@ -461,6 +534,15 @@ void AssetServer::completeSetup() {
         _filesizeLimit = assetsFilesizeLimit * BITS_PER_MEGABITS;
     }
 
+    // get the size of the cache of mapped asset files
+    static const QString ASSETS_CACHE_SIZE_OPTION = "assets_cache_size";
+    static const qint64 BYTES_PER_MEGABYTE = 1024 * 1024;
+    auto assetsCacheSizeJSONValue = assetServerObject[ASSETS_CACHE_SIZE_OPTION];
+    if (assetsCacheSizeJSONValue.isDouble()) {
+        _fileCache->setMaxCachedBytes(std::max(assetsCacheSizeJSONValue.toInt(), 0) * BYTES_PER_MEGABYTE);
+        qCInfo(asset_server) << "Asset file cache size set to" << assetsCacheSizeJSONValue.toInt() << "MB";
+    }
+
     PathUtils::removeTemporaryApplicationDirs();
     PathUtils::removeTemporaryApplicationDirs("Oven");
 
@@ -525,36 +607,129 @@ void AssetServer::replayRequests() {
 }
 
 void AssetServer::cleanupUnmappedFiles() {
-    QRegExp hashFileRegex { AssetUtils::ASSET_HASH_REGEX_STRING };
+    qCInfo(asset_server) << "Performing unmapped asset cleanup.";
 
-    auto files = _filesDirectory.entryInfoList(QDir::Files);
+    QSet<AssetUtils::AssetHash> mappedHashes;
+    for (auto& pair : _fileMappings) {
+        mappedHashes.insert(pair.second);
+    }
 
-    qCInfo(asset_server) << "Performing unmapped asset cleanup.";
+    QStringList hashes;
+    if (_packStore) {
+        // the pack index already lists the stored assets, no need to scan a directory
+        for (const auto& hash : _packStore->getHashes()) {
+            hashes << hash;
+        }
+    } else {
+        QRegExp hashFileRegex { AssetUtils::ASSET_HASH_REGEX_STRING };
+        for (const auto& filename : _filesDirectory.entryList(QDir::Files)) {
+            if (hashFileRegex.exactMatch(filename)) {
+                hashes << filename;
+            }
+        }
+    }
 
-    for (const auto& fileInfo : files) {
-        auto filename = fileInfo.fileName();
-        if (hashFileRegex.exactMatch(filename)) {
-            bool matched { false };
-            for (auto& pair : _fileMappings) {
-                if (pair.second == filename) {
-                    matched = true;
-                    break;
-                }
+    for (const auto& hash : hashes) {
+        if (!mappedHashes.contains(hash)) {
+            // remove the unmapped file
+            if (removeAssetFile(hash)) {
+                qCDebug(asset_server) << "\tDeleted" << hash << "from asset files directory since it is unmapped.";
+
+                removeBakedPathsForDeletedAsset(hash);
+            } else {
+                qCDebug(asset_server) << "\tAttempt to delete unmapped file" << hash << "failed";
             }
-            if (!matched) {
-                // remove the unmapped file
-                QFile removeableFile { fileInfo.absoluteFilePath() };
+        }
+    }
+}
 
-                if (removeableFile.remove()) {
-                    qCDebug(asset_server) << "\tDeleted" << filename << "from asset files directory since it is unmapped.";
+bool AssetServer::setupPackStore(bool enabled) {
+    QDir packsDirectory { _resourcesDirectory.absoluteFilePath(ASSET_PACKS_SUBDIR) };
 
-                    removeBakedPathsForDeletedAsset(filename);
-                } else {
-                    qCDebug(asset_server) << "\tAttempt to delete unmapped file" << filename << "failed";
-                }
+    if (!enabled) {
+        if (!packsDirectory.exists()) {
+            return true;
+        }
+
+        // pack storage was turned off, move the assets back to separate files
+        AssetPackStore packStore { packsDirectory };
+        if (!packStore.open()) {
+            return false;
+        }
+
+        auto hashes = packStore.getHashes();
+        for (const auto& hash : hashes) {
+            if (!packStore.extract(hash, _filesDirectory.absoluteFilePath(hash))) {
+                qCCritical(asset_server) << "Could not move asset" << hash << "out of the asset packs.";
+                return false;
             }
         }
+        packStore.close();
+
+        packsDirectory.removeRecursively();
+        qCInfo(asset_server) << "Moved" << hashes.size() << "assets from the asset packs to separate files.";
+
+        return true;
+    }
+
+    _packStore = std::make_shared<AssetPackStore>(packsDirectory);
+    if (!_packStore->open()) {
+        _packStore.reset();
+        return false;
+    }
+
+    // move assets that are still stored as separate files into the packs, this only has to be done once
+    QRegExp hashFileRegex { AssetUtils::ASSET_HASH_REGEX_STRING };
+    int numImported = 0;
+    for (const auto& fileInfo : _filesDirectory.entryInfoList(QDir::Files)) {
+        auto filename = fileInfo.fileName();
+        if (!hashFileRegex.exactMatch(filename)) {
+            continue;
+        }
+
+        QFile file { fileInfo.absoluteFilePath() };
+        if (!file.open(QIODevice::ReadOnly)) {
+            qCWarning(asset_server) << "Could not open" << filename << "to move it to the asset packs.";
+            continue;
+        }
+
+        auto data = file.readAll();
+        file.close();
+
+        if (QString(AssetUtils::hashData(data).toHex()) != filename) {
+            qCWarning(asset_server) << "Not moving asset file" << filename << "to the asset packs, its contents don't match its hash.";
+            continue;
+        }
+
+        if (_packStore->write(filename, data) && file.remove()) {
+            ++numImported;
+        }
+    }
+
+    if (numImported > 0) {
+        qCInfo(asset_server) << "Moved" << numImported << "asset files to the asset packs.";
     }
+
+    static const int PACK_STORE_MAINTENANCE_INTERVAL_MS = 10 * 60 * 1000;
+    QTimer* maintenanceTimer = new QTimer(this);
+    connect(maintenanceTimer, &QTimer::timeout, this, &AssetServer::maintainPackStore);
+    maintenanceTimer->setTimerType(Qt::CoarseTimer);
+    maintenanceTimer->start(PACK_STORE_MAINTENANCE_INTERVAL_MS);
+
+    return true;
+}
+
+void AssetServer::maintainPackStore() {
+    if (!_packStore) {
+        return;
+    }
+
+    if (_packStore->compact() > 0) {
+        // release the mappings of the compacted segments, so that their files can be deleted everywhere
+        _fileCache->clear();
+    }
+
+    _packStore->scrub();
 }
 
 void AssetServer::cleanupBakedFilesForDeletedAssets() {
@@ -849,12 +1024,21 @@ void AssetServer::handleAssetGetInfo(QSharedPointer<ReceivedMessage> message, Sh
     replyPacket->write(assetHash);
 
     QString fileName = QString(hexHash);
-    QFileInfo fileInfo { _filesDirectory.filePath(fileName) };
+    qint64 fileSize = -1;
 
-    if (fileInfo.exists() && fileInfo.isReadable()) {
-        qCDebug(asset_server) << "Opening file: " << fileInfo.filePath();
+    if (_packStore) {
+        fileSize = _packStore->getSize(fileName);
+    } else {
+        QFileInfo fileInfo { _filesDirectory.filePath(fileName) };
+        if (fileInfo.exists() && fileInfo.isReadable()) {
+            qCDebug(asset_server) << "Opening file: " << fileInfo.filePath();
+            fileSize = fileInfo.size();
+        }
+    }
+
+    if (fileSize >= 0) {
         replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
-        replyPacket->writePrimitive(fileInfo.size());
+        replyPacket->writePrimitive(fileSize);
     } else {
         qCDebug(asset_server) << "Asset not found: " << QString(hexHash);
         replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
@@ -874,7 +1058,7 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _filesDirectory, _fileCache, _packStore);
     _transferTaskPool.start(task);
 }
 
@@ -888,7 +1072,7 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     if (canWriteToAssetServer) {
         qCDebug(asset_server) << "Starting an UploadAssetTask for upload from" << message->getSourceID();
 
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit);
+        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _packStore, _filesizeLimit);
         _transferTaskPool.start(task);
     } else {
         // this is a node the domain told us is not allowed to rez entities
@@ -967,6 +1151,11 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     });
 
+    serverStats["asset_file_cache"] = _fileCache->getStats();
+    if (_packStore) {
+        serverStats["asset_pack_store"] = _packStore->getStats();
+    }
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -1180,9 +1369,7 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
         // we now have a set of hashes that are unmapped - we will delete those asset files
         for (auto& hash : hashesToCheckForDeletion) {
             // remove the unmapped file
-            QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
-
-            if (removeableFile.remove()) {
+            if (removeAssetFile(hash)) {
                 qCDebug(asset_server) << "\tDeleted" << hash << "from asset files directory since it is now unmapped.";
 
                 removeBakedPathsForDeletedAsset(hash);
@@ -1423,10 +1610,16 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
         bakedFileHash = hasher.result().toHex();
 
         // first check that we don't already have this bake file in our list
-        auto bakeFileDestination = _filesDirectory.absoluteFilePath(bakedFileHash);
-        if (!QFile::exists(bakeFileDestination)) {
+        if (!assetFileExists(bakedFileHash)) {
             // copy each to our files folder (with the hash as their filename)
-            if (!file.copy(_filesDirectory.absoluteFilePath(bakedFileHash))) {
+            bool copied;
+            if (_packStore) {
+                copied = file.seek(0) && _packStore->write(bakedFileHash, file.readAll());
+            } else {
+                copied = file.copy(_filesDirectory.absoluteFilePath(bakedFileHash));
+            }
+
+            if (!copied) {
                 // stop handling this bake, couldn't copy the bake file into our files directory
                 errorCompletingBake = true;
                 errorReason = "Failed to copy baked assets to asset server";
@@ -1493,12 +1686,9 @@ std::pair<bool, AssetMeta> AssetServer::readMetaFile(AssetUtils::AssetHash hash)
 
     auto metaFileHash = it->second;
 
-    QFile metaFile(_filesDirectory.absoluteFilePath(metaFileHash));
-
-    if (metaFile.open(QIODevice::ReadOnly)) {
-        auto data = metaFile.readAll();
-        metaFile.close();
+    auto data = readAssetFile(metaFileHash);
 
+    if (!data.isNull()) {
         QJsonParseError error;
         auto doc = QJsonDocument::fromJson(data, &error);
 
@@ -1548,12 +1738,7 @@ bool AssetServer::writeMetaFile(AssetUtils::AssetHash originalAssetHash, const A
     AssetUtils::AssetHash metaFileHash = QCryptographicHash::hash(metaFileJSON, QCryptographicHash::Sha256).toHex();
 
     // create the meta file in our files folder, named by the hash of its contents
-    QFile metaFile(_filesDirectory.absoluteFilePath(metaFileHash));
-
-    if (metaFile.open(QIODevice::WriteOnly)) {
-        metaFile.write(metaFileJSON);
-        metaFile.close();
-
+    if (writeAssetFile(metaFileHash, metaFileJSON)) {
         // add a mapping to the meta file so it doesn't get deleted because it is unmapped
         auto metaFileMapping = AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER + originalAssetHash + "/" + "meta.json";
 
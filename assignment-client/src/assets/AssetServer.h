@@ -12,6 +12,8 @@
 #ifndef hifi_AssetServer_h
 #define hifi_AssetServer_h
 
+#include <memory>
+
 #include <QtCore/QDir>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QThreadPool>
@@ -19,6 +21,8 @@
 
 #include <ThreadedAssignment.h>
 
+#include "AssetFileCache.h"
+#include "AssetPackStore.h"
 #include "AssetUtils.h"
 #include "ReceivedMessage.h"
 
@@ -128,6 +132,18 @@ private:
 
     QString getPathToAssetHash(const AssetUtils::AssetHash& assetHash);
 
+    /// Open the pack store if it's enabled, moving assets between separate files and the store when the setting changed
+    bool setupPackStore(bool enabled);
+
+    /// Compact and scrub the pack store, called periodically
+    void maintainPackStore();
+
+    // Asset file operations, on separate files or the pack store
+    bool assetFileExists(const AssetUtils::AssetHash& hash);
+    QByteArray readAssetFile(const AssetUtils::AssetHash& hash);
+    bool writeAssetFile(const AssetUtils::AssetHash& hash, const QByteArray& data);
+    bool removeAssetFile(const AssetUtils::AssetHash& hash);
+
     std::pair<AssetUtils::BakingStatus, QString> getAssetStatus(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash);
 
     void bakeAssets();
@@ -154,6 +170,12 @@ private:
     QDir _resourcesDirectory;
     QDir _filesDirectory;
 
+    /// Mapped asset files shared by the SendAssetTasks
+    std::shared_ptr<AssetFileCache> _fileCache;
+
+    /// Segmented storage of the asset files, null when they are stored as separate files
+    std::shared_ptr<AssetPackStore> _packStore;
+
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
 
@@ -21,10 +21,12 @@
 #include "ClientServerUtils.h"
 
 UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
-                                 const QDir& resourcesDir, uint64_t filesizeLimit) :
+                                 const QDir& resourcesDir, std::shared_ptr<AssetPackStore> packStore,
+                                 uint64_t filesizeLimit) :
     _receivedMessage(receivedMessage),
     _senderNode(senderNode),
     _resourcesDir(resourcesDir),
+    _packStore(packStore),
     _filesizeLimit(filesizeLimit)
 {
     
@@ -65,43 +67,57 @@ void UploadAssetTask::run() {
             qDebug() << "Hash for uploaded file from" << _receivedMessage->getSenderSockAddr() << "is: (" << hexHash << ")";
         }
         
-        QFile file { _resourcesDir.filePath(QString(hexHash)) };
-
-        bool existingCorrectFile = false;
-        
-        if (file.exists()) {
-            // check if the local file has the correct contents, otherwise we overwrite
-            if (file.open(QIODevice::ReadOnly) && AssetUtils::hashData(file.readAll()) == hash) {
-                qDebug() << "Not overwriting existing verified file: " << hexHash;
-
-                existingCorrectFile = true;
+        if (_packStore) {
+            // the pack store keeps the first copy of a hash, which was verified when it was written or replayed
+            if (_packStore->write(hexHash, fileData)) {
+                qDebug() << "Wrote file" << hexHash << "to asset pack. Upload complete";
 
                 replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
                 replyPacket->write(hash);
             } else {
-                qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
-                file.close();
+                qWarning() << "Failed to write file" << hexHash << "to asset pack - upload failed.";
+
+                replyPacket->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
             }
-        }
+        } else {
+            QFile file { _resourcesDir.filePath(QString(hexHash)) };
 
-        if (!existingCorrectFile) {
-            if (file.open(QIODevice::WriteOnly) && file.write(fileData) == qint64(fileSize)) {
-                qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
-                file.close();
+            bool existingCorrectFile = false;
 
-                replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
-                replyPacket->write(hash);
-            } else {
-                qWarning() << "Failed to upload or write to file" << hexHash << " - upload failed.";
+            if (file.exists()) {
+                // check if the local file has the correct contents, otherwise we overwrite
+                if (file.open(QIODevice::ReadOnly) && AssetUtils::hashData(file.readAll()) == hash) {
+                    qDebug() << "Not overwriting existing verified file: " << hexHash;
 
-                // upload has failed - remove the file and return an error
-                auto removed = file.remove();
+                    existingCorrectFile = true;
 
-                if (!removed) {
-                    qWarning() << "Removal of failed upload file" << hexHash << "failed.";
+                    replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
+                    replyPacket->write(hash);
+                } else {
+                    qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
+                    file.close();
+                }
+            }
+
+            if (!existingCorrectFile) {
+                if (file.open(QIODevice::WriteOnly) && file.write(fileData) == qint64(fileSize)) {
+                    qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
+                    file.close();
+
+                    replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
+                    replyPacket->write(hash);
+                } else {
+                    qWarning() << "Failed to upload or write to file" << hexHash << " - upload failed.";
+
+                    // upload has failed - remove the file and return an error
+                    auto removed = file.remove();
+
+                    if (!removed) {
+                        qWarning() << "Removal of failed upload file" << hexHash << "failed.";
+                    }
+
+                    replyPacket->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
                 }
-                
-                replyPacket->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
             }
         }
 
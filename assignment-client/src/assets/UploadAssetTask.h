@@ -14,11 +14,14 @@
 #ifndef hifi_UploadAssetTask_h
 #define hifi_UploadAssetTask_h
 
+#include <memory>
+
 #include <QtCore/QDir>
 #include <QtCore/QObject>
 #include <QtCore/QRunnable>
 #include <QtCore/QSharedPointer>
 
+#include "AssetPackStore.h"
 #include "ReceivedMessage.h"
 
 class NLPacketList;
@@ -27,7 +30,7 @@ class Node;
 class UploadAssetTask : public QRunnable {
 public:
     UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, 
-                    const QDir& resourcesDir, uint64_t filesizeLimit);
+                    const QDir& resourcesDir, std::shared_ptr<AssetPackStore> packStore, uint64_t filesizeLimit);
 
     void run() override;
 
@@ -35,6 +38,7 @@ private:
     QSharedPointer<ReceivedMessage> _receivedMessage;
     QSharedPointer<Node> _senderNode;
     QDir _resourcesDir;
+    std::shared_ptr<AssetPackStore> _packStore; // null when assets are stored as separate files
     uint64_t _filesizeLimit;
 };
 
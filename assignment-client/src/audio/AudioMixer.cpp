@@ -48,6 +48,8 @@ using namespace std;
 static const float DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE = 0.5f;    // attenuation = -6dB * log2(distance)
 static const int DISABLE_STATIC_JITTER_FRAMES = -1;
 static const float DEFAULT_NOISE_MUTING_THRESHOLD = 1.0f;
+static const float DEFAULT_FOA_BUS_DISTANCE = 0.0f;  // disabled
+static const float DEFAULT_FOA_BUS_CELL_SIZE = 8.0f;
 static const QString AUDIO_MIXER_LOGGING_TARGET_NAME = "audio-mixer";
 static const QString AUDIO_ENV_GROUP_KEY = "audio_env";
 static const QString AUDIO_BUFFER_GROUP_KEY = "audio_buffer";
@@ -91,7 +93,8 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     auto& packetReceiver = nodeList->getPacketReceiver();
 
     // packets whose consequences are limited to their own node can be parallelized
-    packetReceiver.registerListenerForTypes({
+    // they skip the event queue and are picked up by the frame loop
+    packetReceiver.registerQueueForTypes({
             PacketType::MicrophoneAudioNoEcho,
             PacketType::MicrophoneAudioWithEcho,
             PacketType::InjectAudio,
@@ -106,7 +109,7 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
             PacketType::InjectorGainSet,
             PacketType::AudioSoloRequest,
             PacketType::StopInjector },
-            PacketReceiver::makeSourcedListenerReference<AudioMixer>(this, &AudioMixer::queueAudioPacket)
+            this, _audioPacketQueue
     );
 
     // packets whose consequences are global should be processed on the main thread
@@ -131,6 +134,9 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
 }
 
 void AudioMixer::aboutToFinish() {
+    // stop the networking threads from pushing onto our queue before it goes away
+    DependencyManager::get<NodeList>()->getPacketReceiver().unregisterListener(this);
+
     DependencyManager::destroy<PluginManager>();
 }
 
@@ -317,6 +323,7 @@ void AudioMixer::sendStatsPacket() {
     addTiming(_frameTiming, "frame");
     addTiming(_packetsTiming, "packets");
     addTiming(_mixTiming, "mix");
+    addTiming(_foaBusTiming, "foa_bus");
     addTiming(_eventsTiming, "events");
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
@@ -332,10 +339,15 @@ void AudioMixer::sendStatsPacket() {
     mixStats["%_hrtf_mixes"] = percentageForMixStats(_stats.hrtfRenders);
     mixStats["%_manual_stereo_mixes"] = percentageForMixStats(_stats.manualStereoMixes);
     mixStats["%_manual_echo_mixes"] = percentageForMixStats(_stats.manualEchoMixes);
+    mixStats["%_foa_bus_mixes"] = percentageForMixStats(_stats.foaBusMixes);
 
     mixStats["1_hrtf_renders"] = (int)(_stats.hrtfRenders / (float)_numStatFrames);
     mixStats["1_hrtf_resets"] = (int)(_stats.hrtfResets / (float)_numStatFrames);
     mixStats["1_hrtf_updates"] = (int)(_stats.hrtfUpdates / (float)_numStatFrames);
+    mixStats["1_foa_bus_renders"] = (int)(_stats.foaBusRenders / (float)_numStatFrames);
+    mixStats["1_foa_bus_encoded_cells"] = (int)(_stats.foaBusEncodedCells / (float)_numStatFrames);
+    mixStats["1_foa_bus_prepared_cells"] = (int)(_stats.foaBusPreparedCells / (float)_numStatFrames);
+    mixStats["1_foa_bus_fallback_cells"] = (int)(_stats.foaBusFallbackCells / (float)_numStatFrames);
 
     mixStats["2_skipped_streams"] = (int)(_stats.skipped / (float)_numStatFrames);
     mixStats["2_inactive_streams"] = (int)(_stats.inactive / (float)_numStatFrames);
@@ -453,6 +465,13 @@ void AudioMixer::start() {
             // first clear the concurrent vector of added streams that the workers will add to when they process packets
             _workerSharedData.addedStreams.clear();
 
+            // hand the packets received since the last frame to their clients
+            _audioPacketQueue.drain([this](const QSharedPointer<ReceivedMessage>& message, const SharedNodePointer& node) {
+                if (node) {
+                    queueAudioPacket(message, node);
+                }
+            });
+
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 _workerPool.processPackets(cbegin, cend);
             });
@@ -470,6 +489,16 @@ void AudioMixer::start() {
             QCoreApplication::processEvents();
         }
 
+        // sum distant sources into the shared FOA bus, now that this frame's set of nodes is settled
+        if (_workerSharedData.foaBus.isEnabled()) {
+            auto foaBusTimer = _foaBusTiming.timer();
+
+            nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+                _workerSharedData.foaBus.prepare(cbegin, cend);
+            });
+            _stats.foaBusPreparedCells += _workerSharedData.foaBus.getNumCells();
+        }
+
         int numToRetain = -1;
         assert(_throttlingRatio >= 0.0f && _throttlingRatio <= 1.0f);
         if (_throttlingRatio > EPSILON) {
@@ -565,6 +594,8 @@ void AudioMixer::throttle(chrono::microseconds duration, int frame) {
 void AudioMixer::clearDomainSettings() {
     _numStaticJitterFrames = DISABLE_STATIC_JITTER_FRAMES;
     _attenuationPerDoublingInDistance = DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE;
+    _workerSharedData.foaBus.setDistance(DEFAULT_FOA_BUS_DISTANCE);
+    _workerSharedData.foaBus.setCellSize(DEFAULT_FOA_BUS_CELL_SIZE);
     _noiseMutingThreshold = DEFAULT_NOISE_MUTING_THRESHOLD;
     _codecPreferenceOrder.clear();
     _audioZones.clear();
@@ -579,6 +610,7 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
         QJsonObject audioThreadingGroupObject = settingsObject[AUDIO_THREADING_GROUP_KEY].toObject();
         const QString AUTO_THREADS = "auto_threads";
         bool autoThreads = audioThreadingGroupObject[AUTO_THREADS].toBool();
+
         if (!autoThreads) {
             bool ok;
             const QString NUM_THREADS = "num_threads";
@@ -691,6 +723,26 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
             }
         }
 
+        const QString FOA_BUS_DISTANCE = "foa_bus_distance";
+        if (audioEnvGroupObject[FOA_BUS_DISTANCE].isString()) {
+            bool ok = false;
+            float foaBusDistance = audioEnvGroupObject[FOA_BUS_DISTANCE].toString().toFloat(&ok);
+            if (ok) {
+                _workerSharedData.foaBus.setDistance(std::max(foaBusDistance, 0.0f));
+                qCDebug(audio) << "FOA bus distance changed to" << _workerSharedData.foaBus.getDistance();
+            }
+        }
+
+        const QString FOA_BUS_CELL_SIZE = "foa_bus_cell_size";
+        if (audioEnvGroupObject[FOA_BUS_CELL_SIZE].isString()) {
+            bool ok = false;
+            float foaBusCellSize = audioEnvGroupObject[FOA_BUS_CELL_SIZE].toString().toFloat(&ok);
+            if (ok) {
+                _workerSharedData.foaBus.setCellSize(foaBusCellSize);
+                qCDebug(audio) << "FOA bus cell size changed to" << _workerSharedData.foaBus.getCellSize();
+            }
+        }
+
         const QString NOISE_MUTING_THRESHOLD = "noise_muting_threshold";
         if (audioEnvGroupObject[NOISE_MUTING_THRESHOLD].isString()) {
             bool ok = false;
@@ -17,6 +17,7 @@
 #include <Transform.h>
 #include <AudioHRTF.h>
 #include <AudioRingBuffer.h>
+#include <ReceivedMessageQueue.h>
 #include <ThreadedAssignment.h>
 #include <UUIDHasher.h>
 
@@ -105,6 +106,9 @@ private:
 
     int _numSilentPackets { 0 };
 
+    // node-isolated audio packets, pushed by the networking threads and drained at the start of each frame
+    ReceivedMessageQueue _audioPacketQueue;
+
     int _numStatFrames { 0 };
     AudioMixerStats _stats;
 
@@ -140,6 +144,7 @@ private:
     Timer _mixTiming;
     Timer _eventsTiming;
     Timer _packetsTiming;
+    Timer _foaBusTiming;
 
     static int _numStaticJitterFrames; // -1 denotes dynamic jitter buffering
     static float _noiseMutingThreshold;
@@ -557,6 +557,13 @@ void AudioMixerClientData::processStreamPacket(ReceivedMessage& message, Concurr
     }
 }
 
+AudioMixerFOABus::ListenerState& AudioMixerClientData::getFOABusState() {
+    if (!_foaBusState) {
+        _foaBusState = std::make_unique<AudioMixerFOABus::ListenerState>();
+    }
+    return *_foaBusState;
+}
+
 int AudioMixerClientData::checkBuffersBeforeFrameSend() {
     auto it = _audioStreams.begin();
     while (it != _audioStreams.end()) {
@@ -564,6 +571,9 @@ int AudioMixerClientData::checkBuffersBeforeFrameSend() {
 
         if (stream->popFrames(1, true) > 0) {
             stream->updateLastPopOutputLoudnessAndTrailingLoudness();
+
+            // prepare the frame once here, rather than once per listener in AudioMixerWorker::addStream
+            stream->preRenderLastPopOutput();
         }
 
         static const int INJECTOR_MAX_INACTIVE_BLOCKS = 500;
@@ -32,6 +32,7 @@
 
 #include "PositionalAudioStream.h"
 #include "AvatarAudioStream.h"
+#include "AudioMixerFOABus.h"
 
 class AudioMixerClientData : public NodeData {
     Q_OBJECT
@@ -124,6 +125,7 @@ public:
         PositionalAudioStream* positionalStream;
         bool ignoredByListener { false };
         bool ignoringListener { false };
+        int foaBusCell { AudioMixerFOABus::NO_CELL };
 
         MixableStream(NodeIDStreamID nodeIDStreamID, PositionalAudioStream* positionalStream) :
             nodeStreamID(nodeIDStreamID), hrtf(new AudioHRTF), positionalStream(positionalStream) {};
@@ -163,6 +165,10 @@ public:
     bool getHasReceivedFirstMix() const { return _hasReceivedFirstMix; }
     void setHasReceivedFirstMix(bool hasReceivedFirstMix) { _hasReceivedFirstMix = hasReceivedFirstMix; }
 
+    // created the first time this listener hears the shared FOA bus
+    AudioMixerFOABus::ListenerState& getFOABusState();
+    bool hasFOABusState() const { return (bool)_foaBusState; }
+
     // end of methods called non-concurrently from single AudioMixerWorker
 
 signals:
@@ -223,6 +229,8 @@ private:
     std::vector<QUuid> _soloedNodes;
 
     bool _hasReceivedFirstMix { false };
+
+    std::unique_ptr<AudioMixerFOABus::ListenerState> _foaBusState;
 };
 
 #endif // hifi_AudioMixerClientData_h
@@ -0,0 +1,177 @@
+//
+//  AudioMixerFOABus.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerFOABus.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <InjectedAudioStream.h>
+
+#include "AudioMixerClientData.h"
+
+static const int NUM_FRAMES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+static const int HRTF_DATASET_INDEX = 1;
+
+static const float MIN_CELL_SIZE = 1.0f;
+
+// midpoint of the fixed off-axis attenuation applied to avatars by the HRTF path,
+// since the direction of emission is not known until there is a listener
+static const float AVERAGE_OFF_AXIS_ATTENUATION = 0.6f;
+
+// ambiX (SN3D) W to the B-format W expected by AudioFOA
+static const float SQRT1_2 = 0.707106781f;
+
+// keeps the centroid of a cell of silent sources well defined
+static const float MIN_LOUDNESS_WEIGHT = 1.0e-6f;
+
+void AudioMixerFOABus::setCellSize(float cellSize) {
+    _cellSize = std::max(cellSize, MIN_CELL_SIZE);
+}
+
+int64_t AudioMixerFOABus::cellKeyForPosition(const glm::vec3& position) const {
+    // 21 bits per axis
+    const int64_t MASK = (1 << 21) - 1;
+    glm::ivec3 cell = glm::ivec3(glm::floor(position / _cellSize));
+    return ((int64_t)(cell.x & MASK) << 42) | ((int64_t)(cell.y & MASK) << 21) | (int64_t)(cell.z & MASK);
+}
+
+void AudioMixerFOABus::prepare(ConstIter begin, ConstIter end) {
+    _numCells = 0;
+    _cellIndexForKey.clear();
+    _cellIndexForStream.clear();
+
+    if (!isEnabled()) {
+        return;
+    }
+
+    // sum of the loudness weights, to finish the centroids
+    std::vector<float> weights;
+
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (!nodeData) {
+            return;
+        }
+
+        for (auto& stream : nodeData->getAudioStreams()) {
+            // stereo sources are not spatialized, and repeated frames are faded per listener.
+            // Silent sources are inactive in the workers (see shouldBeInactive), so they are left out of the
+            // counts they compare against, or a cell with a muted source would never be used
+            if (stream->isStereo() || !stream->lastPopSucceeded() || stream->getLastPopOutputLoudness() == 0.0f) {
+                continue;
+            }
+
+            int64_t key = cellKeyForPosition(stream->getPosition());
+            auto it = _cellIndexForKey.find(key);
+            int index;
+            if (it == _cellIndexForKey.end()) {
+                index = _numCells++;
+                _cellIndexForKey[key] = index;
+                if ((int)_cells.size() < _numCells) {
+                    _cells.resize(_numCells);
+                }
+                weights.resize(_numCells);
+
+                Cell& cell = _cells[index];
+                cell.key = key;
+                cell.position = glm::vec3(0.0f);
+                cell.numSources = 0;
+                memset(cell.avatarSamples, 0, sizeof(cell.avatarSamples));
+                memset(cell.injectorSamples, 0, sizeof(cell.injectorSamples));
+                weights[index] = 0.0f;
+            } else {
+                index = it->second;
+            }
+
+            Cell& cell = _cells[index];
+            const float* samples = stream->getPreRenderedFloatSamples();
+
+            float* sum;
+            float gain;
+            if (stream->getType() == PositionalAudioStream::Injector) {
+                sum = cell.injectorSamples;
+                gain = static_cast<const InjectedAudioStream*>(stream.get())->getAttenuationRatio();
+            } else {
+                sum = cell.avatarSamples;
+                gain = AVERAGE_OFF_AXIS_ATTENUATION;
+            }
+
+            for (int i = 0; i < NUM_FRAMES; i++) {
+                sum[i] += samples[i] * gain;
+            }
+
+            float weight = stream->getLastPopOutputLoudness() + MIN_LOUDNESS_WEIGHT;
+            cell.position += stream->getPosition() * weight;
+            weights[index] += weight;
+
+            ++cell.numSources;
+            _cellIndexForStream[stream.get()] = index;
+        }
+    });
+
+    for (int i = 0; i < _numCells; i++) {
+        _cells[i].position /= weights[i];
+    }
+}
+
+int AudioMixerFOABus::getCellIndex(const PositionalAudioStream* stream) const {
+    auto it = _cellIndexForStream.find(stream);
+    return (it != _cellIndexForStream.end()) ? it->second : NO_CELL;
+}
+
+void AudioMixerFOABus::render(ListenerState& state, const std::vector<Encoding>& encodings, float* output) const {
+    alignas(32) float inBuffer[4][NUM_FRAMES] = {};
+    float* in[4] = { inBuffer[0], inBuffer[1], inBuffer[2], inBuffer[3] };
+
+    std::vector<ListenerState::Coefficients> coefficients;
+    coefficients.reserve(encodings.size());
+
+    for (const auto& encoding : encodings) {
+        const Cell& cell = _cells[encoding.cell];
+
+        // convert from Y-up (OpenGL) to Z-up (Ambisonic) coordinate system
+        const glm::vec3& d = encoding.direction;
+        const float basis[4] = { SQRT1_2, -d.z, -d.x, d.y };
+
+        ListenerState::Coefficients current;
+        current.key = cell.key;
+        for (int k = 0; k < 4; k++) {
+            current.avatar[k] = basis[k] * encoding.avatarGain;
+            current.injector[k] = basis[k] * encoding.injectorGain;
+        }
+
+        // crossfade from last frame's encoding of this cell, if there was one
+        auto previous = std::find_if(state.coefficients.begin(), state.coefficients.end(),
+                                     [&](const ListenerState::Coefficients& c) { return c.key == cell.key; });
+        const ListenerState::Coefficients& start = (previous != state.coefficients.end()) ? *previous : current;
+
+        for (int k = 0; k < 4; k++) {
+            float avatar = start.avatar[k];
+            float injector = start.injector[k];
+            float avatarStep = (current.avatar[k] - avatar) * (1.0f / NUM_FRAMES);
+            float injectorStep = (current.injector[k] - injector) * (1.0f / NUM_FRAMES);
+
+            for (int i = 0; i < NUM_FRAMES; i++) {
+                avatar += avatarStep;
+                injector += injectorStep;
+                in[k][i] += cell.avatarSamples[i] * avatar + cell.injectorSamples[i] * injector;
+            }
+        }
+
+        coefficients.push_back(current);
+    }
+
+    state.coefficients.swap(coefficients);
+
+    // the encoding is already relative to the listener, so no rotation
+    state.foa.render(in, output, HRTF_DATASET_INDEX, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, NUM_FRAMES);
+}
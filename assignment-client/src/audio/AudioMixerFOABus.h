@@ -0,0 +1,99 @@
+//
+//  AudioMixerFOABus.h
+//  assignment-client/src/audio
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerFOABus_h
+#define hifi_AudioMixerFOABus_h
+
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AudioConstants.h>
+#include <AudioFOA.h>
+#include <NodeList.h>
+
+class PositionalAudioStream;
+
+// Shared first-order ambisonic bus for distant sources.
+//
+// Once per frame, every mono source is summed into a mono bus for the spatial cell it is in.
+// A listener that hears all the sources of a cell from far enough away encodes the cell bus
+// into first-order ambisonics, instead of running an HRTF render per source, and renders
+// all of its encoded cells with a single AudioFOA.
+class AudioMixerFOABus {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    static const int NO_CELL = -1;
+
+    struct Cell {
+        int64_t key;
+        glm::vec3 position;     // loudness-weighted centroid of the sources
+        int numSources;
+
+        // summed separately, so that the listener's primary avatar and injector gains can be applied
+        float avatarSamples[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+        float injectorSamples[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+    };
+
+    // a cell as heard by one listener
+    struct Encoding {
+        int cell;
+        glm::vec3 direction;    // unit vector, in the listener's frame
+        float avatarGain;
+        float injectorGain;
+    };
+
+    // per-listener render state
+    struct ListenerState {
+        struct Coefficients {
+            int64_t key;
+            float avatar[4];
+            float injector[4];
+        };
+
+        AudioFOA foa;
+        std::vector<Coefficients> coefficients;   // last frame's encoding, to crossfade from
+    };
+
+    // a distance of 0 disables the bus
+    void setDistance(float distance) { _distance = distance; }
+    float getDistance() const { return _distance; }
+    bool isEnabled() const { return _distance > 0.0f; }
+
+    void setCellSize(float cellSize);
+    float getCellSize() const { return _cellSize; }
+
+    // called by the AudioMixer once per frame, after packets are processed and before mixing
+    void prepare(ConstIter begin, ConstIter end);
+
+    // thread-safe, called from AudioMixerWorker(s) while preparing mixes
+    int getCellIndex(const PositionalAudioStream* stream) const;
+    int getNumCells() const { return _numCells; }
+    const Cell& getCell(int index) const { return _cells[index]; }
+
+    // encode the cells heard by a listener and render them into output (interleaved stereo, accumulates)
+    void render(ListenerState& state, const std::vector<Encoding>& encodings, float* output) const;
+
+private:
+    int64_t cellKeyForPosition(const glm::vec3& position) const;
+
+    float _distance { 0.0f };
+    float _cellSize { 8.0f };
+
+    std::vector<Cell> _cells;
+    int _numCells { 0 };
+
+    std::unordered_map<int64_t, int> _cellIndexForKey;
+    std::unordered_map<const PositionalAudioStream*, int> _cellIndexForStream;
+};
+
+#endif // hifi_AudioMixerFOABus_h
@@ -25,6 +25,12 @@ void AudioMixerStats::reset() {
     manualStereoMixes = 0;
     manualEchoMixes = 0;
 
+    foaBusMixes = 0;
+    foaBusRenders = 0;
+    foaBusEncodedCells = 0;
+    foaBusPreparedCells = 0;
+    foaBusFallbackCells = 0;
+
     skippedToActive = 0;
     skippedToInactive = 0;
     inactiveToSkipped = 0;
@@ -55,6 +61,12 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     manualStereoMixes += otherStats.manualStereoMixes;
     manualEchoMixes += otherStats.manualEchoMixes;
 
+    foaBusMixes += otherStats.foaBusMixes;
+    foaBusRenders += otherStats.foaBusRenders;
+    foaBusEncodedCells += otherStats.foaBusEncodedCells;
+    foaBusPreparedCells += otherStats.foaBusPreparedCells;
+    foaBusFallbackCells += otherStats.foaBusFallbackCells;
+
     skippedToActive += otherStats.skippedToActive;
     skippedToInactive += otherStats.skippedToInactive;
     inactiveToSkipped += otherStats.inactiveToSkipped;
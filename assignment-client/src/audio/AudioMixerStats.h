@@ -30,6 +30,12 @@ struct AudioMixerStats {
     int manualStereoMixes { 0 };
     int manualEchoMixes { 0 };
 
+    int foaBusMixes { 0 };
+    int foaBusRenders { 0 };
+    int foaBusEncodedCells { 0 };
+    int foaBusPreparedCells { 0 };
+    int foaBusFallbackCells { 0 }; // cells a listener hears only some of the sources of, rendered per source
+
     int skippedToActive { 0 };
     int skippedToInactive { 0 };
     int inactiveToSkipped { 0 };
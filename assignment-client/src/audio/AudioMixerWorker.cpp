@@ -35,6 +35,7 @@
 #include "AvatarAudioStream.h"
 #include "InjectedAudioStream.h"
 #include "AudioHelpers.h"
+#include "AudioMixKernels.h"
 
 using namespace std;
 using AudioStreamVector = AudioMixerClientData::AudioStreamVector;
@@ -54,6 +55,8 @@ inline float computeGain(float primaryAvatarGain, float primaryInjectorGain, con
         const PositionalAudioStream& streamToAdd, const glm::vec3& relativePosition, float distance);
 inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
         const glm::vec3& relativePosition);
+inline float applyDistanceAttenuation(float gain, const glm::vec3& listenerPosition, const glm::vec3& sourcePosition,
+        float distance);
 
 void AudioMixerWorker::processPackets(const SharedNodePointer& node) {
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
@@ -369,6 +372,12 @@ bool AudioMixerWorker::prepareMix(const SharedNodePointer& listener) {
         return false;
     });
 
+    // distant sources may be heard through the shared FOA bus, unless this mix is throttled or soloed
+    _useFOABus = _sharedData.foaBus.isEnabled() && !isThrottling && !isSoloing;
+    if (_useFOABus) {
+        prepareFOABus(streams.active, *listener, *listenerAudioStream, *listenerData);
+    }
+
     // Process active streams
     erase_if(streams.active, [&](MixableStream& stream) {
         if (shouldBeRemoved(stream, _sharedData)) {
@@ -464,6 +473,11 @@ bool AudioMixerWorker::prepareMix(const SharedNodePointer& listener) {
     stats.inactive += (int)streams.inactive.size();
     stats.active += (int)streams.active.size();
 
+    // render the cells of the FOA bus heard by this listener, or flush the bus once after it stops being used
+    if (_useFOABus || (listenerData->hasFOABusState() && !listenerData->getFOABusState().coefficients.empty())) {
+        addFOABus(*listenerAudioStream, *listenerData);
+    }
+
     // clear the newly ignored, un-ignored, ignoring, and un-ignoring streams now that we've processed them
     listenerData->clearStagedIgnoreChanges();
 
@@ -475,13 +489,7 @@ bool AudioMixerWorker::prepareMix(const SharedNodePointer& listener) {
 
     // check for silent audio before limiting
     // limiting uses a dither and can only guarantee abs(sample) <= 1
-    bool hasAudio = false;
-    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
-        if (_mixSamples[i] != 0.0f) {
-            hasAudio = true;
-            break;
-        }
-    }
+    bool hasAudio = !AudioMixKernels::isSilent(_mixSamples, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
 
     // use the per listener AudioLimiter to render the mixed data
     listenerData->audioLimiter.render(_mixSamples, _bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
@@ -546,31 +554,34 @@ void AudioMixerWorker::addStream(AudioMixerClientData::MixableStream& mixableStr
         }
     }
 
-    // grab the stream from the ring buffer
-    AudioRingBuffer::ConstIterator streamPopOutput = streamToAdd->getLastPopOutput();
+    if (_useFOABus && mixableStream.foaBusCell != AudioMixerFOABus::NO_CELL) {
+        // mixed with the rest of its cell in the shared FOA bus, see addFOABus
+        // the HRTF restarts from reset if the source is rendered directly again
+        mixableStream.hrtf->reset();
 
-    if (streamToAdd->isStereo()) {
+        ++stats.foaBusMixes;
+        return;
+    }
+
+    // the last popped frame, pre-rendered once for all listeners while processing packets
+    const int16_t* streamSamples = streamToAdd->getPreRenderedSamples();
 
-        streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+    if (streamToAdd->isStereo()) {
 
         // stereo sources are not passed through HRTF
-        mixableStream.hrtf->mixStereo(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        mixableStream.hrtf->mixStereo(streamSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         ++stats.manualStereoMixes;
     } else if (isEcho) {
 
-        streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
         // echo sources are not passed through HRTF
-        mixableStream.hrtf->mixMono(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        mixableStream.hrtf->mixMono(streamSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         ++stats.manualEchoMixes;
     } else {
 
-        streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
-        mixableStream.hrtf->render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                                   AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        mixableStream.hrtf->render(streamToAdd->getPreRenderedFloatSamples(), _mixSamples, HRTF_DATASET_INDEX, azimuth,
+                                   distance, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
         ++stats.hrtfRenders;
     }
 }
@@ -601,6 +612,100 @@ void AudioMixerWorker::resetHRTFState(AudioMixerClientData::MixableStream& mixab
     ++stats.hrtfResets;
 }
 
+void AudioMixerWorker::prepareFOABus(MixableStreamsVector& streams, const Node& listener,
+                                     AvatarAudioStream& listeningNodeStream, const AudioMixerClientData& listenerData) {
+    const auto& foaBus = _sharedData.foaBus;
+    const float minDistance2 = foaBus.getDistance() * foaBus.getDistance();
+
+    _foaBusCellCounts.assign(foaBus.getNumCells(), 0);
+
+    for (auto& stream : streams) {
+        stream.foaBusCell = AudioMixerFOABus::NO_CELL;
+
+        // streams that went silent since the last frame are still active until they are mixed once more
+        if (shouldBeRemoved(stream, _sharedData) || shouldBeInactive(stream)) {
+            continue;
+        }
+
+        int cell = foaBus.getCellIndex(stream.positionalStream);
+        if (cell == AudioMixerFOABus::NO_CELL || stream.positionalStream == &listeningNodeStream) {
+            continue;
+        }
+
+        // a per-avatar gain set by this listener cannot be applied to the shared bus
+        if (stream.hrtf->getGainAdjustment() != HRTF_GAIN) {
+            continue;
+        }
+
+        if (glm::distance2(stream.positionalStream->getPosition(), listeningNodeStream.getPosition()) < minDistance2) {
+            continue;
+        }
+
+        if (shouldBeSkipped(stream, listener, listeningNodeStream, listenerData)) {
+            continue;
+        }
+
+        stream.foaBusCell = cell;
+        ++_foaBusCellCounts[cell];
+    }
+
+    // a cell is only used when every one of its sources can go through the bus,
+    // otherwise its sources are rendered individually
+    for (int cell = 0; cell < foaBus.getNumCells(); cell++) {
+        // both count by the same rules, a listener can only see fewer of a cell's sources than the bus holds
+        assert(_foaBusCellCounts[cell] <= foaBus.getCell(cell).numSources);
+        if (_foaBusCellCounts[cell] > 0 && _foaBusCellCounts[cell] != foaBus.getCell(cell).numSources) {
+            ++stats.foaBusFallbackCells;
+        }
+    }
+
+    for (auto& stream : streams) {
+        int cell = stream.foaBusCell;
+        if (cell != AudioMixerFOABus::NO_CELL && _foaBusCellCounts[cell] != foaBus.getCell(cell).numSources) {
+            stream.foaBusCell = AudioMixerFOABus::NO_CELL;
+        }
+    }
+}
+
+void AudioMixerWorker::addFOABus(AvatarAudioStream& listeningNodeStream, AudioMixerClientData& listenerData) {
+    const auto& foaBus = _sharedData.foaBus;
+
+    _foaBusEncodings.clear();
+
+    if (_useFOABus) {
+        glm::quat inverseOrientation = glm::inverse(listeningNodeStream.getOrientation());
+        const glm::vec3& listenerPosition = listeningNodeStream.getPosition();
+
+        for (int cell = 0; cell < foaBus.getNumCells(); cell++) {
+            const auto& busCell = foaBus.getCell(cell);
+            if (_foaBusCellCounts[cell] == 0 || _foaBusCellCounts[cell] != busCell.numSources) {
+                continue;
+            }
+
+            glm::vec3 relativePosition = busCell.position - listenerPosition;
+            float distance = glm::max(glm::length(relativePosition), EPSILON);
+
+            AudioMixerFOABus::Encoding encoding;
+            encoding.cell = cell;
+            encoding.direction = inverseOrientation * (relativePosition / distance);
+            encoding.avatarGain = applyDistanceAttenuation(listenerData.getPrimaryAvatarGain(), listenerPosition,
+                                                           busCell.position, distance);
+            encoding.injectorGain = applyDistanceAttenuation(listenerData.getPrimaryInjectorGain(), listenerPosition,
+                                                             busCell.position, distance);
+            _foaBusEncodings.push_back(encoding);
+        }
+    }
+
+    if (_foaBusEncodings.empty() && (!listenerData.hasFOABusState() || listenerData.getFOABusState().coefficients.empty())) {
+        return;
+    }
+
+    foaBus.render(listenerData.getFOABusState(), _foaBusEncodings, _mixSamples);
+
+    ++stats.foaBusRenders;
+    stats.foaBusEncodedCells += (int)_foaBusEncodings.size();
+}
+
 std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec) {
     auto audioPacket = NLPacket::create(type, size);
     audioPacket->writePrimitive(sequence);
@@ -767,6 +872,13 @@ float computeGain(float primaryAvatarGain,
         gain *= primaryAvatarGain;
     }
 
+    return applyDistanceAttenuation(gain, listeningNodeStream.getPosition(), streamToAdd.getPosition(), distance);
+}
+
+float applyDistanceAttenuation(float gain,
+                               const glm::vec3& listenerPosition,
+                               const glm::vec3& sourcePosition,
+                               float distance) {
     auto& audioZones = AudioMixer::getAudioZones();
 
     // find distance attenuation coefficient
@@ -776,13 +888,13 @@ float computeGain(float primaryAvatarGain,
     float bestZonesCoefficient;
     for (const auto& sourceZone : audioZones) {
         if (sourceZone.second.listeners.size() > 0 && sourceZone.second.listeners.size() == sourceZone.second.coefficients.size()) {
-            vec4 localSourcePosition = sourceZone.second.inverseTransform * vec4(streamToAdd.getPosition(), 1.0f);
+            vec4 localSourcePosition = sourceZone.second.inverseTransform * vec4(sourcePosition, 1.0f);
             if (UNIT_BOX.contains(localSourcePosition)) {
                 size_t listenerIndex = 0;
                 for (const auto& listener : sourceZone.second.listeners) {
                     const auto& listenerZone = audioZones.find(listener);
                     if (listenerZone != audioZones.end()) {
-                        vec4 localListenerPosition = listenerZone->second.inverseTransform * vec4(listeningNodeStream.getPosition(), 1.0f);
+                        vec4 localListenerPosition = listenerZone->second.inverseTransform * vec4(listenerPosition, 1.0f);
                         if (UNIT_BOX.contains(localListenerPosition)) {
                             // This isn't an exact solution, but we target the smallest sum of volumes of the source and listener zones
                             const float zonesVolume = sourceZone.second.volume + listenerZone->second.volume;
@@ -26,6 +26,7 @@
 #include <PositionalAudioStream.h>
 
 #include "AudioMixerClientData.h"
+#include "AudioMixerFOABus.h"
 #include "AudioMixerStats.h"
 
 class AvatarAudioStream;
@@ -39,6 +40,7 @@ public:
         AudioMixerClientData::ConcurrentAddedStreams addedStreams;
         std::vector<Node::LocalID> removedNodes;
         std::vector<NodeIDStreamID> removedStreams;
+        AudioMixerFOABus foaBus;
     };
 
     AudioMixerWorker(SharedData& sharedData) : _sharedData(sharedData) {};
@@ -71,10 +73,20 @@ private:
 
     void addStreams(Node& listener, AudioMixerClientData& listenerData);
 
+    // shared FOA bus for distant sources
+    void prepareFOABus(AudioMixerClientData::MixableStreamsVector& streams, const Node& listener,
+                       AvatarAudioStream& listeningNodeStream, const AudioMixerClientData& listenerData);
+    void addFOABus(AvatarAudioStream& listeningNodeStream, AudioMixerClientData& listenerData);
+
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
 
+    // FOA bus state for the current listener
+    bool _useFOABus { false };
+    std::vector<int> _foaBusCellCounts;
+    std::vector<AudioMixerFOABus::Encoding> _foaBusEncodings;
+
     // frame state
     ConstIter _begin;
     ConstIter _end;
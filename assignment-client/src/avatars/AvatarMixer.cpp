@@ -45,6 +45,9 @@ const QString AVATAR_MIXER_LOGGING_NAME = "avatar-mixer";
 // FIXME - what we'd actually like to do is send to users at ~50% of their present rate down to 30hz. Assume 90 for now.
 const int AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 45;
 
+// fraction of a frame by which the broadcast to every listener should be done
+const float AVATAR_MIXER_BROADCAST_DEADLINE_FRAME_FRACTION = 0.5f;
+
 const QRegularExpression AvatarMixer::suffixedNamePattern { R"(^\s*(.+)\s*_(\d)+\s*$)" };
 
 // Lexicographic comparison:
@@ -62,6 +65,9 @@ AvatarMixer::AvatarMixer(ReceivedMessage& message) :
     ThreadedAssignment(message),
     _workerPool(&_workerSharedData)
 {
+    _workerPool.setBroadcastDeadline((quint64)(AVATAR_MIXER_BROADCAST_DEADLINE_FRAME_FRACTION * USECS_PER_SECOND /
+                                               AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND));
+
     DependencyManager::registerInheritance<EntityDynamicFactoryInterface, AssignmentDynamicFactory>();
     DependencyManager::set<AssignmentDynamicFactory>();
     DependencyManager::set<ModelFormatRegistry>();
@@ -336,6 +342,7 @@ void AvatarMixer::start() {
                 _workerPool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio);
                 auto end = usecTimestampNow();
                 _broadcastAvatarDataInner += (end - start);
+                _broadcastAvatarDataInnerMax = std::max(_broadcastAvatarDataInnerMax, end - start);
             }, &lockWait, &nodeTransform, &functor);
             auto end = usecTimestampNow();
             _broadcastAvatarDataElapsedTime += (end - start);
@@ -811,6 +818,7 @@ void AvatarMixer::sendStatsPacket() {
     broadcastAvatarDataStats["3_lockWait"] = TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataLockWait);
     broadcastAvatarDataStats["4_NodeTransform"] = TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataNodeTransform);
     broadcastAvatarDataStats["5_Functor"] = TIGHT_LOOP_STAT_UINT64(_broadcastAvatarDataNodeFunctor);
+    broadcastAvatarDataStats["6_innerMax"] = (double)_broadcastAvatarDataInnerMax;
 
     parallelTasks["broadcastAvatarData"] = broadcastAvatarDataStats;
 
@@ -855,6 +863,15 @@ void AvatarMixer::sendStatsPacket() {
     workersAggregatObject["timing_5_packetSending"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.packetSendingElapsedTime);
     workersAggregatObject["timing_6_jobElapsedTime"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.jobElapsedTime);
 
+    workersAggregatObject["scheduling_1_nodesStolen"] = TIGHT_LOOP_STAT(aggregateStats.nodesStolen);
+    workersAggregatObject["scheduling_2_nodesPastDeadline"] = TIGHT_LOOP_STAT(aggregateStats.nodesPastDeadline);
+
+    workersAggregatObject["encode_cache_1_hits"] = TIGHT_LOOP_STAT(aggregateStats.encodeCacheHits);
+    workersAggregatObject["encode_cache_2_misses"] = TIGHT_LOOP_STAT(aggregateStats.encodeCacheMisses);
+    int encodeCacheLookups = aggregateStats.encodeCacheHits + aggregateStats.encodeCacheMisses;
+    float encodeCacheHitRate = encodeCacheLookups ? (float)aggregateStats.encodeCacheHits / encodeCacheLookups : 0.0f;
+    workersAggregatObject["encode_cache_3_hitRate"] = encodeCacheHitRate;
+
     statsObject["workers_aggregate (per frame)"] = workersAggregatObject;
 
     _handleViewFrustumPacketElapsedTime = 0;
@@ -915,6 +932,7 @@ void AvatarMixer::sendStatsPacket() {
 
     _broadcastAvatarDataElapsedTime = 0;
     _broadcastAvatarDataInner = 0;
+    _broadcastAvatarDataInnerMax = 0;
     _broadcastAvatarDataLockWait = 0;
     _broadcastAvatarDataNodeTransform = 0;
     _broadcastAvatarDataNodeFunctor = 0;
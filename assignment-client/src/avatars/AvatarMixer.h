@@ -131,6 +131,7 @@ private:
 
     quint64 _broadcastAvatarDataElapsedTime { 0 }; // total time spent in broadcastAvatarData since last stats window
     quint64 _broadcastAvatarDataInner { 0 };
+    quint64 _broadcastAvatarDataInnerMax { 0 }; // slowest single broadcast since last stats window
     quint64 _broadcastAvatarDataLockWait { 0 };
     quint64 _broadcastAvatarDataNodeTransform { 0 };
     quint64 _broadcastAvatarDataNodeFunctor { 0 };
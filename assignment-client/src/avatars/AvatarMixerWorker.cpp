@@ -580,7 +580,54 @@ void AvatarMixerWorker::broadcastAvatarDataToAgent(const SharedNodePointer& node
             AvatarDataPacket::SendStatus sendStatus;
             sendStatus.sendUUID = true;
 
-            do {
+            // use the encoding shared with the other receivers of this avatar when it fits the current packet
+            bool sharedEncodingSent = false;
+            if (MixerAvatar::isSharedEncodingDetail(detail)) {
+                auto startSerialize = chrono::high_resolution_clock::now();
+                bool cacheHit = false;
+                QByteArray bytes = sourceAvatar->getSharedEncoding(_lastFrameTimestamp, detail, lastEncodeForOther, cacheHit);
+                auto endSerialize = chrono::high_resolution_clock::now();
+                _stats.toByteArrayElapsedTime +=
+                    (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
+                if (cacheHit) {
+                    ++_stats.encodeCacheHits;
+                } else {
+                    ++_stats.encodeCacheMisses;
+                }
+
+                if (bytes.size() <= avatarSpaceAvailable) {
+                    if (detail == AvatarData::SendAllData) {
+                        // record the joints as sent, as toByteArray would have
+                        const auto& jointData = sourceAvatar->getRawJointData();
+                        lastSentJointsForOther.resize(jointData.size());
+                        for (int i = 0; i < jointData.size(); ++i) {
+                            const JointData& data = jointData[i];
+                            JointData& sent = lastSentJointsForOther[i];
+                            if (!data.rotationIsDefaultPose) {
+                                sent.rotation = data.rotation;
+                            }
+                            sent.rotationIsDefaultPose = data.rotationIsDefaultPose;
+                            if (!data.translationIsDefaultPose) {
+                                sent.translation = data.translation;
+                            }
+                            sent.translationIsDefaultPose = data.translationIsDefaultPose;
+                        }
+                    }
+
+                    avatarPacket->write(bytes);
+                    avatarSpaceAvailable -= bytes.size();
+                    numAvatarDataBytes += bytes.size();
+                    if (avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
+                        nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
+                        ++numPacketsSent;
+                        avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
+                        avatarSpaceAvailable = avatarPacketCapacity;
+                    }
+                    sharedEncodingSent = true;
+                }
+            }
+
+            while (!sharedEncodingSent) {
                 auto startSerialize = chrono::high_resolution_clock::now();
                 QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
                     sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
@@ -599,7 +646,10 @@ void AvatarMixerWorker::broadcastAvatarDataToAgent(const SharedNodePointer& node
                     avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
                     avatarSpaceAvailable = avatarPacketCapacity;
                 }
-            } while (!sendStatus);
+                if (sendStatus) {
+                    break;
+                }
+            }
 
             if (detail != AvatarData::NoData) {
                 _stats.numOthersIncluded++;
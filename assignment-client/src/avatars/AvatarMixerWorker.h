@@ -33,6 +33,10 @@ public:
     int numOthersIncluded { 0 };
     int overBudgetAvatars { 0 };
     int numHeroesIncluded { 0 };
+    int nodesStolen { 0 };
+    int nodesPastDeadline { 0 };
+    int encodeCacheHits { 0 };
+    int encodeCacheMisses { 0 };
 
     quint64 ignoreCalculationElapsedTime { 0 };
     quint64 avatarDataPackingElapsedTime { 0 };
@@ -59,6 +63,10 @@ public:
         numOthersIncluded = 0;
         overBudgetAvatars = 0;
         numHeroesIncluded = 0;
+        nodesStolen = 0;
+        nodesPastDeadline = 0;
+        encodeCacheHits = 0;
+        encodeCacheMisses = 0;
 
         ignoreCalculationElapsedTime = 0;
         avatarDataPackingElapsedTime = 0;
@@ -83,6 +91,10 @@ public:
         numOthersIncluded += rhs.numOthersIncluded;
         overBudgetAvatars += rhs.overBudgetAvatars;
         numHeroesIncluded += rhs.numHeroesIncluded;
+        nodesStolen += rhs.nodesStolen;
+        nodesPastDeadline += rhs.nodesPastDeadline;
+        encodeCacheHits += rhs.encodeCacheHits;
+        encodeCacheMisses += rhs.encodeCacheMisses;
 
         ignoreCalculationElapsedTime += rhs.ignoreCalculationElapsedTime;
         avatarDataPackingElapsedTime += rhs.avatarDataPackingElapsedTime;
@@ -118,6 +130,9 @@ public:
 
     void harvestStats(AvatarMixerWorkerStats& stats);
 
+protected:
+    AvatarMixerWorkerStats _stats;
+
 private:
     int sendIdentityPacket(NLPacketList& packet, const AvatarMixerClientData* nodeData, const Node& destinationNode);
     int sendReplicatedIdentityPacket(const Node& agentNode, const AvatarMixerClientData* nodeData, const Node& destinationNode);
@@ -143,7 +158,6 @@ private:
     float _throttlingRatio { 0.0f };
     float _avatarHeroFraction { 0.4f };
 
-    AvatarMixerWorkerStats _stats;
     WorkerSharedData* _sharedData;
 };
 
@@ -13,6 +13,12 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <limits>
+
+#include <SharedUtil.h>
+
+// weight of the last frame in the broadcast cost estimates
+static const quint64 COST_SMOOTHING_DIVISOR = 2;
 
 void AvatarMixerWorkerThread::run() {
     while (true) {
@@ -21,7 +27,19 @@ void AvatarMixerWorkerThread::run() {
         // iterate over all available nodes
         SharedNodePointer node;
         while (try_pop(node)) {
-            (this->*_function)(node);
+            if (_pool._isScheduled) {
+                quint64 start = usecTimestampNow();
+                bool pastDeadline = start > _pool._deadline;
+                if (pastDeadline) {
+                    ++_stats.nodesPastDeadline;
+                }
+
+                (this->*_function)(node);
+
+                _jobTimes.push_back({ node->getLocalID(), usecTimestampNow() - start, pastDeadline });
+            } else {
+                (this->*_function)(node);
+            }
         }
 
         bool stopping = _stop;
@@ -60,7 +78,34 @@ void AvatarMixerWorkerThread::notify(bool stopping) {
 }
 
 bool AvatarMixerWorkerThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
+    if (!_pool._isScheduled) {
+        return _pool._queue.try_pop(node);
+    }
+
+    // own nodes first, most expensive first
+    {
+        Lock lock(_assignedMutex);
+        if (!_assigned.empty()) {
+            node = std::move(_assigned.front());
+            _assigned.pop_front();
+            return true;
+        }
+    }
+
+    // then steal the cheapest nodes left to the other workers
+    int numWorkers = (int)_pool._workers.size();
+    for (int i = 1; i < numWorkers; ++i) {
+        auto& victim = *_pool._workers[(_index + i) % numWorkers];
+        Lock lock(victim._assignedMutex);
+        if (!victim._assigned.empty()) {
+            node = std::move(victim._assigned.back());
+            victim._assigned.pop_back();
+            ++_stats.nodesStolen;
+            return true;
+        }
+    }
+
+    return false;
 }
 
 void AvatarMixerWorkerPool::processIncomingPackets(ConstIter begin, ConstIter end) {
@@ -79,17 +124,98 @@ void AvatarMixerWorkerPool::broadcastAvatarData(ConstIter begin, ConstIter end,
         worker.configureBroadcast(begin, end, lastFrameTimestamp, maxKbpsPerNode, throttlingRatio,
             _priorityReservedFraction);
    };
+
+    // listeners differ a lot in cost, so they are balanced up front rather than pulled from a shared queue
+    schedule(begin, end);
     run(begin, end);
+    updateCosts();
+}
+
+void AvatarMixerWorkerPool::schedule(ConstIter begin, ConstIter end) {
+    struct Job {
+        SharedNodePointer node;
+        quint64 cost;
+        bool late;
+    };
+
+    std::vector<Job> jobs;
+    quint64 totalKnownCost = 0;
+    int numKnown = 0;
+
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        auto it = _broadcastCosts.find(node->getLocalID());
+        quint64 cost = 0;
+        if (it != _broadcastCosts.end()) {
+            cost = it->second;
+            totalKnownCost += cost;
+            ++numKnown;
+        }
+        jobs.push_back({ node, cost, _lateNodes.count(node->getLocalID()) > 0 });
+    });
+
+    // nodes not timed yet are assumed to be average
+    quint64 averageCost = numKnown > 0 ? std::max(totalKnownCost / numKnown, (quint64)1) : 1;
+    for (auto& job : jobs) {
+        if (job.cost == 0) {
+            job.cost = averageCost;
+        }
+    }
+
+    // listeners that were late last frame first, then longest first
+    std::sort(jobs.begin(), jobs.end(), [](const Job& a, const Job& b) {
+        return a.late != b.late ? a.late : a.cost > b.cost;
+    });
+
+    // each node goes to the least loaded worker; the workers aren't running, so no locking
+    std::vector<quint64> loads(_workers.size(), 0);
+    for (auto& job : jobs) {
+        auto leastLoaded = std::min_element(loads.begin(), loads.end()) - loads.begin();
+        _workers[leastLoaded]->_assigned.push_back(std::move(job.node));
+        loads[leastLoaded] += job.cost;
+    }
+
+    _isScheduled = true;
+    _deadline = _broadcastDeadline > 0 ? usecTimestampNow() + _broadcastDeadline : std::numeric_limits<quint64>::max();
+}
+
+void AvatarMixerWorkerPool::updateCosts() {
+    _isScheduled = false;
+
+    // rebuilt every frame, which drops the nodes that are gone
+    std::unordered_map<Node::LocalID, quint64> costs;
+    costs.reserve(_broadcastCosts.size());
+    _lateNodes.clear();
+
+    for (auto& worker : _workers) {
+        for (const auto& jobTime : worker->_jobTimes) {
+            auto it = _broadcastCosts.find(jobTime.nodeID);
+            quint64 elapsed = std::max(jobTime.elapsed, (quint64)1);
+            if (it != _broadcastCosts.end()) {
+                costs[jobTime.nodeID] = it->second + ((qint64)elapsed - (qint64)it->second) / (qint64)COST_SMOOTHING_DIVISOR;
+            } else {
+                costs[jobTime.nodeID] = elapsed;
+            }
+
+            if (jobTime.pastDeadline) {
+                _lateNodes.insert(jobTime.nodeID);
+            }
+        }
+        worker->_jobTimes.clear();
+    }
+
+    _broadcastCosts.swap(costs);
 }
 
 void AvatarMixerWorkerPool::run(ConstIter begin, ConstIter end) {
     _begin = begin;
     _end = end;
 
-    // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.push(node);
-    });
+    // fill the queue, unless the nodes were already handed out
+    if (!_isScheduled) {
+        std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
+            _queue.push(node);
+        });
+    }
 
     {
         Lock lock(_mutex);
@@ -108,6 +234,7 @@ void AvatarMixerWorkerPool::run(ConstIter begin, ConstIter end) {
     }
 
     assert(_queue.empty());
+    assert(std::all_of(_workers.begin(), _workers.end(), [](const auto& worker) { return worker->_assigned.empty(); }));
 }
 
 
@@ -160,7 +287,7 @@ void AvatarMixerWorkerPool::resize(int numThreads) {
     if (numThreads > _numThreads) {
         // start new workers
         for (int i = 0; i < numThreads - _numThreads; ++i) {
-            auto worker = new AvatarMixerWorkerThread(*this, _workerSharedData);
+            auto worker = new AvatarMixerWorkerThread(*this, _workerSharedData, (int)_workers.size());
             worker->start();
             _workers.emplace_back(worker);
         }
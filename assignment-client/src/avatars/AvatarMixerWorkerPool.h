@@ -13,7 +13,10 @@
 #define hifi_AvatarMixerWorkerPool_h
 
 #include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <QThread>
@@ -34,8 +37,8 @@ class AvatarMixerWorkerThread : public QThread, public AvatarMixerWorker {
     using Lock = std::unique_lock<Mutex>;
 
 public:
-    AvatarMixerWorkerThread(AvatarMixerWorkerPool& pool, WorkerSharedData* workerSharedData) :
-        AvatarMixerWorker(workerSharedData), _pool(pool) {};
+    AvatarMixerWorkerThread(AvatarMixerWorkerPool& pool, WorkerSharedData* workerSharedData, int index) :
+        AvatarMixerWorker(workerSharedData), _pool(pool), _index(index) {};
 
     void run() override final;
 
@@ -49,6 +52,18 @@ private:
     AvatarMixerWorkerPool& _pool;
     void (AvatarMixerWorker::*_function)(const SharedNodePointer& node) { nullptr };
     bool _stop { false };
+
+    // scheduled frame state, see AvatarMixerWorkerPool::schedule
+    struct JobTime {
+        Node::LocalID nodeID;
+        quint64 elapsed;
+        bool pastDeadline;
+    };
+
+    int _index;
+    Mutex _assignedMutex;
+    std::deque<SharedNodePointer> _assigned; // most expensive first, guarded by _assignedMutex
+    std::vector<JobTime> _jobTimes;
 };
 
 // Worker pool for avatar mixers
@@ -84,12 +99,21 @@ public:
     void setPriorityReservedFraction(float fraction) { _priorityReservedFraction = fraction; }
     float getPriorityReservedFraction() const { return  _priorityReservedFraction; }
 
+    // time after the start of a broadcast by which every listener should have been sent to
+    void setBroadcastDeadline(quint64 deadlineUsecs) { _broadcastDeadline = deadlineUsecs; }
+    quint64 getBroadcastDeadline() const { return _broadcastDeadline; }
+
 private:
     void run(ConstIter begin, ConstIter end);
     void resize(int numThreads);
 
+    // hand the nodes out to the workers up front, balanced by their estimated cost
+    void schedule(ConstIter begin, ConstIter end);
+    void updateCosts();
+
     std::vector<std::unique_ptr<AvatarMixerWorkerThread>> _workers;
 
+    friend void AvatarMixerWorkerThread::run();
     friend void AvatarMixerWorkerThread::wait();
     friend void AvatarMixerWorkerThread::notify(bool stopping);
     friend bool AvatarMixerWorkerThread::try_pop(SharedNodePointer& node);
@@ -103,6 +127,7 @@ private:
 
     // Set from Domain Settings:
     float _priorityReservedFraction { 0.4f };
+    quint64 _broadcastDeadline { 0 };
     int _numThreads { 0 };
 
     int _numStarted { 0 }; // guarded by _mutex
@@ -113,6 +138,13 @@ private:
     Queue _queue;
     ConstIter _begin;
     ConstIter _end;
+    bool _isScheduled { false };
+    quint64 _deadline { 0 };
+
+    // broadcast cost estimates from the last frames, in usecs
+    std::unordered_map<Node::LocalID, quint64> _broadcastCosts;
+    // listeners that were sent to after the deadline last frame, they go first in the next
+    std::unordered_set<Node::LocalID> _lateNodes;
 
     WorkerSharedData* _workerSharedData;
 };
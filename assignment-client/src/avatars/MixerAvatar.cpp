@@ -0,0 +1,48 @@
+//
+//  MixerAvatar.cpp
+//  assignment-client/src/avatars
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MixerAvatar.h"
+
+QByteArray MixerAvatar::getSharedEncoding(p_high_resolution_clock::time_point frame, AvatarDataDetail detail,
+                                          quint64 lastSentTime, bool& cacheHit) const {
+    cacheHit = false;
+    if (!isSharedEncodingDetail(detail)) {
+        return QByteArray();
+    }
+
+    // The avatar isn't modified while it is broadcast, so the encoding only depends on which sections are
+    // included, and those depend on the receiver through its last sent time.
+    const bool dropFaceTracking = false;
+    auto flags = getWantedFlags(detail, lastSentTime, dropFaceTracking);
+
+    std::lock_guard<std::mutex> lock(_sharedEncodingsMutex);
+    if (_sharedEncodingsFrame != frame) {
+        _sharedEncodingsFrame = frame;
+        _sharedEncodings.clear();
+    }
+
+    for (const auto& encoding : _sharedEncodings) {
+        if (encoding.detail == detail && encoding.flags == flags) {
+            cacheHit = true;
+            return encoding.data;
+        }
+    }
+
+    // None of these details compare joints against the last sent ones, any vector of the right size will do.
+    QVector<JointData> lastSentJointData(getJointCount());
+    AvatarDataPacket::SendStatus sendStatus;
+    sendStatus.sendUUID = true;
+    const bool distanceAdjust = false;
+    QByteArray data = toByteArray(detail, lastSentTime, lastSentJointData, sendStatus, dropFaceTracking,
+                                  distanceAdjust, glm::vec3(0.0f), nullptr);
+
+    _sharedEncodings.push_back({ detail, flags, data });
+    return data;
+}
@@ -14,7 +14,11 @@
 #ifndef hifi_MixerAvatar_h
 #define hifi_MixerAvatar_h
 
+#include <mutex>
+#include <vector>
+
 #include <AvatarData.h>
+#include <PortableHighResolutionClock.h>
 
 class ResourceRequest;
 
@@ -29,10 +33,30 @@ public:
     bool needsIdentityUpdate() const { return _needsIdentityUpdate; }
     void setNeedsIdentityUpdate(bool value = true) { _needsIdentityUpdate = value; }
 
+    // Encodings that don't depend on the receiving node (SendAllData, MinimumData and PALMinimum, with the UUID and
+    // no size limit) are built once per broadcast frame and shared by every worker sending this avatar.
+    // Returns a null QByteArray for the other details. cacheHit is set to whether the encoding was already built.
+    QByteArray getSharedEncoding(p_high_resolution_clock::time_point frame, AvatarDataDetail detail,
+                                 quint64 lastSentTime, bool& cacheHit) const;
+
+    static bool isSharedEncodingDetail(AvatarDataDetail detail) {
+        return detail == SendAllData || detail == MinimumData || detail == PALMinimum;
+    }
+
 private:
     bool _needsHeroCheck { false };
     bool _needsIdentityUpdate { false };
 
+    struct SharedEncoding {
+        AvatarDataDetail detail;
+        AvatarDataPacket::HasFlags flags;
+        QByteArray data;
+    };
+
+    mutable std::mutex _sharedEncodingsMutex;
+    mutable p_high_resolution_clock::time_point _sharedEncodingsFrame;
+    mutable std::vector<SharedEncoding> _sharedEncodings;
+
 };
 
 using MixerAvatarSharedPointer = std::shared_ptr<MixerAvatar>;
@@ -61,6 +61,9 @@ EntityServer::EntityServer(ReceivedMessage& message) :
         PacketType::EntityErase,
         PacketType::EntityPhysics },
         PacketReceiver::makeSourcedListenerReference<EntityServer>(this, &EntityServer::handleEntityPacket));
+
+    // each send thread appends the same entities for its own viewer
+    EntityItem::setEncodedPropertiesCacheEnabled(true);
 }
 
 EntityServer::~EntityServer() {
@@ -71,6 +74,8 @@ EntityServer::~EntityServer() {
 
     EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
     tree->removeNewlyCreatedHook(this);
+
+    EntityItem::setEncodedPropertiesCacheEnabled(false);
 }
 
 void EntityServer::aboutToFinish() {
@@ -98,6 +103,7 @@ OctreePointer EntityServer::createTree() {
     tree->createRootElement();
     tree->addNewlyCreatedHook(this);
     tree->setIsEntityServer(true);
+    tree->setBVHEnabled(true);
     if (!_entitySimulation) {
         SimpleEntitySimulationPointer simpleSimulation { new SimpleEntitySimulation() };
         simpleSimulation->setEntityTree(tree);
@@ -29,10 +29,48 @@ EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedN
 }
 
 void EntityTreeSendThread::resetState() {
-    qCDebug(entities) << "Clearing known EntityTreeSendThread state for" << _nodeUuid;
+    std::lock_guard<std::mutex> lock(_pendingStateMutex);
+    _pendingResetState = true;
+    _pendingEditedEntities.clear();
+    _pendingDeletedEntities.clear();
+}
+
+void EntityTreeSendThread::applyPendingStateChanges() {
+    bool shouldResetState;
+    std::vector<EntityItemPointer> editedEntities;
+    std::vector<EntityItem*> deletedEntities;
+    {
+        std::lock_guard<std::mutex> lock(_pendingStateMutex);
+        shouldResetState = _pendingResetState;
+        _pendingResetState = false;
+        std::swap(editedEntities, _pendingEditedEntities);
+        std::swap(deletedEntities, _pendingDeletedEntities);
+    }
+
+    if (shouldResetState) {
+        qCDebug(entities) << "Clearing known EntityTreeSendThread state for" << _nodeUuid;
+
+        _knownState.clear();
+        _traversal.reset();
+    }
 
-    _knownState.clear();
-    _traversal.reset();
+    for (auto entity : deletedEntities) {
+        _knownState.erase(entity);
+    }
+
+    for (const auto& entity : editedEntities) {
+        if (!_sendQueue.contains(entity.get()) && _knownState.find(entity.get()) != _knownState.end()) {
+            const auto& view = _traversal.getCurrentView();
+            float priority = view.computePriority(entity);
+
+            // We can force a removal from _knownState if the current view is used and entity is out of view
+            if (priority == PrioritizedEntity::DO_NOT_SEND) {
+                _sendQueue.emplace(entity, PrioritizedEntity::FORCE_REMOVE, true);
+            } else if (priority == PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY) {
+                _sendQueue.emplace(entity, PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY, true);
+            }
+        }
+    }
 }
 
 void EntityTreeSendThread::preDistributionProcessing() {
@@ -101,6 +139,8 @@ void EntityTreeSendThread::preDistributionProcessing() {
 
 bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene) {
+    applyPendingStateChanges();
+
     if (viewFrustumChanged || _traversal.finished()) {
         EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
 
@@ -146,12 +186,25 @@ bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, O
     if (!_traversal.finished()) {
         quint64 startTime = usecTimestampNow();
 
-        #ifdef DEBUG
-        const uint64_t TIME_BUDGET = 400; // usec
-        #else
-        const uint64_t TIME_BUDGET = 200; // usec
-        #endif
-        _traversal.traverse(TIME_BUDGET);
+        if (_traversal.canTraverseInParallel()) {
+            // the first pass finds everything in view at once, so that a new arrival
+            // doesn't wait on many time-budgeted passes for its scene
+            std::vector<PrioritizedEntity> entitiesInView;
+            _traversal.traverseInParallel(entitiesInView);
+            for (const auto& prioritizedEntity : entitiesInView) {
+                EntityItemPointer entity = prioritizedEntity.getEntity();
+                if (entity && !_sendQueue.contains(entity.get())) {
+                    _sendQueue.emplace(entity, prioritizedEntity.getPriority());
+                }
+            }
+        } else {
+            #ifdef DEBUG
+            const uint64_t TIME_BUDGET = 400; // usec
+            #else
+            const uint64_t TIME_BUDGET = 200; // usec
+            #endif
+            _traversal.traverse(TIME_BUDGET);
+        }
         OctreeServer::trackTreeTraverseTime((float)(usecTimestampNow() - startTime));
     }
 
@@ -255,6 +308,17 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
                     }
                 });
             });
+            // the _sendQueue is merged into after the parallel scan, so it is not touched here
+            _traversal.setParallelScanCallback([this](DiffTraversal::VisibleElement& next,
+                                                      std::vector<PrioritizedEntity>& results) {
+                const auto& view = _traversal.getCurrentView();
+                next.element->forEachEntity([&](EntityItemPointer entity) {
+                    float priority = view.computePriority(entity);
+                    if (priority != PrioritizedEntity::DO_NOT_SEND) {
+                        results.emplace_back(entity, priority);
+                    }
+                });
+            });
             break;
         case DiffTraversal::Repeat:
             _traversal.setScanCallback([this](DiffTraversal::VisibleElement& next) {
@@ -420,20 +484,12 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
 
 void EntityTreeSendThread::editingEntityPointer(const EntityItemPointer& entity) {
     if (entity) {
-        if (!_sendQueue.contains(entity.get()) && _knownState.find(entity.get()) != _knownState.end()) {
-            const auto& view = _traversal.getCurrentView();
-            float priority = view.computePriority(entity);
-
-            // We can force a removal from _knownState if the current view is used and entity is out of view
-            if (priority == PrioritizedEntity::DO_NOT_SEND) {
-                _sendQueue.emplace(entity, PrioritizedEntity::FORCE_REMOVE, true);
-            } else if (priority == PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY) {
-                _sendQueue.emplace(entity, PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY, true);
-            }
-        }
+        std::lock_guard<std::mutex> lock(_pendingStateMutex);
+        _pendingEditedEntities.push_back(entity);
     }
 }
 
 void EntityTreeSendThread::deletingEntityPointer(EntityItem* entity) {
-    _knownState.erase(entity);
+    std::lock_guard<std::mutex> lock(_pendingStateMutex);
+    _pendingDeletedEntities.push_back(entity);
 }
@@ -12,6 +12,7 @@
 #ifndef hifi_EntityTreeSendThread_h
 #define hifi_EntityTreeSendThread_h
 
+#include <mutex>
 #include <unordered_set>
 
 #include "../octree/OctreeSendThread.h"
@@ -45,6 +46,9 @@ private:
     void startNewTraversal(const DiffTraversal::View& viewFrustum, EntityTreeElementPointer root, bool forceFirstPass = false);
     bool traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) override;
 
+    // applies tree and connection changes signalled since our last pass, see the slots below
+    void applyPendingStateChanges();
+
     void preDistributionProcessing() override;
     bool hasSomethingToSend(OctreeQueryNode* nodeData) override { return !_sendQueue.empty(); }
     bool shouldStartNewTraversal(OctreeQueryNode* nodeData, bool viewFrustumChanged) override { return viewFrustumChanged || _traversal.finished(); }
@@ -58,6 +62,13 @@ private:
     int32_t _numEntitiesOffset { 0 };
     uint16_t _numEntities { 0 };
 
+    // Our slots may be delivered on a different thread than the one running our next pass (when we're scheduled
+    // on the OctreeSendPool), so they only record what changed and the pass applies it.
+    std::mutex _pendingStateMutex;
+    bool _pendingResetState { false };
+    std::vector<EntityItemPointer> _pendingEditedEntities;
+    std::vector<EntityItem*> _pendingDeletedEntities;
+
 private slots:
     void editingEntityPointer(const EntityItemPointer& entity);
     void deletingEntityPointer(EntityItem* entity);
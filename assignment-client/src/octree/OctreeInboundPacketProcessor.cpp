@@ -22,6 +22,7 @@
 
 static QUuid DEFAULT_NODE_ID_REF;
 const quint64 TOO_LONG_SINCE_LAST_NACK = 1 * USECS_PER_SECOND;
+const int MAX_EDIT_BATCH_SIZE = 1000;
 
 OctreeInboundPacketProcessor::OctreeInboundPacketProcessor(OctreeServer* myServer) :
     _myServer(myServer),
@@ -31,6 +32,12 @@ OctreeInboundPacketProcessor::OctreeInboundPacketProcessor(OctreeServer* myServe
     _totalLockWaitTime(0),
     _totalElementsInPacket(0),
     _totalPackets(0),
+    _totalBatches(0),
+    _totalBatchedEdits(0),
+    _totalCoalescedEdits(0),
+    _maxBatchSize(0),
+    _totalBatchProcessTime(0),
+    _totalBatchLockWaitTime(0),
     _lastNackTime(usecTimestampNow()),
     _shuttingDown(false)
 {
@@ -42,6 +49,12 @@ void OctreeInboundPacketProcessor::resetStats() {
     _totalLockWaitTime = 0;
     _totalElementsInPacket = 0;
     _totalPackets = 0;
+    _totalBatches = 0;
+    _totalBatchedEdits = 0;
+    _totalCoalescedEdits = 0;
+    _maxBatchSize = 0;
+    _totalBatchProcessTime = 0;
+    _totalBatchLockWaitTime = 0;
     _lastNackTime = usecTimestampNow();
 
     QWriteLocker locker(&_senderStatsLock);
@@ -68,6 +81,11 @@ void OctreeInboundPacketProcessor::preProcess() {
 }
 
 void OctreeInboundPacketProcessor::midProcess() {
+    // don't let a long queue of packets grow the batch without bound
+    if (_myServer->getOctree()->getNumDecodedEdits() >= MAX_EDIT_BATCH_SIZE) {
+        applyDecodedEdits();
+    }
+
     // check if it's time to send a nack. If yes, do so
     quint64 now = usecTimestampNow();
     if (now - _lastNackTime >= TOO_LONG_SINCE_LAST_NACK) {
@@ -76,6 +94,35 @@ void OctreeInboundPacketProcessor::midProcess() {
     }
 }
 
+void OctreeInboundPacketProcessor::postProcess() {
+    applyDecodedEdits();
+}
+
+void OctreeInboundPacketProcessor::applyDecodedEdits() {
+    OctreePointer tree = _myServer->getOctree();
+    int batchSize = tree->getNumDecodedEdits();
+    if (batchSize == 0) {
+        return;
+    }
+
+    quint64 startProcess, startLock = usecTimestampNow();
+    int editsApplied;
+    tree->withWriteLock([&] {
+        startProcess = usecTimestampNow();
+        editsApplied = tree->applyDecodedEdits();
+    });
+    quint64 endProcess = usecTimestampNow();
+
+    _totalBatches++;
+    _totalBatchedEdits += batchSize;
+    _totalCoalescedEdits += batchSize - editsApplied;
+    _totalBatchProcessTime += endProcess - startProcess;
+    _totalBatchLockWaitTime += startProcess - startLock;
+    if ((uint64_t)batchSize > _maxBatchSize) {
+        _maxBatchSize = batchSize;
+    }
+}
+
 void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     if (_shuttingDown) {
         qDebug() << "OctreeInboundPacketProcessor::processPacket() while shutting down... ignoring incoming packet";
@@ -142,6 +189,7 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
         }
         
         const unsigned char* editData = nullptr;
+        bool batchEdits = _myServer->wantsBatchedEdits();
         
         while (message->getBytesLeftToRead() > 0) {
 
@@ -159,12 +207,25 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
             }
 
             quint64 startProcess, startLock = usecTimestampNow();
-            int editDataBytesRead;
-            _myServer->getOctree()->withWriteLock([&] {
-                startProcess = usecTimestampNow();
+            int editDataBytesRead = 0;
+            if (batchEdits) {
+                // decode without the tree lock, the edit is applied later with the rest of the batch
+                startProcess = startLock;
                 editDataBytesRead =
-                    _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
-            });
+                    _myServer->getOctree()->decodeEditPacketData(*message, editData, maxSize, sendingNode);
+                if (editDataBytesRead == 0) {
+                    // this edit can't be batched, apply what's staged first so edits stay in order
+                    applyDecodedEdits();
+                    startLock = usecTimestampNow();
+                }
+            }
+            if (editDataBytesRead == 0) {
+                _myServer->getOctree()->withWriteLock([&] {
+                    startProcess = usecTimestampNow();
+                    editDataBytesRead =
+                        _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
+                });
+            }
             quint64 endProcess = usecTimestampNow();
 
             if (debugProcessPacket) {
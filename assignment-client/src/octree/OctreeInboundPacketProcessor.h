@@ -72,6 +72,14 @@ public:
     quint64 getAverageLockWaitTimePerElement() const
                 { return _totalElementsInPacket == 0 ? 0 : _totalLockWaitTime / _totalElementsInPacket; }
 
+    quint64 getTotalBatches() const { return _totalBatches; }
+    quint64 getTotalBatchedEdits() const { return _totalBatchedEdits; }
+    quint64 getTotalCoalescedEdits() const { return _totalCoalescedEdits; }
+    quint64 getMaxBatchSize() const { return _maxBatchSize; }
+    quint64 getAverageBatchSize() const { return _totalBatches == 0 ? 0 : _totalBatchedEdits / _totalBatches; }
+    quint64 getAverageProcessTimePerBatch() const { return _totalBatches == 0 ? 0 : _totalBatchProcessTime / _totalBatches; }
+    quint64 getAverageLockWaitTimePerBatch() const { return _totalBatches == 0 ? 0 : _totalBatchLockWaitTime / _totalBatches; }
+
     void resetStats();
 
     NodeToSenderStatsMap getSingleSenderStats() { QReadLocker locker(&_senderStatsLock); return _singleSenderStats; }
@@ -85,9 +93,11 @@ protected:
     virtual uint32_t getMaxWait() const override;
     virtual void preProcess() override;
     virtual void midProcess() override;
+    virtual void postProcess() override;
 
 private:
     int sendNackPackets();
+    void applyDecodedEdits();
 
 private:
     void trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
@@ -101,6 +111,14 @@ private:
     std::atomic<uint64_t> _totalLockWaitTime;
     std::atomic<uint64_t> _totalElementsInPacket;
     std::atomic<uint64_t> _totalPackets;
+
+    // edits decoded outside the tree lock and applied together, see OctreeServer::wantsBatchedEdits()
+    std::atomic<uint64_t> _totalBatches;
+    std::atomic<uint64_t> _totalBatchedEdits;
+    std::atomic<uint64_t> _totalCoalescedEdits;
+    std::atomic<uint64_t> _maxBatchSize;
+    std::atomic<uint64_t> _totalBatchProcessTime;
+    std::atomic<uint64_t> _totalBatchLockWaitTime;
     
     NodeToSenderStatsMap _singleSenderStats;
     QReadWriteLock _senderStatsLock;
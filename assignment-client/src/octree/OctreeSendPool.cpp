@@ -0,0 +1,298 @@
+//
+//  OctreeSendPool.cpp
+//  assignment-client/src/octree
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSendPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+#include <QtCore/QDebug>
+
+#include <SharedUtil.h>
+#include <ThreadHelpers.h>
+#include <UUID.h>
+
+#include "OctreeSendThread.h"
+#include "OctreeServerConsts.h"
+
+void OctreeSendPoolThread::run() {
+    _pool.workerLoop(_index);
+}
+
+OctreeSendPool::OctreeSendPool(int numThreads) {
+    int maxThreads = QThread::idealThreadCount();
+    if (maxThreads == -1) {
+        // idealThreadCount returns -1 if cores cannot be detected
+        static const int MAX_THREADS_IF_UNKNOWN = 4;
+        maxThreads = MAX_THREADS_IF_UNKNOWN;
+    }
+
+    int clampedThreads = std::min(std::max(1, numThreads), maxThreads);
+    if (clampedThreads != numThreads) {
+        qWarning("%s: clamped to %d (was %d)", __FUNCTION__, clampedThreads, numThreads);
+        numThreads = clampedThreads;
+    }
+
+    qDebug("%s: starting %d send threads", __FUNCTION__, numThreads);
+
+    for (int i = 0; i < numThreads; ++i) {
+        _queues.emplace_back(new WorkerQueue());
+    }
+
+    for (int i = 0; i < numThreads; ++i) {
+        auto worker = new OctreeSendPoolThread(*this, i);
+        QObject::connect(worker, &QThread::started, [] { setThreadName("OctreeSendPoolThread"); });
+        worker->start();
+        _workers.emplace_back(worker);
+    }
+}
+
+OctreeSendPool::~OctreeSendPool() {
+    {
+        Lock lock(_mutex);
+        _stop = true;
+    }
+    _workerCondition.notify_all();
+
+    for (auto& worker : _workers) {
+        worker->wait();
+    }
+    _workers.clear();
+}
+
+void OctreeSendPool::addSender(OctreeSendThread* sender) {
+    quint64 now = usecTimestampNow();
+    {
+        Lock lock(_mutex);
+
+        auto& state = _senders[sender];
+        state = SenderState();
+        state.nodeUuid = sender->getNodeUuid();
+        state.generation = ++_nextGeneration;
+
+        _schedule.emplace(now, Task { sender, state.generation, now });
+    }
+    _workerCondition.notify_one();
+}
+
+void OctreeSendPool::removeSender(OctreeSendThread* sender) {
+    Lock lock(_mutex);
+
+    auto it = _senders.find(sender);
+    if (it == _senders.end()) {
+        return;
+    }
+
+    // any task still queued for this sender will be dropped once popped, we only need to wait out a running pass
+    it->second.isRemoved = true;
+    _idleCondition.wait(lock, [&] {
+        return !_senders[sender].isRunning;
+    });
+    _senders.erase(sender);
+}
+
+void OctreeSendPool::workerLoop(int index) {
+    while (true) {
+        Task task;
+        if (popTask(index, task)) {
+            runTask(task);
+            continue;
+        }
+
+        Lock lock(_mutex);
+        if (_stop) {
+            return;
+        }
+
+        // work was released to the queues between our pop and taking the lock
+        if (_queueDepth > 0 || releaseDueTasks()) {
+            continue;
+        }
+
+        if (_schedule.empty()) {
+            _workerCondition.wait(lock);
+        } else {
+            quint64 now = usecTimestampNow();
+            quint64 nextDue = _schedule.begin()->first;
+            if (nextDue > now) {
+                _workerCondition.wait_for(lock, std::chrono::microseconds(nextDue - now));
+            }
+        }
+    }
+}
+
+bool OctreeSendPool::popTask(int index, Task& task) {
+    {
+        auto& queue = *_queues[index];
+        Lock lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+            --_queueDepth;
+            return true;
+        }
+    }
+
+    // our own queue is empty, steal from the back of the others
+    int numQueues = (int)_queues.size();
+    for (int i = 1; i < numQueues; ++i) {
+        auto& victim = *_queues[(index + i) % numQueues];
+        Lock lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.back();
+            victim.tasks.pop_back();
+            --_queueDepth;
+            ++_totalSteals;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool OctreeSendPool::releaseDueTasks() {
+    quint64 now = usecTimestampNow();
+    int numReleased = 0;
+
+    // hand due tasks out round robin, oldest first, so that no node waits behind another node's second pass
+    auto it = _schedule.begin();
+    while (it != _schedule.end() && it->first <= now) {
+        auto& queue = *_queues[_nextQueue];
+        _nextQueue = (_nextQueue + 1) % (int)_queues.size();
+        {
+            Lock queueLock(queue.mutex);
+            queue.tasks.push_back(it->second);
+        }
+        ++_queueDepth;
+        ++numReleased;
+        it = _schedule.erase(it);
+    }
+
+    if (numReleased > 0) {
+        _averageQueueDepth.updateAverage((float)_queueDepth);
+        if (numReleased > 1) {
+            _workerCondition.notify_all();
+        }
+    }
+
+    return numReleased > 0;
+}
+
+void OctreeSendPool::runTask(const Task& task) {
+    OctreeSendThread* sender = task.sender;
+    {
+        Lock lock(_mutex);
+        auto it = _senders.find(sender);
+        if (it == _senders.end() || it->second.generation != task.generation || it->second.isRemoved) {
+            return; // stale task for a sender that has since gone away
+        }
+        it->second.isRunning = true;
+    }
+
+    quint64 start = usecTimestampNow();
+    quint64 latency = (start > task.dueTime) ? start - task.dueTime : 0;
+
+    bool keepRunning = sender->processSendPass();
+
+    quint64 end = usecTimestampNow();
+    ++_totalPasses;
+
+    if (!keepRunning) {
+        // the sender is still marked running, so it can not be deleted before we're done with it below
+        emit sender->finished();
+    }
+
+    {
+        Lock lock(_mutex);
+        auto it = _senders.find(sender);
+        assert(it != _senders.end());
+        auto& state = it->second;
+
+        state.isRunning = false;
+        _averageLatency.updateAverage((float)latency);
+        state.latency.updateAverage((float)latency);
+        state.sendTime.updateAverage((float)(end - start));
+
+        if (state.isRemoved) {
+            _idleCondition.notify_all();
+        } else if (!keepRunning) {
+            _senders.erase(it);
+        } else {
+            quint64 nextDue = std::max(start + OCTREE_SEND_INTERVAL_USECS, end);
+            _schedule.emplace(nextDue, Task { sender, state.generation, nextDue });
+            _workerCondition.notify_one();
+        }
+    }
+}
+
+QJsonObject OctreeSendPool::getStats() {
+    QJsonObject stats;
+    stats["1. threads"] = numThreads();
+    stats["3. queueDepth"] = getQueueDepth();
+    stats["6. totalPasses"] = (double)_totalPasses;
+    stats["7. totalSteals"] = (double)_totalSteals;
+
+    QJsonObject nodeStats;
+    {
+        Lock lock(_mutex);
+        stats["4. avgQueueDepth"] = _averageQueueDepth.getAverage();
+        stats["5. avgLatencyUsecs"] = _averageLatency.getAverage();
+        stats["2. senders"] = (int)_senders.size();
+        for (const auto& entry : _senders) {
+            const auto& state = entry.second;
+            QJsonObject senderStats;
+            senderStats["latency_usecs"] = state.latency.getAverage();
+            senderStats["send_usecs"] = state.sendTime.getAverage();
+            nodeStats[uuidStringWithoutCurlyBraces(state.nodeUuid)] = senderStats;
+        }
+    }
+    stats["8. nodes"] = nodeStats;
+
+    return stats;
+}
+
+QString OctreeSendPool::getStatsString() {
+    Lock lock(_mutex);
+
+    QString statsString;
+    statsString += QString("                   Send Pool Threads: %1 threads\r\n").arg(numThreads());
+    statsString += QString("               Send Pool Queue Depth: %1 tasks (average %2)\r\n")
+        .arg(getQueueDepth())
+        .arg((double)_averageQueueDepth.getAverage(), 0, 'f', 2);
+    statsString += QString("            Average Send Pass Latency: %1 usecs\r\n")
+        .arg((double)_averageLatency.getAverage(), 0, 'f', 2);
+    statsString += QString("                   Total Send Passes: %1\r\n").arg((quint64)_totalPasses);
+    statsString += QString("                   Total Stolen Tasks: %1\r\n\r\n").arg((quint64)_totalSteals);
+
+    statsString += "----- Node ID ------------------------    -- Latency (usecs) --    -- Send Time (usecs) --\r\n";
+    for (const auto& entry : _senders) {
+        const auto& state = entry.second;
+        statsString += QString("%1    %2    %3\r\n")
+            .arg(uuidStringWithoutCurlyBraces(state.nodeUuid))
+            .arg((double)state.latency.getAverage(), 20, 'f', 2)
+            .arg((double)state.sendTime.getAverage(), 22, 'f', 2);
+    }
+
+    return statsString;
+}
+
+void OctreeSendPool::resetStats() {
+    _totalPasses = 0;
+    _totalSteals = 0;
+
+    Lock lock(_mutex);
+    _averageLatency.reset();
+    _averageQueueDepth.reset();
+    for (auto& entry : _senders) {
+        entry.second.latency.reset();
+        entry.second.sendTime.reset();
+    }
+}
@@ -0,0 +1,119 @@
+//
+//  OctreeSendPool.h
+//  assignment-client/src/octree
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Fixed-size pool of threads shared by all octree send tasks
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeSendPool_h
+#define hifi_OctreeSendPool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QThread>
+#include <QtCore/QUuid>
+
+#include <SimpleMovingAverage.h>
+
+class OctreeSendPool;
+class OctreeSendThread;
+
+class OctreeSendPoolThread : public QThread {
+    Q_OBJECT
+public:
+    OctreeSendPoolThread(OctreeSendPool& pool, int index) : _pool(pool), _index(index) {}
+
+    void run() override final;
+
+private:
+    OctreeSendPool& _pool;
+    int _index;
+};
+
+// Runs the send passes of many OctreeSendThreads (in non-threaded mode) on a fixed set of threads.
+//   Each sender is scheduled at most once per send interval. When a sender comes due it is handed to a worker queue,
+//   and workers that run out of work steal from the back of each other's queues.
+//   addSender/removeSender/getStats may be called from any thread.
+class OctreeSendPool {
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+    using ConditionVariable = std::condition_variable;
+
+public:
+    OctreeSendPool(int numThreads = QThread::idealThreadCount());
+    ~OctreeSendPool();
+
+    void addSender(OctreeSendThread* sender);
+
+    // blocks until the sender is no longer running on a worker, after which it is safe to delete
+    void removeSender(OctreeSendThread* sender);
+
+    int numThreads() const { return (int)_workers.size(); }
+    int getQueueDepth() const { return _queueDepth; }
+
+    QJsonObject getStats();
+    QString getStatsString();
+    void resetStats();
+
+private:
+    friend class OctreeSendPoolThread;
+
+    struct Task {
+        OctreeSendThread* sender;
+        uint64_t generation;
+        quint64 dueTime;
+    };
+
+    struct SenderState {
+        QUuid nodeUuid;
+        uint64_t generation { 0 };
+        bool isRunning { false };
+        bool isRemoved { false };
+        SimpleMovingAverage latency; // usecs between a pass coming due and a worker starting it
+        SimpleMovingAverage sendTime; // usecs spent in the pass itself
+    };
+
+    struct WorkerQueue {
+        Mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(int index);
+    bool popTask(int index, Task& task);
+    bool releaseDueTasks(); // must be called with _mutex held
+    void runTask(const Task& task);
+
+    std::vector<std::unique_ptr<OctreeSendPoolThread>> _workers;
+    std::vector<std::unique_ptr<WorkerQueue>> _queues;
+
+    // scheduling state, guarded by _mutex
+    Mutex _mutex;
+    ConditionVariable _workerCondition;
+    ConditionVariable _idleCondition;
+    std::multimap<quint64, Task> _schedule;
+    std::unordered_map<OctreeSendThread*, SenderState> _senders;
+    uint64_t _nextGeneration { 0 };
+    int _nextQueue { 0 };
+    bool _stop { false };
+
+    std::atomic<int> _queueDepth { 0 };
+    std::atomic<uint64_t> _totalPasses { 0 };
+    std::atomic<uint64_t> _totalSteals { 0 };
+    SimpleMovingAverage _averageLatency; // guarded by _mutex
+    SimpleMovingAverage _averageQueueDepth; // guarded by _mutex
+};
+
+#endif // hifi_OctreeSendPool_h
@@ -38,6 +38,10 @@ public:
 
     QUuid getNodeUuid() const { return _nodeUuid; }
 
+    /// Runs a single send pass for our node without sleeping afterwards, used directly by the OctreeSendPool.
+    /// Returns false once this sender should stop being scheduled.
+    bool processSendPass();
+
     static AtomicUIntStat _totalBytes;
     static AtomicUIntStat _totalWastedBytes;
     static AtomicUIntStat _totalPackets;
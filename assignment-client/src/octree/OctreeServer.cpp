@@ -244,6 +244,7 @@ OctreeServer::OctreeServer(ReceivedMessage& message) :
     _debugSending(false),
     _debugReceiving(false),
     _verboseDebug(false),
+    _batchEdits(false),
     _octreeInboundPacketProcessor(nullptr),
     _persistManager(nullptr),
     _started(time(0)),
@@ -316,6 +317,9 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             _octreeInboundPacketProcessor->resetStats();
             _tree->resetEditStats();
             resetSendingStats();
+            if (_sendPool) {
+                _sendPool->resetStats();
+            }
             showStats = true;
         } else if ((url.path() == PERSIST_FILE_DOWNLOAD_PATH) || (url.path() == PERSIST_FILE_DOWNLOAD_PATH + "/")) {
             if (_persistFileDownload) {
@@ -440,6 +444,11 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         statsString += QString("      writeDatagram() last second: %1 clients\r\n\r\n")
             .arg(locale.toString((uint)howManyThreadsDidCallWriteDatagram(oneSecondAgo)).rightJustified(COLUMN_WIDTH, ' '));
 
+        if (_sendPool) {
+            statsString += _sendPool->getStatsString();
+            statsString += "\r\n";
+        }
+
         float averageLoopTime = getAverageLoopTime();
         statsString += QString("           Average packetLoop() time:      %1 msecs"
                                "                 samples: %2\r\n")
@@ -728,6 +737,21 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         statsString += QString("            Average Filter Time: %1 usecs\r\n")
             .arg(locale.toString((uint)averageFilterTime).rightJustified(COLUMN_WIDTH, ' '));
 
+        if (_batchEdits) {
+            statsString += QString("           Total Batches Applied: %1 batches\r\n")
+                .arg(locale.toString((uint)_octreeInboundPacketProcessor->getTotalBatches()).rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("              Average Batch Size: %1 edits\r\n")
+                .arg(locale.toString((uint)_octreeInboundPacketProcessor->getAverageBatchSize()).rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("                  Max Batch Size: %1 edits\r\n")
+                .arg(locale.toString((uint)_octreeInboundPacketProcessor->getMaxBatchSize()).rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("           Total Coalesced Edits: %1 edits\r\n")
+                .arg(locale.toString((uint)_octreeInboundPacketProcessor->getTotalCoalescedEdits()).rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("      Average Process Time/Batch: %1 usecs\r\n")
+                .arg(locale.toString((uint)_octreeInboundPacketProcessor->getAverageProcessTimePerBatch()).rightJustified(COLUMN_WIDTH, ' '));
+            statsString += QString("    Average Wait Lock Time/Batch: %1 usecs\r\n")
+                .arg(locale.toString((uint)_octreeInboundPacketProcessor->getAverageLockWaitTimePerBatch()).rightJustified(COLUMN_WIDTH, ' '));
+        }
+
 
         int senderNumber = 0;
         NodeToSenderStatsMap allSenderStats = _octreeInboundPacketProcessor->getSingleSenderStats();
@@ -906,7 +930,13 @@ OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePo
 
     // we want to be notified when the thread finishes
     connect(sendThread.get(), &GenericThread::finished, this, &OctreeServer::removeSendThread);
-    sendThread->initialize(true);
+
+    if (_sendPool) {
+        sendThread->initialize(false);
+        _sendPool->addSender(sendThread.get());
+    } else {
+        sendThread->initialize(true);
+    }
 
     return sendThread;
 }
@@ -914,6 +944,10 @@ OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePo
 void OctreeServer::removeSendThread() {
     // If the object has been deleted since the event was queued, sender() will return nullptr
     if (auto sendThread = qobject_cast<OctreeSendThread*>(sender())) {
+        if (_sendPool) {
+            _sendPool->removeSender(sendThread);
+        }
+
         // This deletes the unique_ptr, so sendThread is destructed after that line
         _sendThreads.erase(sendThread->getNodeUuid());
     }
@@ -930,6 +964,9 @@ void OctreeServer::handleOctreeQueryPacket(QSharedPointer<ReceivedMessage> messa
         if (it == _sendThreads.end()) {
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
         } else if (it->second->isShuttingDown()) {
+            if (_sendPool) {
+                _sendPool->removeSender(it->second.get());
+            }
             _sendThreads.erase(it); // Remove right away and wait on thread to be
 
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
@@ -1091,6 +1128,19 @@ void OctreeServer::readConfiguration() {
         readOptionBool(QString("persistFileDownload"), settingsSectionObject, _persistFileDownload);
         qDebug() << "persistFileDownload=" << _persistFileDownload;
 
+        readOptionBool(QString("persistIncremental"), settingsSectionObject, _persistIncremental);
+        qDebug() << "persistIncremental=" << _persistIncremental;
+
+        result = -1;
+        readOptionInt(QString("persistSnapshotInterval"), settingsSectionObject, result);
+        if (result > 0) {
+            _persistSnapshotInterval = std::chrono::milliseconds(result);
+        }
+        qDebug() << "persistSnapshotInterval=" << _persistSnapshotInterval.count();
+
+        readOptionBool(QString("persistBinarySnapshot"), settingsSectionObject, _persistBinarySnapshot);
+        qDebug() << "persistBinarySnapshot=" << _persistBinarySnapshot;
+
     } else {
         qDebug("persistFilename= DISABLED");
     }
@@ -1126,6 +1176,24 @@ void OctreeServer::readConfiguration() {
     qDebug("packetsPerSecondTotalMax=%d _packetsTotalPerInterval=%d",
                     packetsPerSecondTotalMax, _packetsTotalPerInterval);
 
+    bool useSendThreadPool = false;
+    readOptionBool(QString("useSendThreadPool"), settingsSectionObject, useSendThreadPool);
+    qDebug("useSendThreadPool=%s", debug::valueOf(useSendThreadPool));
+
+    if (useSendThreadPool && !_sendPool) {
+        // the setting is left empty to use a thread per core
+        int sendThreadPoolSize = QThread::idealThreadCount();
+        int configuredSendThreadPoolSize = 0;
+        if (readOptionInt(QString("sendThreadPoolSize"), settingsSectionObject, configuredSendThreadPoolSize)
+                && configuredSendThreadPoolSize > 0) {
+            sendThreadPoolSize = configuredSendThreadPoolSize;
+        }
+        _sendPool = std::make_unique<OctreeSendPool>(sendThreadPoolSize);
+        qDebug("sendThreadPoolSize=%d", _sendPool->numThreads());
+    }
+
+    readOptionBool(QString("batchEdits"), settingsSectionObject, _batchEdits);
+    qDebug("batchEdits=%s", debug::valueOf(_batchEdits));
 
     readAdditionalConfiguration(settingsSectionObject);
 }
@@ -1219,6 +1287,8 @@ void OctreeServer::domainSettingsRequestComplete() {
         // now set up PersistThread
         _persistManager = new OctreePersistThread(_tree, _persistAbsoluteFilePath, _persistInterval, _debugTimestampNow,
                                                  _persistAsFileType);
+        _persistManager->setIncrementalPersist(_persistIncremental, _persistSnapshotInterval);
+        _persistManager->setBinarySnapshot(_persistBinarySnapshot);
         _persistManager->moveToThread(&_persistThread);
         connect(&_persistThread, &QThread::finished, _persistManager, &QObject::deleteLater);
         connect(&_persistThread, &QThread::started, _persistManager, [this] {
@@ -1327,12 +1397,16 @@ void OctreeServer::aboutToFinish() {
     for (auto& it : _sendThreads) {
         auto& sendThread = *it.second;
         sendThread.setIsShuttingDown();
+        if (_sendPool) {
+            _sendPool->removeSender(&sendThread);
+        }
         sendThread.terminate();
     }
 
     // Clear will destruct all the unique_ptr to OctreeSendThreads which will call the GenericThread's dtor
     // which waits on the thread to be done before returning
     _sendThreads.clear(); // Cleans up all the send threads.
+    _sendPool.reset();
 
     if (_persistManager) {
         _persistThread.quit();
@@ -1503,12 +1577,18 @@ void OctreeServer::sendStatsPacket() {
         dataArray2["1. packetQueue"] = (double)_octreeInboundPacketProcessor->packetsToProcessCount();
         dataArray2["2. totalPackets"] = (double)_octreeInboundPacketProcessor->getTotalPacketsProcessed();
         dataArray2["3. totalElements"] = (double)_octreeInboundPacketProcessor->getTotalElementsProcessed();
+        dataArray2["4. totalBatches"] = (double)_octreeInboundPacketProcessor->getTotalBatches();
+        dataArray2["5. totalBatchedEdits"] = (double)_octreeInboundPacketProcessor->getTotalBatchedEdits();
+        dataArray2["6. totalCoalescedEdits"] = (double)_octreeInboundPacketProcessor->getTotalCoalescedEdits();
+        dataArray2["7. maxBatchSize"] = (double)_octreeInboundPacketProcessor->getMaxBatchSize();
 
         timingArray2["1. avgTransitTimePerPacket"] = (double)_octreeInboundPacketProcessor->getAverageTransitTimePerPacket();
         timingArray2["2. avgProcessTimePerPacket"] = (double)_octreeInboundPacketProcessor->getAverageProcessTimePerPacket();
         timingArray2["3. avgLockWaitTimePerPacket"] = (double)_octreeInboundPacketProcessor->getAverageLockWaitTimePerPacket();
         timingArray2["4. avgProcessTimePerElement"] = (double)_octreeInboundPacketProcessor->getAverageProcessTimePerElement();
         timingArray2["5. avgLockWaitTimePerElement"] = (double)_octreeInboundPacketProcessor->getAverageLockWaitTimePerElement();
+        timingArray2["6. avgProcessTimePerBatch"] = (double)_octreeInboundPacketProcessor->getAverageProcessTimePerBatch();
+        timingArray2["7. avgLockWaitTimePerBatch"] = (double)_octreeInboundPacketProcessor->getAverageLockWaitTimePerBatch();
     }
 
     QJsonObject statsObject3;
@@ -1521,6 +1601,9 @@ void OctreeServer::sendStatsPacket() {
     jsonArray["2. octree"] = octreeStats;
     jsonArray["3. outbound"] = statsObject2;
     jsonArray["4. inbound"] = statsObject3;
+    if (_sendPool) {
+        jsonArray["5. sendPool"] = _sendPool->getStats();
+    }
 
     QJsonObject statsObject;
     statsObject[QString(getMyServerName()) + "Server"] = jsonArray;
@@ -24,6 +24,7 @@
 #include <ThreadedAssignment.h>
 
 #include "OctreePersistThread.h"
+#include "OctreeSendPool.h"
 #include "OctreeSendThread.h"
 #include "OctreeServerConsts.h"
 #include "OctreeInboundPacketProcessor.h"
@@ -47,6 +48,7 @@ public:
     bool wantsDebugSending() const { return _debugSending; }
     bool wantsDebugReceiving() const { return _debugReceiving; }
     bool wantsVerboseDebug() const { return _verboseDebug; }
+    bool wantsBatchedEdits() const { return _batchEdits; }
 
     OctreePointer getOctree() { return _tree; }
 
@@ -192,12 +194,16 @@ protected:
     bool _debugReceiving;
     bool _debugTimestampNow;
     bool _verboseDebug;
+    bool _batchEdits;
     OctreeInboundPacketProcessor* _octreeInboundPacketProcessor;
     OctreePersistThread* _persistManager;
     QThread _persistThread;
 
     std::chrono::milliseconds _persistInterval;
     bool _persistFileDownload;
+    bool _persistIncremental { false };
+    std::chrono::milliseconds _persistSnapshotInterval { OctreePersistThread::DEFAULT_SNAPSHOT_INTERVAL };
+    bool _persistBinarySnapshot { false };
     int _maxBackupVersions;
 
     time_t _started;
@@ -206,6 +212,9 @@ protected:
     
     SendThreads _sendThreads;
 
+    // when set, send threads run their passes as tasks on this shared pool instead of on their own thread
+    std::unique_ptr<OctreeSendPool> _sendPool;
+
     static int _clientCount;
     static SimpleMovingAverage _averageLoopTime;
 
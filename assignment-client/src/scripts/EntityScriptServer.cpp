@@ -15,6 +15,8 @@
 
 #include <mutex>
 
+#include <QtCore/QThread>
+
 #include <AudioConstants.h>
 #include <AudioScriptingInterface.h>
 #include <AudioInjectorManager.h>
@@ -30,6 +32,7 @@
 #include <ResourceManager.h>
 #include <ResourceScriptingInterface.h>
 #include <ScriptCache.h>
+#include <ScriptEngine.h>
 #include <ScriptEngines.h>
 #include <SoundCacheScriptingInterface.h>
 #include <UUID.h>
@@ -50,6 +53,32 @@ void messageHandler(QtMsgType type, const QMessageLogContext& context, const QSt
 
 int EntityScriptServer::_entitiesScriptEngineCount = 0;
 
+static size_t getScriptEngineShard(const EntityItemID& entityID, size_t numShards) {
+    return qHash(entityID) % numShards;
+}
+
+// Lets EntityScriptingInterface reach entity scripts spread across several script engines
+class ShardedEntitiesScriptEngineProvider : public EntitiesScriptEngineProvider {
+public:
+    ShardedEntitiesScriptEngineProvider(std::vector<ScriptManagerPointer> managers) : _managers(std::move(managers)) {}
+
+    virtual void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                        const QStringList& params, const QUuid& remoteCallerID) override {
+        getManager(entityID)->callEntityScriptMethod(entityID, methodName, params, remoteCallerID);
+    }
+
+    virtual QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) override {
+        return getManager(entityID)->getLocalEntityScriptDetails(entityID);
+    }
+
+private:
+    const ScriptManagerPointer& getManager(const EntityItemID& entityID) const {
+        return _managers[getScriptEngineShard(entityID, _managers.size())];
+    }
+
+    std::vector<ScriptManagerPointer> _managers;
+};
+
 EntityScriptServer::EntityScriptServer(ReceivedMessage& message) : ThreadedAssignment(message) {
     qInstallMessageHandler(messageHandler);
 
@@ -126,7 +155,8 @@ void EntityScriptServer::handleEntityScriptGetStatusPacket(QSharedPointer<Receiv
         replyPacketList->writePrimitive(messageID);
 
         EntityScriptDetails details;
-        if (_entitiesScriptManager->getEntityScriptDetails(entityID, details)) {
+        auto scriptManager = getEntitiesScriptManager(entityID);
+        if (scriptManager && scriptManager->getEntityScriptDetails(entityID, details)) {
             replyPacketList->writePrimitive(true);
             replyPacketList->writePrimitive(details.status);
             replyPacketList->writeString(details.errorInfo);
@@ -158,6 +188,25 @@ void EntityScriptServer::handleSettings() {
 
     auto entityScriptServerSettings = settingsObject[ENTITY_SCRIPT_SERVER_SETTINGS_KEY].toObject();
 
+    static const QString SCRIPT_ENGINE_SHARDS_OPTION = "script_engine_shards";
+    int numScriptEngineShards = std::max(1, entityScriptServerSettings[SCRIPT_ENGINE_SHARDS_OPTION].toInt(1));
+
+    // each engine has a thread of its own, more of them than cores only adds contention
+    int maxScriptEngineShards = std::max(1, QThread::idealThreadCount());
+    if (numScriptEngineShards > maxScriptEngineShards) {
+        qCWarning(entity_script_server) << "Requested" << numScriptEngineShards << "script engines, limiting to"
+            << maxScriptEngineShards << "(the number of cores)";
+        numScriptEngineShards = maxScriptEngineShards;
+    }
+
+    if (numScriptEngineShards != _numScriptEngineShards) {
+        qDebug() << "Running entity scripts in" << numScriptEngineShards << "script engines";
+        _numScriptEngineShards = numScriptEngineShards;
+        if (!_scriptEngineShards.empty() && !_shuttingDown) {
+            reshardEntitiesScriptEngines();
+        }
+    }
+
     static const QString MAX_ENTITY_PPS_OPTION = "max_total_entity_pps";
     static const QString ENTITY_PPS_PER_SCRIPT = "entity_pps_per_script";
 
@@ -174,7 +223,7 @@ void EntityScriptServer::handleSettings() {
 }
 
 void EntityScriptServer::updateEntityPPS() {
-    int numRunningScripts = _entitiesScriptManager->getNumRunningEntityScripts();
+    int numRunningScripts = getNumRunningEntityScripts();
     int pps;
     if (std::numeric_limits<int>::max() / _entityPPSPerScript < numRunningScripts) {
         qWarning() << QString("Integer multiplication would overflow, clamping to maxint: %1 * %2").arg(numRunningScripts).arg(_entityPPSPerScript);
@@ -246,7 +295,7 @@ void EntityScriptServer::addLogEntry(const QString& message, const QString& file
 
 void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
 
-    if (_entitiesScriptManager && _entityViewer.getTree() && !_shuttingDown) {
+    if (!_scriptEngineShards.empty() && _entityViewer.getTree() && !_shuttingDown) {
         auto entityID = QUuid::fromRfc4122(receivedMessage->read(NUM_BYTES_RFC4122_UUID));
 
         auto method = receivedMessage->readString();
@@ -260,7 +309,7 @@ void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<Recei
             params << paramString;
         }
 
-        _entitiesScriptManager->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
+        getEntitiesScriptManager(entityID)->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
     }
 }
 
@@ -317,6 +366,8 @@ void EntityScriptServer::run() {
 
     auto treePtr = _entityViewer.getTree();
     treePtr->setIsServer(true);
+    // server scripts poll findEntities() and picks far more often than the tree changes
+    treePtr->setBVHEnabled(true);
     DependencyManager::set<AssignmentParentFinder>(treePtr);
 
     if (!_entitySimulation) {
@@ -455,7 +506,7 @@ void EntityScriptServer::selectAudioFormat(const QString& selectedCodecName) {
     }
 }
 
-void EntityScriptServer::resetEntitiesScriptEngine() {
+ScriptManagerPointer EntityScriptServer::createEntitiesScriptManager(bool updatesEntityViewer) {
     auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
     auto newManager = scriptManagerFactory(ScriptManager::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
     auto newEngine = newManager->engine();
@@ -496,37 +547,94 @@ void EntityScriptServer::resetEntitiesScriptEngine() {
                 addLogEntry(message, fileName, lineNumber, entityID, ScriptMessage::Severity::SEVERITY_WARNING);
             });
 
-    connect(newManager.get(), &ScriptManager::update, this, [this] {
-        _entityViewer.queryOctree();
-        _entityViewer.getTree()->preUpdate();
-        _entityViewer.getTree()->update();
-    });
+    if (updatesEntityViewer) {
+        connect(newManager.get(), &ScriptManager::update, this, [this] {
+            _entityViewer.queryOctree();
+            _entityViewer.getTree()->preUpdate();
+            _entityViewer.getTree()->update();
+        });
+    }
+
+    connect(newManager.get(), &ScriptManager::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
 
     scriptEngines->runScriptInitializers(newManager);
     newManager->runInThread();
-    std::shared_ptr<EntitiesScriptEngineProvider> newEngineSP = newManager;
+    return newManager;
+}
+
+void EntityScriptServer::resetEntitiesScriptEngine() {
+    for (auto& shard : _scriptEngineShards) {
+        disconnect(shard.manager.get(), &ScriptManager::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
+    }
+
+    std::vector<ScriptEngineShard> newShards(_numScriptEngineShards);
+    std::vector<ScriptManagerPointer> newManagers;
+    for (size_t i = 0; i < newShards.size(); ++i) {
+        // only one engine needs to drive the entity viewer
+        ScriptEngineShard& shard = newShards[i];
+        shard.manager = createEntitiesScriptManager(i == 0);
+        shard.cpuTime = std::make_shared<std::atomic<quint64>>(0);
+        auto cpuTime = shard.cpuTime;
+        connect(shard.manager.get(), &ScriptManager::update, [cpuTime] {
+            *cpuTime = usecCurrentThreadCPUTime();
+        });
+        newManagers.push_back(shard.manager);
+    }
+
+    std::shared_ptr<EntitiesScriptEngineProvider> newEngineSP;
+    if (newManagers.size() == 1) {
+        newEngineSP = newManagers.front();
+    } else {
+        newEngineSP = std::make_shared<ShardedEntitiesScriptEngineProvider>(newManagers);
+    }
     // On the entity script server, these are the same
     DependencyManager::get<EntityScriptingInterface>()->setPersistentEntitiesScriptEngine(newEngineSP);
     DependencyManager::get<EntityScriptingInterface>()->setNonPersistentEntitiesScriptEngine(newEngineSP);
 
-    if (_entitiesScriptManager) {
-        disconnect(_entitiesScriptManager.get(), &ScriptManager::entityScriptDetailsUpdated,
-                   this, &EntityScriptServer::updateEntityPPS);
+    _scriptEngineShards.swap(newShards);
+    _lastShardStatsTime = usecTimestampNow();
+}
+
+void EntityScriptServer::reshardEntitiesScriptEngines() {
+    // stop the current engines, then load the scripts they were running into the new ones
+    QList<EntityItemID> entityIDs;
+    for (auto& shard : _scriptEngineShards) {
+        entityIDs += shard.manager->getListOfEntityScriptIDs();
+        shard.manager->unloadAllEntityScripts();
+        shard.manager->stop();
+        shard.manager->waitTillDoneRunning();
     }
 
-    _entitiesScriptManager.swap(newManager);
-    connect(_entitiesScriptManager.get(), &ScriptManager::entityScriptDetailsUpdated,
-            this, &EntityScriptServer::updateEntityPPS);
+    resetEntitiesScriptEngine();
+
+    for (const auto& entityID : entityIDs) {
+        checkAndCallPreload(entityID);
+    }
+}
+
+ScriptManagerPointer EntityScriptServer::getEntitiesScriptManager(const EntityItemID& entityID) const {
+    if (_scriptEngineShards.empty()) {
+        return ScriptManagerPointer();
+    }
+    return _scriptEngineShards[getScriptEngineShard(entityID, _scriptEngineShards.size())].manager;
+}
+
+int EntityScriptServer::getNumRunningEntityScripts() const {
+    int numRunningScripts = 0;
+    for (const auto& shard : _scriptEngineShards) {
+        numRunningScripts += shard.manager->getNumRunningEntityScripts();
+    }
+    return numRunningScripts;
 }
 
 
 void EntityScriptServer::clear() {
-    // unload and stop the engine
-    if (_entitiesScriptManager) {
+    // unload and stop the engines
+    for (auto& shard : _scriptEngineShards) {
         // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptManager->unloadAllEntityScripts();
-        _entitiesScriptManager->stop();
-        _entitiesScriptManager->waitTillDoneRunning();
+        shard.manager->unloadAllEntityScripts();
+        shard.manager->stop();
+        shard.manager->waitTillDoneRunning();
     }
 
     _entityViewer.clear();
@@ -538,8 +646,8 @@ void EntityScriptServer::clear() {
 }
 
 void EntityScriptServer::shutdownScriptEngine() {
-    if (_entitiesScriptManager) {
-        _entitiesScriptManager->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    for (auto& shard : _scriptEngineShards) {
+        shard.manager->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
     }
     _shuttingDown = true;
 
@@ -548,7 +656,7 @@ void EntityScriptServer::shutdownScriptEngine() {
     auto scriptEngines = DependencyManager::get<ScriptEngines>();
     scriptEngines->shutdownScripting();
 
-    _entitiesScriptManager.reset();
+    _scriptEngineShards.clear();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
@@ -566,9 +674,10 @@ void EntityScriptServer::addingEntity(const EntityItemID& entityID) {
 }
 
 void EntityScriptServer::deletingEntity(const EntityItemID& entityID) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptManager) {
+    auto scriptManager = getEntitiesScriptManager(entityID);
+    if (_entityViewer.getTree() && !_shuttingDown && scriptManager) {
         // TODO: Check if this is running on script engine thread, otherwise lambda capturing script engine pointer is needed
-        _entitiesScriptManager->unloadEntityScript(entityID, true);
+        scriptManager->unloadEntityScript(entityID, true);
     }
 }
 
@@ -579,21 +688,22 @@ void EntityScriptServer::entityServerScriptChanging(const EntityItemID& entityID
 }
 
 void EntityScriptServer::checkAndCallPreload(const EntityItemID& entityID, bool forceRedownload) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptManager) {
+    auto scriptManager = getEntitiesScriptManager(entityID);
+    if (_entityViewer.getTree() && !_shuttingDown && scriptManager) {
 
         EntityItemPointer entity = _entityViewer.getTree()->findEntityByEntityItemID(entityID);
         EntityScriptDetails details;
-        bool isRunning = _entitiesScriptManager->getEntityScriptDetails(entityID, details);
+        bool isRunning = scriptManager->getEntityScriptDetails(entityID, details);
         if (entity && (forceRedownload || !isRunning || details.scriptText != entity->getServerScripts())) {
             // TODO: Check if this is running on script engine thread, otherwise lambda capturing script engine pointer is needed
             if (isRunning) {
-                _entitiesScriptManager->unloadEntityScript(entityID, true);
+                scriptManager->unloadEntityScript(entityID, true);
             }
 
             QString scriptUrl = entity->getServerScripts();
             if (!scriptUrl.isEmpty()) {
                 scriptUrl = DependencyManager::get<ResourceManager>()->normalizeURL(scriptUrl);
-                _entitiesScriptManager->loadEntityScript(entityID, scriptUrl, forceRedownload);
+                scriptManager->loadEntityScript(entityID, scriptUrl, forceRedownload);
             }
         }
     }
@@ -609,12 +719,31 @@ void EntityScriptServer::sendStatsPacket() {
     statsObject["octree_stats"] = octreeStats;
 
     QJsonObject scriptEngineStats;
-    int numberRunningScripts = 0;
-    const auto scriptManager = _entitiesScriptManager;
-    if (scriptManager) {
-        numberRunningScripts = scriptManager->getNumRunningEntityScripts();
+    scriptEngineStats["number_running_scripts"] = getNumRunningEntityScripts();
+    if (!_scriptEngineShards.empty() && _scriptEngineShards.front().manager->engine()) {
+        auto codeCacheStatistics = _scriptEngineShards.front().manager->engine()->getCodeCacheStatistics();
+        scriptEngineStats["code_cache_hits"] = (double)codeCacheStatistics.hits;
+        scriptEngineStats["code_cache_misses"] = (double)codeCacheStatistics.misses;
+        scriptEngineStats["code_cache_rejected"] = (double)codeCacheStatistics.rejected;
+    }
+
+    // CPU time used by each script engine's thread since the last stats
+    quint64 now = usecTimestampNow();
+    quint64 statsInterval = now - _lastShardStatsTime;
+    _lastShardStatsTime = now;
+    QJsonObject shardsStats;
+    for (size_t i = 0; i < _scriptEngineShards.size(); ++i) {
+        auto& shard = _scriptEngineShards[i];
+        quint64 cpuTime = *shard.cpuTime;
+        QJsonObject shardStats;
+        shardStats["number_running_scripts"] = shard.manager->getNumRunningEntityScripts();
+        shardStats["cpu_time_msecs"] = (double)(cpuTime / USECS_PER_MSEC);
+        shardStats["cpu_usage_percent"] = statsInterval == 0 ? 0.0 :
+            (double)(cpuTime - shard.reportedCPUTime) * 100.0 / statsInterval;
+        shard.reportedCPUTime = cpuTime;
+        shardsStats[QString::number(i)] = shardStats;
     }
-    scriptEngineStats["number_running_scripts"] = numberRunningScripts;
+    scriptEngineStats["script_engines"] = shardsStats;
     statsObject["script_engine_stats"] = scriptEngineStats;
 
 
@@ -14,6 +14,7 @@
 #ifndef hifi_EntityScriptServer_h
 #define hifi_EntityScriptServer_h
 
+#include <atomic>
 #include <set>
 #include <vector>
 
@@ -91,6 +92,10 @@ private:
     void selectAudioFormat(const QString& selectedCodecName);
 
     void resetEntitiesScriptEngine();
+    ScriptManagerPointer createEntitiesScriptManager(bool updatesEntityViewer);
+    void reshardEntitiesScriptEngines();
+    ScriptManagerPointer getEntitiesScriptManager(const EntityItemID& entityID) const;
+    int getNumRunningEntityScripts() const;
     void clear();
     void shutdownScriptEngine();
 
@@ -103,8 +108,18 @@ private:
 
     bool _shuttingDown { false };
 
+    // entity scripts are sharded by entity ID across script engines, each with its own isolate and thread
+    class ScriptEngineShard {
+    public:
+        ScriptManagerPointer manager;
+        std::shared_ptr<std::atomic<quint64>> cpuTime; // sampled on the engine's thread each update
+        quint64 reportedCPUTime { 0 };
+    };
+
     static int _entitiesScriptEngineCount;
-    ScriptManagerPointer _entitiesScriptManager;
+    std::vector<ScriptEngineShard> _scriptEngineShards;
+    int _numScriptEngineShards { 1 };
+    quint64 _lastShardStatsTime { 0 };
     SimpleEntitySimulationPointer _entitySimulation;
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
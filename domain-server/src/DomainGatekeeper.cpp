@@ -378,7 +378,12 @@ void DomainGatekeeper::updateNodePermissions() {
                                               connectingAddr.getAddress(), hardwareAddress, machineFingerprint);
         }
 
+        // this runs every time the groups cache is refreshed, only a change that other nodes see bumps the list version
+        bool permissionsChanged = userPerms.permissions != node->getPermissions().permissions;
         node->setPermissions(userPerms);
+        if (permissionsChanged) {
+            _server->nodeListChanged(node);
+        }
 
         if (!userPerms.can(NodePermissions::Permission::canConnectToDomain)) {
             qDebug() << "node" << node->getUUID() << "no longer has permission to connect.";
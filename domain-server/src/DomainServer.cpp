@@ -785,6 +785,7 @@ bool DomainServer::isPacketVerified(const udt::Packet& packet) {
 void DomainServer::setupNodeListAndAssignments() {
     const QString CUSTOM_LOCAL_PORT_OPTION = "metaverse.local_port";
     static const QString ENABLE_PACKET_AUTHENTICATION = "metaverse.enable_packet_verification";
+    static const QString PACKET_AUTHENTICATION_METHOD = "metaverse.packet_verification_method";
 
     QVariant localPortValue = _settingsManager.valueOrDefaultValueForKeyPath(CUSTOM_LOCAL_PORT_OPTION);
     int domainServerPort = localPortValue.toInt();
@@ -855,6 +856,11 @@ void DomainServer::setupNodeListAndAssignments() {
     bool isAuthEnabled = _settingsManager.valueOrDefaultValueForKeyPath(ENABLE_PACKET_AUTHENTICATION).toBool();
     nodeList->setAuthenticatePackets(isAuthEnabled);
 
+    // the domain picks the hash every node uses to verify the packets of its connections, and hands it out in the domain list
+    static const QString MD5_AUTHENTICATION_METHOD = "md5";
+    QString authMethod = _settingsManager.valueOrDefaultValueForKeyPath(PACKET_AUTHENTICATION_METHOD).toString();
+    nodeList->setAuthenticationMethod(authMethod == MD5_AUTHENTICATION_METHOD ? HMACAuth::MD5 : HMACAuth::SIPHASH);
+
     connect(nodeList.data(), &LimitedNodeList::nodeAdded, this, &DomainServer::nodeAdded);
     connect(nodeList.data(), &LimitedNodeList::nodeKilled, this, &DomainServer::nodeKilled);
     connect(nodeList.data(), &LimitedNodeList::localSockAddrChanged, this,
@@ -1263,12 +1269,22 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     QDataStream packetStream(message->getMessage());
     NodeConnectionData nodeRequestData = NodeConnectionData::fromDataStream(packetStream, message->getSenderSockAddr(), false);
 
-    // update this node's sockets in case they have changed
-    sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
-    sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+    // the version of the node list this node has, so that we only send it what changed since
+    quint32 acknowledgedListVersion = 0;
+    if (!packetStream.atEnd()) {
+        packetStream >> acknowledgedListVersion;
+    }
 
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
 
+    // update this node's sockets in case they have changed
+    if (sendingNode->getPublicSocket() != nodeRequestData.publicSockAddr
+            || sendingNode->getLocalSocket() != nodeRequestData.localSockAddr) {
+        sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
+        sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+        nodeListChanged(sendingNode);
+    }
+
     if (!nodeData->hasCheckedIn()) {
         nodeData->setHasCheckedIn(true);
 
@@ -1282,8 +1298,13 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
         safeInterestSet.remove(NodeType::Agent);
     }
 
-    // update the NodeInterestSet in case there have been any changes
-    nodeData->setNodeInterestSet(safeInterestSet);
+    // update the NodeInterestSet in case there have been any changes,
+    // the node hasn't heard about the node types it just became interested in so it needs a full list
+    if (nodeData->getNodeInterestSet() != safeInterestSet) {
+        nodeData->setNodeInterestSet(safeInterestSet);
+        acknowledgedListVersion = 0;
+    }
+    nodeData->setAcknowledgedListVersion(acknowledgedListVersion);
 
     // update the connecting hostname in case it has changed
     nodeData->setPlaceName(nodeRequestData.placeName);
@@ -1369,6 +1390,8 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode, quint64 reques
         newNode->setIsReplicated(true);
     }
 
+    nodeListChanged(newNode);
+
     // send out this node to our other connected nodes
     broadcastNewNode(newNode);
 }
@@ -1390,39 +1413,53 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     extendedHeaderStream << node->getLocalID();
     extendedHeaderStream << node->getPermissions();
     extendedHeaderStream << limitedNodeList->getAuthenticatePackets();
+    extendedHeaderStream << (quint8)limitedNodeList->getAuthenticationMethod();
     extendedHeaderStream << nodeData->getLastDomainCheckinTimestamp();
     extendedHeaderStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
     extendedHeaderStream << quint64(duration_cast<microseconds>(p_high_resolution_clock::now().time_since_epoch()).count()) - requestPacketReceiveTime;
     extendedHeaderStream << newConnection;
+
+    // nodes that already have a version of the node list only get the nodes that changed since, which in the steady
+    // state is none of them; removed nodes aren't part of the list, the reliable DomainServerRemovedNode takes care of those
+    quint32 baseListVersion = nodeData->getAcknowledgedListVersion();
+    if (newConnection || baseListVersion > _nodeListVersion) {
+        baseListVersion = 0;
+    }
+
+    // the nodes to send, counted up front so the node can tell when it has all the packets of the list
+    std::vector<SharedNodePointer> listNodes;
+    if (nodeData->getNodeInterestSet().size() > 0 && nodeData->isAuthenticated()) {
+        limitedNodeList->eachNode([this, node, baseListVersion, &listNodes](const SharedNodePointer& otherNode) {
+            auto otherNodeData = static_cast<DomainServerNodeData*>(otherNode->getLinkedData());
+            if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode) &&
+                (baseListVersion == 0 || (otherNodeData && otherNodeData->getListVersion() > baseListVersion))) {
+                listNodes.push_back(otherNode);
+            }
+        });
+    }
+
+    extendedHeaderStream << _nodeListVersion;
+    extendedHeaderStream << baseListVersion;
+    extendedHeaderStream << (quint32)listNodes.size();
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
     // always send the node their own UUID back
     QDataStream domainListStream(domainListPackets.get());
 
-    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
-    auto& nodeInterestSet = nodeData->getNodeInterestSet();
-
-    if (nodeInterestSet.size() > 0) {
-
-        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
-        if (nodeData->isAuthenticated()) {
-            // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([this, node, &domainListPackets, &domainListStream](const SharedNodePointer& otherNode) {
-                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
-                    // since we're about to add a node to the packet we start a segment
-                    domainListPackets->startSegment();
+    // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
+    // if this authenticated node has any interest types, send back those nodes as well
+    for (const auto& otherNode : listNodes) {
+        // since we're about to add a node to the packet we start a segment
+        domainListPackets->startSegment();
 
-                    // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
+        // don't send avatar nodes to other avatars, that will come from avatar mixer
+        domainListStream << *otherNode.data();
 
-                    // pack the secret that these two nodes will use to communicate with each other
-                    domainListStream << connectionSecretForNodes(node, otherNode);
+        // pack the secret that these two nodes will use to communicate with each other
+        domainListStream << connectionSecretForNodes(node, otherNode);
 
-                    // we've added the node we wanted so end the segment now
-                    domainListPackets->endSegment();
-                }
-            });
-        }
+        // we've added the node we wanted so end the segment now
+        domainListPackets->endSegment();
     }
 
     // send an empty list to the node, in case there were no other nodes
@@ -3255,7 +3292,10 @@ void DomainServer::updateReplicatedNodes() {
                 qDebug() << "Setting node to replicated:"
                     << otherNode->getPermissions().getVerifiedUserName() << otherNode->getUUID();
             }
-            otherNode->setIsReplicated(shouldReplicate);
+            if (isReplicated != shouldReplicate) {
+                otherNode->setIsReplicated(shouldReplicate);
+                nodeListChanged(otherNode);
+            }
         }
     );
 }
@@ -3279,6 +3319,13 @@ bool DomainServer::isAssetServerEnabled() {
     return _settingsManager.valueOrDefaultValueForKeyPath(ASSET_SERVER_ENABLED_KEYPATH).toBool();
 }
 
+void DomainServer::nodeListChanged(const SharedNodePointer& node) {
+    auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    if (nodeData) {
+        nodeData->setListVersion(++_nodeListVersion);
+    }
+}
+
 void DomainServer::nodeAdded(SharedNodePointer node) {
     // we don't use updateNodeWithData, so add the DomainServerNodeData to the node here
     node->setLinkedData(std::unique_ptr<DomainServerNodeData> { new DomainServerNodeData() });
@@ -83,6 +83,9 @@ public:
 
     static bool forceCrashReporting() { return _forceCrashReporting; }
 
+    /// Flags a change to a node that the other nodes have to hear about in their next domain list
+    void nodeListChanged(const SharedNodePointer& node);
+
 public slots:
     /// Called by NodeList to inform us a node has been added
     void nodeAdded(SharedNodePointer node);
@@ -294,6 +297,8 @@ private:
     int _iceAddressLookupID { INVALID_ICE_LOOKUP_ID };
     int _noReplyICEHeartbeats { 0 };
     int _numHeartbeatDenials { 0 };
+
+    quint32 _nodeListVersion { 0 };
     bool _connectedToICEServer { false };
 
     DomainType _type { DomainType::NonMetaverse };
@@ -73,6 +73,14 @@ public:
 
     bool hasCheckedIn() const { return _hasCheckedIn; }
     void setHasCheckedIn(bool hasCheckedIn) { _hasCheckedIn = hasCheckedIn; }
+
+    // the version of the domain's node list in which this node last changed
+    quint32 getListVersion() const { return _listVersion; }
+    void setListVersion(quint32 listVersion) { _listVersion = listVersion; }
+
+    // the version of the domain's node list this node last told us it has, zero if it needs a full list
+    quint32 getAcknowledgedListVersion() const { return _acknowledgedListVersion; }
+    void setAcknowledgedListVersion(quint32 listVersion) { _acknowledgedListVersion = listVersion; }
     
 private:
     QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
@@ -99,6 +107,9 @@ private:
     bool _wasAssigned { false };
 
     bool _hasCheckedIn { false };
+
+    quint32 _listVersion { 0 };
+    quint32 _acknowledgedListVersion { 0 };
 };
 
 #endif // hifi_DomainServerNodeData_h
@@ -1061,20 +1061,35 @@ static void scaleMatrix_4x4(float scale, float m[4][4]) {
 // Ambisonic to binaural render
 void AudioFOA::render(int16_t* input, float* output, int index, float qw, float qx, float qy, float qz, float gain, int numFrames) {
 
-    assert(index >= 0);
-    assert(index < FOA_TABLES);
     assert(numFrames == FOA_BLOCK);
 
-    ALIGN32 float fftBuffer[FOA_NFFT];          // in-place FFT buffer
-    ALIGN32 float accBuffer[2][FOA_NFFT] = {};  // binaural accumulation buffers
     ALIGN32 float inBuffer[4][FOA_BLOCK];       // deinterleaved input buffers
 
     float* in[4] = { inBuffer[0], inBuffer[1], inBuffer[2], inBuffer[3] };
-    float rotation[4][4];
 
     // convert input to deinterleaved float
     convertInput(input, in, FOA_GAIN, FOA_BLOCK);
 
+    renderBlock(in, output, index, qw, qx, qy, qz, gain);
+}
+
+void AudioFOA::render(float* input[4], float* output, int index, float qw, float qx, float qy, float qz, float gain, int numFrames) {
+
+    assert(numFrames == FOA_BLOCK);
+
+    renderBlock(input, output, index, qw, qx, qy, qz, gain * FOA_GAIN);
+}
+
+void AudioFOA::renderBlock(float* in[4], float* output, int index, float qw, float qx, float qy, float qz, float gain) {
+
+    assert(index >= 0);
+    assert(index < FOA_TABLES);
+
+    ALIGN32 float fftBuffer[FOA_NFFT];          // in-place FFT buffer
+    ALIGN32 float accBuffer[2][FOA_NFFT] = {};  // binaural accumulation buffers
+
+    float rotation[4][4];
+
     // convert quaternion to 4x4 rotation
     quatToMatrix_4x4(qw, qx, qy, qz, rotation);
 
@@ -40,10 +40,18 @@ public:
     //
     void render(int16_t* input, float* output, int index, float qw, float qx, float qy, float qz, float gain, int numFrames);
 
+    //
+    // Same as above, with input already deinterleaved and converted to float B-format (W, X, Y, Z),
+    // as produced by an encoder. The input buffers are rotated in place.
+    //
+    void render(float* input[4], float* output, int index, float qw, float qx, float qy, float qz, float gain, int numFrames);
+
 private:
     AudioFOA(const AudioFOA&) = delete;
     AudioFOA& operator=(const AudioFOA&) = delete;
 
+    void renderBlock(float* in[4], float* output, int index, float qw, float qx, float qy, float qz, float gain);
+
     // For best cache utilization when processing thousands of instances, only
     // the minimum persistant state is stored here. No coefs or work buffers.
 
@@ -16,6 +16,7 @@
 #include <assert.h>
 
 #include "AudioHRTFData.h"
+#include "AudioMixKernels.h"
 
 #if defined(_MSC_VER)
 #define ALIGN32 __declspec(align(32))
@@ -691,43 +692,6 @@ static void interpolate(const float* src0, const float* src1, float* dst, float
 
 #endif
 
-// apply gain crossfade with accumulation (interleaved)
-static void gainfade_1x2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
-
-    gain0 *= (1/32768.0f);  // int16_t to float
-    gain1 *= (1/32768.0f);
-
-    for (int i = 0; i < numFrames; i++) {
-
-        float frac = win[i];
-        float gain = gain1 + frac * (gain0 - gain1);
-
-        float x0 = (float)src[i] * gain;
-
-        dst[2*i+0] += x0;
-        dst[2*i+1] += x0;
-    }
-}
-
-// apply gain crossfade with accumulation (interleaved)
-static void gainfade_2x2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
-
-    gain0 *= (1/32768.0f);  // int16_t to float
-    gain1 *= (1/32768.0f);
-
-    for (int i = 0; i < numFrames; i++) {
-
-        float frac = win[i];
-        float gain = gain1 + frac * (gain0 - gain1);
-
-        float x0 = (float)src[2*i+0] * gain;
-        float x1 = (float)src[2*i+1] * gain;
-
-        dst[2*i+0] += x0;
-        dst[2*i+1] += x1;
-    }
-}
-
 // design a 2nd order Thiran allpass
 static void ThiranBiquad(float f, float& b0, float& b1, float& b2, float& a1, float& a2) {
 
@@ -1063,11 +1027,34 @@ static void setFilters(float firCoef[4][HRTF_TAPS], float bqCoef[5][8], int dela
 void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames,
                        float lpfDistance) {
 
-    assert(index >= 0);
-    assert(index < HRTF_TABLES);
     assert(numFrames == HRTF_BLOCK);
 
     ALIGN32 float in[HRTF_TAPS + HRTF_BLOCK];               // mono
+
+    // convert mono input to float
+    AudioMixKernels::int16ToFloat(input, &in[HRTF_TAPS], 1/32768.0f, HRTF_BLOCK);
+
+    renderBlock(in, output, index, azimuth, distance, gain, lpfDistance);
+}
+
+void AudioHRTF::render(const float* input, float* output, int index, float azimuth, float distance, float gain, int numFrames,
+                       float lpfDistance) {
+
+    assert(numFrames == HRTF_BLOCK);
+
+    ALIGN32 float in[HRTF_TAPS + HRTF_BLOCK];               // mono
+
+    memcpy(&in[HRTF_TAPS], input, HRTF_BLOCK * sizeof(float));
+
+    renderBlock(in, output, index, azimuth, distance, gain, lpfDistance);
+}
+
+void AudioHRTF::renderBlock(float* in, float* output, int index, float azimuth, float distance, float gain,
+                            float lpfDistance) {
+
+    assert(index >= 0);
+    assert(index < HRTF_TABLES);
+
     ALIGN32 float firCoef[4][HRTF_TAPS];                    // 4-channel
     ALIGN32 float firBuffer[4][HRTF_DELAY + HRTF_BLOCK];    // 4-channel
     ALIGN32 float bqCoef[5][8];                             // 4-channel (interleaved)
@@ -1101,11 +1088,6 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
     _gainState = gain;
     _lpfState = lpf;
 
-    // convert mono input to float
-    for (int i = 0; i < HRTF_BLOCK; i++) {
-        in[HRTF_TAPS+i] = (float)input[i] * (1/32768.0f);
-    }
-
     // FIR state update
     memcpy(in, _firState, HRTF_TAPS * sizeof(float));
     memcpy(_firState, &in[HRTF_BLOCK], HRTF_TAPS * sizeof(float));
@@ -1162,7 +1144,7 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
     _resetState = false;
 }
 
-void AudioHRTF::mixMono(int16_t* input, float* output, float gain, int numFrames) {
+void AudioHRTF::mixMono(const int16_t* input, float* output, float gain, int numFrames) {
 
     assert(numFrames == HRTF_BLOCK);
 
@@ -1175,7 +1157,7 @@ void AudioHRTF::mixMono(int16_t* input, float* output, float gain, int numFrames
     }
 
     // crossfade gain and accumulate
-    gainfade_1x2(input, output, crossfadeTable, _gainState, gain, HRTF_BLOCK);
+    AudioMixKernels::mixMonoToStereo(input, output, crossfadeTable, _gainState, gain, HRTF_BLOCK);
 
     // new parameters become old
     _gainState = gain;
@@ -1183,7 +1165,7 @@ void AudioHRTF::mixMono(int16_t* input, float* output, float gain, int numFrames
     _resetState = false;
 }
 
-void AudioHRTF::mixStereo(int16_t* input, float* output, float gain, int numFrames) {
+void AudioHRTF::mixStereo(const int16_t* input, float* output, float gain, int numFrames) {
 
     assert(numFrames == HRTF_BLOCK);
 
@@ -1196,7 +1178,7 @@ void AudioHRTF::mixStereo(int16_t* input, float* output, float gain, int numFram
     }
 
     // crossfade gain and accumulate
-    gainfade_2x2(input, output, crossfadeTable, _gainState, gain, HRTF_BLOCK);
+    AudioMixKernels::mixStereo(input, output, crossfadeTable, _gainState, gain, HRTF_BLOCK);
 
     // new parameters become old
     _gainState = gain;
@@ -58,11 +58,17 @@ public:
     void render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames,
                 float lpfDistance = LPF_DISTANCE_REF);
 
+    //
+    // Same as above, with mono input already converted to float (full scale is 1.0)
+    //
+    void render(const float* input, float* output, int index, float azimuth, float distance, float gain, int numFrames,
+                float lpfDistance = LPF_DISTANCE_REF);
+
     //
     // Non-spatialized direct mix (accumulates into existing output)
     //
-    void mixMono(int16_t* input, float* output, float gain, int numFrames);
-    void mixStereo(int16_t* input, float* output, float gain, int numFrames);
+    void mixMono(const int16_t* input, float* output, float gain, int numFrames);
+    void mixStereo(const int16_t* input, float* output, float gain, int numFrames);
 
     //
     // Fast path when input is known to be silent and state as been flushed
@@ -111,6 +117,9 @@ private:
     AudioHRTF(const AudioHRTF&) = delete;
     AudioHRTF& operator=(const AudioHRTF&) = delete;
 
+    // in: HRTF_TAPS of scratch followed by HRTF_BLOCK of float input
+    void renderBlock(float* in, float* output, int index, float azimuth, float distance, float gain, float lpfDistance);
+
     // SIMD channel assignmentS
     enum Channel {
         L0, R0,
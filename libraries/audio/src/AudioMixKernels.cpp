@@ -0,0 +1,229 @@
+//
+//  AudioMixKernels.cpp
+//  libraries/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixKernels.h"
+
+//
+// Portable code, also used for the tails of blocks that are not a multiple of the vector width
+//
+
+static void mixMonoToStereo_ref(const int16_t* src, float* dst, const float* win, float gain0, float gain1,
+                                int begin, int end) {
+
+    gain0 *= (1/32768.0f);  // int16_t to float
+    gain1 *= (1/32768.0f);
+
+    for (int i = begin; i < end; i++) {
+
+        float frac = win[i];
+        float gain = gain1 + frac * (gain0 - gain1);
+
+        float x0 = (float)src[i] * gain;
+
+        dst[2*i+0] += x0;
+        dst[2*i+1] += x0;
+    }
+}
+
+static void mixStereo_ref(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int begin, int end) {
+
+    gain0 *= (1/32768.0f);  // int16_t to float
+    gain1 *= (1/32768.0f);
+
+    for (int i = begin; i < end; i++) {
+
+        float frac = win[i];
+        float gain = gain1 + frac * (gain0 - gain1);
+
+        float x0 = (float)src[2*i+0] * gain;
+        float x1 = (float)src[2*i+1] * gain;
+
+        dst[2*i+0] += x0;
+        dst[2*i+1] += x1;
+    }
+}
+
+static void int16ToFloat_ref(const int16_t* src, float* dst, float gain, int begin, int end) {
+    for (int i = begin; i < end; i++) {
+        dst[i] = (float)src[i] * gain;
+    }
+}
+
+static bool isSilent_ref(const float* src, int begin, int end) {
+    for (int i = begin; i < end; i++) {
+        if (src[i] != 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+// sign-extend 4 int16_t to float
+static inline __m128 cvt_epi16lo_ps(__m128i x) {
+    return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+}
+
+static inline __m128 cvt_epi16hi_ps(__m128i x) {
+    return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16));
+}
+
+static void mixMonoToStereo_SSE(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    __m128 g1 = _mm_set1_ps(gain1 * (1/32768.0f));
+    __m128 dg = _mm_set1_ps((gain0 - gain1) * (1/32768.0f));
+
+    int i = 0;
+    for (; i + 4 <= numFrames; i += 4) {
+
+        __m128 gain = _mm_add_ps(g1, _mm_mul_ps(_mm_loadu_ps(&win[i]), dg));
+        __m128 x0 = _mm_mul_ps(cvt_epi16lo_ps(_mm_loadl_epi64((const __m128i*)&src[i])), gain);
+
+        // duplicate to left and right
+        __m128 d0 = _mm_unpacklo_ps(x0, x0);
+        __m128 d1 = _mm_unpackhi_ps(x0, x0);
+
+        _mm_storeu_ps(&dst[2*i+0], _mm_add_ps(_mm_loadu_ps(&dst[2*i+0]), d0));
+        _mm_storeu_ps(&dst[2*i+4], _mm_add_ps(_mm_loadu_ps(&dst[2*i+4]), d1));
+    }
+
+    mixMonoToStereo_ref(src, dst, win, gain0, gain1, i, numFrames);
+}
+
+static void mixStereo_SSE(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    __m128 g1 = _mm_set1_ps(gain1 * (1/32768.0f));
+    __m128 dg = _mm_set1_ps((gain0 - gain1) * (1/32768.0f));
+
+    int i = 0;
+    for (; i + 4 <= numFrames; i += 4) {
+
+        __m128 gain = _mm_add_ps(g1, _mm_mul_ps(_mm_loadu_ps(&win[i]), dg));
+
+        __m128i x = _mm_loadu_si128((const __m128i*)&src[2*i]);
+        __m128 x0 = _mm_mul_ps(cvt_epi16lo_ps(x), _mm_unpacklo_ps(gain, gain));
+        __m128 x1 = _mm_mul_ps(cvt_epi16hi_ps(x), _mm_unpackhi_ps(gain, gain));
+
+        _mm_storeu_ps(&dst[2*i+0], _mm_add_ps(_mm_loadu_ps(&dst[2*i+0]), x0));
+        _mm_storeu_ps(&dst[2*i+4], _mm_add_ps(_mm_loadu_ps(&dst[2*i+4]), x1));
+    }
+
+    mixStereo_ref(src, dst, win, gain0, gain1, i, numFrames);
+}
+
+static void int16ToFloat_SSE(const int16_t* src, float* dst, float gain, int numSamples) {
+
+    __m128 g = _mm_set1_ps(gain);
+
+    int i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+
+        __m128i x = _mm_loadu_si128((const __m128i*)&src[i]);
+
+        _mm_storeu_ps(&dst[i+0], _mm_mul_ps(cvt_epi16lo_ps(x), g));
+        _mm_storeu_ps(&dst[i+4], _mm_mul_ps(cvt_epi16hi_ps(x), g));
+    }
+
+    int16ToFloat_ref(src, dst, gain, i, numSamples);
+}
+
+static bool isSilent_SSE(const float* src, int numSamples) {
+
+    __m128 zero = _mm_setzero_ps();
+
+    int i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+
+        __m128 x0 = _mm_cmpneq_ps(_mm_loadu_ps(&src[i+0]), zero);
+        __m128 x1 = _mm_cmpneq_ps(_mm_loadu_ps(&src[i+4]), zero);
+
+        if (_mm_movemask_ps(_mm_or_ps(x0, x1))) {
+            return false;
+        }
+    }
+
+    return isSilent_ref(src, i, numSamples);
+}
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+void mixMonoToStereo_AVX2(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames);
+void mixStereo_AVX2(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames);
+void int16ToFloat_AVX2(const int16_t* src, float* dst, float gain, int numSamples);
+bool isSilent_AVX2(const float* src, int numSamples);
+
+void AudioMixKernels::mixMonoToStereo(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? mixMonoToStereo_AVX2 : mixMonoToStereo_SSE;
+    (*f)(src, dst, win, gain0, gain1, numFrames); // dispatch
+}
+
+void AudioMixKernels::mixStereo(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? mixStereo_AVX2 : mixStereo_SSE;
+    (*f)(src, dst, win, gain0, gain1, numFrames); // dispatch
+}
+
+void AudioMixKernels::int16ToFloat(const int16_t* src, float* dst, float gain, int numSamples) {
+    static auto f = cpuSupportsAVX2() ? int16ToFloat_AVX2 : int16ToFloat_SSE;
+    (*f)(src, dst, gain, numSamples); // dispatch
+}
+
+bool AudioMixKernels::isSilent(const float* src, int numSamples) {
+    static auto f = cpuSupportsAVX2() ? isSilent_AVX2 : isSilent_SSE;
+    return (*f)(src, numSamples); // dispatch
+}
+
+// the AVX2 kernels fall back to these for their tails
+void mixMonoToStereo_tail(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int begin, int end) {
+    mixMonoToStereo_ref(src, dst, win, gain0, gain1, begin, end);
+}
+
+void mixStereo_tail(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int begin, int end) {
+    mixStereo_ref(src, dst, win, gain0, gain1, begin, end);
+}
+
+void int16ToFloat_tail(const int16_t* src, float* dst, float gain, int begin, int end) {
+    int16ToFloat_ref(src, dst, gain, begin, end);
+}
+
+bool isSilent_tail(const float* src, int begin, int end) {
+    return isSilent_ref(src, begin, end);
+}
+
+#else   // portable reference code
+
+// the compiler is free to auto-vectorize these (e.g. NEON is baseline on aarch64)
+
+void AudioMixKernels::mixMonoToStereo(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+    mixMonoToStereo_ref(src, dst, win, gain0, gain1, 0, numFrames);
+}
+
+void AudioMixKernels::mixStereo(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+    mixStereo_ref(src, dst, win, gain0, gain1, 0, numFrames);
+}
+
+void AudioMixKernels::int16ToFloat(const int16_t* src, float* dst, float gain, int numSamples) {
+    int16ToFloat_ref(src, dst, gain, 0, numSamples);
+}
+
+bool AudioMixKernels::isSilent(const float* src, int numSamples) {
+    return isSilent_ref(src, 0, numSamples);
+}
+
+#endif
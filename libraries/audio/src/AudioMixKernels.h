@@ -0,0 +1,38 @@
+//
+//  AudioMixKernels.h
+//  libraries/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixKernels_h
+#define hifi_AudioMixKernels_h
+
+#include <stdint.h>
+
+//
+// Block kernels for the mixing paths that do not go through the HRTF.
+// On x86 these are dispatched at runtime to AVX2 or SSE2, elsewhere portable code is used.
+// Any numFrames/numSamples is supported, multiples of 8 take the fastest path.
+//
+namespace AudioMixKernels {
+
+// accumulate mono int16 input into interleaved stereo float output (int16 full scale is 1.0),
+// crossfading the gain from gain0 to gain1 with win (1.0 = all gain0, 0.0 = all gain1)
+void mixMonoToStereo(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames);
+
+// accumulate interleaved stereo int16 input into interleaved stereo float output, with the same gain crossfade
+void mixStereo(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames);
+
+// convert int16 samples to float, scaled by gain
+void int16ToFloat(const int16_t* src, float* dst, float gain, int numSamples);
+
+// true if every sample is zero
+bool isSilent(const float* src, int numSamples);
+
+}
+
+#endif // hifi_AudioMixKernels_h
@@ -11,7 +11,9 @@
 
 #include "PositionalAudioStream.h"
 #include "SharedUtil.h"
+#include "AudioMixKernels.h"
 
+#include <cassert>
 #include <cstring>
 
 #include <QtCore/QDataStream>
@@ -73,6 +75,19 @@ void PositionalAudioStream::updateLastPopOutputLoudnessAndTrailingLoudness() {
     }
 }
 
+void PositionalAudioStream::preRenderLastPopOutput() {
+    int numSamples = _ringBuffer.getNumFrameSamples();
+    assert(numSamples <= AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+
+    // copy the iterator, readSamples advances it
+    AudioRingBuffer::ConstIterator popOutput = _lastPopOutput;
+    popOutput.readSamples(_preRenderedSamples, numSamples);
+
+    if (!_isStereo) {
+        AudioMixKernels::int16ToFloat(_preRenderedSamples, _preRenderedFloatSamples, 1/32768.0f, numSamples);
+    }
+}
+
 int PositionalAudioStream::parsePositionalData(const QByteArray& positionalByteArray) {
     QDataStream packetStream(positionalByteArray);
 
@@ -59,6 +59,15 @@ public:
     float getLastPopOutputLoudness() const { return _lastPopOutputLoudness; }
     float getQuietestFrameLoudness() const { return _quietestFrameLoudness; }
 
+    // called from single AudioMixerWorker while processing packets for node, after a successful pop
+    // copies the last popped frame out of the ring buffer (and converts mono frames to float for the HRTF)
+    // so that every listener mixing this stream can share it
+    void preRenderLastPopOutput();
+
+    // thread-safe, called from AudioMixerWorker(s) while preparing mixes
+    const int16_t* getPreRenderedSamples() const { return _preRenderedSamples; }
+    const float* getPreRenderedFloatSamples() const { return _preRenderedFloatSamples; }
+
     bool shouldLoopbackForNode() const { return _shouldLoopbackForNode; }
     bool isStereo() const { return _isStereo; }
 
@@ -109,6 +118,10 @@ protected:
 
     bool _isIgnoreBoxEnabled { false };
     IgnoreBox _ignoreBox;
+
+    // last popped frame, shared by all listeners of this stream
+    int16_t _preRenderedSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO] {};
+    float _preRenderedFloatSamples[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] {};
 };
 
 #endif // hifi_PositionalAudioStream_h
@@ -0,0 +1,107 @@
+//
+//  AudioMixKernels_avx2.cpp
+//  libraries/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <stdint.h>
+#include <immintrin.h>
+
+void mixMonoToStereo_tail(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int begin, int end);
+void mixStereo_tail(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int begin, int end);
+void int16ToFloat_tail(const int16_t* src, float* dst, float gain, int begin, int end);
+bool isSilent_tail(const float* src, int begin, int end);
+
+// sign-extend 8 int16_t to float
+static inline __m256 cvt_epi16_ps(const int16_t* src) {
+    return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)src)));
+}
+
+void mixMonoToStereo_AVX2(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    __m256 g1 = _mm256_set1_ps(gain1 * (1/32768.0f));
+    __m256 dg = _mm256_set1_ps((gain0 - gain1) * (1/32768.0f));
+
+    int i = 0;
+    for (; i + 8 <= numFrames; i += 8) {
+
+        __m256 gain = _mm256_fmadd_ps(_mm256_loadu_ps(&win[i]), dg, g1);
+        __m256 x0 = _mm256_mul_ps(cvt_epi16_ps(&src[i]), gain);
+
+        // duplicate to left and right, then undo the lane split
+        __m256 t0 = _mm256_unpacklo_ps(x0, x0);
+        __m256 t1 = _mm256_unpackhi_ps(x0, x0);
+        __m256 d0 = _mm256_permute2f128_ps(t0, t1, 0x20);
+        __m256 d1 = _mm256_permute2f128_ps(t0, t1, 0x31);
+
+        _mm256_storeu_ps(&dst[2*i+0], _mm256_add_ps(_mm256_loadu_ps(&dst[2*i+0]), d0));
+        _mm256_storeu_ps(&dst[2*i+8], _mm256_add_ps(_mm256_loadu_ps(&dst[2*i+8]), d1));
+    }
+
+    mixMonoToStereo_tail(src, dst, win, gain0, gain1, i, numFrames);
+}
+
+void mixStereo_AVX2(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    __m256 g1 = _mm256_set1_ps(gain1 * (1/32768.0f));
+    __m256 dg = _mm256_set1_ps((gain0 - gain1) * (1/32768.0f));
+
+    int i = 0;
+    for (; i + 8 <= numFrames; i += 8) {
+
+        __m256 gain = _mm256_fmadd_ps(_mm256_loadu_ps(&win[i]), dg, g1);
+
+        // per-frame gain, duplicated for left and right
+        __m256 t0 = _mm256_unpacklo_ps(gain, gain);
+        __m256 t1 = _mm256_unpackhi_ps(gain, gain);
+        __m256 g0 = _mm256_permute2f128_ps(t0, t1, 0x20);
+        __m256 g2 = _mm256_permute2f128_ps(t0, t1, 0x31);
+
+        __m256 x0 = _mm256_mul_ps(cvt_epi16_ps(&src[2*i+0]), g0);
+        __m256 x1 = _mm256_mul_ps(cvt_epi16_ps(&src[2*i+8]), g2);
+
+        _mm256_storeu_ps(&dst[2*i+0], _mm256_add_ps(_mm256_loadu_ps(&dst[2*i+0]), x0));
+        _mm256_storeu_ps(&dst[2*i+8], _mm256_add_ps(_mm256_loadu_ps(&dst[2*i+8]), x1));
+    }
+
+    mixStereo_tail(src, dst, win, gain0, gain1, i, numFrames);
+}
+
+void int16ToFloat_AVX2(const int16_t* src, float* dst, float gain, int numSamples) {
+
+    __m256 g = _mm256_set1_ps(gain);
+
+    int i = 0;
+    for (; i + 16 <= numSamples; i += 16) {
+        _mm256_storeu_ps(&dst[i+0], _mm256_mul_ps(cvt_epi16_ps(&src[i+0]), g));
+        _mm256_storeu_ps(&dst[i+8], _mm256_mul_ps(cvt_epi16_ps(&src[i+8]), g));
+    }
+
+    int16ToFloat_tail(src, dst, gain, i, numSamples);
+}
+
+bool isSilent_AVX2(const float* src, int numSamples) {
+
+    __m256 zero = _mm256_setzero_ps();
+
+    int i = 0;
+    for (; i + 16 <= numSamples; i += 16) {
+
+        __m256 x0 = _mm256_cmp_ps(_mm256_loadu_ps(&src[i+0]), zero, _CMP_NEQ_UQ);
+        __m256 x1 = _mm256_cmp_ps(_mm256_loadu_ps(&src[i+8]), zero, _CMP_NEQ_UQ);
+
+        if (_mm256_movemask_ps(_mm256_or_ps(x0, x1))) {
+            return false;
+        }
+    }
+
+    return isSilent_tail(src, i, numSamples);
+}
+
+#endif
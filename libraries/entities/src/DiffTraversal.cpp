@@ -11,9 +11,10 @@
 
 #include "DiffTraversal.h"
 
-#include <OctreeUtils.h>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtCore/QThreadPool>
 
-#include "EntityPriorityQueue.h"
+#include <OctreeUtils.h>
 
 DiffTraversal::Waypoint::Waypoint(EntityTreeElementPointer& element) : _nextIndex(0) {
     assert(element);
@@ -208,7 +209,8 @@ DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View
     //        updates VisibleElement ref argument with pointer-to-element and view-intersection
     //        (INSIDE, INTERSECT, or OUTSIDE)
     //
-    // external code should update the _scanElementCallback after calling prepareNewTraversal
+    // external code should update the _scanElementCallback after calling prepareNewTraversal,
+    // and may set a _parallelScanElementCallback for a First traversal
     //
 
     Type type;
@@ -241,6 +243,8 @@ DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View
 
     _currentView.startTime = usecTimestampNow();
 
+    _type = type;
+    _parallelScanElementCallback = nullptr;
     return type;
 }
 
@@ -297,3 +301,79 @@ void DiffTraversal::traverse(uint64_t timeBudget) {
         getNextVisibleElement(next);
     }
 }
+
+bool DiffTraversal::canTraverseInParallel() const {
+    // only a First traversal that hasn't started yet: the others are cheap and stay time-budgeted
+    return _type == Type::First && _parallelScanElementCallback && _path.size() == 1 &&
+        _path.back().getNextIndex() == -1 && QThreadPool::globalInstance()->maxThreadCount() > 1;
+}
+
+void DiffTraversal::traverseInParallel(std::vector<PrioritizedEntity>& results) {
+    assert(canTraverseInParallel());
+    EntityTreeElementPointer root = _path.back().getElement();
+    if (!root) {
+        _path.clear();
+        return;
+    }
+
+    // fan out from the root until there are enough subtrees to keep the pool busy,
+    // scanning the elements above them on this thread
+    const size_t MIN_NUM_SUBTREES = 4 * QThreadPool::globalInstance()->maxThreadCount();
+    const int MAX_FAN_OUT_DEPTH = 3;
+    std::vector<EntityTreeElementPointer> level { root };
+    DiffTraversal::VisibleElement next;
+    for (int depth = 0; depth < MAX_FAN_OUT_DEPTH && !level.empty() && level.size() < MIN_NUM_SUBTREES; ++depth) {
+        std::vector<EntityTreeElementPointer> nextLevel;
+        for (const auto& element : level) {
+            // like the serial traversal, the root is never culled
+            if (element->hasContent()) {
+                next.element = element;
+                _parallelScanElementCallback(next, results);
+            }
+            for (int32_t i = 0; i < NUMBER_OF_CHILDREN; ++i) {
+                EntityTreeElementPointer child = element->getChildAtIndex(i);
+                if (child && _currentView.shouldTraverseElement(*child)) {
+                    nextLevel.push_back(child);
+                }
+            }
+        }
+        level.swap(nextLevel);
+    }
+
+    struct Subtree {
+        EntityTreeElementPointer root;
+        std::vector<PrioritizedEntity> results;
+    };
+    std::vector<Subtree> subtrees;
+    subtrees.reserve(level.size());
+    for (auto& element : level) {
+        subtrees.push_back({ std::move(element), {} });
+    }
+    QtConcurrent::blockingMap(subtrees, [this](Subtree& subtree) {
+        scanSubtreeInParallel(subtree.root, subtree.results);
+    });
+
+    for (auto& subtree : subtrees) {
+        results.insert(results.end(), std::make_move_iterator(subtree.results.begin()),
+            std::make_move_iterator(subtree.results.end()));
+    }
+
+    // we've traversed the entire tree
+    _path.clear();
+    _completedView = _currentView;
+}
+
+void DiffTraversal::scanSubtreeInParallel(const EntityTreeElementPointer& element,
+                                          std::vector<PrioritizedEntity>& results) const {
+    if (element->hasContent()) {
+        DiffTraversal::VisibleElement next;
+        next.element = element;
+        _parallelScanElementCallback(next, results);
+    }
+    for (int32_t i = 0; i < NUMBER_OF_CHILDREN; ++i) {
+        EntityTreeElementPointer child = element->getChildAtIndex(i);
+        if (child && _currentView.shouldTraverseElement(*child)) {
+            scanSubtreeInParallel(child, results);
+        }
+    }
+}
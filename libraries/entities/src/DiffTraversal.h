@@ -14,6 +14,7 @@
 
 #include <shared/ConicalViewFrustum.h>
 
+#include "EntityPriorityQueue.h"
 #include "EntityTreeElement.h"
 
 // DiffTraversal traverses the tree and applies _scanElementCallback on elements it finds
@@ -51,6 +52,7 @@ public:
 
         int8_t getNextIndex() const { return _nextIndex; }
         void initRootNextIndex() { _nextIndex = -1; }
+        EntityTreeElementPointer getElement() const { return _weakElement.lock(); }
 
     protected:
         EntityTreeElementWeakPointer _weakElement;
@@ -59,6 +61,9 @@ public:
 
     typedef enum { First, Repeat, Differential } Type;
 
+    // ParallelScanCallback is called from worker threads, and adds the entities of the element to send to results
+    using ParallelScanCallback = std::function<void (VisibleElement&, std::vector<PrioritizedEntity>&)>;
+
     DiffTraversal();
 
     Type prepareNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root, bool forceFirstPass = false);
@@ -71,16 +76,25 @@ public:
     void setScanCallback(std::function<void (VisibleElement&)> cb);
     void traverse(uint64_t timeBudget);
 
+    // A First traversal with a ParallelScanCallback can be done in one go across the global thread pool,
+    // rather than in time-budgeted steps.
+    void setParallelScanCallback(ParallelScanCallback cb) { _parallelScanElementCallback = cb; }
+    bool canTraverseInParallel() const;
+    void traverseInParallel(std::vector<PrioritizedEntity>& results);
+
     void reset() { _path.clear(); _completedView.startTime = 0; } // resets our state to force a new "First" traversal
 
 private:
     void getNextVisibleElement(VisibleElement& next);
+    void scanSubtreeInParallel(const EntityTreeElementPointer& element, std::vector<PrioritizedEntity>& results) const;
 
     View _currentView;
     View _completedView;
     std::vector<Waypoint> _path;
     std::function<void (VisibleElement&)> _getNextVisibleElementCallback { nullptr };
     std::function<void (VisibleElement&)> _scanElementCallback { [](VisibleElement& e){} };
+    ParallelScanCallback _parallelScanElementCallback { nullptr };
+    Type _type { First };
 };
 
 #endif // hifi_EntityPriorityQueue_h
@@ -0,0 +1,459 @@
+//
+//  EntityBVH.cpp
+//  libraries/entities/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityBVH.h"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+
+const int NUM_SAH_BINS = 12;
+const int32_t MAX_LEAF_SIZE = 4;
+const int MIN_PENDING_FOR_REBUILD = 64;
+
+static float halfSurfaceArea(const glm::vec3& minimum, const glm::vec3& maximum) {
+    glm::vec3 extent = glm::max(maximum - minimum, glm::vec3(0.0f));
+    return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+}
+
+static bool boxesTouch(const glm::vec3& minimum, const glm::vec3& maximum, const glm::vec3& otherMinimum,
+                       const glm::vec3& otherMaximum) {
+    return maximum.x >= otherMinimum.x && minimum.x <= otherMaximum.x &&
+        maximum.y >= otherMinimum.y && minimum.y <= otherMaximum.y &&
+        maximum.z >= otherMinimum.z && minimum.z <= otherMaximum.z;
+}
+
+void EntityBVH::insert(const EntityItemPointer& entity, const AABox& bounds) {
+    Item newItem { bounds.getMinimumPoint(), bounds.getMaximumPoint(), entity };
+    EntityItemID entityID = entity->getEntityItemID();
+
+    QWriteLocker locker(&_lock);
+    auto itemItr = _itemIndices.find(entityID);
+    if (itemItr != _itemIndices.end()) {
+        Item& item = _items[itemItr.value()];
+        if (!item.entity) {
+            --_numRemoved;
+        }
+        item = std::move(newItem);
+        refit(_itemLeaves[itemItr.value()]);
+        ++_numRefits;
+        return;
+    }
+
+    auto pendingItr = _pendingIndices.find(entityID);
+    if (pendingItr != _pendingIndices.end()) {
+        _pending[pendingItr.value()] = std::move(newItem);
+    } else {
+        _pendingIndices.insert(entityID, (int32_t)_pending.size());
+        _pending.push_back(std::move(newItem));
+    }
+}
+
+void EntityBVH::remove(const EntityItemID& entityID) {
+    QWriteLocker locker(&_lock);
+    auto itemItr = _itemIndices.find(entityID);
+    if (itemItr != _itemIndices.end()) {
+        // keep the index, so that an entity removed while it changes element is refit rather than re-added
+        Item& item = _items[itemItr.value()];
+        if (item.entity) {
+            item.entity.reset();
+            ++_numRemoved;
+        }
+        return;
+    }
+
+    auto pendingItr = _pendingIndices.find(entityID);
+    if (pendingItr != _pendingIndices.end()) {
+        int32_t index = pendingItr.value();
+        _pendingIndices.erase(pendingItr);
+        if (index != (int32_t)_pending.size() - 1) {
+            _pending[index] = std::move(_pending.back());
+            _pendingIndices[_pending[index].entity->getEntityItemID()] = index;
+        }
+        _pending.pop_back();
+    }
+}
+
+void EntityBVH::clear() {
+    QWriteLocker locker(&_lock);
+    _nodes.clear();
+    _parents.clear();
+    _items.clear();
+    _itemLeaves.clear();
+    _itemIndices.clear();
+    _pending.clear();
+    _pendingIndices.clear();
+    _numRemoved = 0;
+    _numRefits = 0;
+}
+
+EntityBVH::Stats EntityBVH::getStats() const {
+    QReadLocker locker(&_lock);
+    Stats stats;
+    stats.numEntities = (int)(_items.size() + _pending.size()) - _numRemoved;
+    stats.numNodes = (int)_nodes.size();
+    stats.numPending = (int)_pending.size();
+    stats.numRemoved = _numRemoved;
+    stats.numRebuilds = _numRebuilds;
+    stats.numRefits = _numRefits;
+    return stats;
+}
+
+void EntityBVH::prepareForQuery() {
+    {
+        QReadLocker locker(&_lock);
+        if (!needsRebuild()) {
+            return;
+        }
+    }
+    QWriteLocker locker(&_lock);
+    if (needsRebuild()) {
+        rebuild();
+    }
+}
+
+bool EntityBVH::needsRebuild() const {
+    int numItems = (int)_items.size() - _numRemoved;
+    return (int)_pending.size() > std::max(MIN_PENDING_FOR_REBUILD, numItems / 16) ||
+        (_numRemoved > 0 && _numRemoved > numItems / 4) ||
+        _numRefits > 2 * std::max(MIN_PENDING_FOR_REBUILD, numItems);
+}
+
+void EntityBVH::rebuild() {
+    std::vector<Item> items;
+    items.reserve(_items.size() - _numRemoved + _pending.size());
+    for (Item& item : _items) {
+        if (item.entity) {
+            items.push_back(std::move(item));
+        }
+    }
+    for (Item& item : _pending) {
+        items.push_back(std::move(item));
+    }
+    _pending.clear();
+    _pendingIndices.clear();
+    _numRemoved = 0;
+    _numRefits = 0;
+    ++_numRebuilds;
+
+    int32_t numItems = (int32_t)items.size();
+    _nodes.clear();
+    _parents.clear();
+    _itemLeaves.assign(numItems, 0);
+    _nodes.reserve(2 * numItems);
+    _parents.reserve(2 * numItems);
+
+    class Bin {
+    public:
+        glm::vec3 minimum { FLT_MAX };
+        glm::vec3 maximum { -FLT_MAX };
+        int32_t count { 0 };
+    };
+
+    class BuildTask {
+    public:
+        int32_t node;
+        int32_t begin;
+        int32_t end;
+    };
+
+    std::vector<BuildTask> tasks;
+    if (numItems > 0) {
+        _nodes.emplace_back();
+        _parents.push_back(-1);
+        tasks.push_back({ 0, 0, numItems });
+    }
+
+    while (!tasks.empty()) {
+        BuildTask task = tasks.back();
+        tasks.pop_back();
+
+        glm::vec3 minimum(FLT_MAX);
+        glm::vec3 maximum(-FLT_MAX);
+        glm::vec3 centroidMinimum(FLT_MAX);
+        glm::vec3 centroidMaximum(-FLT_MAX);
+        for (int32_t i = task.begin; i < task.end; ++i) {
+            const Item& item = items[i];
+            minimum = glm::min(minimum, item.minimum);
+            maximum = glm::max(maximum, item.maximum);
+            glm::vec3 centroid = 0.5f * (item.minimum + item.maximum);
+            centroidMinimum = glm::min(centroidMinimum, centroid);
+            centroidMaximum = glm::max(centroidMaximum, centroid);
+        }
+        _nodes[task.node].minimum = minimum;
+        _nodes[task.node].maximum = maximum;
+
+        int32_t count = task.end - task.begin;
+        if (count <= MAX_LEAF_SIZE) {
+            _nodes[task.node].first = task.begin;
+            _nodes[task.node].count = count;
+            for (int32_t i = task.begin; i < task.end; ++i) {
+                _itemLeaves[i] = task.node;
+            }
+            continue;
+        }
+
+        // bin the centroids along the longest axis and split where the surface area heuristic is cheapest
+        int32_t middle = task.begin;
+        glm::vec3 centroidExtent = centroidMaximum - centroidMinimum;
+        int axis = centroidExtent.x > centroidExtent.y ? (centroidExtent.x > centroidExtent.z ? 0 : 2) :
+            (centroidExtent.y > centroidExtent.z ? 1 : 2);
+        if (centroidExtent[axis] > 0.0f) {
+            float binScale = NUM_SAH_BINS / centroidExtent[axis];
+            float binOffset = centroidMinimum[axis];
+            auto getBin = [&](const Item& item) {
+                float centroid = 0.5f * (item.minimum[axis] + item.maximum[axis]);
+                return std::min((int)((centroid - binOffset) * binScale), NUM_SAH_BINS - 1);
+            };
+
+            std::array<Bin, NUM_SAH_BINS> bins;
+            for (int32_t i = task.begin; i < task.end; ++i) {
+                Bin& bin = bins[getBin(items[i])];
+                bin.minimum = glm::min(bin.minimum, items[i].minimum);
+                bin.maximum = glm::max(bin.maximum, items[i].maximum);
+                ++bin.count;
+            }
+
+            std::array<float, NUM_SAH_BINS> rightCosts;
+            Bin right;
+            for (int i = NUM_SAH_BINS - 1; i > 0; --i) {
+                right.minimum = glm::min(right.minimum, bins[i].minimum);
+                right.maximum = glm::max(right.maximum, bins[i].maximum);
+                right.count += bins[i].count;
+                rightCosts[i] = right.count * halfSurfaceArea(right.minimum, right.maximum);
+            }
+
+            float bestCost = FLT_MAX;
+            int bestSplit = 0;
+            Bin left;
+            for (int i = 1; i < NUM_SAH_BINS; ++i) {
+                left.minimum = glm::min(left.minimum, bins[i - 1].minimum);
+                left.maximum = glm::max(left.maximum, bins[i - 1].maximum);
+                left.count += bins[i - 1].count;
+                if (left.count == 0 || left.count == count) {
+                    continue;
+                }
+                float cost = left.count * halfSurfaceArea(left.minimum, left.maximum) + rightCosts[i];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestSplit = i;
+                }
+            }
+
+            if (bestSplit > 0) {
+                auto partition = std::partition(items.begin() + task.begin, items.begin() + task.end,
+                    [&](const Item& item) { return getBin(item) < bestSplit; });
+                middle = (int32_t)(partition - items.begin());
+            }
+        }
+        if (middle <= task.begin || middle >= task.end) {
+            // the centroids all coincide, split evenly
+            middle = task.begin + count / 2;
+        }
+
+        int32_t children = (int32_t)_nodes.size();
+        _nodes.emplace_back();
+        _nodes.emplace_back();
+        _parents.push_back(task.node);
+        _parents.push_back(task.node);
+        _nodes[task.node].first = children;
+        _nodes[task.node].count = 0;
+        tasks.push_back({ children, task.begin, middle });
+        tasks.push_back({ children + 1, middle, task.end });
+    }
+
+    _items = std::move(items);
+    _itemIndices.clear();
+    _itemIndices.reserve(numItems);
+    for (int32_t i = 0; i < numItems; ++i) {
+        _itemIndices.insert(_items[i].entity->getEntityItemID(), i);
+    }
+}
+
+void EntityBVH::refit(int32_t nodeIndex) {
+    Node& leaf = _nodes[nodeIndex];
+    leaf.minimum = glm::vec3(FLT_MAX);
+    leaf.maximum = glm::vec3(-FLT_MAX);
+    for (int32_t i = leaf.first; i < leaf.first + leaf.count; ++i) {
+        if (_items[i].entity) {
+            leaf.minimum = glm::min(leaf.minimum, _items[i].minimum);
+            leaf.maximum = glm::max(leaf.maximum, _items[i].maximum);
+        }
+    }
+
+    for (int32_t parent = _parents[nodeIndex]; parent != -1; parent = _parents[parent]) {
+        Node& node = _nodes[parent];
+        const Node& firstChild = _nodes[node.first];
+        const Node& secondChild = _nodes[node.first + 1];
+        node.minimum = glm::min(firstChild.minimum, secondChild.minimum);
+        node.maximum = glm::max(firstChild.maximum, secondChild.maximum);
+    }
+}
+
+template <typename NodeTest, typename ItemTest>
+void EntityBVH::findAll(NodeTest nodeTest, ItemTest itemTest, std::vector<EntityItemPointer>& found) {
+    prepareForQuery();
+
+    QReadLocker locker(&_lock);
+    for (const Item& item : _pending) {
+        if (itemTest(item.minimum, item.maximum)) {
+            found.push_back(item.entity);
+        }
+    }
+
+    if (_nodes.empty()) {
+        return;
+    }
+    std::vector<int32_t> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        stack.pop_back();
+        if (!nodeTest(node.minimum, node.maximum)) {
+            continue;
+        }
+        if (node.count > 0) {
+            for (int32_t i = node.first; i < node.first + node.count; ++i) {
+                const Item& item = _items[i];
+                if (item.entity && itemTest(item.minimum, item.maximum)) {
+                    found.push_back(item.entity);
+                }
+            }
+        } else {
+            stack.push_back(node.first + 1);
+            stack.push_back(node.first);
+        }
+    }
+}
+
+template <typename NodeDistance>
+void EntityBVH::forEachInOrder(NodeDistance nodeDistance, const float& maxDistance, const Visitor& visitor) {
+    prepareForQuery();
+
+    QReadLocker locker(&_lock);
+    float distance;
+    for (const Item& item : _pending) {
+        if (nodeDistance(item.minimum, item.maximum, distance) && distance <= maxDistance) {
+            visitor(item.entity);
+        }
+    }
+
+    if (_nodes.empty() || !nodeDistance(_nodes[0].minimum, _nodes[0].maximum, distance)) {
+        return;
+    }
+    // depth first, nearer child first, dropping any node that is farther than the nearest hit so far
+    std::vector<std::pair<float, int32_t>> stack;
+    stack.reserve(64);
+    stack.emplace_back(distance, 0);
+    while (!stack.empty()) {
+        std::pair<float, int32_t> entry = stack.back();
+        stack.pop_back();
+        if (entry.first > maxDistance) {
+            continue;
+        }
+        const Node& node = _nodes[entry.second];
+        if (node.count > 0) {
+            for (int32_t i = node.first; i < node.first + node.count; ++i) {
+                const Item& item = _items[i];
+                if (item.entity && nodeDistance(item.minimum, item.maximum, distance) && distance <= maxDistance) {
+                    visitor(item.entity);
+                }
+            }
+            continue;
+        }
+
+        float firstDistance;
+        float secondDistance;
+        bool firstHit = nodeDistance(_nodes[node.first].minimum, _nodes[node.first].maximum, firstDistance);
+        bool secondHit = nodeDistance(_nodes[node.first + 1].minimum, _nodes[node.first + 1].maximum, secondDistance);
+        if (firstHit && secondHit) {
+            if (firstDistance <= secondDistance) {
+                stack.emplace_back(secondDistance, node.first + 1);
+                stack.emplace_back(firstDistance, node.first);
+            } else {
+                stack.emplace_back(firstDistance, node.first);
+                stack.emplace_back(secondDistance, node.first + 1);
+            }
+        } else if (firstHit) {
+            stack.emplace_back(firstDistance, node.first);
+        } else if (secondHit) {
+            stack.emplace_back(secondDistance, node.first + 1);
+        }
+    }
+}
+
+void EntityBVH::findInBox(const AABox& box, std::vector<EntityItemPointer>& found) {
+    glm::vec3 boxMinimum = box.getMinimumPoint();
+    glm::vec3 boxMaximum = box.getMaximumPoint();
+    auto touchesBox = [&](const glm::vec3& minimum, const glm::vec3& maximum) {
+        return boxesTouch(minimum, maximum, boxMinimum, boxMaximum);
+    };
+    findAll(touchesBox, touchesBox, found);
+}
+
+void EntityBVH::findInSphere(const glm::vec3& center, float radius, std::vector<EntityItemPointer>& found) {
+    float radiusSquared = radius * radius;
+    auto touchesSphere = [&](const glm::vec3& minimum, const glm::vec3& maximum) {
+        glm::vec3 offset = glm::clamp(center, minimum, maximum) - center;
+        return glm::dot(offset, offset) <= radiusSquared;
+    };
+    findAll(touchesSphere, touchesSphere, found);
+}
+
+void EntityBVH::findInFrustum(const ViewFrustum& frustum, std::vector<EntityItemPointer>& found) {
+    auto inFrustum = [&](const glm::vec3& minimum, const glm::vec3& maximum) {
+        if (minimum.x > maximum.x) {
+            return false; // a leaf whose items have all been removed
+        }
+        AABox box(minimum, maximum - minimum);
+        return frustum.boxIntersectsFrustum(box) || frustum.boxIntersectsKeyhole(box);
+    };
+    findAll(inFrustum, inFrustum, found);
+}
+
+void EntityBVH::forEachAlongRay(const glm::vec3& origin, const glm::vec3& direction, const float& maxDistance,
+                                const Visitor& visitor) {
+    glm::vec3 invDirection(direction.x == 0.0f ? FLT_MAX : 1.0f / direction.x,
+                           direction.y == 0.0f ? FLT_MAX : 1.0f / direction.y,
+                           direction.z == 0.0f ? FLT_MAX : 1.0f / direction.z);
+    auto rayDistance = [&](const glm::vec3& minimum, const glm::vec3& maximum, float& distance) {
+        if (minimum.x > maximum.x) {
+            return false;
+        }
+        glm::vec3 minimumDistances = (minimum - origin) * invDirection;
+        glm::vec3 maximumDistances = (maximum - origin) * invDirection;
+        glm::vec3 entry = glm::min(minimumDistances, maximumDistances);
+        glm::vec3 exit = glm::max(minimumDistances, maximumDistances);
+        float entryDistance = glm::max(glm::max(entry.x, entry.y), glm::max(entry.z, 0.0f));
+        float exitDistance = glm::min(glm::min(exit.x, exit.y), exit.z);
+        distance = entryDistance;
+        return entryDistance <= exitDistance;
+    };
+    forEachInOrder(rayDistance, maxDistance, visitor);
+}
+
+void EntityBVH::forEachAlongParabola(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
+                                     const float& maxDistance, const Visitor& visitor) {
+    auto parabolaDistance = [&](const glm::vec3& minimum, const glm::vec3& maximum, float& distance) {
+        if (minimum.x > maximum.x) {
+            return false;
+        }
+        AABox box(minimum, maximum - minimum);
+        if (box.contains(origin)) {
+            distance = 0.0f;
+            return true;
+        }
+        BoxFace face;
+        glm::vec3 surfaceNormal;
+        return box.findParabolaIntersection(origin, velocity, acceleration, distance, face, surfaceNormal);
+    };
+    forEachInOrder(parabolaDistance, maxDistance, visitor);
+}
@@ -0,0 +1,107 @@
+//
+//  EntityBVH.h
+//  libraries/entities/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityBVH_h
+#define hifi_EntityBVH_h
+
+#include <functional>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QReadWriteLock>
+
+#include <AABox.h>
+#include <ViewFrustum.h>
+
+#include "EntityItem.h"
+
+// EntityBVH is a flat bounding volume hierarchy over the entities of an EntityTree, which the tree's spatial queries
+// and picks can use instead of recursing the octree.
+//
+// Each entity is bounded by the cube of the octree element containing it, so the BVH finds a superset of what the
+// octree recursion finds and only has to change when an entity changes element.  Entities that change element are
+// refit in place; new entities are kept in a small unsorted list until the next query that finds enough of them to
+// be worth rebuilding the hierarchy, which is built with a binned surface area heuristic.
+//
+// Queries return candidates; callers still test each entity's own bounds.  All the methods are thread safe.
+class EntityBVH {
+public:
+    using Visitor = std::function<void(const EntityItemPointer&)>;
+
+    class Stats {
+    public:
+        int numEntities { 0 };
+        int numNodes { 0 };
+        int numPending { 0 };
+        int numRemoved { 0 };
+        int numRebuilds { 0 };
+        int numRefits { 0 };
+    };
+
+    // Adds the entity with the given bounds, or refits it if it is already in the BVH.
+    void insert(const EntityItemPointer& entity, const AABox& bounds);
+    void remove(const EntityItemID& entityID);
+    void clear();
+
+    void findInBox(const AABox& box, std::vector<EntityItemPointer>& found);
+    void findInSphere(const glm::vec3& center, float radius, std::vector<EntityItemPointer>& found);
+    void findInFrustum(const ViewFrustum& frustum, std::vector<EntityItemPointer>& found);
+
+    // Visits the entities whose bounds the ray or parabola crosses, nearest bounds first, skipping any that are farther
+    // than maxDistance.  maxDistance is read again after each visit so the visitor can narrow the search as it hits.
+    void forEachAlongRay(const glm::vec3& origin, const glm::vec3& direction, const float& maxDistance, const Visitor& visitor);
+    void forEachAlongParabola(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
+                              const float& maxDistance, const Visitor& visitor);
+
+    Stats getStats() const;
+
+private:
+    class Node {
+    public:
+        glm::vec3 minimum;
+        int32_t first { 0 }; // first item if count > 0, otherwise first of the two children
+        glm::vec3 maximum;
+        int32_t count { 0 };
+    };
+
+    class Item {
+    public:
+        glm::vec3 minimum;
+        glm::vec3 maximum;
+        EntityItemPointer entity;
+    };
+
+    void prepareForQuery();
+    bool needsRebuild() const;
+    void rebuild();
+    void refit(int32_t nodeIndex);
+
+    template <typename NodeTest, typename ItemTest>
+    void findAll(NodeTest nodeTest, ItemTest itemTest, std::vector<EntityItemPointer>& found);
+    template <typename NodeDistance>
+    void forEachInOrder(NodeDistance nodeDistance, const float& maxDistance, const Visitor& visitor);
+
+    mutable QReadWriteLock _lock;
+
+    std::vector<Node> _nodes;
+    std::vector<int32_t> _parents;
+    std::vector<Item> _items; // removed items have a null entity until the next rebuild
+    std::vector<int32_t> _itemLeaves;
+    QHash<EntityItemID, int32_t> _itemIndices;
+
+    std::vector<Item> _pending;
+    QHash<EntityItemID, int32_t> _pendingIndices;
+
+    int _numRemoved { 0 };
+    int _numRefits { 0 };
+    int _numRebuilds { 0 };
+};
+
+#endif // hifi_EntityBVH_h
@@ -0,0 +1,513 @@
+//
+//  EntitySnapshot.cpp
+//  libraries/entities/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySnapshot.h"
+
+#include <atomic>
+#include <cstring>
+#include <limits>
+
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+
+#include "EntitiesLogging.h"
+#include "EntityTree.h"
+
+namespace {
+
+enum Section {
+    IDS = 0,
+    TYPES,
+    FLAGS,
+    PARENT_IDS,
+    CREATED,
+    POSITIONS,
+    ROTATIONS,
+    DIMENSIONS,
+    NAMES,
+    SCRIPTS,
+    SERVER_SCRIPTS,
+    MODEL_URLS,
+    PROPERTY_OFFSETS,
+    PROPERTY_DATA,
+    STRING_OFFSETS,
+    STRING_DATA,
+    JSON_ENTITIES,
+    NAMED_PATHS,
+    NUM_SECTIONS
+};
+
+struct SectionRange {
+    quint64 offset;
+    quint64 size;
+};
+
+struct FileHeader {
+    OctreeUtils::SnapshotHeader snapshot;
+    quint64 numEntities;
+    quint64 numStrings;
+    SectionRange sections[NUM_SECTIONS];
+};
+
+const int SECTION_ALIGNMENT = 8;
+const int UUID_SIZE = 16;
+
+enum RowFlag : quint8 {
+    VISIBLE_IN_SECONDARY_CAMERA = 1
+};
+
+// rows are encoded and decoded a few hundred at a time, to keep the thread pool overhead low
+const size_t ROWS_PER_TASK = 256;
+
+// most entities fit the first buffer, the second one fits any entity accepted by canEncode
+const int DEFAULT_ENCODE_BUFFER_SIZE = 16 * 1024;
+const int MAX_ENCODE_BUFFER_SIZE = 4 * 1024 * 1024;
+
+// strings and byte arrays are packet-encoded with a 16-bit length
+const int MAX_ENCODED_VALUE_SIZE = std::numeric_limits<uint16_t>::max();
+
+struct RowRange {
+    size_t begin;
+    size_t end;
+};
+
+std::vector<RowRange> splitRows(size_t numRows) {
+    std::vector<RowRange> ranges;
+    for (size_t begin = 0; begin < numRows; begin += ROWS_PER_TASK) {
+        ranges.push_back({ begin, std::min(begin + ROWS_PER_TASK, numRows) });
+    }
+    return ranges;
+}
+
+// The properties left to the packet encoding, those stored in columns aside.
+EntityPropertyFlags getEncodedProperties(EntityTypes::EntityType type) {
+    static const EntityPropertyFlags COMMON_PROPERTIES = [] {
+        EntityPropertyFlags flags;
+        for (int i = 0; i < PROP_AFTER_LAST_ITEM; i++) {
+            flags.setHasProperty((EntityPropertyList)i);
+        }
+        flags -= PROP_NAME;
+        flags -= PROP_SCRIPT;
+        flags -= PROP_SERVER_SCRIPTS;
+        flags -= PROP_PARENT_ID;
+        flags -= PROP_POSITION;
+        flags -= PROP_ROTATION;
+        flags -= PROP_DIMENSIONS;
+        return flags;
+    }();
+
+    EntityPropertyFlags flags = COMMON_PROPERTIES;
+    // the type specific properties share their flags, so the model URL can only be left out of models
+    if (type == EntityTypes::Model) {
+        flags -= PROP_MODEL_URL;
+    }
+    return flags;
+}
+
+bool encodeProperties(const EntityItemID& id, const EntityItemProperties& properties, QByteArray& buffer) {
+    EntityPropertyFlags requestedProperties = getEncodedProperties(properties.getType());
+    for (int bufferSize : { DEFAULT_ENCODE_BUFFER_SIZE, MAX_ENCODE_BUFFER_SIZE }) {
+        buffer = QByteArray(bufferSize, 0);
+        EntityPropertyFlags didntFitProperties;
+        auto appendState = EntityItemProperties::encodeEntityEditPacket(PacketType::EntityAdd, id, properties, buffer,
+                                                                        requestedProperties, didntFitProperties);
+        if (appendState == OctreeElement::COMPLETED) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void beginSection(QByteArray& data, FileHeader& header, Section section) {
+    int padding = (SECTION_ALIGNMENT - data.size() % SECTION_ALIGNMENT) % SECTION_ALIGNMENT;
+    data.append(padding, '\0');
+    header.sections[section].offset = data.size();
+}
+
+void endSection(QByteArray& data, FileHeader& header, Section section) {
+    header.sections[section].size = data.size() - header.sections[section].offset;
+}
+
+template <typename T>
+void appendValue(QByteArray& data, const T& value) {
+    data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+class MappedSnapshot {
+public:
+    MappedSnapshot(const uchar* data, quint64 size) : _data(data), _size(size) {}
+
+    bool readHeader() {
+        if (_size < sizeof(FileHeader)) {
+            return false;
+        }
+        memcpy(&_header, _data, sizeof(FileHeader));
+
+        // every section must be in the file, and large enough for the number of rows it claims
+        for (const auto& section : _header.sections) {
+            if (section.offset < sizeof(FileHeader) || section.offset > _size || section.size > _size - section.offset) {
+                return false;
+            }
+        }
+        const quint64 numEntities = _header.numEntities;
+        const quint64 numStrings = _header.numStrings;
+        if (numEntities > _size || numStrings > _size) {
+            return false;
+        }
+        return hasSize(IDS, numEntities * UUID_SIZE) && hasSize(TYPES, numEntities) && hasSize(FLAGS, numEntities) &&
+            hasSize(PARENT_IDS, numEntities * UUID_SIZE) && hasSize(CREATED, numEntities * sizeof(quint64)) &&
+            hasSize(POSITIONS, numEntities * sizeof(glm::vec3)) && hasSize(ROTATIONS, numEntities * sizeof(glm::quat)) &&
+            hasSize(DIMENSIONS, numEntities * sizeof(glm::vec3)) && hasSize(NAMES, numEntities * sizeof(quint32)) &&
+            hasSize(SCRIPTS, numEntities * sizeof(quint32)) && hasSize(SERVER_SCRIPTS, numEntities * sizeof(quint32)) &&
+            hasSize(MODEL_URLS, numEntities * sizeof(quint32)) &&
+            hasSize(PROPERTY_OFFSETS, (numEntities + 1) * sizeof(quint64)) &&
+            hasSize(STRING_OFFSETS, (numStrings + 1) * sizeof(quint64));
+    }
+
+    const FileHeader& getHeader() const { return _header; }
+
+    const char* getSection(Section section) const {
+        return reinterpret_cast<const char*>(_data + _header.sections[section].offset);
+    }
+    quint64 getSectionSize(Section section) const { return _header.sections[section].size; }
+
+    template <typename T>
+    T getValue(Section section, size_t row) const {
+        T value;
+        memcpy(&value, getSection(section) + row * sizeof(T), sizeof(T));
+        return value;
+    }
+
+    QUuid getUuid(Section section, size_t row) const {
+        return QUuid::fromRfc4122(QByteArray::fromRawData(getSection(section) + row * UUID_SIZE, UUID_SIZE));
+    }
+
+    QByteArray getBytes(Section section) const {
+        return QByteArray::fromRawData(getSection(section), (int)getSectionSize(section));
+    }
+
+private:
+    bool hasSize(Section section, quint64 size) const { return _header.sections[section].size >= size; }
+
+    const uchar* _data;
+    quint64 _size;
+    FileHeader _header;
+};
+
+bool readSnapshot(const MappedSnapshot& snapshot, EntitySnapshot::Contents& contents) {
+    const FileHeader& header = snapshot.getHeader();
+    const size_t numEntities = header.numEntities;
+    const size_t numStrings = header.numStrings;
+
+    // the dictionary strings are converted once, then shared by the properties of every entity using them
+    std::vector<QString> strings(numStrings);
+    const quint64 stringDataSize = snapshot.getSectionSize(STRING_DATA);
+    for (size_t i = 0; i < numStrings; ++i) {
+        auto begin = snapshot.getValue<quint64>(STRING_OFFSETS, i);
+        auto end = snapshot.getValue<quint64>(STRING_OFFSETS, i + 1);
+        if (begin > end || end > stringDataSize) {
+            return false;
+        }
+        strings[i] = QString::fromUtf8(snapshot.getSection(STRING_DATA) + begin, (int)(end - begin));
+    }
+
+    contents.ids.resize(numEntities);
+    contents.properties.resize(numEntities);
+
+    const quint64 propertyDataSize = snapshot.getSectionSize(PROPERTY_DATA);
+    const auto propertyData = reinterpret_cast<const unsigned char*>(snapshot.getSection(PROPERTY_DATA));
+    std::atomic<bool> isValid { true };
+
+    auto getString = [&](Section section, size_t row, QString& string) {
+        auto index = snapshot.getValue<quint32>(section, row);
+        if (index >= numStrings) {
+            return false;
+        }
+        string = strings[index];
+        return true;
+    };
+
+    auto ranges = splitRows(numEntities);
+    QtConcurrent::blockingMap(ranges, [&](RowRange& range) {
+        for (size_t i = range.begin; i < range.end && isValid; ++i) {
+            EntityItemID id = snapshot.getUuid(IDS, i);
+            EntityItemProperties& properties = contents.properties[i];
+
+            auto begin = snapshot.getValue<quint64>(PROPERTY_OFFSETS, i);
+            auto end = snapshot.getValue<quint64>(PROPERTY_OFFSETS, i + 1);
+            int processedBytes = 0;
+            EntityItemID decodedID;
+            if (begin > end || end > propertyDataSize ||
+                !EntityItemProperties::decodeEntityEditPacket(propertyData + begin, (int)(end - begin), processedBytes,
+                                                              decodedID, properties) ||
+                decodedID != id || (quint8)properties.getType() != snapshot.getValue<quint8>(TYPES, i)) {
+                isValid = false;
+                return;
+            }
+
+            QString name;
+            QString script;
+            QString serverScripts;
+            QString modelURL;
+            if (!getString(NAMES, i, name) || !getString(SCRIPTS, i, script) ||
+                !getString(SERVER_SCRIPTS, i, serverScripts) || !getString(MODEL_URLS, i, modelURL)) {
+                isValid = false;
+                return;
+            }
+
+            properties.setName(name);
+            properties.setScript(script);
+            properties.setServerScripts(serverScripts);
+            if (properties.getType() == EntityTypes::Model) {
+                properties.setModelURL(modelURL);
+            }
+            properties.setParentID(snapshot.getUuid(PARENT_IDS, i));
+            properties.setCreated(snapshot.getValue<quint64>(CREATED, i));
+            properties.setPosition(snapshot.getValue<glm::vec3>(POSITIONS, i));
+            properties.setRotation(snapshot.getValue<glm::quat>(ROTATIONS, i));
+            properties.setDimensions(snapshot.getValue<glm::vec3>(DIMENSIONS, i));
+
+            auto flags = snapshot.getValue<quint8>(FLAGS, i);
+            properties.setIsVisibleInSecondaryCamera((flags & VISIBLE_IN_SECONDARY_CAMERA) != 0);
+
+            contents.ids[i] = id;
+        }
+    });
+
+    if (!isValid) {
+        return false;
+    }
+
+    if (snapshot.getSectionSize(JSON_ENTITIES) > 0) {
+        QJsonParseError error;
+        auto document = QJsonDocument::fromJson(snapshot.getBytes(JSON_ENTITIES), &error);
+        if (error.error != QJsonParseError::NoError || !document.isArray()) {
+            return false;
+        }
+        contents.info.variantEntityData = document.array().toVariantList();
+    }
+
+    contents.namedPaths.clear();
+    QJsonObject namedPaths = QJsonDocument::fromJson(snapshot.getBytes(NAMED_PATHS)).object();
+    for (auto it = namedPaths.begin(); it != namedPaths.end(); ++it) {
+        contents.namedPaths[it.key()] = it.value().toString();
+    }
+
+    return true;
+}
+
+}
+
+bool EntitySnapshot::canEncode(const EntityItemProperties& properties) {
+    for (const auto& value : { properties.getUserData(), properties.getPrivateUserData(), properties.getDescription(),
+                               properties.getHref(), properties.getText(), properties.getTextures(),
+                               properties.getCompoundShapeURL(), properties.getParticleUpdateData(),
+                               properties.getParticleRenderData(), properties.getBlendshapeCoefficients(),
+                               properties.getSourceUrl(), properties.getImageURL(), properties.getMaterialURL(),
+                               properties.getMaterialData() }) {
+        // UTF-8 takes at most 3 bytes per UTF-16 code unit, only convert the strings that may be too long
+        if (value.size() * 3 > MAX_ENCODED_VALUE_SIZE && value.toUtf8().size() > MAX_ENCODED_VALUE_SIZE) {
+            return false;
+        }
+    }
+    if (properties.getType() != EntityTypes::Model && properties.getModelURL().toUtf8().size() > MAX_ENCODED_VALUE_SIZE) {
+        return false;
+    }
+    return properties.getActionData().size() <= MAX_ENCODED_VALUE_SIZE &&
+        properties.getVoxelData().size() <= MAX_ENCODED_VALUE_SIZE;
+}
+
+bool EntitySnapshot::write(const QString& filename, const Contents& contents) {
+    QElapsedTimer timer;
+    timer.start();
+
+    const size_t numEntities = contents.properties.size();
+    assert(contents.ids.size() == numEntities);
+
+    std::vector<QByteArray> encodedProperties(numEntities);
+    std::atomic<bool> isEncoded { true };
+    auto ranges = splitRows(numEntities);
+    QtConcurrent::blockingMap(ranges, [&](RowRange& range) {
+        for (size_t i = range.begin; i < range.end && isEncoded; ++i) {
+            if (!encodeProperties(contents.ids[i], contents.properties[i], encodedProperties[i])) {
+                qCWarning(entities) << "Couldn't encode entity" << contents.ids[i] << "for snapshot" << filename;
+                isEncoded = false;
+            }
+        }
+    });
+    if (!isEncoded) {
+        return false;
+    }
+
+    FileHeader header;
+    memset(&header, 0, sizeof(FileHeader));
+    header.snapshot = contents.info.toSnapshotHeader(FORMAT_VERSION);
+    header.numEntities = numEntities;
+
+    QByteArray data(sizeof(FileHeader), '\0');
+
+    auto appendColumn = [&](Section section, auto getValue) {
+        beginSection(data, header, section);
+        for (size_t i = 0; i < numEntities; ++i) {
+            appendValue(data, getValue(contents.properties[i]));
+        }
+        endSection(data, header, section);
+    };
+
+    beginSection(data, header, IDS);
+    for (const auto& id : contents.ids) {
+        data.append(id.toRfc4122());
+    }
+    endSection(data, header, IDS);
+
+    appendColumn(TYPES, [](const EntityItemProperties& properties) { return (quint8)properties.getType(); });
+    appendColumn(FLAGS, [](const EntityItemProperties& properties) {
+        return (quint8)(properties.getIsVisibleInSecondaryCamera() ? VISIBLE_IN_SECONDARY_CAMERA : 0);
+    });
+
+    beginSection(data, header, PARENT_IDS);
+    for (const auto& properties : contents.properties) {
+        data.append(properties.getParentID().toRfc4122());
+    }
+    endSection(data, header, PARENT_IDS);
+
+    appendColumn(CREATED, [](const EntityItemProperties& properties) { return (quint64)properties.getCreated(); });
+    appendColumn(POSITIONS, [](const EntityItemProperties& properties) { return properties.getPosition(); });
+    appendColumn(ROTATIONS, [](const EntityItemProperties& properties) { return properties.getRotation(); });
+    appendColumn(DIMENSIONS, [](const EntityItemProperties& properties) { return properties.getDimensions(); });
+
+    QHash<QString, quint32> stringIndices;
+    std::vector<QString> strings;
+    auto getStringIndex = [&](const QString& string) {
+        auto it = stringIndices.find(string);
+        if (it != stringIndices.end()) {
+            return it.value();
+        }
+        quint32 index = (quint32)strings.size();
+        strings.push_back(string);
+        stringIndices.insert(string, index);
+        return index;
+    };
+
+    appendColumn(NAMES, [&](const EntityItemProperties& properties) { return getStringIndex(properties.getName()); });
+    appendColumn(SCRIPTS, [&](const EntityItemProperties& properties) { return getStringIndex(properties.getScript()); });
+    appendColumn(SERVER_SCRIPTS, [&](const EntityItemProperties& properties) {
+        return getStringIndex(properties.getServerScripts());
+    });
+    appendColumn(MODEL_URLS, [&](const EntityItemProperties& properties) {
+        return getStringIndex(properties.getType() == EntityTypes::Model ? properties.getModelURL() : QString());
+    });
+
+    beginSection(data, header, PROPERTY_OFFSETS);
+    quint64 propertyOffset = 0;
+    for (const auto& encoded : encodedProperties) {
+        appendValue(data, propertyOffset);
+        propertyOffset += encoded.size();
+    }
+    appendValue(data, propertyOffset);
+    endSection(data, header, PROPERTY_OFFSETS);
+
+    beginSection(data, header, PROPERTY_DATA);
+    for (const auto& encoded : encodedProperties) {
+        data.append(encoded);
+    }
+    endSection(data, header, PROPERTY_DATA);
+
+    header.numStrings = strings.size();
+    std::vector<QByteArray> utf8Strings;
+    utf8Strings.reserve(strings.size());
+    beginSection(data, header, STRING_OFFSETS);
+    quint64 stringOffset = 0;
+    for (const auto& string : strings) {
+        utf8Strings.push_back(string.toUtf8());
+        appendValue(data, stringOffset);
+        stringOffset += utf8Strings.back().size();
+    }
+    appendValue(data, stringOffset);
+    endSection(data, header, STRING_OFFSETS);
+
+    beginSection(data, header, STRING_DATA);
+    for (const auto& utf8String : utf8Strings) {
+        data.append(utf8String);
+    }
+    endSection(data, header, STRING_DATA);
+
+    beginSection(data, header, JSON_ENTITIES);
+    if (!contents.info.variantEntityData.isEmpty()) {
+        data.append(QJsonDocument(QJsonArray::fromVariantList(contents.info.variantEntityData)).toJson(QJsonDocument::Compact));
+    }
+    endSection(data, header, JSON_ENTITIES);
+
+    QJsonObject namedPaths;
+    for (const auto& namedPath : contents.namedPaths) {
+        namedPaths[namedPath.first] = namedPath.second;
+    }
+    beginSection(data, header, NAMED_PATHS);
+    data.append(QJsonDocument(namedPaths).toJson(QJsonDocument::Compact));
+    endSection(data, header, NAMED_PATHS);
+
+    memcpy(data.data(), &header, sizeof(FileHeader));
+
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qCWarning(entities) << "Couldn't write entity snapshot" << filename << file.errorString();
+        return false;
+    }
+
+    qCDebug(entities) << "Wrote" << numEntities << "entities," << contents.info.variantEntityData.size() << "as JSON, and"
+        << strings.size() << "distinct strings to" << filename << "in" << timer.elapsed() << "ms";
+    return true;
+}
+
+bool EntitySnapshot::read(const QString& filename, Contents& contents) {
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(entities) << "Couldn't open entity snapshot" << filename << file.errorString();
+        return false;
+    }
+
+    qint64 fileSize = file.size();
+    uchar* data = fileSize > 0 ? file.map(0, fileSize) : nullptr;
+    if (!data) {
+        qCWarning(entities) << "Couldn't map entity snapshot" << filename << file.errorString();
+        return false;
+    }
+
+    MappedSnapshot snapshot(data, (quint64)fileSize);
+    bool success = false;
+    if (!snapshot.readHeader() || !contents.info.readOctreeDataInfoFromSnapshotHeader(snapshot.getHeader().snapshot)) {
+        qCWarning(entities) << "Invalid entity snapshot" << filename;
+    } else if (snapshot.getHeader().snapshot.formatVersion != FORMAT_VERSION) {
+        qCWarning(entities) << "Unsupported entity snapshot format" << snapshot.getHeader().snapshot.formatVersion << "in"
+            << filename;
+    } else {
+        success = readSnapshot(snapshot, contents);
+        if (!success) {
+            qCWarning(entities) << "Corrupt entity snapshot" << filename;
+        }
+    }
+
+    file.unmap(data);
+
+    if (success) {
+        qCDebug(entities) << "Read" << contents.ids.size() + contents.info.variantEntityData.size()
+            << "entities from snapshot" << filename << "in" << timer.elapsed() << "ms";
+    }
+    return success;
+}
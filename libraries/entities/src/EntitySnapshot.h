@@ -0,0 +1,63 @@
+//
+//  EntitySnapshot.h
+//  libraries/entities/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitySnapshot_h
+#define hifi_EntitySnapshot_h
+
+#include <map>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include <OctreeDataUtils.h>
+
+#include "EntityItemID.h"
+#include "EntityItemProperties.h"
+
+/// Binary columnar snapshot of the entities of an EntityTree, loaded at startup instead of parsing the JSON persist file.
+///
+/// After an OctreeUtils::SnapshotHeader, the file holds a table of section offsets then the sections, each 8-byte
+/// aligned so that the file is memory-mapped and read in place:
+///  - typed columns of the properties every entity has: ids, types, flags, parent ids, created times, positions,
+///    rotations and dimensions
+///  - string dictionary indices of the names, scripts, server scripts and model URLs, which many entities share
+///  - the remaining properties of each entity, in the entity edit packet encoding
+///  - the string dictionary
+///  - the entities that can't be packet-encoded, as JSON
+///  - the named paths, as JSON
+///
+/// The packet encoding changes with the entity data version, so a snapshot can only be read by a server of the version
+/// that wrote it. The JSON persist file remains the authoritative copy of the entities.
+class EntitySnapshot {
+public:
+    static const quint32 FORMAT_VERSION = 1;
+
+    struct Contents {
+        // the version info, and the entities stored as JSON
+        OctreeUtils::RawEntityData info;
+
+        std::vector<EntityItemID> ids;
+        std::vector<EntityItemProperties> properties;
+
+        std::map<QString, QString> namedPaths;
+    };
+
+    /// Returns false if some property of the entity is too large for the packet encoding, in which case it must be
+    /// stored as JSON.
+    static bool canEncode(const EntityItemProperties& properties);
+
+    /// Encodes the properties across the global thread pool.
+    static bool write(const QString& filename, const Contents& contents);
+
+    /// Maps the snapshot and decodes the properties across the global thread pool.
+    static bool read(const QString& filename, Contents& contents);
+};
+
+#endif // hifi_EntitySnapshot_h
@@ -28,6 +28,7 @@
 #include <Extents.h>
 #include <PerfStat.h>
 #include <Profile.h>
+#include <OctreeEntitiesFileParser.h>
 #include <AddressManager.h>
 
 #include "EntitySimulation.h"
@@ -39,6 +40,7 @@
 #include "EntitiesLogging.h"
 #include "RecurseOctreeToMapOperator.h"
 #include "RecurseOctreeToJSONOperator.h"
+#include "EntitySnapshot.h"
 #include "LogHandler.h"
 #include "EntityEditFilters.h"
 #include "EntityDynamicFactoryInterface.h"
@@ -92,8 +94,7 @@ void EntityTree::eraseDomainAndNonOwnedEntities() {
         QHash<EntityItemID, EntityItemPointer> savedEntities;
         // NOTE: lock the Tree first, then lock the _entityMap.
         // It should never be done the other way around.
-        QReadLocker locker(&_entityMapLock);
-        foreach(EntityItemPointer entity, _entityMap) {
+        _entityMap.forEach([&](const EntityItemPointer& entity) {
             EntityTreeElementPointer element = entity->getElement();
             if (element) {
                 element->cleanupDomainAndNonOwnedEntities();
@@ -109,8 +110,15 @@ void EntityTree::eraseDomainAndNonOwnedEntities() {
                     }
                 }
             }
-        }
+        });
         _entityMap.swap(savedEntities);
+        if (_bvh) {
+            _bvh->clear();
+            _entityMap.forEach([&](const EntityItemPointer& entity) {
+                entityElementChanged(entity, entity->getElement());
+            });
+        }
+        recordPersistErase();
     });
 
     resetClientEditStats();
@@ -138,7 +146,10 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
         _simulation->clearEntities();
     }
     QHash<EntityItemID, EntityItemPointer> localMap;
-    localMap.swap(_entityMap);
+    _entityMap.swap(localMap);
+    if (_bvh) {
+        _bvh->clear();
+    }
     this->withWriteLock([&] {
         foreach(EntityItemPointer entity, localMap) {
             EntityTreeElementPointer element = entity->getElement();
@@ -299,6 +310,7 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
     }
 
     _isDirty = true;
+    recordPersistChange(entity->getID());
 
     // find and hook up any entities with this entity as a (previously) missing parent
     fixupNeedsParentFixups();
@@ -308,11 +320,7 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
 }
 
 bool EntityTree::updateEntity(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode) {
-    EntityItemPointer entity;
-    {
-        QReadLocker locker(&_entityMapLock);
-        entity = _entityMap.value(entityID);
-    }
+    EntityItemPointer entity = _entityMap.value(entityID);
     if (!entity) {
         return false;
     }
@@ -365,6 +373,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
                     emit editingEntityPointer(entity);
                 }
                 _isDirty = true;
+                recordPersistChange(entity->getID());
             }
         }
     } else {
@@ -500,6 +509,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
         }
 
         _isDirty = true;
+        recordPersistChange(entity->getID());
 
         uint32_t newFlags = entity->getDirtyFlags() & ~preFlags;
         if (newFlags) {
@@ -679,11 +689,7 @@ void EntityTree::deleteEntitiesByID(const std::vector<EntityItemID>& ids, bool f
             std::vector<EntityItemPointer> entitiesToDelete;
             entitiesToDelete.reserve(ids.size());
             for (auto id : ids) {
-                EntityItemPointer entity;
-                {
-                    QReadLocker locker(&_entityMapLock);
-                    entity = _entityMap.value(id);
-                }
+                EntityItemPointer entity = _entityMap.value(id);
                 if (entity) {
                     recursivelyFilterAndCollectForDelete(entity, entitiesToDelete, force);
                 }
@@ -699,11 +705,7 @@ void EntityTree::deleteEntitiesByID(const std::vector<EntityItemID>& ids, bool f
         QUuid sessionID = DependencyManager::get<NodeList>()->getSessionUUID();
         withWriteLock([&] {
             for (auto id : ids) {
-                EntityItemPointer entity;
-                {
-                    QReadLocker locker(&_entityMapLock);
-                    entity = _entityMap.value(id);
-                }
+                EntityItemPointer entity = _entityMap.value(id);
                 if (entity) {
                     bool isServerless = isServerlessMode();
                     if (entity->isDomainEntity() && !isServerless) {
@@ -741,6 +743,7 @@ void EntityTree::deleteEntitiesByPointer(const std::vector<EntityItemPointer>& e
             theOperator.addEntityToDeleteList(entity);
             emit deletingEntity(entity->getID());
             emit deletingEntityPointer(entity.get());
+            recordPersistDelete(entity->getID());
         }
     }
 
@@ -857,7 +860,16 @@ EntityItemID EntityTree::evalRayIntersection(const glm::vec3& origin, const glm:
 
     bool requireLock = lockType == Octree::Lock;
     bool lockResult = withReadLock([&]{
-        recurseTreeWithOperationSorted(evalRayIntersectionOp, evalRayIntersectionSortingOp, &args);
+        if (_bvh) {
+            _bvh->forEachAlongRay(origin, direction, distance, [&](const EntityItemPointer& entity) {
+                if (EntityTreeElement::evalEntityRayIntersection(entity, origin, direction, args.viewFrustumPos, element,
+                        distance, face, surfaceNormal, entityIdsToInclude, entityIdsToDiscard, searchFilter, extraInfo)) {
+                    args.entityID = entity->getEntityItemID();
+                }
+            });
+        } else {
+            recurseTreeWithOperationSorted(evalRayIntersectionOp, evalRayIntersectionSortingOp, &args);
+        }
     }, requireLock);
 
     if (accurateResult) {
@@ -937,7 +949,19 @@ EntityItemID EntityTree::evalParabolaIntersection(const PickParabola& parabola,
 
     bool requireLock = lockType == Octree::Lock;
     bool lockResult = withReadLock([&] {
-        recurseTreeWithOperationSorted(evalParabolaIntersectionOp, evalParabolaIntersectionSortingOp, &args);
+        if (_bvh) {
+            glm::vec3 normal = EntityTreeElement::computeParabolaPlaneNormal(parabola.velocity, parabola.acceleration);
+            auto visitor = [&](const EntityItemPointer& entity) {
+                if (EntityTreeElement::evalEntityParabolaIntersection(entity, parabola.origin, parabola.velocity,
+                        parabola.acceleration, args.viewFrustumPos, normal, element, parabolicDistance, face, surfaceNormal,
+                        entityIdsToInclude, entityIdsToDiscard, searchFilter, extraInfo)) {
+                    args.entityID = entity->getEntityItemID();
+                }
+            };
+            _bvh->forEachAlongParabola(parabola.origin, parabola.velocity, parabola.acceleration, parabolicDistance, visitor);
+        } else {
+            recurseTreeWithOperationSorted(evalParabolaIntersectionOp, evalParabolaIntersectionSortingOp, &args);
+        }
     }, requireLock);
 
     if (accurateResult) {
@@ -1006,6 +1030,19 @@ QUuid EntityTree::evalClosestEntity(const glm::vec3& position, float targetRadiu
     return args.closestEntity;
 }
 
+// Collects the IDs of the BVH candidates that pass the search filter and test, as the element searches do.
+template <typename Test>
+static void filterBVHCandidates(const std::vector<EntityItemPointer>& candidates, PickFilter searchFilter, Test test,
+                                QVector<QUuid>& foundEntities) {
+    QVector<QUuid> entities;
+    for (const EntityItemPointer& entity : candidates) {
+        if (EntityTreeElement::checkFilterSettings(entity, searchFilter) && test(entity)) {
+            entities.push_back(entity->getID());
+        }
+    }
+    foundEntities.swap(entities);
+}
+
 class FindEntitiesInSphereArgs {
 public:
     // Inputs
@@ -1035,6 +1072,14 @@ bool evalInSphereOperation(const OctreeElementPointer& element, void* extraData)
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphere(const glm::vec3& center, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    if (_bvh) {
+        std::vector<EntityItemPointer> candidates;
+        _bvh->findInSphere(center, radius, candidates);
+        filterBVHCandidates(candidates, searchFilter, [&](const EntityItemPointer& entity) {
+            return EntityTreeElement::checkEntityInSphere(entity, center, radius);
+        }, foundEntities);
+        return;
+    }
     FindEntitiesInSphereArgs args = { center, radius, searchFilter, QVector<QUuid>() };
     recurseTreeWithOperation(evalInSphereOperation, &args);
     foundEntities.swap(args.entities);
@@ -1070,6 +1115,14 @@ bool evalInSphereWithTypeOperation(const OctreeElementPointer& element, void* ex
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithType(const glm::vec3& center, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    if (_bvh) {
+        std::vector<EntityItemPointer> candidates;
+        _bvh->findInSphere(center, radius, candidates);
+        filterBVHCandidates(candidates, searchFilter, [&](const EntityItemPointer& entity) {
+            return type == entity->getType() && EntityTreeElement::checkEntityInSphere(entity, center, radius);
+        }, foundEntities);
+        return;
+    }
     FindEntitiesInSphereWithTypeArgs args = { center, radius, type, searchFilter, QVector<QUuid>() };
     recurseTreeWithOperation(evalInSphereWithTypeOperation, &args);
     foundEntities.swap(args.entities);
@@ -1106,6 +1159,15 @@ bool evalInSphereWithNameOperation(const OctreeElementPointer& element, void* ex
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithName(const glm::vec3& center, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    if (_bvh) {
+        std::vector<EntityItemPointer> candidates;
+        _bvh->findInSphere(center, radius, candidates);
+        filterBVHCandidates(candidates, searchFilter, [&](const EntityItemPointer& entity) {
+            return EntityTreeElement::checkEntityName(entity, name, caseSensitive) &&
+                EntityTreeElement::checkEntityInSphere(entity, center, radius);
+        }, foundEntities);
+        return;
+    }
     FindEntitiesInSphereWithNameArgs args = { center, radius, name, caseSensitive, searchFilter, QVector<QUuid>() };
     recurseTreeWithOperation(evalInSphereWithNameOperation, &args);
     foundEntities.swap(args.entities);
@@ -1142,6 +1204,15 @@ bool evalInSphereWithTagsOperation(const OctreeElementPointer& element, void* ex
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithTags(const glm::vec3& center, float radius, const QVector<QString>& tags, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    if (_bvh) {
+        std::vector<EntityItemPointer> candidates;
+        _bvh->findInSphere(center, radius, candidates);
+        filterBVHCandidates(candidates, searchFilter, [&](const EntityItemPointer& entity) {
+            return EntityTreeElement::checkEntityTags(entity, tags, caseSensitive) &&
+                EntityTreeElement::checkEntityInSphere(entity, center, radius);
+        }, foundEntities);
+        return;
+    }
     FindEntitiesInSphereWithTagsArgs args = { center, radius, tags, caseSensitive, searchFilter, QVector<QUuid>() };
     recurseTreeWithOperation(evalInSphereWithTagsOperation, &args);
     foundEntities.swap(args.entities);
@@ -1169,6 +1240,16 @@ bool findInCubeOperation(const OctreeElementPointer& element, void* extraData) {
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInCube(const AACube& cube, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    if (_bvh) {
+        std::vector<EntityItemPointer> candidates;
+        _bvh->findInBox(AABox(cube), candidates);
+        filterBVHCandidates(candidates, searchFilter, [&](const EntityItemPointer& entity) {
+            bool success;
+            AABox entityBox = entity->getAABox(success);
+            return success && entityBox.touches(cube);
+        }, foundEntities);
+        return;
+    }
     FindEntitiesInCubeArgs args { cube, searchFilter, QVector<QUuid>() };
     recurseTreeWithOperation(findInCubeOperation, &args);
     foundEntities.swap(args.entities);
@@ -1196,6 +1277,16 @@ bool findInBoxOperation(const OctreeElementPointer& element, void* extraData) {
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    if (_bvh) {
+        std::vector<EntityItemPointer> candidates;
+        _bvh->findInBox(box, candidates);
+        filterBVHCandidates(candidates, searchFilter, [&](const EntityItemPointer& entity) {
+            bool success;
+            AABox entityBox = entity->getAABox(success);
+            return success && entityBox.touches(box);
+        }, foundEntities);
+        return;
+    }
     FindEntitiesInBoxArgs args { box, searchFilter, QVector<QUuid>() };
     // NOTE: This should use recursion, since this is a spatial operation
     recurseTreeWithOperation(findInBoxOperation, &args);
@@ -1225,6 +1316,16 @@ bool findInFrustumOperation(const OctreeElementPointer& element, void* extraData
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInFrustum(const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    if (_bvh) {
+        std::vector<EntityItemPointer> candidates;
+        _bvh->findInFrustum(frustum, candidates);
+        filterBVHCandidates(candidates, searchFilter, [&](const EntityItemPointer& entity) {
+            bool success;
+            AABox entityBox = entity->getAABox(success);
+            return success && (frustum.boxIntersectsFrustum(entityBox) || frustum.boxIntersectsKeyhole(entityBox));
+        }, foundEntities);
+        return;
+    }
     FindEntitiesInFrustumArgs args = { frustum, searchFilter, QVector<QUuid>() };
     // NOTE: This should use recursion, since this is a spatial operation
     recurseTreeWithOperation(findInFrustumOperation, &args);
@@ -1238,11 +1339,7 @@ EntityItemPointer EntityTree::findEntityByID(const QUuid& id) const {
 }
 
 EntityItemPointer EntityTree::findEntityByEntityItemID(const EntityItemID& entityID) const {
-    EntityItemPointer foundEntity = nullptr;
-    {
-        QReadLocker locker(&_entityMapLock);
-        foundEntity = _entityMap.value(entityID);
-    }
+    EntityItemPointer foundEntity = _entityMap.value(entityID);
     if (foundEntity && !foundEntity->getElement()) {
         // special case to maintain legacy behavior:
         // if the entity is in the map but not in the tree
@@ -1475,7 +1572,6 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
     }
 
     int processedBytes = 0;
-    bool isAdd = false;
     bool isClone = false;
     // we handle these types of "edit" packets
     switch (message.getType()) {
@@ -1489,114 +1585,89 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
             isClone = true; // fall through to next case
             // FALLTHRU
         case PacketType::EntityAdd:
-            isAdd = true;  // fall through to next case
             // FALLTHRU
         case PacketType::EntityPhysics:
         case PacketType::EntityEdit: {
-            quint64 startDecode = 0, endDecode = 0;
-            quint64 startLookup = 0, endLookup = 0;
-            quint64 startUpdate = 0, endUpdate = 0;
-            quint64 startCreate = 0, endCreate = 0;
-            quint64 startFilter = 0, endFilter = 0;
-            quint64 startLogging = 0, endLogging = 0;
-
-            bool suppressDisallowedClientScript = false;
-            bool suppressDisallowedServerScript = false;
-            bool suppressDisallowedPrivateUserData = false;
-            bool isPhysics = message.getType() == PacketType::EntityPhysics;
-
             _totalEditMessages++;
 
-            EntityItemID entityItemID;
-            EntityItemProperties properties;
-            startDecode = usecTimestampNow();
+            DecodedEdit edit;
+            edit.type = message.getType();
+            edit.senderNode = senderNode;
+            quint64 startDecode = usecTimestampNow();
 
-            bool validEditPacket = false;
-            EntityItemID entityIDToClone;
             EntityItemPointer entityToClone;
             if (isClone) {
                 QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
-                validEditPacket = EntityItemProperties::decodeCloneEntityMessage(buffer, processedBytes, entityIDToClone, entityItemID);
-                if (validEditPacket) {
-                    entityToClone = findEntityByEntityItemID(entityIDToClone);
+                edit.valid = EntityItemProperties::decodeCloneEntityMessage(buffer, processedBytes, edit.entityIDToClone,
+                    edit.entityID);
+                if (edit.valid) {
+                    entityToClone = findEntityByEntityItemID(edit.entityIDToClone);
                     if (entityToClone) {
-                        properties = entityToClone->getProperties();
+                        edit.properties = entityToClone->getProperties();
                     }
                 }
             } else {
-                validEditPacket = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes, entityItemID, properties);
+                edit.valid = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes, edit.entityID,
+                    edit.properties);
             }
+            edit.decodeTime = usecTimestampNow() - startDecode;
 
-            endDecode = usecTimestampNow();
+            applyEdit(edit, entityToClone);
+            break;
+        }
 
-            EntityItemPointer existingEntity;
-            if (!isAdd) {
-                // search for the entity by EntityItemID
-                startLookup = usecTimestampNow();
-                existingEntity = findEntityByEntityItemID(entityItemID);
-                endLookup = usecTimestampNow();
-                if (!existingEntity) {
-                    // this is not an add-entity operation, and we don't know about the identified entity.
-                    validEditPacket = false;
-                }
-            }
+        default:
+            processedBytes = 0;
+            break;
+    }
+    return processedBytes;
+}
 
-            if (validEditPacket && !_entityScriptSourceAllowlist.isEmpty()) {
 
-                bool wasDeletedBecauseOfClientScript = false;
+void EntityTree::applyEdit(DecodedEdit& edit, const EntityItemPointer& entityToClone) {
+    bool isAdd = edit.type == PacketType::EntityAdd || edit.type == PacketType::EntityClone;
+    bool isClone = edit.type == PacketType::EntityClone;
+    bool isPhysics = edit.type == PacketType::EntityPhysics;
+    const EntityItemID& entityItemID = edit.entityID;
+    const EntityItemID& entityIDToClone = edit.entityIDToClone;
+    EntityItemProperties& properties = edit.properties;
+    const SharedNodePointer& senderNode = edit.senderNode;
+    bool validEditPacket = edit.valid;
 
-                // check the client entity script to make sure its URL is in the allowlist
-                if (!properties.getScript().isEmpty()) {
-                    bool clientScriptPassedAllowlist = isScriptInAllowlist(properties.getScript());
+    quint64 startLookup = 0, endLookup = 0;
+    quint64 startUpdate = 0, endUpdate = 0;
+    quint64 startCreate = 0, endCreate = 0;
+    quint64 startFilter = 0, endFilter = 0;
+    quint64 startLogging = 0, endLogging = 0;
 
-                    if (!clientScriptPassedAllowlist) {
-                        if (wantEditLogging()) {
-                            qCDebug(entities) << "User [" << senderNode->getUUID()
-                                << "] attempting to set entity script not on allowlist, edit rejected";
-                        }
+    bool suppressDisallowedClientScript = false;
+    bool suppressDisallowedServerScript = false;
+    bool suppressDisallowedPrivateUserData = false;
 
-                        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                        if (isAdd) {
-                            QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                            _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                            validEditPacket = false;
-                            wasDeletedBecauseOfClientScript = true;
-                        } else {
-                            suppressDisallowedClientScript = true;
-                        }
-                    }
-                }
+    EntityItemPointer existingEntity;
+    if (!isAdd) {
+        // search for the entity by EntityItemID
+        startLookup = usecTimestampNow();
+        existingEntity = findEntityByEntityItemID(entityItemID);
+        endLookup = usecTimestampNow();
+        if (!existingEntity) {
+            // this is not an add-entity operation, and we don't know about the identified entity.
+            validEditPacket = false;
+        }
+    }
 
-                // check all server entity scripts to make sure their URLs are in the allowlist
-                if (!properties.getServerScripts().isEmpty()) {
-                    bool serverScriptPassedAllowlist = isScriptInAllowlist(properties.getServerScripts());
+    if (validEditPacket && !_entityScriptSourceAllowlist.isEmpty()) {
 
-                    if (!serverScriptPassedAllowlist) {
-                        if (wantEditLogging()) {
-                            qCDebug(entities) << "User [" << senderNode->getUUID()
-                                << "] attempting to set server entity script not on allowlist, edit rejected";
-                        }
+        bool wasDeletedBecauseOfClientScript = false;
 
-                        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                        if (isAdd) {
-                            // Make sure we didn't already need to send back a delete because the client script failed
-                            // the allowlist check
-                            if (!wasDeletedBecauseOfClientScript) {
-                                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                                _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                                validEditPacket = false;
-                            }
-                        } else {
-                            suppressDisallowedServerScript = true;
-                        }
-                    }
-                }
-            }
+        // check the client entity script to make sure its URL is in the allowlist
+        if (!properties.getScript().isEmpty()) {
+            bool clientScriptPassedAllowlist = isScriptInAllowlist(properties.getScript());
 
-            if (!properties.getPrivateUserData().isEmpty() && validEditPacket && !senderNode->getCanGetAndSetPrivateUserData()) {
+            if (!clientScriptPassedAllowlist) {
                 if (wantEditLogging()) {
                     qCDebug(entities) << "User [" << senderNode->getUUID()
-                        << "] is attempting to set private user data but user isn't allowed; edit rejected...";
+                        << "] attempting to set entity script not on allowlist, edit rejected";
                 }
 
                 // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
@@ -1604,175 +1675,288 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                     QWriteLocker locker(&_recentlyDeletedEntitiesLock);
                     _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
                     validEditPacket = false;
+                    wasDeletedBecauseOfClientScript = true;
                 } else {
-                    suppressDisallowedPrivateUserData = true;
+                    suppressDisallowedClientScript = true;
                 }
             }
+        }
 
-            if (!isClone) {
-                if ((isAdd || properties.lifetimeChanged()) &&
-                    ((!senderNode->getCanRez() && senderNode->getCanRezTmp()))) {
-                    // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
-                    if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
-                        properties.getLifetime() > _maxTmpEntityLifetime) {
-                        properties.setLifetime(_maxTmpEntityLifetime);
-                        bumpTimestamp(properties);
-                    }
+        // check all server entity scripts to make sure their URLs are in the allowlist
+        if (!properties.getServerScripts().isEmpty()) {
+            bool serverScriptPassedAllowlist = isScriptInAllowlist(properties.getServerScripts());
+
+            if (!serverScriptPassedAllowlist) {
+                if (wantEditLogging()) {
+                    qCDebug(entities) << "User [" << senderNode->getUUID()
+                        << "] attempting to set server entity script not on allowlist, edit rejected";
                 }
 
-                if (isAdd && properties.getLocked() && !senderNode->isAllowedEditor()) {
-                    // if a node can't change locks, don't allow it to create an already-locked entity -- automatically
-                    // clear the locked property and allow the unlocked entity to be created.
-                    properties.setLocked(false);
-                    bumpTimestamp(properties);
+                // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
+                if (isAdd) {
+                    // Make sure we didn't already need to send back a delete because the client script failed
+                    // the allowlist check
+                    if (!wasDeletedBecauseOfClientScript) {
+                        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+                        validEditPacket = false;
+                    }
+                } else {
+                    suppressDisallowedServerScript = true;
                 }
             }
+        }
+    }
 
-            // If we got a valid edit packet, then it could be a new entity or it could be an update to
-            // an existing entity... handle appropriately
-            if (validEditPacket) {
-                startFilter = usecTimestampNow();
-                bool wasChanged = false;
-                // Having (un)lock rights bypasses the filter, unless it's a physics result.
-                FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
-                bool allowed = (!isPhysics && senderNode->isAllowedEditor()) || filterProperties(existingEntity, properties, properties, wasChanged, filterType);
-                if (!allowed) {
-                    // the update failed and we need to convey that fact to the sender
-                    // our method is to re-assert the current properties and bump the lastEdited timestamp
-                    auto timestamp = properties.getLastEdited();
-                    properties = EntityItemProperties();
-                    properties.setLastEdited(timestamp);
-                }
-                if (!allowed || wasChanged) {
-                    bumpTimestamp(properties);
-                    // For now, free ownership on any modification.
-                    properties.clearSimulationOwner();
-                }
-                endFilter = usecTimestampNow();
+    if (!properties.getPrivateUserData().isEmpty() && validEditPacket && !senderNode->getCanGetAndSetPrivateUserData()) {
+        if (wantEditLogging()) {
+            qCDebug(entities) << "User [" << senderNode->getUUID()
+                << "] is attempting to set private user data but user isn't allowed; edit rejected...";
+        }
+
+        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
+        if (isAdd) {
+            QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+            _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+            validEditPacket = false;
+        } else {
+            suppressDisallowedPrivateUserData = true;
+        }
+    }
 
-                if (existingEntity && !isAdd) {
+    if (!isClone) {
+        if ((isAdd || properties.lifetimeChanged()) &&
+            ((!senderNode->getCanRez() && senderNode->getCanRezTmp()))) {
+            // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
+            if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
+                properties.getLifetime() > _maxTmpEntityLifetime) {
+                properties.setLifetime(_maxTmpEntityLifetime);
+                bumpTimestamp(properties);
+            }
+        }
 
-                    if (suppressDisallowedClientScript) {
-                        bumpTimestamp(properties);
-                        properties.setScript(existingEntity->getScript());
-                    }
+        if (isAdd && properties.getLocked() && !senderNode->isAllowedEditor()) {
+            // if a node can't change locks, don't allow it to create an already-locked entity -- automatically
+            // clear the locked property and allow the unlocked entity to be created.
+            properties.setLocked(false);
+            bumpTimestamp(properties);
+        }
+    }
 
-                    if (suppressDisallowedServerScript) {
-                        bumpTimestamp(properties);
-                        properties.setServerScripts(existingEntity->getServerScripts());
-                    }
+    // If we got a valid edit packet, then it could be a new entity or it could be an update to
+    // an existing entity... handle appropriately
+    if (validEditPacket) {
+        startFilter = usecTimestampNow();
+        bool wasChanged = false;
+        // Having (un)lock rights bypasses the filter, unless it's a physics result.
+        FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
+        bool allowed = (!isPhysics && senderNode->isAllowedEditor()) || filterProperties(existingEntity, properties, properties, wasChanged, filterType);
+        if (!allowed) {
+            // the update failed and we need to convey that fact to the sender
+            // our method is to re-assert the current properties and bump the lastEdited timestamp
+            auto timestamp = properties.getLastEdited();
+            properties = EntityItemProperties();
+            properties.setLastEdited(timestamp);
+        }
+        if (!allowed || wasChanged) {
+            bumpTimestamp(properties);
+            // For now, free ownership on any modification.
+            properties.clearSimulationOwner();
+        }
+        endFilter = usecTimestampNow();
+
+        if (existingEntity && !isAdd) {
+
+            if (suppressDisallowedClientScript) {
+                bumpTimestamp(properties);
+                properties.setScript(existingEntity->getScript());
+            }
+
+            if (suppressDisallowedServerScript) {
+                bumpTimestamp(properties);
+                properties.setServerScripts(existingEntity->getServerScripts());
+            }
+
+            if (suppressDisallowedPrivateUserData) {
+                bumpTimestamp(properties);
+                properties.setPrivateUserData(existingEntity->getPrivateUserData());
+            }
+
+            // if the EntityItem exists, then update it
+            startLogging = usecTimestampNow();
+            if (wantEditLogging()) {
+                qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+                qCDebug(entities) << "   properties:" << properties;
+            }
+            if (wantTerseEditLogging()) {
+                QList<QString> changedProperties = properties.listChangedProperties();
+                fixupTerseEditLogging(properties, changedProperties);
+                qCDebug(entities) << senderNode->getUUID() << "edit" <<
+                    existingEntity->getDebugName() << changedProperties;
+            }
+            endLogging = usecTimestampNow();
+
+            startUpdate = usecTimestampNow();
+            if (!isPhysics) {
+                properties.setLastEditedBy(senderNode->getUUID());
+            }
+            updateEntity(existingEntity, properties, senderNode);
+            existingEntity->markAsChangedOnServer();
+            endUpdate = usecTimestampNow();
+            _totalUpdates++;
+        } else if (isAdd) {
+            bool failedAdd = !allowed;
+            bool isCloneable = properties.getCloneable();
+            int cloneLimit = properties.getCloneLimit();
+            if (!allowed) {
+                qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
+            } else if (!isClone && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
+                failedAdd = true;
+                qCDebug(entities) << "User without 'rez rights' [" << senderNode->getUUID()
+                    << "] attempted to add an entity with ID:" << entityItemID;
+            } else if (isClone && !isCloneable) {
+                failedAdd = true;
+                qCDebug(entities) << "User attempted to clone non-cloneable entity from entity ID:" << entityIDToClone;
+            } else if (isClone && entityToClone && entityToClone->getCloneIDs().size() >= cloneLimit && cloneLimit != 0) {
+                failedAdd = true;
+                qCDebug(entities) << "User attempted to clone entity ID:" << entityIDToClone << " which reached it's cloneable limit.";
+            } else {
+                if (isClone) {
+                    properties.convertToCloneProperties(entityIDToClone);
+                }
 
-                    if (suppressDisallowedPrivateUserData) {
-                        bumpTimestamp(properties);
-                        properties.setPrivateUserData(existingEntity->getPrivateUserData());
-                    }
+                // this is a new entity... assign a new entityID
+                properties.setLastEditedBy(senderNode->getUUID());
+                startCreate = usecTimestampNow();
+                EntityItemPointer newEntity = addEntity(entityItemID, properties);
+                endCreate = usecTimestampNow();
+                _totalCreates++;
+
+                if (newEntity && isClone) {
+                    entityToClone->addCloneID(newEntity->getEntityItemID());
+                    newEntity->setCloneOriginID(entityIDToClone);
+                }
 
-                    // if the EntityItem exists, then update it
+                if (newEntity) {
+                    newEntity->markAsChangedOnServer();
+                    notifyNewlyCreatedEntity(*newEntity, senderNode);
+                    
                     startLogging = usecTimestampNow();
                     if (wantEditLogging()) {
-                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
+                                          << newEntity->getEntityItemID();
                         qCDebug(entities) << "   properties:" << properties;
                     }
                     if (wantTerseEditLogging()) {
                         QList<QString> changedProperties = properties.listChangedProperties();
                         fixupTerseEditLogging(properties, changedProperties);
-                        qCDebug(entities) << senderNode->getUUID() << "edit" <<
-                            existingEntity->getDebugName() << changedProperties;
+                        qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
                     }
                     endLogging = usecTimestampNow();
 
-                    startUpdate = usecTimestampNow();
-                    if (!isPhysics) {
-                        properties.setLastEditedBy(senderNode->getUUID());
-                    }
-                    updateEntity(existingEntity, properties, senderNode);
-                    existingEntity->markAsChangedOnServer();
-                    endUpdate = usecTimestampNow();
-                    _totalUpdates++;
-                } else if (isAdd) {
-                    bool failedAdd = !allowed;
-                    bool isCloneable = properties.getCloneable();
-                    int cloneLimit = properties.getCloneLimit();
-                    if (!allowed) {
-                        qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
-                    } else if (!isClone && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User without 'rez rights' [" << senderNode->getUUID()
-                            << "] attempted to add an entity with ID:" << entityItemID;
-                    } else if (isClone && !isCloneable) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone non-cloneable entity from entity ID:" << entityIDToClone;
-                    } else if (isClone && entityToClone && entityToClone->getCloneIDs().size() >= cloneLimit && cloneLimit != 0) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone entity ID:" << entityIDToClone << " which reached it's cloneable limit.";
-                    } else {
-                        if (isClone) {
-                            properties.convertToCloneProperties(entityIDToClone);
-                        }
-
-                        // this is a new entity... assign a new entityID
-                        properties.setLastEditedBy(senderNode->getUUID());
-                        startCreate = usecTimestampNow();
-                        EntityItemPointer newEntity = addEntity(entityItemID, properties);
-                        endCreate = usecTimestampNow();
-                        _totalCreates++;
-
-                        if (newEntity && isClone) {
-                            entityToClone->addCloneID(newEntity->getEntityItemID());
-                            newEntity->setCloneOriginID(entityIDToClone);
-                        }
-
-                        if (newEntity) {
-                            newEntity->markAsChangedOnServer();
-                            notifyNewlyCreatedEntity(*newEntity, senderNode);
-                            
-                            startLogging = usecTimestampNow();
-                            if (wantEditLogging()) {
-                                qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
-                                                  << newEntity->getEntityItemID();
-                                qCDebug(entities) << "   properties:" << properties;
-                            }
-                            if (wantTerseEditLogging()) {
-                                QList<QString> changedProperties = properties.listChangedProperties();
-                                fixupTerseEditLogging(properties, changedProperties);
-                                qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
-                            }
-                            endLogging = usecTimestampNow();
-
-                        } else {
-                            failedAdd = true;
-                            qCDebug(entities) << "Add entity failed ID:" << entityItemID;
-                        }
-                    }
-                    if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
-                        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                    }
                 } else {
-                    HIFI_FCDEBUG(entities(), "Edit failed. [" << message.getType() <<"] " <<
-                            "entity id:" << entityItemID << 
-                            "existingEntity pointer:" << existingEntity.get());
+                    failedAdd = true;
+                    qCDebug(entities) << "Add entity failed ID:" << entityItemID;
                 }
             }
+            if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
+                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+            }
+        } else {
+            HIFI_FCDEBUG(entities(), "Edit failed. [" << edit.type <<"] " <<
+                    "entity id:" << entityItemID << 
+                    "existingEntity pointer:" << existingEntity.get());
+        }
+    }
 
+    _totalDecodeTime += edit.decodeTime;
+    _totalLookupTime += endLookup - startLookup;
+    _totalUpdateTime += endUpdate - startUpdate;
+    _totalCreateTime += endCreate - startCreate;
+    _totalLoggingTime += endLogging - startLogging;
+    _totalFilterTime += endFilter - startFilter;
+}
 
-            _totalDecodeTime += endDecode - startDecode;
-            _totalLookupTime += endLookup - startLookup;
-            _totalUpdateTime += endUpdate - startUpdate;
-            _totalCreateTime += endCreate - startCreate;
-            _totalLoggingTime += endLogging - startLogging;
-            _totalFilterTime += endFilter - startFilter;
+int EntityTree::decodeEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                     const SharedNodePointer& senderNode) {
+    // adds and clones look up or create entities while they decode, so only edits of existing entities are staged
+    PacketType type = message.getType();
+    if (!isEntityServer() || (type != PacketType::EntityEdit && type != PacketType::EntityPhysics)) {
+        return 0;
+    }
 
-            break;
-        }
+    DecodedEdit edit;
+    edit.type = type;
+    edit.senderNode = senderNode;
+    int processedBytes = 0;
+    quint64 startDecode = usecTimestampNow();
+    edit.valid = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes, edit.entityID,
+        edit.properties);
+    edit.decodeTime = usecTimestampNow() - startDecode;
 
-        default:
-            processedBytes = 0;
-            break;
+    if (processedBytes > 0) {
+        _decodedEdits.push_back(std::move(edit));
     }
     return processedBytes;
 }
 
+bool EntityTree::isCoveredBy(const DecodedEdit& edit, const DecodedEdit& laterEdit) const {
+    if (!edit.valid || !laterEdit.valid || edit.type != laterEdit.type || edit.senderNode != laterEdit.senderNode ||
+        laterEdit.properties.getLastEdited() < edit.properties.getLastEdited()) {
+        return false;
+    }
+
+    // whether the later edit is accepted can depend on the lock and simulation owner the earlier edit leaves behind
+    if (edit.properties.lockedChanged() || edit.properties.simulationOwnerChanged()) {
+        return false;
+    }
+
+    EntityPropertyFlags changed = edit.properties.getChangedProperties();
+    if (changed.isEmpty()) {
+        return false;
+    }
+    EntityPropertyFlags laterChanged = laterEdit.properties.getChangedProperties();
+    for (int flag = changed.firstFlag(); flag <= changed.lastFlag(); ++flag) {
+        if (changed.getHasProperty((EntityPropertyList)flag) && !laterChanged.getHasProperty((EntityPropertyList)flag)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int EntityTree::applyDecodedEdits() {
+    // an edit is dropped when a later edit of the same entity from the same sender sets all the same properties, since
+    // applying it would only be overwritten. An entity filter or script allowlist may reject or alter the later edit,
+    // which would lose the earlier one as well, so nothing is dropped while either is in use.
+    std::vector<bool> coalesced(_decodedEdits.size(), false);
+    bool canCoalesce = !_hasEntityEditFilter && _entityScriptSourceAllowlist.isEmpty();
+    QHash<EntityItemID, size_t> laterEdits;
+    for (size_t i = _decodedEdits.size(); canCoalesce && i-- > 0;) {
+        const DecodedEdit& edit = _decodedEdits[i];
+        auto later = laterEdits.find(edit.entityID);
+        if (later != laterEdits.end()) {
+            coalesced[i] = isCoveredBy(edit, _decodedEdits[later.value()]);
+            later.value() = i;
+        } else {
+            laterEdits.insert(edit.entityID, i);
+        }
+    }
+
+    int numApplied = 0;
+    for (size_t i = 0; i < _decodedEdits.size(); ++i) {
+        DecodedEdit& edit = _decodedEdits[i];
+        _totalEditMessages++;
+        if (coalesced[i]) {
+            _totalDecodeTime += edit.decodeTime;
+        } else {
+            applyEdit(edit);
+            numApplied++;
+        }
+    }
+    _decodedEdits.clear();
+    return numApplied;
+}
 
 void EntityTree::notifyNewlyCreatedEntity(const EntityItem& newEntity, const SharedNodePointer& senderNode) {
     _newlyCreatedHooksLock.lockForRead();
@@ -2184,11 +2368,7 @@ int EntityTree::processEraseMessageDetails(const QByteArray& dataByteArray, cons
 }
 
 EntityTreeElementPointer EntityTree::getContainingElement(const EntityItemID& entityItemID)  /*const*/ {
-    EntityItemPointer entity;
-    {
-        QReadLocker locker(&_entityMapLock);
-        entity = _entityMap.value(entityItemID);
-    }
+    EntityItemPointer entity = _entityMap.value(entityItemID);
     if (entity) {
         return entity->getElement();
     }
@@ -2197,25 +2377,50 @@ EntityTreeElementPointer EntityTree::getContainingElement(const EntityItemID& en
 
 void EntityTree::addEntityMapEntry(EntityItemPointer entity) {
     EntityItemID id = entity->getEntityItemID();
-    QWriteLocker locker(&_entityMapLock);
-    EntityItemPointer otherEntity = _entityMap.value(id);
-    if (otherEntity) {
+    if (!_entityMap.insert(id, entity)) {
         qCWarning(entities) << "EntityTree::addEntityMapEntry() found pre-existing id " << id;
         assert(false);
-        return;
     }
-    _entityMap.insert(id, entity);
 }
 
 void EntityTree::clearEntityMapEntry(const EntityItemID& id) {
-    QWriteLocker locker(&_entityMapLock);
     _entityMap.remove(id);
 }
 
+// Called by EntityTreeElement whenever an entity is added to or removed from an element, which covers every add,
+// move and delete, with a null element on removal.
+void EntityTree::entityElementChanged(const EntityItemPointer& entity, const EntityTreeElementPointer& element) {
+    if (!_bvh) {
+        return;
+    }
+    if (element) {
+        _bvh->insert(entity, AABox(element->getAACube()));
+    } else {
+        _bvh->remove(entity->getEntityItemID());
+    }
+}
+
+void EntityTree::setBVHEnabled(bool enabled) {
+    withWriteLock([&] {
+        if (enabled == (bool)_bvh) {
+            return;
+        }
+        if (!enabled) {
+            _bvh.reset();
+            return;
+        }
+        _bvh = std::make_unique<EntityBVH>();
+        _entityMap.forEach([&](const EntityItemPointer& entity) {
+            EntityTreeElementPointer element = entity->getElement();
+            if (element) {
+                entityElementChanged(entity, element);
+            }
+        });
+    });
+}
+
 void EntityTree::debugDumpMap() {
-    // QHash's are implicitly shared, so we make a shared copy and use that instead.
-    // This way we might be able to avoid both a lock and a true copy.
-    QHash<EntityItemID, EntityItemPointer> localMap(_entityMap);
+    QHash<EntityItemID, EntityItemPointer> localMap = _entityMap.toHash();
     qCDebug(entities) << "EntityTree::debugDumpMap() --------------------------";
     QHashIterator<EntityItemID, EntityItemPointer> i(localMap);
     while (i.hasNext()) {
@@ -2716,23 +2921,7 @@ bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
     // These are needed to deal with older content (before adding inheritance modes)
     int contentVersion = map["Version"].toInt();
 
-    if (map.contains("Id")) {
-        _persistID = map["Id"].toUuid();
-    }
-
-    if (map.contains("DataVersion")) {
-        _persistDataVersion = map["DataVersion"].toInt();
-    }
-
-    _namedPaths.clear();
-    if (map.contains("Paths")) {
-        QVariantMap namedPathsMap = map["Paths"].toMap();
-        for(QVariantMap::const_iterator iter = namedPathsMap.begin(); iter != namedPathsMap.end(); ++iter) {
-            QString namedPathName = iter.key();
-            QString namedPathViewPoint = iter.value().toString();
-            _namedPaths[namedPathName] = namedPathViewPoint;
-        }
-    }
+    readPersistInfoFromMap(map);
 
     // map will have a top-level list keyed as "Entities".  This will be extracted
     // and iterated over.  Each member of this list is converted to a QVariantMap, then
@@ -2752,172 +2941,239 @@ bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
     foreach (QVariant entityVariant, entitiesQList) {
         // QVariantMap --> ScriptValue --> EntityItemProperties --> Entity
         QVariantMap entityMap = entityVariant.toMap();
+        success = readEntityFromMap(entityMap, contentVersion, isImport, cloneIDs) && success;
+    }
 
-        // handle parentJointName for wearables
-        if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
-            QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
+    fixupCloneIDs(cloneIDs);
 
-            entityMap["parentJointIndex"] = _myAvatar->getJointIndex(entityMap["parentJointName"].toString());
+    return success;
+}
 
-            qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
-                " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
-        }
+// Unlike readFromMap, the entities are read one at a time as they are parsed, so that the whole content set is never
+// held as QVariants on top of the entities built from it.
+bool EntityTree::readFromParser(OctreeEntitiesFileParser& parser, const bool isImport) {
+    // the version is needed to convert the entities, and is written after them
+    QVariantMap map;
+    if (!parser.parseHeader(map)) {
+        qCritical() << "Couldn't parse Entities JSON:" << parser.getErrorString().c_str();
+        return false;
+    }
 
-        EntityItemProperties properties;
-        _helperScriptEngine.run( [&] {
-            ScriptValue entityScriptValue = variantMapToScriptValue(entityMap, *_helperScriptEngine.get());
-            EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
-        });
+    int contentVersion = map["Version"].toInt();
+    readPersistInfoFromMap(map);
 
-        EntityItemID entityItemID;
-        if (entityMap.contains("id")) {
-            entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
-        } else {
-            entityItemID = EntityItemID(QUuid::createUuid());
-        }
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
 
-        // Convert old clientOnly bool to new entityHostType enum
-        // (must happen before setOwningAvatarID below)
-        if (contentVersion < (int)EntityVersion::EntityHostTypes) {
-            if (entityMap.contains("clientOnly")) {
-                properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
-            }
-        }
+    bool success = true;
+    int numEntities = 0;
+    bool parsed = parser.parseEntities([&](const QJsonObject& entityObject) {
+        // QJsonObject --> QVariantMap --> ScriptValue --> EntityItemProperties --> Entity
+        QVariantMap entityMap = entityObject.toVariantMap();
+        success = readEntityFromMap(entityMap, contentVersion, isImport, cloneIDs) && success;
+        ++numEntities;
+        return true;
+    });
 
-        if (properties.getEntityHostType() == entity::HostType::AVATAR) {
-            auto nodeList = DependencyManager::get<NodeList>();
-            const QUuid myNodeID = nodeList->getSessionUUID();
-            properties.setOwningAvatarID(myNodeID);
-        }
+    fixupCloneIDs(cloneIDs);
 
-        // Fix for older content not containing mode fields in the zones
-        if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
-            // The legacy version had no keylight mode - this is set to on
-            properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
+    if (!parsed) {
+        qCritical() << "Couldn't parse Entities JSON:" << parser.getErrorString().c_str();
+        return false;
+    }
 
-            // The ambient URL has been moved from "keyLight" to "ambientLight"
-            if (entityMap.contains("keyLight")) {
-                QVariantMap keyLightObject = entityMap["keyLight"].toMap();
-                properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
-            }
+    if (numEntities == 0) {
+        qCDebug(entities) << "EntityTree::readFromParser: no entities, Empty map or invalidly formed file";
+        return false;
+    }
 
-            // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
-            // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
-            properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
-            if (properties.getAmbientLight().getAmbientURL() == "") {
-                if (properties.getSkybox().getUrl() != "") {
-                    properties.getAmbientLight().setAmbientURL(properties.getSkybox().getUrl());
-                } else {
-                    properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
-                }
-            }
+    return success;
+}
 
-            // The background should be enabled if the mode is skybox
-            // Note that if the values are default then they are not stored in the JSON file
-            if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
-                properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
-            } else {
-                properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
-            }
+void EntityTree::readPersistInfoFromMap(const QVariantMap& map) {
+    if (map.contains("Id")) {
+        _persistID = map["Id"].toUuid();
+    }
+
+    if (map.contains("DataVersion")) {
+        _persistDataVersion = map["DataVersion"].toInt();
+    }
+
+    _namedPaths.clear();
+    if (map.contains("Paths")) {
+        QVariantMap namedPathsMap = map["Paths"].toMap();
+        for(QVariantMap::const_iterator iter = namedPathsMap.begin(); iter != namedPathsMap.end(); ++iter) {
+            QString namedPathName = iter.key();
+            QString namedPathViewPoint = iter.value().toString();
+            _namedPaths[namedPathName] = namedPathViewPoint;
         }
+    }
+}
 
-        // Convert old materials so that they use materialData instead of userData
-        if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
-            if (properties.getMaterialURL().startsWith("userData")) {
-                QString materialURL = properties.getMaterialURL();
-                properties.setMaterialURL(materialURL.replace("userData", "materialData"));
+bool EntityTree::readEntityFromMap(QVariantMap& entityMap, int contentVersion, const bool isImport,
+                                   QMap<QUuid, QVector<QUuid>>& cloneIDs) {
+    // handle parentJointName for wearables
+    if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
+        QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
 
-                QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-                QJsonObject materialData;
-                QJsonValue materialVersion = userData["materialVersion"];
-                if (!materialVersion.isNull()) {
-                    materialData.insert("materialVersion", materialVersion);
-                    userData.remove("materialVersion");
-                }
-                QJsonValue materials = userData["materials"];
-                if (!materials.isNull()) {
-                    materialData.insert("materials", materials);
-                    userData.remove("materials");
-                }
+        entityMap["parentJointIndex"] = _myAvatar->getJointIndex(entityMap["parentJointName"].toString());
 
-                properties.setMaterialData(QJsonDocument(materialData).toJson());
-                properties.setUserData(QJsonDocument(userData).toJson());
-            }
-        }
+        qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
+            " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
+    }
 
-        // Convert old cloneable entities so they use cloneableData instead of userData
-        if (contentVersion < (int)EntityVersion::CloneableData) {
-            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-            QJsonObject grabbableKey = userData["grabbableKey"].toObject();
-            QJsonValue cloneable = grabbableKey["cloneable"];
-            if (cloneable.isBool() && cloneable.toBool()) {
-                QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
-                QJsonValue cloneLimit = grabbableKey["cloneLimit"];
-                QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
-                QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+    EntityItemProperties properties;
+    _helperScriptEngine.run( [&] {
+        ScriptValue entityScriptValue = variantMapToScriptValue(entityMap, *_helperScriptEngine.get());
+        EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+    });
 
-                // This is cloneable, we need to convert the properties
-                properties.setCloneable(true);
-                properties.setCloneLifetime(cloneLifetime.toInt());
-                properties.setCloneLimit(cloneLimit.toInt());
-                properties.setCloneDynamic(cloneDynamic.toBool());
-                properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
-            }
-        }
+    EntityItemID entityItemID;
+    if (entityMap.contains("id")) {
+        entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
+    } else {
+        entityItemID = EntityItemID(QUuid::createUuid());
+    }
 
-        // convert old grab-related userData to new grab properties
-        if (contentVersion < (int)EntityVersion::GrabProperties) {
-            convertGrabUserDataToProperties(properties);
+    // Convert old clientOnly bool to new entityHostType enum
+    // (must happen before setOwningAvatarID below)
+    if (contentVersion < (int)EntityVersion::EntityHostTypes) {
+        if (entityMap.contains("clientOnly")) {
+            properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
         }
+    }
+
+    if (properties.getEntityHostType() == entity::HostType::AVATAR) {
+        auto nodeList = DependencyManager::get<NodeList>();
+        const QUuid myNodeID = nodeList->getSessionUUID();
+        properties.setOwningAvatarID(myNodeID);
+    }
 
-        // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
-        if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
-            properties.setRadiusSpread(0.0f);
-            properties.setAlphaSpread(0.0f);
-            properties.setColorSpread({0, 0, 0});
+    // Fix for older content not containing mode fields in the zones
+    if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
+        // The legacy version had no keylight mode - this is set to on
+        properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
+
+        // The ambient URL has been moved from "keyLight" to "ambientLight"
+        if (entityMap.contains("keyLight")) {
+            QVariantMap keyLightObject = entityMap["keyLight"].toMap();
+            properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
         }
 
-        if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
-            if (entityMap.contains("created")) {
-                quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
-                properties.setCreated(created);
+        // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
+        // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
+        properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
+        if (properties.getAmbientLight().getAmbientURL() == "") {
+            if (properties.getSkybox().getUrl() != "") {
+                properties.getAmbientLight().setAmbientURL(properties.getSkybox().getUrl());
+            } else {
+                properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
             }
         }
 
-        // Before, billboarded entities ignored rotation.  Now, they use it to determine which axis is facing you.
-        if (contentVersion < (int)EntityVersion::AllBillboardMode) {
-            if (properties.getBillboardMode() != BillboardMode::NONE) {
-                properties.setRotation(glm::quat());
+        // The background should be enabled if the mode is skybox
+        // Note that if the values are default then they are not stored in the JSON file
+        if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
+            properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
+        } else {
+            properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
+        }
+    }
+
+    // Convert old materials so that they use materialData instead of userData
+    if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
+        if (properties.getMaterialURL().startsWith("userData")) {
+            QString materialURL = properties.getMaterialURL();
+            properties.setMaterialURL(materialURL.replace("userData", "materialData"));
+
+            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+            QJsonObject materialData;
+            QJsonValue materialVersion = userData["materialVersion"];
+            if (!materialVersion.isNull()) {
+                materialData.insert("materialVersion", materialVersion);
+                userData.remove("materialVersion");
+            }
+            QJsonValue materials = userData["materials"];
+            if (!materials.isNull()) {
+                materialData.insert("materials", materials);
+                userData.remove("materials");
             }
+
+            properties.setMaterialData(QJsonDocument(materialData).toJson());
+            properties.setUserData(QJsonDocument(userData).toJson());
         }
+    }
+
+    // Convert old cloneable entities so they use cloneableData instead of userData
+    if (contentVersion < (int)EntityVersion::CloneableData) {
+        QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+        QJsonObject grabbableKey = userData["grabbableKey"].toObject();
+        QJsonValue cloneable = grabbableKey["cloneable"];
+        if (cloneable.isBool() && cloneable.toBool()) {
+            QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
+            QJsonValue cloneLimit = grabbableKey["cloneLimit"];
+            QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
+            QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
 
-        // Before, animations weren't smoothed
-        if (contentVersion < (int)EntityVersion::AnimationSmoothFrames && properties.getType() == EntityTypes::EntityType::Model) {
-            properties.getAnimation().setSmoothFrames(false);
+            // This is cloneable, we need to convert the properties
+            properties.setCloneable(true);
+            properties.setCloneLifetime(cloneLifetime.toInt());
+            properties.setCloneLimit(cloneLimit.toInt());
+            properties.setCloneDynamic(cloneDynamic.toBool());
+            properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
         }
+    }
 
-        EntityItemPointer entity = addEntity(entityItemID, properties, isImport);
-        if (!entity) {
-            qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
-            success = false;
+    // convert old grab-related userData to new grab properties
+    if (contentVersion < (int)EntityVersion::GrabProperties) {
+        convertGrabUserDataToProperties(properties);
+    }
+
+    // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
+    if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
+        properties.setRadiusSpread(0.0f);
+        properties.setAlphaSpread(0.0f);
+        properties.setColorSpread({0, 0, 0});
+    }
+
+    if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
+        if (entityMap.contains("created")) {
+            quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
+            properties.setCreated(created);
         }
+    }
 
-        if (entity) {
-            const QUuid& cloneOriginID = entity->getCloneOriginID();
-            if (!cloneOriginID.isNull()) {
-                cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
-            }
+    // Before, billboarded entities ignored rotation.  Now, they use it to determine which axis is facing you.
+    if (contentVersion < (int)EntityVersion::AllBillboardMode) {
+        if (properties.getBillboardMode() != BillboardMode::NONE) {
+            properties.setRotation(glm::quat());
         }
     }
 
+    // Before, animations weren't smoothed
+    if (contentVersion < (int)EntityVersion::AnimationSmoothFrames && properties.getType() == EntityTypes::EntityType::Model) {
+        properties.getAnimation().setSmoothFrames(false);
+    }
+
+    EntityItemPointer entity = addEntity(entityItemID, properties, isImport);
+    if (!entity) {
+        qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
+        return false;
+    }
+
+    const QUuid& cloneOriginID = entity->getCloneOriginID();
+    if (!cloneOriginID.isNull()) {
+        cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+    }
+    return true;
+}
+
+void EntityTree::fixupCloneIDs(const QMap<QUuid, QVector<QUuid>>& cloneIDs) {
     for (const auto& entityID : cloneIDs.keys()) {
         auto entity = findEntityByID(entityID);
         if (entity) {
             entity->setCloneIDs(cloneIDs.value(entityID));
         }
     }
-
-    return success;
 }
 
 bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& element) {
@@ -2930,6 +3186,124 @@ bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& el
     return true;
 }
 
+bool EntityTree::writeToJSONStream(const std::function<void(const QString&)>& writeChunk, const OctreeElementPointer& element) {
+    const int JSON_CHUNK_SIZE = 256 * 1024;
+    _helperScriptEngine.run( [&] {
+        RecurseOctreeToJSONOperator theOperator(element, _helperScriptEngine.get());
+        theOperator.setChunkWriter(writeChunk, JSON_CHUNK_SIZE);
+        withReadLock([&] { recurseTreeWithOperator(&theOperator); });
+
+        writeChunk(theOperator.getJson());
+    });
+    return true;
+}
+
+bool EntityTree::writeItemsToJSON(const QSet<QUuid>& ids, QVector<QByteArray>& jsonItems) {
+    _helperScriptEngine.run( [&] {
+        ScriptEngine* engine = _helperScriptEngine.get();
+        // unlike the persist file, journal records are kept on a single line
+        ScriptValue toStringMethod = engine->evaluate("(function() { return JSON.stringify(this) })");
+
+        withReadLock([&] {
+            for (const auto& id : ids) {
+                EntityItemPointer entity = findEntityByEntityItemID(id);
+                if (!entity) {
+                    continue;
+                }
+
+                ScriptValue properties = EntityItemNonDefaultPropertiesToScriptValue(engine, entity->getProperties());
+                properties.setProperty("toString", toStringMethod);
+                jsonItems.push_back(properties.toString().toUtf8());
+            }
+        });
+    });
+    return true;
+}
+
+bool EntityTree::writeToSnapshotFile(const QString& filename) {
+    EntitySnapshot::Contents contents;
+    contents.info.id = getPersistID();
+    contents.info.dataVersion = getPersistDataVersion();
+    contents.info.version = (int)expectedVersion();
+
+    _helperScriptEngine.run( [&] {
+        ScriptEngine* engine = _helperScriptEngine.get();
+
+        // NOTE: lock the Tree first, then lock the _entityMap.
+        withReadLock([&] {
+            int numEntities = _entityMap.size();
+            contents.ids.reserve(numEntities);
+            contents.properties.reserve(numEntities);
+            _entityMap.forEach([&](const EntityItemPointer& entity) {
+                EntityItemProperties properties = entity->getProperties();
+                if (EntitySnapshot::canEncode(properties)) {
+                    contents.ids.push_back(entity->getEntityItemID());
+                    contents.properties.push_back(properties);
+                } else {
+                    QVariant entityVariant = EntityItemNonDefaultPropertiesToScriptValue(engine, properties).toVariant();
+                    contents.info.variantEntityData.push_back(entityVariant);
+                }
+            });
+            contents.namedPaths = _namedPaths;
+        });
+    });
+
+    return EntitySnapshot::write(filename, contents);
+}
+
+bool EntityTree::readFromSnapshotFile(const QString& filename) {
+    EntitySnapshot::Contents contents;
+    if (!EntitySnapshot::read(filename, contents)) {
+        return false;
+    }
+
+    // the properties are packet-encoded, which depends on the entity data version
+    if (contents.info.version != (int)expectedVersion()) {
+        qCDebug(entities) << "Ignoring entity snapshot" << filename << "of version" << contents.info.version;
+        return false;
+    }
+
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
+    auto addCloneID = [&](const EntityItemPointer& entity) {
+        const QUuid& cloneOriginID = entity->getCloneOriginID();
+        if (!cloneOriginID.isNull()) {
+            cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+        }
+    };
+
+    for (size_t i = 0; i < contents.ids.size(); ++i) {
+        EntityItemPointer entity = addEntity(contents.ids[i], contents.properties[i]);
+        if (!entity) {
+            qCDebug(entities) << "adding Entity failed:" << contents.ids[i] << contents.properties[i].getType();
+            continue;
+        }
+        addCloneID(entity);
+    }
+
+    // the entities that couldn't be packet-encoded are read like JSON content
+    if (!contents.info.variantEntityData.isEmpty()) {
+        QVariantMap map;
+        map["Version"] = (int)contents.info.version;
+        map["Entities"] = contents.info.variantEntityData;
+        readFromMap(map);
+
+        for (const auto& entityVariant : contents.info.variantEntityData) {
+            EntityItemPointer entity = findEntityByID(QUuid(entityVariant.toMap()["id"].toString()));
+            if (entity) {
+                addCloneID(entity);
+            }
+        }
+    }
+
+    _persistID = contents.info.id;
+    _persistDataVersion = contents.info.dataVersion;
+    _namedPaths = contents.namedPaths;
+
+    fixupCloneIDs(cloneIDs);
+
+    return true;
+}
+
 void EntityTree::resetClientEditStats() {
     _treeResetTime = usecTimestampNow();
     _maxEditDelta = 0;
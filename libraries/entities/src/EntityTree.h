@@ -18,8 +18,10 @@
 #include <HelperScriptEngine.h>
 #include <Octree.h>
 #include <SpatialParentFinder.h>
+#include <shared/ShardedHash.h>
 
 #include "AddEntityOperator.h"
+#include "EntityBVH.h"
 #include "EntityTreeElement.h"
 #include "DeleteEntityOperator.h"
 #include "MovingEntitiesOperator.h"
@@ -91,6 +93,10 @@ public:
     void fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties);
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& senderNode) override;
+    virtual int decodeEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                     const SharedNodePointer& senderNode) override;
+    virtual int getNumDecodedEdits() const override { return (int)_decodedEdits.size(); }
+    virtual int applyDecodedEdits() override;
 
     virtual EntityItemID evalRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
         QVector<EntityItemID> entityIdsToInclude, QVector<EntityItemID> entityIdsToDiscard,
@@ -144,6 +150,11 @@ public:
     void evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities);
     void evalEntitiesInFrustum(const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities);
 
+    // With the BVH enabled, the picks and evalEntitiesIn*() above search an EntityBVH instead of recursing the octree.
+    void setBVHEnabled(bool enabled);
+    bool isBVHEnabled() const { return (bool)_bvh; }
+    EntityBVH::Stats getBVHStats() const { return _bvh ? _bvh->getStats() : EntityBVH::Stats(); }
+
     void addNewlyCreatedHook(NewlyCreatedEntityHook* hook);
     void removeNewlyCreatedHook(NewlyCreatedEntityHook* hook);
 
@@ -170,6 +181,7 @@ public:
     EntityTreeElementPointer getContainingElement(const EntityItemID& entityItemID)  /*const*/;
     void addEntityMapEntry(EntityItemPointer entity);
     void clearEntityMapEntry(const EntityItemID& id);
+    void entityElementChanged(const EntityItemPointer& entity, const EntityTreeElementPointer& element);
     void debugDumpMap();
     virtual void dumpTree() override;
     virtual void pruneTree() override;
@@ -196,7 +208,13 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription, const bool isImport = false) override;
+    virtual bool readFromParser(OctreeEntitiesFileParser& parser, const bool isImport = false) override;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) override;
+    virtual bool writeToJSONStream(const std::function<void(const QString&)>& writeChunk,
+                                   const OctreeElementPointer& element) override;
+    virtual bool writeItemsToJSON(const QSet<QUuid>& ids, QVector<QByteArray>& jsonItems) override;
+    virtual bool writeToSnapshotFile(const QString& filename) override;
+    virtual bool readFromSnapshotFile(const QString& filename) override;
 
 
     glm::vec3 getContentsDimensions();
@@ -306,6 +324,24 @@ protected:
 
     bool isScriptInAllowlist(const QString& scriptURL);
 
+    class DecodedEdit {
+    public:
+        PacketType type { PacketType::Unknown };
+        EntityItemID entityID;
+        EntityItemID entityIDToClone;
+        EntityItemProperties properties;
+        SharedNodePointer senderNode;
+        bool valid { false };
+        quint64 decodeTime { 0 };
+    };
+
+    // everything an edit does once decoded, called with the tree write lock held
+    void applyEdit(DecodedEdit& edit, const EntityItemPointer& entityToClone = EntityItemPointer());
+    bool isCoveredBy(const DecodedEdit& edit, const DecodedEdit& laterEdit) const;
+
+    // edits staged by decodeEditPacketData(), only touched by the inbound packet processor thread
+    std::vector<DecodedEdit> _decodedEdits;
+
     QReadWriteLock _newlyCreatedHooksLock;
     QVector<NewlyCreatedEntityHook*> _newlyCreatedHooks;
 
@@ -325,8 +361,11 @@ protected:
         _deletedEntityItemIDs << id;
     }
 
-    mutable QReadWriteLock _entityMapLock;
-    QHash<EntityItemID, EntityItemPointer> _entityMap;
+    // looked up without the tree lock by scripts, physics and the send threads, so each shard has its own lock
+    ShardedHash<EntityItemID, EntityItemPointer> _entityMap;
+
+    // bounds every entity by its containing element, see entityElementChanged()
+    std::unique_ptr<EntityBVH> _bvh;
 
     EntitySimulationPointer _simulation;
 
@@ -388,6 +427,12 @@ private:
 
     std::map<QString, QString> _namedPaths;
 
+    // Helpers of readFromMap, also used when reading entities as they are parsed
+    void readPersistInfoFromMap(const QVariantMap& map);
+    bool readEntityFromMap(QVariantMap& entityMap, int contentVersion, const bool isImport,
+                           QMap<QUuid, QVector<QUuid>>& cloneIDs);
+    void fixupCloneIDs(const QMap<QUuid, QVector<QUuid>>& cloneIDs);
+
     // Return an AACube containing object and all its entity descendants
     AACube updateEntityQueryAACubeWorker(SpatiallyNestablePointer object, EntityEditPacketSender* packetSender,
                                          MovingEntitiesOperator& moveOperator, bool force, bool tellServer);
@@ -135,6 +135,24 @@ public:
     virtual bool deleteApproved() const override { return !hasEntities(); }
 
     static bool checkFilterSettings(const EntityItemPointer& entity, PickFilter searchFilter);
+    static bool checkEntityInSphere(const EntityItemPointer& entity, const glm::vec3& position, float radius);
+    static bool checkEntityName(const EntityItemPointer& entity, const QString& name, bool caseSensitive);
+    static bool checkEntityTags(const EntityItemPointer& entity, const QVector<QString>& tags, bool caseSensitive);
+
+    /// Tests a single entity against a ray, updating distance, face, surfaceNormal and extraInfo and returning true if it
+    /// is hit closer than distance.  Shared by the element and EntityBVH pick paths.
+    static bool evalEntityRayIntersection(const EntityItemPointer& entity, const glm::vec3& origin, const glm::vec3& direction,
+        const glm::vec3& viewFrustumPos, OctreeElementPointer& element, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
+        const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard,
+        PickFilter searchFilter, QVariantMap& extraInfo);
+    /// As evalEntityRayIntersection, for a parabola.  normal is the parabola plane's normal from computeParabolaPlaneNormal().
+    static bool evalEntityParabolaIntersection(const EntityItemPointer& entity, const glm::vec3& origin,
+        const glm::vec3& velocity, const glm::vec3& acceleration, const glm::vec3& viewFrustumPos, const glm::vec3& normal,
+        OctreeElementPointer& element, float& parabolicDistance, BoxFace& face, glm::vec3& surfaceNormal,
+        const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard,
+        PickFilter searchFilter, QVariantMap& extraInfo);
+    static glm::vec3 computeParabolaPlaneNormal(const glm::vec3& velocity, const glm::vec3& acceleration);
+
     virtual bool canPickIntersect() const override { return hasEntities(); }
     virtual EntityItemID evalRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& viewFrustumPos,
         OctreeElementPointer& element, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
@@ -25,6 +25,11 @@ RecurseOctreeToJSONOperator::RecurseOctreeToJSONOperator(const OctreeElementPoin
     _toStringMethod = _engine->evaluate("(function() { return JSON.stringify(this, null, '    ') })");
 }
 
+void RecurseOctreeToJSONOperator::setChunkWriter(std::function<void(const QString&)> writeChunk, int chunkSize) {
+    _writeChunk = writeChunk;
+    _chunkSize = chunkSize;
+}
+
 bool RecurseOctreeToJSONOperator::postRecursion(const OctreeElementPointer& element) {
     EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
 
@@ -50,4 +55,8 @@ void RecurseOctreeToJSONOperator::processEntity(const EntityItemPointer& entity)
     // Override default toString():
     qScriptValues.setProperty("toString", _toStringMethod);
     _json += qScriptValues.toString();
+    if (_writeChunk && _json.size() >= _chunkSize) {
+        _writeChunk(_json);
+        _json.clear();
+    }
 }
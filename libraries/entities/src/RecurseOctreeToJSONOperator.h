@@ -11,6 +11,8 @@
 //  SPDX-License-Identifier: Apache-2.0
 //
 
+#include <functional>
+
 #include "EntityTree.h"
 
 #include <ScriptValue.h>
@@ -26,6 +28,10 @@ public:
 
     QString getJson() const { return _json; }
 
+    // Hands the JSON to writeChunk whenever it grows past chunkSize, instead of accumulating all of it.
+    // getJson() then returns what is left over at the end of the recursion.
+    void setChunkWriter(std::function<void(const QString&)> writeChunk, int chunkSize);
+
 private:
     void processEntity(const EntityItemPointer& entity);
 
@@ -36,4 +42,7 @@ private:
     const bool _skipDefaults;
     bool _skipThoseWithBadParents;
     bool _comma { false };
+
+    std::function<void(const QString&)> _writeChunk;
+    int _chunkSize { 0 };
 };
@@ -19,6 +19,79 @@
 #include <cassert>
 #include "WarningsSuppression.h"
 
+static_assert(HMACAuth::MAX_HASH_SIZE >= EVP_MAX_MD_SIZE, "HMACAuth::MAX_HASH_SIZE is too small for OpenSSL hashes");
+
+static const int SIPHASH_KEY_SIZE = 16;
+static const int SIPHASH_HASH_SIZE = 16;
+
+static inline uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t readLittleEndian64(const unsigned char* data) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) {
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+static inline void writeLittleEndian64(unsigned char* data, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        data[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+#define SIP_ROUND                                                             \
+    do {                                                                      \
+        v0 += v1; v1 = rotateLeft(v1, 13); v1 ^= v0; v0 = rotateLeft(v0, 32); \
+        v2 += v3; v3 = rotateLeft(v3, 16); v3 ^= v2;                          \
+        v0 += v3; v3 = rotateLeft(v3, 21); v3 ^= v0;                          \
+        v2 += v1; v1 = rotateLeft(v1, 17); v1 ^= v2; v2 = rotateLeft(v2, 32); \
+    } while (0)
+
+// SipHash-2-4 with a 128-bit output, see https://www.aumasson.jp/siphash/siphash.pdf
+static void sipHash128(const uint64_t key[2], const unsigned char* data, size_t length, unsigned char* hashResult) {
+    uint64_t v0 = 0x736f6d6570736575ULL ^ key[0];
+    uint64_t v1 = 0x646f72616e646f6dULL ^ key[1] ^ 0xee;
+    uint64_t v2 = 0x6c7967656e657261ULL ^ key[0];
+    uint64_t v3 = 0x7465646279746573ULL ^ key[1];
+
+    const unsigned char* end = data + (length & ~(size_t)7);
+    for (; data != end; data += 8) {
+        uint64_t message = readLittleEndian64(data);
+        v3 ^= message;
+        SIP_ROUND;
+        SIP_ROUND;
+        v0 ^= message;
+    }
+
+    // the last block holds the remaining bytes and the low byte of the length
+    uint64_t lastBlock = (uint64_t)length << 56;
+    for (size_t i = 0; i < (length & 7); ++i) {
+        lastBlock |= (uint64_t)data[i] << (8 * i);
+    }
+    v3 ^= lastBlock;
+    SIP_ROUND;
+    SIP_ROUND;
+    v0 ^= lastBlock;
+
+    v2 ^= 0xee;
+    SIP_ROUND;
+    SIP_ROUND;
+    SIP_ROUND;
+    SIP_ROUND;
+    writeLittleEndian64(hashResult, v0 ^ v1 ^ v2 ^ v3);
+
+    v1 ^= 0xdd;
+    SIP_ROUND;
+    SIP_ROUND;
+    SIP_ROUND;
+    SIP_ROUND;
+    writeLittleEndian64(hashResult + 8, v0 ^ v1 ^ v2 ^ v3);
+}
+
+#undef SIP_ROUND
 
 OVERTE_IGNORE_DEPRECATED_BEGIN
 // Qt provides HMAC, do we actually need this here?
@@ -50,6 +123,7 @@ HMACAuth::~HMACAuth() {
 
 bool HMACAuth::setKey(const char* keyValue, int keyLen) {
     const EVP_MD* sslStruct = nullptr;
+    QMutexLocker lock(&_lock);
 
     switch (_authMethod) {
     case MD5:
@@ -72,11 +146,21 @@ bool HMACAuth::setKey(const char* keyValue, int keyLen) {
         sslStruct = EVP_ripemd160();
         break;
 
+    case SIPHASH: {
+        if (keyLen != SIPHASH_KEY_SIZE) {
+            return false;
+        }
+        const unsigned char* keyBytes = reinterpret_cast<const unsigned char*>(keyValue);
+        _sipHashKey[0] = readLittleEndian64(keyBytes);
+        _sipHashKey[1] = readLittleEndian64(keyBytes + 8);
+        _sipHashData.clear();
+        return true;
+    }
+
     default:
         return false;
     }
 
-    QMutexLocker lock(&_lock);
     return (bool) HMAC_Init_ex(_hmacContext, keyValue, keyLen, sslStruct, nullptr);
 }
 
@@ -85,8 +169,20 @@ bool HMACAuth::setKey(const QUuid& uidKey) {
     return setKey(rfcBytes.constData(), rfcBytes.length());
 }
 
+bool HMACAuth::setKey(AuthMethod authMethod, const QUuid& uidKey) {
+    QMutexLocker lock(&_lock);
+    _authMethod = authMethod;
+    _sipHashData.clear();
+    return setKey(uidKey);
+}
+
 bool HMACAuth::addData(const char* data, int dataLen) {
     QMutexLocker lock(&_lock);
+    if (_authMethod == SIPHASH) {
+        // SipHash needs the length of the data up front, so hold on to it until result() is called
+        _sipHashData.append(data, dataLen);
+        return true;
+    }
     return (bool) HMAC_Update(_hmacContext, reinterpret_cast<const unsigned char*>(data), dataLen);
 }
 
@@ -95,6 +191,14 @@ HMACAuth::HMACHash HMACAuth::result() {
     unsigned int hashLen;
     QMutexLocker lock(&_lock);
 
+    if (_authMethod == SIPHASH) {
+        sipHash128(_sipHashKey, reinterpret_cast<const unsigned char*>(_sipHashData.constData()),
+                   (size_t)_sipHashData.size(), &hashValue[0]);
+        hashValue.resize(SIPHASH_HASH_SIZE);
+        _sipHashData.clear();
+        return hashValue;
+    }
+
     auto hmacResult = HMAC_Final(_hmacContext, &hashValue[0], &hashLen);
 
     if (hmacResult) {
@@ -111,16 +215,36 @@ HMACAuth::HMACHash HMACAuth::result() {
 }
 
 bool HMACAuth::calculateHash(HMACHash& hashResult, const char* data, int dataLen) {
-    QMutexLocker lock(&_lock);
-    if (!addData(data, dataLen)) {
-        qCWarning(networking) << "Error occured calling HMACAuth::addData()";
+    unsigned char hashValue[MAX_HASH_SIZE];
+    int hashLen = calculateHash(hashValue, data, dataLen);
+    if (hashLen == 0) {
+        qCWarning(networking) << "Error occured calling HMACAuth::calculateHash()";
         assert(false);
         return false;
     }
 
-    hashResult = result();
+    hashResult.assign(hashValue, hashValue + hashLen);
     return true;
 }
 
+int HMACAuth::calculateHash(unsigned char* hashResult, const char* data, int dataLen) {
+    QMutexLocker lock(&_lock);
+    if (_authMethod == SIPHASH) {
+        // only the key needs the lock, so threads sending to the same node can hash their packets in parallel
+        uint64_t key[2] { _sipHashKey[0], _sipHashKey[1] };
+        lock.unlock();
+        sipHash128(key, reinterpret_cast<const unsigned char*>(data), (size_t)dataLen, hashResult);
+        return SIPHASH_HASH_SIZE;
+    }
+
+    unsigned int hashLen = 0;
+    bool success = HMAC_Update(_hmacContext, reinterpret_cast<const unsigned char*>(data), dataLen)
+        && HMAC_Final(_hmacContext, hashResult, &hashLen);
+
+    // Reset to the keyed state for the next hash, which OpenSSL keeps around so the key isn't processed again.
+    HMAC_Init_ex(_hmacContext, nullptr, 0, nullptr, nullptr);
+    return success ? (int)hashLen : 0;
+}
+
 OVERTE_IGNORE_DEPRECATED_END
 
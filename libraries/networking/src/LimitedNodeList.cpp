@@ -361,18 +361,18 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
 
             if (verifiedPacket && verificationEnabled) {
 
-                QByteArray packetHeaderHash = NLPacket::verificationHashInHeader(packet);
-                QByteArray expectedHash;
                 auto sourceNodeHMACAuth = sourceNode->getAuthenticateHash();
-                if (sourceNode->getAuthenticateHash()) {
-                    expectedHash = NLPacket::hashForPacketAndHMAC(packet, *sourceNodeHMACAuth);
-                }
 
-                // check if the HMAC-md5 hash in the header matches the hash we would expect
-                if (!sourceNodeHMACAuth || packetHeaderHash != expectedHash) {
+                // check if the hash in the header matches the hash we would expect
+                if (!sourceNodeHMACAuth || !NLPacket::verificationHashMatches(packet, *sourceNodeHMACAuth)) {
                     static QMultiMap<QUuid, PacketType> hashDebugSuppressMap;
 
                     if (!hashDebugSuppressMap.contains(sourceID, headerType)) {
+                        QByteArray packetHeaderHash = NLPacket::verificationHashInHeader(packet);
+                        QByteArray expectedHash;
+                        if (sourceNodeHMACAuth) {
+                            expectedHash = NLPacket::hashForPacketAndHMAC(packet, *sourceNodeHMACAuth);
+                        }
                         qCDebug(networking) << "Packet hash mismatch on" << headerType << "- Sender" << sourceID;
                         qCDebug(networking) << "Packet len:" << packet.getDataSize() << "Expected hash:" <<
                             expectedHash.toHex() << "Actual:" << packetHeaderHash.toHex();
@@ -693,7 +693,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
         matchingNode->setPublicSocket(publicSocket);
         matchingNode->setLocalSocket(localSocket);
         matchingNode->setPermissions(permissions);
-        matchingNode->setConnectionSecret(connectionSecret);
+        matchingNode->setConnectionSecret(connectionSecret, _authenticationMethod);
         matchingNode->setIsReplicated(isReplicated);
         matchingNode->setIsUpstream(isUpstream || NodeType::isUpstream(nodeType));
         matchingNode->setLocalID(localID);
@@ -732,7 +732,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
     Node* newNode = new Node(uuid, nodeType, publicSocket, localSocket);
     newNode->setIsReplicated(isReplicated);
     newNode->setIsUpstream(isUpstream || NodeType::isUpstream(nodeType));
-    newNode->setConnectionSecret(connectionSecret);
+    newNode->setConnectionSecret(connectionSecret, _authenticationMethod);
     newNode->setPermissions(permissions);
     newNode->setLocalID(localID);
 
@@ -938,6 +938,7 @@ void LimitedNodeList::removeSilentNodes() {
             << "    Inbound Kbps: " << killedNode->getInboundKbps() << "\n"
             << "    Ping: " << killedNode->getPingMs();
         handleNodeKill(killedNode);
+        emit silentNodeRemoved(killedNode);
     }
 }
 
@@ -15,6 +15,7 @@
 
 #include <assert.h>
 #include <stdint.h>
+#include <atomic>
 #include <iterator>
 #include <memory>
 #include <set>
@@ -316,6 +317,8 @@ public:
     udt::Socket::StatsVector sampleStatsForAllConnections() { return _nodeSocket.sampleStatsForAllConnections(); }
 
     void setConnectionMaxBandwidth(int maxBandwidth) { _nodeSocket.setConnectionMaxBandwidth(maxBandwidth); }
+    void setCongestionControlFactory(std::unique_ptr<udt::CongestionControlVirtualFactory> ccFactory)
+        { _nodeSocket.setCongestionControlFactory(std::move(ccFactory)); }
 
     void setPacketFilterOperator(udt::PacketFilterOperator filterOperator) { _nodeSocket.setPacketFilterOperator(filterOperator); }
     bool packetVersionMatch(const udt::Packet& packet);
@@ -324,6 +327,9 @@ public:
     bool isPacketVerified(const udt::Packet& packet) { return isPacketVerifiedWithSource(packet); }
     void setAuthenticatePackets(bool useAuthentication) { _useAuthentication = useAuthentication; }
     bool getAuthenticatePackets() const { return _useAuthentication; }
+    // The hash the connection secrets of nodes added from now on are used with
+    void setAuthenticationMethod(HMACAuth::AuthMethod authMethod) { _authenticationMethod = authMethod; }
+    HMACAuth::AuthMethod getAuthenticationMethod() const { return _authenticationMethod; }
 
     void setFlagTimeForConnectionStep(bool flag) { _flagTimeForConnectionStep = flag; }
     bool isFlagTimeForConnectionStep() { return _flagTimeForConnectionStep; }
@@ -378,6 +384,7 @@ signals:
     void nodeAdded(SharedNodePointer);
     void nodeSocketUpdated(SharedNodePointer);
     void nodeKilled(SharedNodePointer);
+    void silentNodeRemoved(SharedNodePointer);
     void nodeActivated(SharedNodePointer);
 
     void clientConnectionToNodeReset(SharedNodePointer);
@@ -450,6 +457,7 @@ protected:
     SockAddr _stunSockAddr { SocketType::UDP, STUN_SERVER_HOSTNAME, STUN_SERVER_PORT };
     bool _hasTCPCheckedLocalSocket { false };
     bool _useAuthentication { true };
+    std::atomic<HMACAuth::AuthMethod> _authenticationMethod { HMACAuth::MD5 };
 
     PacketReceiver* _packetReceiver;
 
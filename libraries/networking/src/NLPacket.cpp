@@ -12,6 +12,9 @@
 
 #include "NLPacket.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "HMACAuth.h"
 
 int NLPacket::localHeaderSize(PacketType type) {
@@ -153,16 +156,34 @@ QByteArray NLPacket::verificationHashInHeader(const udt::Packet& packet) {
     return QByteArray(packet.getData() + offset, NUM_BYTES_MD5_HASH);
 }
 
-QByteArray NLPacket::hashForPacketAndHMAC(const udt::Packet& packet, HMACAuth& hash) {
-    int offset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
+static int calculateHashForPacket(const udt::Packet& packet, HMACAuth& hash, unsigned char* hashResult) {
+    int offset = udt::Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
         + NUM_BYTES_LOCALID + NUM_BYTES_MD5_HASH;
-    
-    // add the packet payload and the connection UUID
-    HMACAuth::HMACHash hashResult;
-    if (!hash.calculateHash(hashResult, packet.getData() + offset, packet.getDataSize() - offset)) {
-        return QByteArray();
+
+    int payloadSize = (int)packet.getDataSize() - offset;
+    if (payloadSize < 0) {
+        return 0;
+    }
+
+    // hash the packet payload with the connection secret
+    return hash.calculateHash(hashResult, packet.getData() + offset, payloadSize);
+}
+
+QByteArray NLPacket::hashForPacketAndHMAC(const udt::Packet& packet, HMACAuth& hash) {
+    unsigned char hashResult[HMACAuth::MAX_HASH_SIZE];
+    int hashSize = calculateHashForPacket(packet, hash, hashResult);
+    return QByteArray((const char*) hashResult, hashSize);
+}
+
+bool NLPacket::verificationHashMatches(const udt::Packet& packet, HMACAuth& hash) {
+    unsigned char hashResult[HMACAuth::MAX_HASH_SIZE];
+    if (calculateHashForPacket(packet, hash, hashResult) != NUM_BYTES_MD5_HASH) {
+        return false;
     }
-    return QByteArray((const char*) hashResult.data(), (int) hashResult.size());
+
+    int offset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) +
+        sizeof(PacketVersion) + NUM_BYTES_LOCALID;
+    return memcmp(packet.getData() + offset, hashResult, NUM_BYTES_MD5_HASH) == 0;
 }
 
 void NLPacket::writeTypeAndVersion() {
@@ -224,7 +245,10 @@ void NLPacket::writeVerificationHash(HMACAuth& hmacAuth) const {
     auto offset = Packet::totalHeaderSize(isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
                 + NUM_BYTES_LOCALID;
 
-    QByteArray verificationHash = hashForPacketAndHMAC(*this, hmacAuth);
-    
-    memcpy(_packet.get() + offset, verificationHash.data(), verificationHash.size());
+    // the header has room for a 16 byte hash, which all the methods used for packets produce
+    unsigned char verificationHash[HMACAuth::MAX_HASH_SIZE];
+    int hashSize = calculateHashForPacket(*this, hmacAuth, verificationHash);
+    Q_ASSERT(hashSize == NUM_BYTES_MD5_HASH);
+
+    memcpy(_packet.get() + offset, verificationHash, std::min(hashSize, NUM_BYTES_MD5_HASH));
 }
@@ -234,17 +234,20 @@ QDebug operator<<(QDebug debug, const Node& node) {
     return debug.nospace();
 }
 
-void Node::setConnectionSecret(const QUuid& connectionSecret) {
-    if (_connectionSecret == connectionSecret) {
+void Node::setConnectionSecret(const QUuid& connectionSecret, HMACAuth::AuthMethod authMethod) {
+    if (_connectionSecret == connectionSecret &&
+        (!_authenticateHash || _authenticateHash->getAuthMethod() == authMethod)) {
         return;
     }
 
+    _connectionSecret = connectionSecret;
     if (!_authenticateHash) {
-        _authenticateHash.reset(new HMACAuth());
+        _authenticateHash.reset(new HMACAuth(authMethod));
+        _authenticateHash->setKey(_connectionSecret);
+    } else {
+        // other threads may be hashing with it, so switch the method and key together rather than replacing it
+        _authenticateHash->setKey(authMethod, _connectionSecret);
     }
-
-    _connectionSecret = connectionSecret;
-    _authenticateHash->setKey(_connectionSecret);
 }
 
 void Node::updateStats(Stats stats) {
@@ -126,6 +126,10 @@ NodeList::NodeList(char newOwnerType, int socketListenPort, int dtlsListenPort)
     // anytime we get a new node we may need to re-send our set of ignored node IDs to it
     connect(this, &LimitedNodeList::nodeActivated, this, &NodeList::maybeSendIgnoreSetToNode);
 
+    // a node we removed because it went silent is still in the domain-server's list, only a full list re-adds it.
+    // Nodes the domain-server tells us it removed are already gone from its list.
+    connect(this, &LimitedNodeList::silentNodeRemoved, this, [this] { _domainListVersion = 0; });
+
     // setup our timer to send keepalive pings (it's started and stopped on domain connect/disconnect)
     _keepAlivePingTimer.setInterval(KEEPALIVE_PING_INTERVAL_MS); // 1s, Qt::CoarseTimer acceptable
     connect(&_keepAlivePingTimer, &QTimer::timeout, this, &NodeList::sendKeepAlivePings);
@@ -318,6 +322,11 @@ void NodeList::reset(QString reason, bool skipDomainHandlerReset) {
         _domainHandler.softReset(reason);
     }
 
+    // the next domain list has to be a full one
+    _domainListVersion = 0;
+    _pendingDomainListVersion = 0;
+    _pendingDomainListNodeIDs.clear();
+
     // refresh the owner UUID to the NULL UUID
     setSessionUUID(QUuid());
     setSessionLocalID(Node::NULL_LOCAL_ID);
@@ -330,10 +339,16 @@ void NodeList::reset(QString reason, bool skipDomainHandlerReset) {
 
 void NodeList::addNodeTypeToInterestSet(NodeType_t nodeTypeToAdd) {
     _nodeTypesOfInterest << nodeTypeToAdd;
+
+    // the nodes of the new type are only in a full list, ask for one until we have it
+    _domainListVersion = 0;
 }
 
 void NodeList::addSetOfNodeTypesToNodeInterestSet(const NodeSet& setOfNodeTypes) {
     _nodeTypesOfInterest.unite(setOfNodeTypes);
+
+    // the nodes of the new types are only in a full list, ask for one until we have it
+    _domainListVersion = 0;
 }
 
 void NodeList::sendDomainServerCheckIn() {
@@ -504,7 +519,10 @@ void NodeList::sendDomainServerCheckIn() {
             << localSockAddr << _nodeTypesOfInterest.values();
         packetStream << DependencyManager::get<AddressManager>()->getPlaceName();
 
-        if (!domainIsConnected) {
+        if (domainIsConnected) {
+            // let the domain-server know which version of the node list we have, so it only sends what changed since
+            packetStream << _domainListVersion;
+        } else {
 
             // Directory services account.
             DataServerAccountInfo& accountInfo = accountManager->getAccountInfo();
@@ -751,6 +769,10 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
     bool isAuthenticated;
     packetStream >> isAuthenticated;
 
+    // and which hash do the connections it hands out use
+    quint8 authenticationMethod;
+    packetStream >> authenticationMethod;
+
     qint64 now = qint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
 
     quint64 connectRequestTimestamp;
@@ -765,6 +787,13 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
     bool newConnection;
     packetStream >> newConnection;
 
+    // the version of the domain's node list this list brings us to, the version it is a delta from (zero for a full list),
+    // and the number of nodes in the list, which may be split across several unreliable packets
+    quint32 listVersion;
+    quint32 baseListVersion;
+    quint32 numListNodes;
+    packetStream >> listVersion >> baseListVersion >> numListNodes;
+
     if (newConnection) {
         _nodeConnectTimestamp = usecTimestampNow();
         _connectReason = Connect;
@@ -860,10 +889,25 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
 
     setPermissions(newPermissions);
     setAuthenticatePackets(isAuthenticated);
+    // the domain-server only ever picks one of these, fall back to HMAC-MD5 rather than trust anything else
+    setAuthenticationMethod(authenticationMethod == HMACAuth::SIPHASH ? HMACAuth::SIPHASH : HMACAuth::MD5);
+
+    if (listVersion != _pendingDomainListVersion || baseListVersion != _pendingDomainListBaseVersion) {
+        _pendingDomainListVersion = listVersion;
+        _pendingDomainListBaseVersion = baseListVersion;
+        _pendingDomainListNodeIDs.clear();
+    }
 
     // pull each node in the packet
     while (packetStream.device()->pos() < message->getSize()) {
-        parseNodeFromPacketStream(packetStream);
+        _pendingDomainListNodeIDs.insert(parseNodeFromPacketStream(packetStream));
+    }
+
+    // only acknowledge the list version once every node of the list made it, and if it builds on what we already have,
+    // otherwise the domain-server would leave out nodes we never heard about
+    if ((quint32)_pendingDomainListNodeIDs.size() >= numListNodes && baseListVersion <= _domainListVersion
+            && listVersion > _domainListVersion) {
+        _domainListVersion = listVersion;
     }
 }
 
@@ -883,7 +927,7 @@ void NodeList::processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> me
     removeDelayedAdd(nodeUUID);
 }
 
-void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
+QUuid NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
     NewNodeInfo info;
 
     SocketType publicSocketType, localSocketType;
@@ -907,6 +951,8 @@ void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
     }
 
     addNewNode(info);
+
+    return info.uuid;
 }
 
 void NodeList::sendAssignment(Assignment& assignment) {
@@ -169,7 +169,7 @@ private:
 
     void sendDSPathQuery(const QString& newPath);
 
-    void parseNodeFromPacketStream(QDataStream& packetStream);
+    QUuid parseNodeFromPacketStream(QDataStream& packetStream);
 
     void pingPunchForInactiveNode(const SharedNodePointer& node);
 
@@ -183,6 +183,11 @@ private:
     QTimer _keepAlivePingTimer;
     bool _requestsDomainListData { false };
 
+    quint32 _domainListVersion { 0 };
+    quint32 _pendingDomainListVersion { 0 };
+    quint32 _pendingDomainListBaseVersion { 0 };
+    QSet<QUuid> _pendingDomainListNodeIDs;
+
     bool _sendDomainServerCheckInEnabled { true };
     bool _domainPortAutoDiscovery { true };
 
@@ -34,6 +34,14 @@ bool PacketReceiver::ListenerReference::invokeWithQt(const QSharedPointer<Receiv
     });
 }
 
+bool PacketReceiver::QueuedListenerReference::invokeDirectly(const QSharedPointer<ReceivedMessage>& receivedMessagePointer, const QSharedPointer<Node>& sourceNode) {
+    if (_owner.isNull()) {
+        return false;
+    }
+    _queue.push(receivedMessagePointer, sourceNode);
+    return true;
+}
+
 bool PacketReceiver::registerListenerForTypes(PacketTypeList types, const ListenerReferencePointer& listener) {
     Q_ASSERT_X(!types.empty(), "PacketReceiver::registerListenerForTypes", "No types to register");
     Q_ASSERT_X(listener, "PacketReceiver::registerListenerForTypes", "No listener to register");
@@ -70,6 +78,14 @@ void PacketReceiver::registerDirectListenerForTypes(PacketTypeList types, const
     }
 }
 
+bool PacketReceiver::registerQueueForTypes(PacketTypeList types, QObject* owner, ReceivedMessageQueue& queue) {
+    Q_ASSERT_X(owner, "PacketReceiver::registerQueueForTypes", "No owner for queue");
+
+    // queued listeners are invoked directly on the receiving thread, the push onto the queue is the only handoff
+    registerDirectListenerForTypes(std::move(types), QSharedPointer<QueuedListenerReference>::create(owner, queue));
+    return true;
+}
+
 bool PacketReceiver::registerListener(PacketType type, const ListenerReferencePointer& listener,  bool deliverPending) {
     Q_ASSERT_X(listener, "PacketReceiver::registerListener", "No listener to register");
 
@@ -27,6 +27,7 @@
 #include "NLPacket.h"
 #include "NLPacketList.h"
 #include "ReceivedMessage.h"
+#include "ReceivedMessageQueue.h"
 #include "udt/PacketHeaders.h"
 
 class EntityEditPacketSender;
@@ -76,6 +77,11 @@ public:
     bool registerListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending = false);
     bool registerListenerForTypes(PacketTypeList types, const ListenerReferencePointer& listener);
     void unregisterListener(QObject* listener);
+
+    // Messages of these types are pushed onto queue on the thread that received them, instead of being delivered
+    // through the Qt event queue. The owner drains the queue in its own loop, and must unregister before the queue
+    // is destroyed. Only complete messages are queued.
+    bool registerQueueForTypes(PacketTypeList types, QObject* owner, ReceivedMessageQueue& queue);
     
     void handleVerifiedPacket(std::unique_ptr<udt::Packet> packet);
     void handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> message);
@@ -108,6 +114,18 @@ private:
         void (T::*_slot)(QSharedPointer<ReceivedMessage>, QSharedPointer<Node>);
     };
 
+    class QueuedListenerReference : public ListenerReference {
+    public:
+        QueuedListenerReference(QObject* owner, ReceivedMessageQueue& queue) : _owner(owner), _queue(queue) {}
+        virtual bool invokeDirectly(const QSharedPointer<ReceivedMessage>& receivedMessagePointer, const QSharedPointer<Node>& sourceNode) override;
+        virtual bool isSourced() const override { return false; }
+        virtual QObject* getObject() const override { return _owner; }
+
+    private:
+        QPointer<QObject> _owner;
+        ReceivedMessageQueue& _queue;
+    };
+
     struct Listener {
         ListenerReferencePointer listener;
         bool deliverPending;
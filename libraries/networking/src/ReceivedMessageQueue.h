@@ -0,0 +1,61 @@
+//
+//  ReceivedMessageQueue.h
+//  libraries/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_ReceivedMessageQueue_h
+#define hifi_ReceivedMessageQueue_h
+
+#include <atomic>
+
+#include <QtCore/QSharedPointer>
+
+#include <TBBHelpers.h>
+
+#include "Node.h"
+#include "ReceivedMessage.h"
+
+// Hands received messages from the networking threads to a consumer that drains them in its own loop
+// (e.g. a mixer's frame loop), without going through the Qt event queue.
+//   Any number of threads may push, a single thread should drain.
+class ReceivedMessageQueue {
+public:
+    struct Entry {
+        QSharedPointer<ReceivedMessage> message;
+        SharedNodePointer sourceNode;
+    };
+
+    void push(const QSharedPointer<ReceivedMessage>& message, const SharedNodePointer& sourceNode) {
+        _queue.push({ message, sourceNode });
+        ++_totalPushed;
+    }
+
+    // pops everything that is currently queued, calling handler(message, sourceNode) for each entry in order
+    // returns the number of messages drained
+    template <typename Handler>
+    int drain(Handler&& handler) {
+        int numDrained = 0;
+        Entry entry;
+        while (_queue.try_pop(entry)) {
+            handler(entry.message, entry.sourceNode);
+            ++numDrained;
+        }
+        return numDrained;
+    }
+
+    bool isEmpty() const { return _queue.empty(); }
+    uint64_t getTotalPushed() const { return _totalPushed; }
+
+private:
+    tbb::concurrent_queue<Entry> _queue;
+    std::atomic<uint64_t> _totalPushed { 0 };
+};
+
+#endif // hifi_ReceivedMessageQueue_h
@@ -0,0 +1,348 @@
+//
+//  BBRCC.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BBRCC.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+using namespace udt;
+using namespace std::chrono;
+
+static const double USECS_PER_SECOND = 1000000.0;
+
+// 2 / ln(2), the smallest gain that doubles the sending rate every round trip
+static const double HIGH_GAIN = 2.885;
+static const double DRAIN_GAIN = 1.0 / HIGH_GAIN;
+static const double PROBE_BANDWIDTH_WINDOW_GAIN = 2.0;
+
+// while probing for bandwidth, send faster for a round trip, drain the queue that built up for one, and cruise for six
+static const double PACING_GAIN_CYCLE[] = { 1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+static const int PACING_GAIN_CYCLE_LENGTH = sizeof(PACING_GAIN_CYCLE) / sizeof(PACING_GAIN_CYCLE[0]);
+
+static const double FULL_BANDWIDTH_GROWTH = 1.25;
+static const int FULL_BANDWIDTH_ROUNDS = 3;
+
+static const auto MIN_RTT_EXPIRY = seconds(10);
+static const auto PROBE_RTT_DURATION = milliseconds(200);
+
+static const int INITIAL_WINDOW_PACKETS = 10;
+static const int MIN_WINDOW_PACKETS = 4;
+
+static const int RENO_FAST_RETRANSMIT_DUPLICATE_COUNT = 3;
+
+BBRCC::BBRCC() {
+    _packetSendPeriod = 0.0;
+    _congestionWindowSize = INITIAL_WINDOW_PACKETS;
+    _pacingGain = HIGH_GAIN;
+    _windowGain = HIGH_GAIN;
+}
+
+bool BBRCC::onACK(SequenceNumber ack, p_high_resolution_clock::time_point receiveTime) {
+    auto previousAck = _lastACK;
+    _lastACK = ack;
+
+    bool wasDuplicateACK = (ack == previousAck);
+    bool isMinRTTExpired = _minRTT != -1 && receiveTime - _minRTTTime > MIN_RTT_EXPIRY;
+    _isRoundStart = false;
+
+    if (ack > previousAck) {
+        _delivered += seqoff(previousAck, ack);
+        _deliveredTime = receiveTime;
+        _isRecoveringFromTimeout = false;
+
+        // packets are sent in sequence number order, so the ACKed one is at a known offset
+        int offset = _sentPacketDatas.empty() ? -1 : seqoff(_sentPacketDatas.front().sequenceNumber, ack);
+
+        if (offset >= 0 && offset < (int)_sentPacketDatas.size() && _sentPacketDatas[offset].sequenceNumber == ack) {
+            auto packet = _sentPacketDatas[offset];
+            auto end = _sentPacketDatas.begin() + offset + 1;
+
+            // an ACK that covers a re-sent packet was held back waiting for it, so it isn't timed either
+            bool wasResent = countResends(_sentPacketDatas.begin(), end) > 0;
+            _sentPacketDatas.erase(_sentPacketDatas.begin(), end);
+
+            // a round trip ends when a packet sent after the previous one ended is ACKed
+            if (packet.delivered >= _nextRoundDelivered) {
+                _nextRoundDelivered = _delivered;
+                ++_roundCount;
+                _isRoundStart = true;
+                _maxBandwidthPerRound[_roundCount % BANDWIDTH_FILTER_ROUNDS] = 0.0;
+            }
+
+            // the ACK of a re-sent packet could be for either send, so it can't be timed, except for the first ones:
+            // on a long path the initial timeout re-sends the first packets before they can be ACKed, and timing them
+            // from their first send can only overestimate the RTT, which lengthens the timeout enough for clean samples
+            int rtt = duration_cast<microseconds>(receiveTime - packet.timePoint).count();
+            if (!wasResent) {
+                updateRTT(rtt, receiveTime, isMinRTTExpired);
+            } else if (_ewmaRTT == -1 && rtt > 0) {
+                _ewmaRTT = rtt;
+                _rttVariance = rtt / 2;
+            }
+
+            // the delivery rate since the first send of a re-sent packet can only be underestimated, so it's kept
+            updateBandwidth(packet, receiveTime);
+        } else {
+            auto end = std::find_if(_sentPacketDatas.begin(), _sentPacketDatas.end(), [ack](const SentPacketData& data) {
+                return data.sequenceNumber > ack;
+            });
+            countResends(_sentPacketDatas.begin(), end);
+            _sentPacketDatas.erase(_sentPacketDatas.begin(), end);
+        }
+    }
+
+    updateMode(receiveTime, isMinRTTExpired);
+    updateSendParameters();
+
+    return needsFastRetransmit(wasDuplicateACK);
+}
+
+void BBRCC::onTimeout() {
+    // nothing is getting through, keep to a minimal window until the next ACK shows the model is still good
+    _isRecoveringFromTimeout = true;
+    _congestionWindowSize = MIN_WINDOW_PACKETS;
+}
+
+void BBRCC::onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    if (_sentPacketDatas.empty()) {
+        // don't count the time the connection was idle as time spent delivering the next packets
+        _deliveredTime = timePoint;
+    }
+
+    _sentPacketDatas.emplace_back(seqNum, timePoint, _delivered, _deliveredTime);
+}
+
+void BBRCC::onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    if (_sentPacketDatas.empty()) {
+        return;
+    }
+
+    // count the re-sends of a packet that isn't ACKed yet, so we know it can't be timed and how many copies may arrive
+    int offset = seqoff(_sentPacketDatas.front().sequenceNumber, seqNum);
+    if (offset >= 0 && offset < (int)_sentPacketDatas.size() && _sentPacketDatas[offset].sequenceNumber == seqNum) {
+        ++_sentPacketDatas[offset].numResends;
+    }
+}
+
+int BBRCC::estimatedTimeout() const {
+    return _ewmaRTT == -1 ? DEFAULT_SYN_INTERVAL : _ewmaRTT + _rttVariance * 4;
+}
+
+void BBRCC::updateRTT(int rtt, p_high_resolution_clock::time_point now, bool isMinRTTExpired) {
+    const int MAX_RTT_SAMPLE_MICROSECONDS = 10000000;
+
+    if (rtt < 0) {
+        Q_ASSERT_X(false, __FUNCTION__, "calculated an RTT that is not > 0");
+        return;
+    }
+    rtt = std::min(std::max(rtt, 1), MAX_RTT_SAMPLE_MICROSECONDS);
+
+    // the same estimation as TCPVegasCC, used for the re-send timeout
+    if (_ewmaRTT == -1) {
+        _ewmaRTT = rtt;
+        _rttVariance = rtt / 2;
+    } else {
+        static const int RTT_ESTIMATION_ALPHA = 8;
+        static const int RTT_ESTIMATION_VARIANCE_ALPHA = 4;
+
+        _ewmaRTT = (_ewmaRTT * (RTT_ESTIMATION_ALPHA - 1) + rtt) / RTT_ESTIMATION_ALPHA;
+        _rttVariance = (_rttVariance * (RTT_ESTIMATION_VARIANCE_ALPHA - 1)
+                        + abs(rtt - _ewmaRTT)) / RTT_ESTIMATION_VARIANCE_ALPHA;
+    }
+
+    // an old min RTT is replaced by the next sample, in case the path has changed
+    if (_minRTT == -1 || rtt <= _minRTT || isMinRTTExpired) {
+        _minRTT = rtt;
+        _minRTTTime = now;
+    }
+}
+
+void BBRCC::updateBandwidth(const SentPacketData& packet, p_high_resolution_clock::time_point receiveTime) {
+    auto interval = duration_cast<microseconds>(receiveTime - packet.deliveredTime).count();
+
+    // a sample over less than a round trip comes from ACKs that were compressed on the way back and overestimates
+    if (interval <= 0 || interval < _minRTT) {
+        return;
+    }
+
+    double deliveryRate = (_delivered - packet.delivered) * USECS_PER_SECOND / interval;
+
+    auto& roundBandwidth = _maxBandwidthPerRound[_roundCount % BANDWIDTH_FILTER_ROUNDS];
+    roundBandwidth = std::max(roundBandwidth, deliveryRate);
+    _bandwidth = *std::max_element(_maxBandwidthPerRound.begin(), _maxBandwidthPerRound.end());
+}
+
+void BBRCC::updateMode(p_high_resolution_clock::time_point now, bool isMinRTTExpired) {
+    if (_isRoundStart && !_isPipeFilled) {
+        if (_bandwidth >= _fullBandwidth * FULL_BANDWIDTH_GROWTH) {
+            // still growing, check again in a few rounds
+            _fullBandwidth = _bandwidth;
+            _fullBandwidthRounds = 0;
+        } else if (++_fullBandwidthRounds >= FULL_BANDWIDTH_ROUNDS) {
+            _isPipeFilled = true;
+        }
+    }
+
+    int packetsInFlight = getPacketsInFlight();
+
+    switch (_mode) {
+        case Mode::Startup:
+            if (_isPipeFilled) {
+                _mode = Mode::Drain;
+                _pacingGain = DRAIN_GAIN;
+                _windowGain = HIGH_GAIN;
+            }
+            break;
+        case Mode::Drain:
+            if (packetsInFlight <= getBandwidthDelayProduct()) {
+                enterProbeBandwidth(now);
+            }
+            break;
+        case Mode::ProbeBandwidth: {
+            bool isCycleOver = _minRTT != -1 && duration_cast<microseconds>(now - _cycleStartTime).count() > _minRTT;
+            // stop draining early once the queue is gone
+            if (isCycleOver || (_pacingGain < 1.0 && packetsInFlight <= getBandwidthDelayProduct())) {
+                _cycleIndex = (_cycleIndex + 1) % PACING_GAIN_CYCLE_LENGTH;
+                _cycleStartTime = now;
+                _pacingGain = PACING_GAIN_CYCLE[_cycleIndex];
+            }
+            break;
+        }
+        case Mode::ProbeRTT:
+            break;
+    }
+
+    if (isMinRTTExpired && _mode != Mode::ProbeRTT) {
+        enterProbeRTT();
+    }
+
+    if (_mode == Mode::ProbeRTT) {
+        if (_probeRTTDoneTime == p_high_resolution_clock::time_point() && packetsInFlight <= MIN_WINDOW_PACKETS) {
+            // the queue has drained, hold the window down long enough for a few RTT samples
+            _probeRTTDoneTime = now + PROBE_RTT_DURATION;
+            _probeRTTStartRound = _roundCount;
+        } else if (_probeRTTDoneTime != p_high_resolution_clock::time_point() && now >= _probeRTTDoneTime
+                   && _roundCount > _probeRTTStartRound) {
+            exitProbeRTT(now);
+        }
+    }
+}
+
+void BBRCC::updateSendParameters() {
+    if (_bandwidth <= 0.0) {
+        // no estimate yet, send the initial window as fast as it goes
+        _congestionWindowSize = _isRecoveringFromTimeout ? MIN_WINDOW_PACKETS : INITIAL_WINDOW_PACKETS;
+        return;
+    }
+
+    setPacketSendPeriod(USECS_PER_SECOND / (_pacingGain * _bandwidth));
+
+    int windowSize;
+    if (_mode == Mode::ProbeRTT || _isRecoveringFromTimeout) {
+        windowSize = MIN_WINDOW_PACKETS;
+    } else {
+        windowSize = (int)std::ceil(_windowGain * getBandwidthDelayProduct());
+    }
+
+    _congestionWindowSize = std::min(std::max(windowSize, MIN_WINDOW_PACKETS), udt::MAX_PACKETS_IN_FLIGHT);
+}
+
+bool BBRCC::needsFastRetransmit(bool wasDuplicateACK) {
+    if (wasDuplicateACK) {
+        if (_numExpectedDuplicateACKs > 0) {
+            // this is more likely for the second copy of a re-sent packet than for one after a lost packet
+            --_numExpectedDuplicateACKs;
+            return false;
+        }
+
+        // the packet after the ACK didn't arrive but later ones did, re-send it on the 3rd duplicate ACK like Reno
+        if (!_isInRecovery && ++_duplicateACKCount == RENO_FAST_RETRANSMIT_DUPLICATE_COUNT) {
+            _duplicateACKCount = 0;
+            _isInRecovery = true;
+            _recoverySequenceNumber = _sentPacketDatas.empty() ? _lastACK : _sentPacketDatas.back().sequenceNumber;
+            _fastRetransmitEnd = _lastACK + 1;
+            return true;
+        }
+        return false;
+    }
+
+    _duplicateACKCount = 0;
+
+    if (_isInRecovery) {
+        if (_lastACK >= _recoverySequenceNumber) {
+            _isInRecovery = false;
+        } else if (!_sentPacketDatas.empty() && _sentPacketDatas.front().sequenceNumber == _lastACK + 1
+                   && _sentPacketDatas.front().numResends == 0) {
+            // an ACK that stops short of what was sent when the loss was detected shows another packet was lost, and
+            // as ACKs don't say which later packets arrived there may be many more, like after a queue overflowed.
+            // Rather than finding them one per round trip, re-send everything outstanding then, as the timeout would.
+            _fastRetransmitEnd = _recoverySequenceNumber;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void BBRCC::enterProbeBandwidth(p_high_resolution_clock::time_point now) {
+    _mode = Mode::ProbeBandwidth;
+    _windowGain = PROBE_BANDWIDTH_WINDOW_GAIN;
+
+    // start anywhere in the cycle but the draining phase, so connections sharing a link don't probe in lockstep
+    _cycleIndex = rand() % (PACING_GAIN_CYCLE_LENGTH - 1);
+    if (_cycleIndex >= 1) {
+        ++_cycleIndex;
+    }
+    _cycleStartTime = now;
+    _pacingGain = PACING_GAIN_CYCLE[_cycleIndex];
+}
+
+void BBRCC::enterProbeRTT() {
+    _mode = Mode::ProbeRTT;
+    _pacingGain = 1.0;
+    _windowGain = 1.0;
+    _probeRTTDoneTime = p_high_resolution_clock::time_point();
+}
+
+void BBRCC::exitProbeRTT(p_high_resolution_clock::time_point now) {
+    _minRTTTime = now;
+
+    if (_isPipeFilled) {
+        enterProbeBandwidth(now);
+    } else {
+        _mode = Mode::Startup;
+        _pacingGain = HIGH_GAIN;
+        _windowGain = HIGH_GAIN;
+    }
+}
+
+int BBRCC::countResends(std::deque<SentPacketData>::iterator begin, std::deque<SentPacketData>::iterator end) {
+    int numResends = 0;
+    for (auto it = begin; it != end; ++it) {
+        numResends += it->numResends;
+    }
+
+    // every copy of a packet that wasn't actually lost arrives, and the receiver ACKs the extra ones again
+    _numExpectedDuplicateACKs += numResends;
+    return numResends;
+}
+
+int BBRCC::getPacketsInFlight() const {
+    return (int)_sentPacketDatas.size();
+}
+
+double BBRCC::getBandwidthDelayProduct() const {
+    if (_minRTT == -1 || _bandwidth <= 0.0) {
+        return INITIAL_WINDOW_PACKETS;
+    }
+    return _bandwidth * _minRTT / USECS_PER_SECOND;
+}
@@ -0,0 +1,124 @@
+//
+//  BBRCC.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BBRCC_h
+#define hifi_BBRCC_h
+
+#include <array>
+#include <deque>
+
+#include "CongestionControl.h"
+#include "Constants.h"
+
+namespace udt {
+
+// Congestion control modelled on BBR: https://queue.acm.org/detail.cfm?id=3022184
+// Rather than backing off on loss or growing queueing delay, it keeps an estimate of the bottleneck bandwidth (the max
+// delivery rate over the last few round trips) and of the propagation delay (the min RTT over the last few seconds),
+// paces packets at that bandwidth, and keeps about one bandwidth-delay product of packets in flight.
+// Suits long-fat links and bufferbloated paths, where TCPVegasCC either under-fills the link or backs off.
+class BBRCC : public CongestionControl {
+public:
+    BBRCC();
+
+    virtual bool onACK(SequenceNumber ackNum, p_high_resolution_clock::time_point receiveTime) override;
+    virtual SequenceNumber getFastRetransmitEnd(SequenceNumber ackNum) const override { return _fastRetransmitEnd; }
+    virtual void onTimeout() override;
+
+    virtual void onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+    virtual void onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+
+    virtual int estimatedTimeout() const override;
+
+protected:
+    virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) override { _lastACK = seqNum - 1; }
+
+private:
+    enum class Mode {
+        Startup, // grows the sending rate exponentially until the bandwidth estimate stops growing
+        Drain, // drains the queue Startup built up at the bottleneck
+        ProbeBandwidth, // cycles the sending rate around the estimate to discover more bandwidth
+        ProbeRTT // briefly shrinks the window to measure the propagation delay again
+    };
+
+    struct SentPacketData {
+        SentPacketData(SequenceNumber seqNum, p_high_resolution_clock::time_point tPoint, int64_t deliveredCount,
+                       p_high_resolution_clock::time_point deliveredTimePoint) :
+            sequenceNumber(seqNum), timePoint(tPoint), delivered(deliveredCount), deliveredTime(deliveredTimePoint) {};
+
+        SequenceNumber sequenceNumber;
+        p_high_resolution_clock::time_point timePoint;
+        int64_t delivered; // packets delivered when this one was sent
+        p_high_resolution_clock::time_point deliveredTime; // when the last of those was delivered
+        int numResends { 0 };
+    };
+
+    void updateRTT(int rtt, p_high_resolution_clock::time_point now, bool isMinRTTExpired);
+    void updateBandwidth(const SentPacketData& packet, p_high_resolution_clock::time_point receiveTime);
+    void updateMode(p_high_resolution_clock::time_point now, bool isMinRTTExpired);
+    void updateSendParameters();
+    bool needsFastRetransmit(bool wasDuplicateACK);
+
+    void enterProbeBandwidth(p_high_resolution_clock::time_point now);
+    void enterProbeRTT();
+    void exitProbeRTT(p_high_resolution_clock::time_point now);
+
+    int countResends(std::deque<SentPacketData>::iterator begin, std::deque<SentPacketData>::iterator end);
+
+    int getPacketsInFlight() const;
+    double getBandwidthDelayProduct() const; // in packets
+
+    // packets sent but not yet ACKed, in sequence number order
+    std::deque<SentPacketData> _sentPacketDatas;
+
+    Mode _mode { Mode::Startup };
+    double _pacingGain;
+    double _windowGain;
+
+    SequenceNumber _lastACK; // Sequence number of last packet that was ACKed
+    int _duplicateACKCount { 0 }; // Counter for duplicate ACKs received
+    int _numExpectedDuplicateACKs { 0 }; // duplicate ACKs still to come for re-sent packets that were ACKed
+    bool _isInRecovery { false }; // re-sending the packets lost before _recoverySequenceNumber
+    SequenceNumber _recoverySequenceNumber; // the last packet sent when the loss was detected
+    SequenceNumber _fastRetransmitEnd; // the last packet of the current fast re-transmit
+
+    int64_t _delivered { 0 }; // packets ACKed over the life of the connection
+    p_high_resolution_clock::time_point _deliveredTime; // when the last of them was ACKed
+
+    int64_t _roundCount { 0 }; // round trips so far, a round ends when a packet sent after it started is ACKed
+    int64_t _nextRoundDelivered { 0 };
+    bool _isRoundStart { false };
+
+    static const int BANDWIDTH_FILTER_ROUNDS = 10;
+    std::array<double, BANDWIDTH_FILTER_ROUNDS> _maxBandwidthPerRound {}; // in packets per second
+    double _bandwidth { 0.0 }; // max delivery rate over the last BANDWIDTH_FILTER_ROUNDS rounds, in packets per second
+
+    int _minRTT { -1 }; // in microseconds
+    p_high_resolution_clock::time_point _minRTTTime; // when _minRTT was measured
+    int _ewmaRTT { -1 }; // Exponential weighted moving average RTT, for the timeout
+    int _rttVariance { 0 }; // Variance in collected RTT values
+
+    // Startup is done once the bandwidth estimate stops growing by 25% for a few rounds
+    bool _isPipeFilled { false };
+    double _fullBandwidth { 0.0 };
+    int _fullBandwidthRounds { 0 };
+
+    int _cycleIndex { 0 }; // position in the ProbeBandwidth gain cycle
+    p_high_resolution_clock::time_point _cycleStartTime;
+
+    p_high_resolution_clock::time_point _probeRTTDoneTime; // zero until the window has shrunk to the ProbeRTT size
+    int64_t _probeRTTStartRound { 0 }; // the round the window had shrunk in, ProbeRTT lasts at least until the next
+
+    bool _isRecoveringFromTimeout { false };
+};
+
+}
+
+#endif // hifi_BBRCC_h
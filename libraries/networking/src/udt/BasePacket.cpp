@@ -13,6 +13,7 @@
 #include "BasePacket.h"
 
 #include "../NetworkLogging.h"
+#include "PacketBufferPool.h"
 
 using namespace udt;
 
@@ -78,7 +79,20 @@ BasePacket::BasePacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr
     
 }
 
+BasePacket::~BasePacket() {
+    releaseBuffer();
+}
+
+void BasePacket::releaseBuffer() {
+    if (_isBufferPooled) {
+        PacketBufferPool::release(std::move(_packet));
+        _isBufferPooled = false;
+    }
+    _packet.reset();
+}
+
 BasePacket& BasePacket::operator=(const BasePacket& other) {
+    releaseBuffer();
     _packetSize = other._packetSize;
     _packet = std::unique_ptr<char[]>(new char[_packetSize]);
     memcpy(_packet.get(), other._packet.get(), _packetSize);
@@ -104,8 +118,11 @@ BasePacket::BasePacket(BasePacket&& other) {
 }
 
 BasePacket& BasePacket::operator=(BasePacket&& other) {
+    releaseBuffer();
     _packetSize = other._packetSize;
     _packet = std::move(other._packet);
+    _isBufferPooled = other._isBufferPooled;
+    other._isBufferPooled = false;
     
     _payloadStart = other._payloadStart;
     _payloadCapacity = other._payloadCapacity;
@@ -33,6 +33,8 @@ public:
     static std::unique_ptr<BasePacket> create(qint64 size = -1);
     static std::unique_ptr<BasePacket> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
                                                           const SockAddr& senderSockAddr);
+
+    virtual ~BasePacket();
     
     // Current level's header size
     static int localHeaderSize();
@@ -85,6 +87,10 @@ public:
 
     void setReceiveTime(p_high_resolution_clock::time_point receiveTime) { _receiveTime = receiveTime; }
     p_high_resolution_clock::time_point getReceiveTime() const { return _receiveTime; }
+
+    // Marks our memory as acquired from the PacketBufferPool, it is released back to the pool along with this packet
+    void setBufferIsPooled(bool isBufferPooled) { _isBufferPooled = isBufferPooled; }
+    bool isBufferPooled() const { return _isBufferPooled; }
     
 protected:
     BasePacket(qint64 size);
@@ -99,9 +105,11 @@ protected:
     virtual qint64 readData(char* data, qint64 maxSize) override;
     
     void adjustPayloadStartAndCapacity(qint64 headerSize, bool shouldDecreasePayloadSize = false);
+    void releaseBuffer();
     
     qint64 _packetSize = 0;        // Total size of the allocated memory
     std::unique_ptr<char[]> _packet; // Allocated memory
+    bool _isBufferPooled { false }; // _packet came from the PacketBufferPool
     
     char* _payloadStart = nullptr; // Start of the payload
     qint64 _payloadCapacity = 0;          // Total capacity of the payload
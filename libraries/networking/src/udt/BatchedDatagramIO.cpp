@@ -0,0 +1,164 @@
+//
+//  BatchedDatagramIO.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BatchedDatagramIO.h"
+
+#include <algorithm>
+
+#include "../NetworkLogging.h"
+#include "PacketBufferPool.h"
+
+#if defined(Q_OS_LINUX)
+#include <errno.h>
+#include <string.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+using namespace udt;
+
+bool BatchedDatagramIO::isSupported() {
+#if defined(Q_OS_LINUX)
+    return true;
+#else
+    return false;
+#endif
+}
+
+BatchedDatagramIO::BatchedDatagramIO() {
+#if defined(Q_OS_LINUX)
+    _receiveBuffers.reserve(MAX_BATCH_SIZE);
+#endif
+}
+
+BatchedDatagramIO::~BatchedDatagramIO() {
+    for (auto& buffer : _receiveBuffers) {
+        PacketBufferPool::release(std::move(buffer));
+    }
+}
+
+#if defined(Q_OS_LINUX)
+
+int BatchedDatagramIO::receive(std::vector<ReceivedDatagram>& datagrams) {
+    if (_socketDescriptor == -1) {
+        return -1;
+    }
+
+    while (_receiveBuffers.size() < MAX_BATCH_SIZE) {
+        _receiveBuffers.push_back(PacketBufferPool::acquire());
+    }
+
+    mmsghdr headers[MAX_BATCH_SIZE];
+    iovec iovecs[MAX_BATCH_SIZE];
+    sockaddr_in addresses[MAX_BATCH_SIZE];
+    memset(headers, 0, sizeof(headers));
+
+    for (int i = 0; i < MAX_BATCH_SIZE; ++i) {
+        iovecs[i].iov_base = _receiveBuffers[i].get();
+        iovecs[i].iov_len = PacketBufferPool::BUFFER_SIZE;
+        headers[i].msg_hdr.msg_iov = &iovecs[i];
+        headers[i].msg_hdr.msg_iovlen = 1;
+        headers[i].msg_hdr.msg_name = &addresses[i];
+        headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+    }
+
+    int numReceived = recvmmsg((int)_socketDescriptor, headers, MAX_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+    if (numReceived < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return 0;
+        }
+        qCDebug(networking) << "BatchedDatagramIO::receive recvmmsg error -" << strerror(errno);
+        return -1;
+    }
+
+    // hand the filled buffers off with their datagrams, and compact the unfilled ones back to the front
+    for (int i = 0; i < numReceived; ++i) {
+        auto& header = headers[i];
+        if (header.msg_hdr.msg_flags & MSG_TRUNC) {
+            // larger than any packet we could have sent, drop it and keep the buffer
+            continue;
+        }
+        if (header.msg_len < sizeof(uint32_t)) {
+            // too short for a packet header, drop it and keep the buffer rather than parse its stale contents
+            continue;
+        }
+
+        ReceivedDatagram datagram;
+        datagram.buffer = std::move(_receiveBuffers[i]);
+        datagram.size = header.msg_len;
+        datagram.senderSockAddr = SockAddr(SocketType::UDP, QHostAddress(ntohl(addresses[i].sin_addr.s_addr)),
+                                           ntohs(addresses[i].sin_port));
+        datagrams.push_back(std::move(datagram));
+    }
+
+    _receiveBuffers.erase(std::remove_if(_receiveBuffers.begin(), _receiveBuffers.end(),
+                                         [](const std::unique_ptr<char[]>& buffer) { return !buffer; }),
+                          _receiveBuffers.end());
+
+    return numReceived;
+}
+
+qint64 BatchedDatagramIO::send(const std::vector<OutgoingDatagram>& datagrams, const SockAddr& destination) {
+    if (_socketDescriptor == -1 || datagrams.empty()) {
+        return -1;
+    }
+
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(destination.getAddress().toIPv4Address());
+    address.sin_port = htons(destination.getPort());
+
+    mmsghdr headers[MAX_BATCH_SIZE];
+    iovec iovecs[MAX_BATCH_SIZE];
+
+    qint64 bytesWritten = 0;
+    size_t offset = 0;
+    while (offset < datagrams.size()) {
+        int batchSize = (int)std::min(datagrams.size() - offset, (size_t)MAX_BATCH_SIZE);
+        memset(headers, 0, sizeof(mmsghdr) * batchSize);
+
+        for (int i = 0; i < batchSize; ++i) {
+            const auto& datagram = datagrams[offset + i];
+            iovecs[i].iov_base = const_cast<char*>(datagram.data);
+            iovecs[i].iov_len = datagram.size;
+            headers[i].msg_hdr.msg_iov = &iovecs[i];
+            headers[i].msg_hdr.msg_iovlen = 1;
+            headers[i].msg_hdr.msg_name = &address;
+            headers[i].msg_hdr.msg_namelen = sizeof(address);
+        }
+
+        int numSent = sendmmsg((int)_socketDescriptor, headers, batchSize, MSG_DONTWAIT);
+        if (numSent <= 0) {
+            // drop what's left like a failed writeDatagram would, the reliable layer will re-send if it needs to
+            qCDebug(networking) << "BatchedDatagramIO::send sendmmsg error to" << destination << "-" << strerror(errno);
+            break;
+        }
+
+        for (int i = 0; i < numSent; ++i) {
+            bytesWritten += headers[i].msg_len;
+        }
+        offset += numSent;
+    }
+
+    return (offset == 0) ? -1 : bytesWritten;
+}
+
+#else
+
+int BatchedDatagramIO::receive(std::vector<ReceivedDatagram>& datagrams) {
+    return -1;
+}
+
+qint64 BatchedDatagramIO::send(const std::vector<OutgoingDatagram>& datagrams, const SockAddr& destination) {
+    return -1;
+}
+
+#endif
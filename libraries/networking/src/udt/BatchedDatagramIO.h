@@ -0,0 +1,68 @@
+//
+//  BatchedDatagramIO.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_BatchedDatagramIO_h
+#define hifi_BatchedDatagramIO_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QtGlobal>
+
+#include "../SockAddr.h"
+
+namespace udt {
+
+// Reads and writes UDP datagrams in batches (recvmmsg/sendmmsg) directly on a bound socket descriptor,
+// bypassing the QUdpSocket which only moves a single datagram per system call.
+// Only implemented on Linux - elsewhere isSupported() is false and reads and writes fail.
+class BatchedDatagramIO {
+public:
+    static const int MAX_BATCH_SIZE = 64;
+
+    struct ReceivedDatagram {
+        std::unique_ptr<char[]> buffer; // acquired from the PacketBufferPool
+        qint64 size { 0 };
+        SockAddr senderSockAddr;
+    };
+
+    struct OutgoingDatagram {
+        const char* data;
+        qint64 size;
+    };
+
+    static bool isSupported();
+
+    BatchedDatagramIO();
+    ~BatchedDatagramIO();
+
+    void setSocketDescriptor(qintptr socketDescriptor) { _socketDescriptor = socketDescriptor; }
+    qintptr socketDescriptor() const { return _socketDescriptor; }
+
+    // Reads up to MAX_BATCH_SIZE datagrams without blocking, appending them to datagrams.
+    // Returns the number of datagrams read, 0 if none were waiting, or -1 on error.
+    int receive(std::vector<ReceivedDatagram>& datagrams);
+
+    // Writes all datagrams to a single destination, in as few system calls as possible.
+    // Returns the number of bytes written, or -1 if nothing could be written.
+    qint64 send(const std::vector<OutgoingDatagram>& datagrams, const SockAddr& destination);
+
+private:
+    qintptr _socketDescriptor { -1 };
+
+    // buffers staged for the next receive, any not filled by a read are kept for the one after
+    std::vector<std::unique_ptr<char[]>> _receiveBuffers;
+};
+
+}
+
+#endif // hifi_BatchedDatagramIO_h
@@ -41,6 +41,8 @@ public:
 
     // return value specifies if connection should perform a fast re-transmit of ACK + 1 (used in TCP style congestion control)
     virtual bool onACK(SequenceNumber ackNum, p_high_resolution_clock::time_point receiveTime) { return false; }
+    // the last packet to re-send when onACK asks for a fast re-transmit, starting from ackNum + 1
+    virtual SequenceNumber getFastRetransmitEnd(SequenceNumber ackNum) const { return ackNum + 1; }
 
     virtual void onTimeout() {}
 
@@ -14,8 +14,6 @@
 
 #include <random>
 
-#include <QtCore/QThread>
-
 #include <NumericalConstants.h>
 
 #include "../SockAddr.h"
@@ -69,20 +67,16 @@ Connection::~Connection() {
 
 void Connection::stopSendQueue() {
     if (auto sendQueue = _sendQueue.release()) {
-        // grab the send queue thread so we can wait on it
-        QThread* sendQueueThread = sendQueue->thread();
-        
         // tell the send queue to stop and be deleted
         
         sendQueue->stop();
 
+        // wait until no scheduler thread is running the send queue so we know it is done sending
+        _parentSocket->getSendQueueScheduler().remove(*sendQueue);
+
         _lastMessageNumber = sendQueue->getCurrentMessageNumber();
 
         sendQueue->deleteLater();
-        
-        // wait on the send queue thread so we know the send queue is gone
-        sendQueueThread->quit();
-        sendQueueThread->wait();
     }
 }
 
@@ -349,8 +343,8 @@ void Connection::processACK(ControlPacketPointer controlPacket) {
     // give this ACK to the congestion control and update the send queue parameters
     updateCongestionControlAndSendQueue([this, ack, &controlPacket] {
         if (_congestionControl->onACK(ack, controlPacket->getReceiveTime())) {
-            // the congestion control has told us it needs a fast re-transmit of ack + 1, add that now
-            _sendQueue->fastRetransmit(ack + 1);
+            // the congestion control has told us it needs a fast re-transmit from ack + 1, add that now
+            _sendQueue->fastRetransmit(ack + 1, _congestionControl->getFastRetransmitEnd(ack));
         }
     });
     
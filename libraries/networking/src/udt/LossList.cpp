@@ -11,13 +11,47 @@
 
 #include "LossList.h"
 
+#include <algorithm>
+
 #include "ControlPacket.h"
 
 using namespace udt;
 using namespace std;
 
+LossList::Iterator LossList::findRange(SequenceNumber seq) {
+    return lower_bound(firstRange(), _lossList.end(), seq, [](const Range& range, const SequenceNumber& seq) {
+        return range.second < seq;
+    });
+}
+
+LossList::Iterator LossList::insertRange(Iterator it, Range range) {
+    if (it == firstRange() && _numPoppedRanges > 0) {
+        // reuse the slot of a range popped off the front
+        --_numPoppedRanges;
+        _lossList[_numPoppedRanges] = range;
+        return firstRange();
+    }
+    return _lossList.insert(it, range);
+}
+
+LossList::Iterator LossList::eraseRanges(Iterator first, Iterator last) {
+    if (first != firstRange()) {
+        return _lossList.erase(first, last);
+    }
+
+    _numPoppedRanges += last - first;
+    if (_numPoppedRanges == _lossList.size()) {
+        _lossList.clear();
+        _numPoppedRanges = 0;
+    } else if (_numPoppedRanges * 2 >= _lossList.size()) {
+        _lossList.erase(_lossList.begin(), firstRange());
+        _numPoppedRanges = 0;
+    }
+    return firstRange();
+}
+
 void LossList::append(SequenceNumber seq) {
-    Q_ASSERT_X(_lossList.empty() || (_lossList.back().second < seq), "LossList::append(SequenceNumber)",
+    Q_ASSERT_X(isEmpty() || (_lossList.back().second < seq), "LossList::append(SequenceNumber)",
                "SequenceNumber appended is not greater than the last SequenceNumber in the list");
     
     if (getLength() > 0 && _lossList.back().second + 1 == seq) {
@@ -29,7 +63,7 @@ void LossList::append(SequenceNumber seq) {
 }
 
 void LossList::append(SequenceNumber start, SequenceNumber end) {
-    Q_ASSERT_X(_lossList.empty() || (_lossList.back().second < start),
+    Q_ASSERT_X(isEmpty() || (_lossList.back().second < start),
                "LossList::append(SequenceNumber, SequenceNumber)",
                "SequenceNumber range appended is not greater than the last SequenceNumber in the list");
     Q_ASSERT_X(start <= end,
@@ -47,14 +81,12 @@ void LossList::insert(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::insert(SequenceNumber, SequenceNumber)", "Range start greater than range end");
     
-    auto it = find_if_not(_lossList.begin(), _lossList.end(), [&start](pair<SequenceNumber, SequenceNumber> pair){
-        return pair.second < start;
-    });
+    auto it = findRange(start);
     
     if (it == _lossList.end() || end < it->first) {
         // No overlap, simply insert
         _length += seqlen(start, end);
-        _lossList.insert(it, make_pair(start, end));
+        insertRange(it, make_pair(start, end));
     } else {
         // If it starts before segment, extend segment
         if (start < it->first) {
@@ -68,8 +100,7 @@ void LossList::insert(SequenceNumber start, SequenceNumber end) {
             it->second = end;
         }
         
-        auto it2 = it;
-        ++it2;
+        auto it2 = it + 1;
         // For all ranges touching the current range
         while (it2 != _lossList.end() && it->second >= it2->first - 1) {
             // extend current range if necessary
@@ -78,21 +109,21 @@ void LossList::insert(SequenceNumber start, SequenceNumber end) {
                 it->second = it2->second;
             }
             
-            // Remove overlapping range
             _length -= seqlen(it2->first, it2->second);
-            it2 = _lossList.erase(it2);
+            ++it2;
         }
+
+        // Remove overlapping ranges
+        _lossList.erase(it + 1, it2);
     }
 }
 
 bool LossList::remove(SequenceNumber seq) {
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&seq](pair<SequenceNumber, SequenceNumber> pair) {
-        return pair.first <= seq && seq <= pair.second;
-    });
+    auto it = findRange(seq);
     
-    if (it != end(_lossList)) {
+    if (it != _lossList.end() && it->first <= seq) {
         if (it->first == it->second) {
-            _lossList.erase(it);
+            eraseRanges(it, it + 1);
         } else if (seq == it->first) {
             ++it->first;
         } else if (seq == it->second) {
@@ -100,7 +131,7 @@ bool LossList::remove(SequenceNumber seq) {
         } else {
             auto temp = it->second;
             it->second = seq - 1;
-            _lossList.insert(++it, make_pair(seq + 1, temp));
+            insertRange(it + 1, make_pair(seq + 1, temp));
         }
         _length -= 1;
         
@@ -116,28 +147,25 @@ void LossList::remove(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::remove(SequenceNumber, SequenceNumber)", "Range start greater than range end");
     // Find the first segment sharing sequence numbers
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&start, &end](pair<SequenceNumber, SequenceNumber> pair) {
-        return (pair.first <= start && start <= pair.second) || (start <= pair.first && pair.first <= end);
-    });
+    auto it = findRange(start);
     
     // If we found one
-    if (it != _lossList.end()) {
+    if (it != _lossList.end() && it->first <= end) {
         
-        // While the end of the current segment is contained, either shorten it (first one only - sometimes)
-        // or remove it altogether since it is fully contained it the range
-        while (it != _lossList.end() && end >= it->second) {
-            if (start <= it->first) {
-                // Segment is contained, update new length and erase it.
-                _length -= seqlen(it->first, it->second);
-                it = _lossList.erase(it);
-            } else {
-                // Beginning of segment not contained, modify end of segment.
-                // Will only occur sometimes one the first loop
-                _length -= seqlen(start, it->second);
-                it->second = start - 1;
-                ++it;
-            }
+        // Beginning of the first segment not contained, modify end of segment.
+        if (it->first < start && end >= it->second) {
+            _length -= seqlen(start, it->second);
+            it->second = start - 1;
+            ++it;
+        }
+
+        // Erase all the segments fully contained in the range at once
+        auto last = it;
+        while (last != _lossList.end() && end >= last->second) {
+            _length -= seqlen(last->first, last->second);
+            ++last;
         }
+        it = eraseRanges(it, last);
         
         // There might be more to remove
         if (it != _lossList.end() && it->first <= end) {
@@ -150,7 +178,7 @@ void LossList::remove(SequenceNumber start, SequenceNumber end) {
                 _length -= seqlen(start, end);
                 auto temp = it->second;
                 it->second = start - 1;
-                _lossList.insert(++it, make_pair(end + 1, temp));
+                insertRange(it + 1, make_pair(end + 1, temp));
             }
         }
     }
@@ -158,7 +186,7 @@ void LossList::remove(SequenceNumber start, SequenceNumber end) {
 
 SequenceNumber LossList::getFirstSequenceNumber() const {
     Q_ASSERT_X(getLength() > 0, "LossList::getFirstSequenceNumber()", "Trying to get first element of an empty list");
-    return _lossList.front().first;
+    return _lossList[_numPoppedRanges].first;
 }
 
 SequenceNumber LossList::popFirstSequenceNumber() {
@@ -170,9 +198,9 @@ SequenceNumber LossList::popFirstSequenceNumber() {
 void LossList::write(ControlPacket& packet, int maxPairs) {
     int writtenPairs = 0;
     
-    for (const auto& pair : _lossList) {
-        packet.writePrimitive(pair.first);
-        packet.writePrimitive(pair.second);
+    for (auto it = firstRange(); it != _lossList.end(); ++it) {
+        packet.writePrimitive(it->first);
+        packet.writePrimitive(it->second);
         
         ++writtenPairs;
         
@@ -12,7 +12,8 @@
 #ifndef hifi_LossList_h
 #define hifi_LossList_h
 
-#include <list>
+#include <utility>
+#include <vector>
 
 #include "SequenceNumber.h"
 
@@ -20,17 +21,20 @@ namespace udt {
 
 class ControlPacket;
     
+// Sorted, non-overlapping ranges of lost sequence numbers, kept contiguously and searched with a binary search.
+// Ranges popped off the front are only reclaimed once they make up half of the storage, so that working through
+// the losses front to back, as the send queue does, doesn't move the remaining ranges every time.
 class LossList {
 public:
     LossList() {}
     
-    void clear() { _length = 0; _lossList.clear(); }
+    void clear() { _length = 0; _lossList.clear(); _numPoppedRanges = 0; }
     
     // must always add at the end - faster than insert
     void append(SequenceNumber seq);
     void append(SequenceNumber start, SequenceNumber end);
     
-    // inserts anywhere - MUCH slower
+    // inserts anywhere - slower
     void insert(SequenceNumber start, SequenceNumber end);
     
     bool remove(SequenceNumber seq);
@@ -44,7 +48,18 @@ public:
     void write(ControlPacket& packet, int maxPairs = -1);
     
 private:
-    std::list<std::pair<SequenceNumber, SequenceNumber>> _lossList;
+    using Range = std::pair<SequenceNumber, SequenceNumber>;
+    using Iterator = std::vector<Range>::iterator;
+
+    Iterator firstRange() { return _lossList.begin() + _numPoppedRanges; }
+
+    // the first range that ends at or after the sequence number
+    Iterator findRange(SequenceNumber seq);
+    Iterator insertRange(Iterator it, Range range);
+    Iterator eraseRanges(Iterator first, Iterator last);
+
+    std::vector<Range> _lossList;
+    size_t _numPoppedRanges { 0 }; // ranges at the front that were removed but not reclaimed yet
     int _length { 0 };
 };
     
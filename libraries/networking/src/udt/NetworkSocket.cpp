@@ -161,11 +161,16 @@ bool NetworkSocket::hasPendingDatagrams() const {
 #if defined(WEBRTC_DATA_CHANNELS)
         _webrtcSocket.hasPendingDatagrams() ||
 #endif
-        _udpSocket.hasPendingDatagrams();
+        (_isUDPReadEnabled && _udpSocket.hasPendingDatagrams());
 }
 
 qint64 NetworkSocket::pendingDatagramSize() {
 #if defined(WEBRTC_DATA_CHANNELS)
+    if (!_isUDPReadEnabled) {
+        _pendingDatagramSizeSocketType = SocketType::WebRTC;
+        return _webrtcSocket.pendingDatagramSize();
+    }
+
     // Alternate socket types, remembering the socket type used so that the same socket type is used next readDatagram().
     if (_lastSocketTypeRead == SocketType::UDP) {
         if (_webrtcSocket.hasPendingDatagrams()) {
@@ -185,6 +190,9 @@ qint64 NetworkSocket::pendingDatagramSize() {
         }
     }
 #else
+    if (!_isUDPReadEnabled) {
+        return -1;
+    }
     return _udpSocket.pendingDatagramSize();
 #endif
 }
@@ -192,8 +200,8 @@ qint64 NetworkSocket::pendingDatagramSize() {
 qint64 NetworkSocket::readDatagram(char* data, qint64 maxSize, SockAddr* sockAddr) {
 #if defined(WEBRTC_DATA_CHANNELS)
     // Read per preceding pendingDatagramSize() if any, otherwise alternate socket types.
-    if (_pendingDatagramSizeSocketType == SocketType::UDP
-        || (_pendingDatagramSizeSocketType == SocketType::Unknown && _lastSocketTypeRead == SocketType::WebRTC)) {
+    if (_isUDPReadEnabled && (_pendingDatagramSizeSocketType == SocketType::UDP
+        || (_pendingDatagramSizeSocketType == SocketType::Unknown && _lastSocketTypeRead == SocketType::WebRTC))) {
         _lastSocketTypeRead = SocketType::UDP;
         _pendingDatagramSizeSocketType = SocketType::Unknown;
         if (sockAddr) {
@@ -213,6 +221,10 @@ qint64 NetworkSocket::readDatagram(char* data, qint64 maxSize, SockAddr* sockAdd
         }
     }
 #else
+    if (!_isUDPReadEnabled) {
+        return -1;
+    }
+
     if (sockAddr) {
         sockAddr->setType(SocketType::UDP);
         return _udpSocket.readDatagram(data, maxSize, sockAddr->getAddressPointer(), sockAddr->getPortPointer());
@@ -86,6 +86,12 @@ public:
     qint64 bytesToWrite(SocketType socketType, const SockAddr& address = SockAddr()) const;
 
 
+    /// @brief Sets whether UDP datagrams are read through this object.
+    /// @details Disable when the UDP socket is read directly through its descriptor (batched or on another thread), so
+    /// that only WebRTC datagrams are returned by the read methods below.
+    /// @param enabled <code>true</code> to read UDP datagrams through this object, <code>false</code> to leave them.
+    void setUDPReadEnabled(bool enabled) { _isUDPReadEnabled = enabled; }
+
     /// @brief Gets whether there is a pending datagram waiting to be read.
     /// @return <code>true</code> if there is a datagram waiting to be read, <code>false</code> if there isn't.
     bool hasPendingDatagrams() const;
@@ -158,6 +164,8 @@ private:
     WebRTCSocket _webrtcSocket;
 #endif
 
+    bool _isUDPReadEnabled { true };
+
 #if defined(WEBRTC_DATA_CHANNELS)
     SocketType _pendingDatagramSizeSocketType { SocketType::Unknown };
     SocketType _lastSocketTypeRead { SocketType::Unknown };
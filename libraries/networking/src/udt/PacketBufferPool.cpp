@@ -0,0 +1,62 @@
+//
+//  PacketBufferPool.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPool.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+using namespace udt;
+
+namespace {
+    // enough to cover a full receive buffer worth of in-flight packets, anything past this is simply freed
+    const size_t MAX_POOLED_BUFFERS = UDP_RECEIVE_BUFFER_SIZE_BYTES / PacketBufferPool::BUFFER_SIZE;
+
+    std::mutex poolMutex;
+    std::vector<std::unique_ptr<char[]>> pooledBuffers;
+    std::atomic<int> numAllocatedBuffers { 0 };
+}
+
+std::unique_ptr<char[]> PacketBufferPool::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (!pooledBuffers.empty()) {
+            auto buffer = std::move(pooledBuffers.back());
+            pooledBuffers.pop_back();
+            return buffer;
+        }
+    }
+
+    ++numAllocatedBuffers;
+    return std::unique_ptr<char[]>(new char[BUFFER_SIZE]);
+}
+
+void PacketBufferPool::release(std::unique_ptr<char[]> buffer) {
+    if (!buffer) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if (pooledBuffers.size() < MAX_POOLED_BUFFERS) {
+        pooledBuffers.push_back(std::move(buffer));
+    } else {
+        --numAllocatedBuffers;
+    }
+}
+
+int PacketBufferPool::getNumPooledBuffers() {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    return (int)pooledBuffers.size();
+}
+
+int PacketBufferPool::getNumAllocatedBuffers() {
+    return numAllocatedBuffers;
+}
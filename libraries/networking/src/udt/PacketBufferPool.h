@@ -0,0 +1,37 @@
+//
+//  PacketBufferPool.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PacketBufferPool_h
+#define hifi_PacketBufferPool_h
+
+#include <memory>
+
+#include "Constants.h"
+
+namespace udt {
+
+// Thread-safe free list of MAX_PACKET_SIZE buffers, used for datagrams read in batches so that each
+// received packet does not need its own heap allocation. Packets holding a pooled buffer hand it back on destruction.
+class PacketBufferPool {
+public:
+    static const int BUFFER_SIZE = MAX_PACKET_SIZE;
+
+    static std::unique_ptr<char[]> acquire();
+    static void release(std::unique_ptr<char[]> buffer);
+
+    static int getNumPooledBuffers();
+    static int getNumAllocatedBuffers();
+};
+
+}
+
+#endif // hifi_PacketBufferPool_h
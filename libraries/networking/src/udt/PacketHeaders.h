@@ -449,7 +449,8 @@ enum class DomainConnectRequestVersion : PacketVersion {
 
 enum class DomainListRequestVersion : PacketVersion {
     PreSocketTypes = 22,
-    SocketTypes
+    SocketTypes,
+    AcknowledgedListVersion
 };
 
 enum class DomainConnectionDeniedVersion : PacketVersion {
@@ -472,7 +473,9 @@ enum class DomainListVersion : PacketVersion {
     AuthenticationOptional,
     HasTimestamp,
     HasConnectReason,
-    SocketTypes
+    SocketTypes,
+    DeltaLists,
+    AuthenticationMethod
 };
 
 enum class AudioVersion : PacketVersion {
@@ -14,12 +14,10 @@
 #define hifi_SendQueue_h
 
 #include <atomic>
-#include <condition_variable>
 #include <cstdint>
 #include <list>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
 
 #include <QtCore/QObject>
 #include <QtCore/QReadWriteLock>
@@ -32,6 +30,8 @@
 #include "PacketQueue.h"
 #include "SequenceNumber.h"
 #include "LossList.h"
+#include "SentPacketWindow.h"
+#include "SendQueueScheduler.h"
 
 namespace udt {
     
@@ -74,7 +74,7 @@ public slots:
     void stop();
     
     void ack(SequenceNumber ack);
-    void fastRetransmit(SequenceNumber ack);
+    void fastRetransmit(SequenceNumber first, SequenceNumber last);
     void handshakeACK();
     void updateDestinationAddress(SockAddr newAddress);
 
@@ -86,14 +86,22 @@ signals:
 
     void timeout();
     
-private slots:
-    void run();
-    
 private:
     Q_DISABLE_COPY_MOVE(SendQueue)
     SendQueue(Socket* socket, SockAddr dest, SequenceNumber currentSequenceNumber,
               MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK);
-    
+
+    enum class WaitReason {
+        None,
+        NewPackets, // everything sent was ACKed, goes inactive if nothing new comes
+        ACK // packets are waiting for an ACK, times out and re-sends them if none comes
+    };
+
+    // Run by the SendQueueScheduler, on one thread at a time: sends whatever the pacing allows, then sets when the
+    // queue needs to run next, and whether it should run before that as soon as it is woken.
+    // Returns false once the queue has stopped.
+    bool process(SendQueueScheduler::TimePoint now, SendQueueScheduler::TimePoint& nextRunTime, bool& isWaitingForEvent);
+
     void sendHandshake();
     
     int sendPacket(const Packet& packet);
@@ -102,7 +110,8 @@ private:
     int maybeSendNewPacket(); // Figures out what packet to send next
     bool maybeResendPacket(); // Determines whether to resend a packet and which one
     
-    bool isInactive(bool attemptedToSendPacket);
+    // called when there was nothing to send, returns false if there is now, otherwise sets until when to wait
+    bool isWaiting(SendQueueScheduler::TimePoint now, SendQueueScheduler::TimePoint& deadline);
     void deactivate(); // makes the queue inactive and cleans it up
 
     bool isFlowWindowFull() const;
@@ -113,7 +122,13 @@ private:
     PacketQueue _packets;
     
     Socket* _socket { nullptr }; // Socket to send packet on
+    SendQueueScheduler& _scheduler;
+    SendQueueScheduler::Entry _schedulerEntry;
+
     SockAddr _destination; // Destination addr
+    std::mutex _newDestinationLock; // Protects the new destination
+    SockAddr _newDestination; // set from the connection's thread, picked up the next time the queue runs
+    std::atomic<bool> _hasNewDestination { false };
     
     std::atomic<uint32_t> _lastACKSequenceNumber { 0 }; // Last ACKed sequence number
     
@@ -131,19 +146,23 @@ private:
     LossList _naks; // Sequence numbers of packets to resend
     
     mutable QReadWriteLock _sentLock; // Protects the sent packet list
-    using PacketResendPair = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resend + packet ptr
-    std::unordered_map<SequenceNumber, PacketResendPair> _sentPackets; // Packets waiting for ACK.
+    SentPacketWindow _sentPackets; // Packets waiting for ACK.
     
-    std::mutex _handshakeMutex; // Protects the handshake ACK condition_variable
     std::atomic<bool> _hasReceivedHandshakeACK { false }; // flag for receipt of handshake ACK from client
-    std::condition_variable _handshakeACKCondition;
-    
-    std::condition_variable_any _emptyCondition;
+    SendQueueScheduler::TimePoint _nextHandshakeTime;
 
-    std::chrono::high_resolution_clock::time_point _lastPacketSentAt;
+    // the following are only used while the queue runs
+    bool _isPacing { false }; // false until the first send after a wait, the pacing starts over from then
+    SendQueueScheduler::TimePoint _nextPacketTimestamp; // when the next packet should go out
+
+    WaitReason _waitReason { WaitReason::None };
+    SendQueueScheduler::TimePoint _waitDeadline;
+    SequenceNumber _waitACK; // the last ACK when we started waiting for one
 
     static const std::chrono::microseconds MAXIMUM_ESTIMATED_TIMEOUT;
     static const std::chrono::microseconds MINIMUM_ESTIMATED_TIMEOUT;
+
+    friend class SendQueueScheduler;
 };
     
 }
@@ -0,0 +1,192 @@
+//
+//  SendQueueScheduler.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendQueueScheduler.h"
+
+#include <algorithm>
+#include <string>
+
+#include <ThreadHelpers.h>
+
+#include "SendQueue.h"
+
+using namespace udt;
+
+// fine enough for packet send periods, which are caught up on when a queue runs late,
+// and coarse enough that far timers (re-send timeouts, inactivity) are rarely moved around the wheel
+static const std::chrono::microseconds TIMER_WHEEL_TICK { 100 };
+
+SendQueueScheduler::SendQueueScheduler(int numThreads) :
+    _wheel(TIMER_WHEEL_TICK)
+{
+    numThreads = std::max(numThreads, 1);
+    for (int i = 0; i < numThreads; ++i) {
+        _threads.emplace_back(&SendQueueScheduler::run, this, i);
+    }
+}
+
+SendQueueScheduler::~SendQueueScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+
+    _timerCondition.notify_all();
+    _readyCondition.notify_all();
+
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+void SendQueueScheduler::add(SendQueue& queue) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    Entry& entry = queue._schedulerEntry;
+    entry._queue = &queue;
+    entry._isAdded = true;
+
+    makeReady(entry);
+    notifyThread();
+}
+
+void SendQueueScheduler::remove(SendQueue& queue) {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    Entry& entry = queue._schedulerEntry;
+    if (!entry._isAdded) {
+        return;
+    }
+
+    entry._isAdded = false;
+    _wheel.cancel(entry);
+    if (entry._isReady) {
+        _readyEntries.erase(std::find(_readyEntries.begin(), _readyEntries.end(), &entry));
+        entry._isReady = false;
+    }
+
+    _finishedRunningCondition.wait(lock, [&entry] { return !entry._isRunning; });
+}
+
+void SendQueueScheduler::wake(SendQueue& queue) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    Entry& entry = queue._schedulerEntry;
+    if (!entry._isAdded) {
+        return;
+    }
+
+    if (entry._isRunning) {
+        // the queue may have looked for something to do before the caller gave it something, check once it returns
+        entry._wasWokenWhileRunning = true;
+    } else if (entry._isWaitingForEvent) {
+        _wheel.cancel(entry);
+        makeReady(entry);
+        notifyThread();
+    }
+}
+
+void SendQueueScheduler::run(int threadIndex) {
+    setThreadName("Networking: SendQueue scheduler " + std::to_string(threadIndex));
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (!_isStopping) {
+        _wheel.advance(Clock::now(), [this](TimerWheel::Timer& timer) {
+            makeReady(static_cast<Entry&>(timer));
+        });
+
+        if (!_readyEntries.empty()) {
+            Entry& entry = *_readyEntries.front();
+            _readyEntries.pop_front();
+
+            // get another thread going if there is more to run, or to watch the wheel while we run this entry
+            if (!_readyEntries.empty() || (!_hasTimerThread && _numReadyThreads > 0)) {
+                notifyThread();
+            }
+
+            runEntry(lock, entry);
+            continue;
+        }
+
+        if (!_hasTimerThread) {
+            _hasTimerThread = true;
+            _timerThreadWakeTime = _wheel.getNextEventTime();
+            if (_timerThreadWakeTime == TimePoint::max()) {
+                _timerCondition.wait(lock);
+            } else {
+                _timerCondition.wait_until(lock, _timerThreadWakeTime);
+            }
+            _hasTimerThread = false;
+        } else {
+            ++_numReadyThreads;
+            _readyCondition.wait(lock);
+            --_numReadyThreads;
+        }
+    }
+}
+
+void SendQueueScheduler::runEntry(std::unique_lock<std::mutex>& lock, Entry& entry) {
+    entry._isReady = false;
+    entry._isRunning = true;
+    entry._wasWokenWhileRunning = false;
+    lock.unlock();
+
+    TimePoint nextRunTime;
+    bool isWaitingForEvent = false;
+    bool isActive = entry._queue->process(Clock::now(), nextRunTime, isWaitingForEvent);
+
+    lock.lock();
+    entry._isRunning = false;
+
+    if (!entry._isAdded) {
+        // it was removed while it ran, let remove() return
+        _finishedRunningCondition.notify_all();
+        return;
+    }
+
+    if (!isActive) {
+        // the queue stopped, it stays out of the wheel until it is removed
+        return;
+    }
+
+    if (isWaitingForEvent && entry._wasWokenWhileRunning) {
+        makeReady(entry);
+    } else if (nextRunTime <= Clock::now()) {
+        makeReady(entry);
+    } else {
+        schedule(entry, nextRunTime);
+        entry._isWaitingForEvent = isWaitingForEvent;
+    }
+}
+
+void SendQueueScheduler::makeReady(Entry& entry) {
+    entry._isWaitingForEvent = false;
+    entry._isReady = true;
+    _readyEntries.push_back(&entry);
+}
+
+void SendQueueScheduler::schedule(Entry& entry, TimePoint time) {
+    _wheel.schedule(entry, time);
+
+    // the thread watching the wheel needs to wake up sooner than it planned to
+    if (_hasTimerThread && time < _timerThreadWakeTime) {
+        _timerThreadWakeTime = time;
+        _timerCondition.notify_one();
+    }
+}
+
+void SendQueueScheduler::notifyThread() {
+    if (_numReadyThreads > 0) {
+        _readyCondition.notify_one();
+    } else if (_hasTimerThread) {
+        _timerCondition.notify_one();
+    }
+}
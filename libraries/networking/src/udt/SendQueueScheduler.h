@@ -0,0 +1,94 @@
+//
+//  SendQueueScheduler.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_udt_SendQueueScheduler_h
+#define hifi_udt_SendQueueScheduler_h
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "TimerWheel.h"
+
+namespace udt {
+
+class SendQueue;
+
+// Runs all the SendQueues of a Socket on a small, fixed set of threads.
+//   Each time a queue runs it sends whatever its pacing lets it, then tells the scheduler when it next needs to run:
+//   either at its next packet send time, or after waiting for something to happen (a packet to send, an ACK, a loss)
+//   with a deadline for re-sending or going inactive. The scheduler keeps those times in a TimerWheel, so a thread only
+//   wakes up when a queue is due, and runs due queues in order, one at a time per queue.
+class SendQueueScheduler {
+public:
+    using Clock = TimerWheel::Clock;
+    using TimePoint = TimerWheel::TimePoint;
+
+    // state the scheduler keeps for each queue, held by the queue, guarded by the scheduler's mutex
+    class Entry : public TimerWheel::Timer {
+    private:
+        SendQueue* _queue { nullptr };
+        bool _isAdded { false };
+        bool _isReady { false }; // in the ready list
+        bool _isRunning { false };
+        bool _isWaitingForEvent { false }; // the next wake() should run the queue straight away
+        bool _wasWokenWhileRunning { false };
+
+        friend class SendQueueScheduler;
+    };
+
+    static const int DEFAULT_NUM_THREADS = 2;
+
+    SendQueueScheduler(int numThreads = DEFAULT_NUM_THREADS);
+    ~SendQueueScheduler();
+
+    int getNumThreads() const { return (int)_threads.size(); }
+
+    // runs the queue as soon as a thread is free
+    void add(SendQueue& queue);
+
+    // returns once the queue isn't running on any thread, it won't be run again
+    // must not be called from the queue itself
+    void remove(SendQueue& queue);
+
+    // runs the queue now if it is waiting for something to happen, it otherwise runs when its pacing allows
+    void wake(SendQueue& queue);
+
+private:
+    void run(int threadIndex);
+    void runEntry(std::unique_lock<std::mutex>& lock, Entry& entry);
+    void makeReady(Entry& entry);
+    void schedule(Entry& entry, TimePoint time);
+    void notifyThread();
+
+    std::mutex _mutex;
+    TimerWheel _wheel;
+    std::deque<Entry*> _readyEntries;
+
+    // one idle thread waits for the next timer in the wheel, the others for entries to become ready
+    std::condition_variable _timerCondition;
+    std::condition_variable _readyCondition;
+    bool _hasTimerThread { false };
+    TimePoint _timerThreadWakeTime;
+    int _numReadyThreads { 0 };
+
+    std::condition_variable _finishedRunningCondition;
+
+    bool _isStopping { false };
+    std::vector<std::thread> _threads;
+};
+
+}
+
+#endif // hifi_udt_SendQueueScheduler_h
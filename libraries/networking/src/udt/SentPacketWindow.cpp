@@ -0,0 +1,98 @@
+//
+//  SentPacketWindow.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SentPacketWindow.h"
+
+#include <algorithm>
+
+#include <QtCore/QtGlobal>
+
+#include "Packet.h"
+
+using namespace udt;
+
+static const int INITIAL_HISTORY_SIZE = 256;
+
+static_assert((SequenceNumber::MAX + 1) % INITIAL_HISTORY_SIZE == 0,
+              "The ring size has to divide the sequence number space for sequence numbers to map to the same slot");
+
+SentPacketWindow::SentPacketWindow() :
+    _entries(INITIAL_HISTORY_SIZE)
+{
+}
+
+SentPacketWindow::~SentPacketWindow() {
+}
+
+void SentPacketWindow::add(SequenceNumber sequenceNumber, std::unique_ptr<Packet> packet) {
+    if (_numSequenceNumbers == 0) {
+        _firstSequenceNumber = sequenceNumber;
+    }
+
+    Q_ASSERT_X(_numSequenceNumbers == 0 || (_firstSequenceNumber < sequenceNumber &&
+               seqoff(_firstSequenceNumber, sequenceNumber) >= _numSequenceNumbers),
+               "SentPacketWindow::add()", "Sequence number added out of order");
+
+    int numSequenceNumbers = seqoff(_firstSequenceNumber, sequenceNumber) + 1;
+    if (numSequenceNumbers > (int)_entries.size()) {
+        grow(numSequenceNumbers);
+    }
+
+    auto& entry = _entries[indexOf(sequenceNumber)];
+    entry.first = 0; // No resend
+    entry.second = std::move(packet);
+    _numSequenceNumbers = std::max(_numSequenceNumbers, numSequenceNumbers);
+}
+
+void SentPacketWindow::acknowledge(SequenceNumber sequenceNumber) {
+    if (_numSequenceNumbers == 0 || sequenceNumber < _firstSequenceNumber) {
+        return;
+    }
+
+    int numAcknowledged = std::min(seqoff(_firstSequenceNumber, sequenceNumber) + 1, _numSequenceNumbers);
+    for (int i = 0; i < numAcknowledged; ++i) {
+        _entries[indexOf(_firstSequenceNumber)].second.reset();
+        ++_firstSequenceNumber;
+    }
+    _numSequenceNumbers -= numAcknowledged;
+}
+
+SentPacketWindow::Entry* SentPacketWindow::find(SequenceNumber sequenceNumber) {
+    if (_numSequenceNumbers == 0 || sequenceNumber < _firstSequenceNumber
+        || seqoff(_firstSequenceNumber, sequenceNumber) >= _numSequenceNumbers) {
+        return nullptr;
+    }
+
+    auto& entry = _entries[indexOf(sequenceNumber)];
+    return entry.second ? &entry : nullptr;
+}
+
+void SentPacketWindow::clear() {
+    for (auto& entry : _entries) {
+        entry.second.reset();
+    }
+    _numSequenceNumbers = 0;
+}
+
+void SentPacketWindow::grow(int minimumSize) {
+    size_t newSize = _entries.size();
+    while ((int)newSize < minimumSize) {
+        newSize *= 2;
+    }
+    Q_ASSERT(newSize <= (size_t)SequenceNumber::MAX + 1);
+
+    // the slots move around since the mask changes, so re-place the packets still in the ring
+    std::vector<Entry> newEntries(newSize);
+    SequenceNumber sequenceNumber = _firstSequenceNumber;
+    for (int i = 0; i < _numSequenceNumbers; ++i, ++sequenceNumber) {
+        newEntries[(SequenceNumber::UType)sequenceNumber & (newSize - 1)] = std::move(_entries[indexOf(sequenceNumber)]);
+    }
+    _entries.swap(newEntries);
+}
@@ -0,0 +1,57 @@
+//
+//  SentPacketWindow.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SentPacketWindow_h
+#define hifi_SentPacketWindow_h
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "SequenceNumber.h"
+
+namespace udt {
+
+class Packet;
+
+// The packets sent on a connection that are waiting for an ACK, in a ring buffer indexed by sequence number.
+// Packets are added in sequence number order and ACKed from the oldest, so the ring only grows while the number of
+// packets in flight does, and doesn't allocate per packet.
+class SentPacketWindow {
+public:
+    using Entry = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resends + packet ptr
+
+    SentPacketWindow();
+    ~SentPacketWindow();
+
+    // sequenceNumber must come after any sequence number already added
+    void add(SequenceNumber sequenceNumber, std::unique_ptr<Packet> packet);
+
+    // removes the packets up to and including sequenceNumber
+    void acknowledge(SequenceNumber sequenceNumber);
+
+    // the entry of a packet that hasn't been ACKed yet, or nullptr
+    Entry* find(SequenceNumber sequenceNumber);
+
+    void clear();
+
+private:
+    size_t indexOf(SequenceNumber sequenceNumber) const { return (SequenceNumber::UType)sequenceNumber & (_entries.size() - 1); }
+    void grow(int minimumSize);
+
+    std::vector<Entry> _entries; // always a power of two in size, so it divides the sequence number space evenly
+    SequenceNumber _firstSequenceNumber { 0 }; // the oldest sequence number the ring holds
+    int _numSequenceNumbers { 0 }; // from _firstSequenceNumber, including the slots of packets that were ACKed or skipped
+};
+
+}
+
+#endif // hifi_SentPacketWindow_h
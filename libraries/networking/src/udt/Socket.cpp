@@ -16,6 +16,7 @@
 #include <sys/socket.h>
 #endif
 
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QThread>
 
 #include <shared/QtHelpers.h>
@@ -27,6 +28,7 @@
 #include "Packet.h"
 #include "../NLPacket.h"
 #include "../NLPacketList.h"
+#include "PacketBufferPool.h"
 #include "PacketList.h"
 #include <Trace.h>
 
@@ -39,6 +41,8 @@ using namespace udt;
 #include <netinet/in.h>
 #endif
 
+static const QString UDT_BATCHED_IO_FLAG = "HIFI_UDT_BATCHED_IO";
+static const QString UDT_SEND_QUEUE_THREADS_ENV = "HIFI_UDT_SEND_QUEUE_THREADS";
 
 Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     QObject(parent),
@@ -56,11 +60,31 @@ Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     const int READY_READ_BACKUP_CHECK_MSECS = 2 * 1000;
     connect(_readyReadBackupTimer, &QTimer::timeout, this, &Socket::checkForReadyReadBackup);
     _readyReadBackupTimer->start(READY_READ_BACKUP_CHECK_MSECS);
+
+    if (QProcessEnvironment::systemEnvironment().contains(UDT_BATCHED_IO_FLAG)) {
+        setBatchedIOEnabled(true);
+    }
+
+    int numSendQueueThreads = SendQueueScheduler::DEFAULT_NUM_THREADS;
+    if (QProcessEnvironment::systemEnvironment().contains(UDT_SEND_QUEUE_THREADS_ENV)) {
+        bool ok = false;
+        int value = QProcessEnvironment::systemEnvironment().value(UDT_SEND_QUEUE_THREADS_ENV).toInt(&ok);
+        if (ok && value > 0) {
+            numSendQueueThreads = value;
+        } else {
+            qCWarning(networking) << "Ignoring invalid" << UDT_SEND_QUEUE_THREADS_ENV << "value";
+        }
+    }
+    _sendQueueScheduler.reset(new SendQueueScheduler(numSendQueueThreads));
 }
 
 void Socket::bind(SocketType socketType, const QHostAddress& address, quint16 port) {
     _networkSocket.bind(socketType, address, port);
 
+    if (socketType == SocketType::UDP) {
+        updateBatchedIOSocketDescriptor();
+    }
+
     if (_shouldChangeSocketOptions) {
         setSystemBufferSizes(socketType);
         if (socketType == SocketType::WebRTC) {
@@ -91,6 +115,44 @@ void Socket::rebind(SocketType socketType, quint16 localPort) {
     bind(socketType, QHostAddress::AnyIPv4, localPort);
 }
 
+void Socket::setBatchedIOEnabled(bool enabled) {
+    if (enabled && !BatchedDatagramIO::isSupported()) {
+        qCWarning(networking) << "Batched datagram I/O is not supported on this platform";
+        return;
+    }
+
+    if (enabled == isBatchedIOEnabled()) {
+        return;
+    }
+
+    qCDebug(networking) << (enabled ? "Enabling" : "Disabling") << "batched datagram I/O";
+    _batchedIO.reset(enabled ? new BatchedDatagramIO() : nullptr);
+    updateBatchedIOSocketDescriptor();
+}
+
+void Socket::updateBatchedIOSocketDescriptor() {
+    if (_batchedReadNotifier) {
+        delete _batchedReadNotifier;
+        _batchedReadNotifier = nullptr;
+    }
+
+    auto socketDescriptor = _networkSocket.socketDescriptor(SocketType::UDP);
+
+    if (_batchedIO) {
+        _batchedIO->setSocketDescriptor(socketDescriptor);
+
+        if (socketDescriptor != -1) {
+            // the QUdpSocket only re-arms its read notifier when a datagram is read through it, since we read around it
+            // we watch the descriptor ourselves
+            _batchedReadNotifier = new QSocketNotifier(socketDescriptor, QSocketNotifier::Read, this);
+            connect(_batchedReadNotifier, SIGNAL(activated(int)), this, SLOT(readPendingDatagrams()));
+        }
+    }
+
+    // when we read the UDP socket around Qt only WebRTC datagrams should come through the NetworkSocket
+    _networkSocket.setUDPReadEnabled(!_batchedReadNotifier);
+}
+
 #if defined(WEBRTC_DATA_CHANNELS)
 const WebRTCSocket* Socket::getWebRTCSocket() {
     return _networkSocket.getWebRTCSocket();
@@ -208,6 +270,10 @@ qint64 Socket::writePacketList(std::unique_ptr<PacketList> packetList, const Soc
     }
 
     // Unreliable and Unordered
+    if (_batchedIO && sockAddr.getType() == SocketType::UDP) {
+        return writeUnreliablePacketsBatched(packetList->_packets, sockAddr);
+    }
+
     qint64 totalBytesSent = 0;
     while (!packetList->_packets.empty()) {
         totalBytesSent += writePacket(packetList->takeFront<Packet>(), sockAddr);
@@ -215,6 +281,42 @@ qint64 Socket::writePacketList(std::unique_ptr<PacketList> packetList, const Soc
     return totalBytesSent;
 }
 
+qint64 Socket::writeUnreliablePacketsBatched(std::list<std::unique_ptr<Packet>>& packets, const SockAddr& sockAddr) {
+    // don't attempt to write the datagrams if we're unbound.  Just drop them.
+    if (_networkSocket.state(SocketType::UDP) != QAbstractSocket::BoundState) {
+        qCDebug(networking) << "Attempt to write batched datagrams when in unbound state to" << sockAddr;
+        return -1;
+    }
+
+    auto connection = findOrCreateConnection(sockAddr, true);
+
+    std::vector<BatchedDatagramIO::OutgoingDatagram> datagrams;
+    datagrams.reserve(packets.size());
+    {
+        Lock lock(_unreliableSequenceNumbersMutex);
+        auto& sequenceNumber = _unreliableSequenceNumbers[sockAddr];
+
+        for (auto& packet : packets) {
+            Q_ASSERT_X(!packet->isReliable(), "Socket::writeUnreliablePacketsBatched",
+                       "Cannot send a reliable packet unreliably");
+
+            // write the correct sequence number to the Packet here
+            packet->writeSequenceNumber(++sequenceNumber);
+            datagrams.push_back({ packet->getData(), packet->getDataSize() });
+        }
+    }
+
+    if (connection) {
+        for (auto& packet : packets) {
+            connection->recordSentUnreliablePackets(packet->getWireSize(), packet->getPayloadSize());
+        }
+    }
+
+    qint64 bytesWritten = _batchedIO->send(datagrams, sockAddr);
+    packets.clear();
+    return bytesWritten;
+}
+
 void Socket::writeReliablePacket(Packet* packet, const SockAddr& sockAddr) {
     auto connection = findOrCreateConnection(sockAddr);
     if (connection) {
@@ -383,6 +485,30 @@ void Socket::readPendingDatagrams() {
     const auto abortTime = system_clock::now() + MAX_PROCESS_TIME;
     int packetSizeWithHeader = -1;
 
+    if (_batchedReadNotifier) {
+        // pull UDP datagrams a batch at a time, anything left on the WebRTC socket goes through the loop below
+        std::vector<BatchedDatagramIO::ReceivedDatagram> datagrams;
+        datagrams.reserve(BatchedDatagramIO::MAX_BATCH_SIZE);
+
+        while (system_clock::now() <= abortTime) {
+            datagrams.clear();
+            if (_batchedIO->receive(datagrams) <= 0) {
+                break;
+            }
+
+            // we're reading packets so re-start the readyRead backup timer
+            _readyReadBackupTimer->start();
+
+            // grab a time point we can mark as the receive time of this batch
+            auto receiveTime = p_high_resolution_clock::now();
+
+            for (auto& datagram : datagrams) {
+                processReceivedDatagram(std::move(datagram.buffer), datagram.size, datagram.senderSockAddr,
+                                        receiveTime, true);
+            }
+        }
+    }
+
     while (_networkSocket.hasPendingDatagrams() &&
            (packetSizeWithHeader = _networkSocket.pendingDatagramSize()) != -1) {
         if (system_clock::now() > abortTime) {
@@ -411,83 +537,98 @@ void Socket::readPendingDatagrams() {
         // pull the datagram
         auto sizeRead = _networkSocket.readDatagram(buffer.get(), packetSizeWithHeader, &senderSockAddr);
 
-        // save information for this packet, in case it is the one that sticks readyRead
-        _lastPacketSizeRead = sizeRead;
-        _lastPacketSockAddr = senderSockAddr;
-
         if (sizeRead <= 0) {
+            // save information for this packet, in case it is the one that sticks readyRead
+            _lastPacketSizeRead = sizeRead;
+            _lastPacketSockAddr = senderSockAddr;
+
             // we either didn't pull anything for this packet or there was an error reading (this seems to trigger
             // on windows even if there's not a packet available)
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
-
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this SockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
-            }
+        processReceivedDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime, false);
+    }
+}
 
-            continue;
+void Socket::processReceivedDatagram(std::unique_ptr<char[]> buffer, int packetSizeWithHeader,
+                                     const SockAddr& senderSockAddr, p_high_resolution_clock::time_point receiveTime,
+                                     bool isBufferPooled) {
+    // save information for this packet, in case it is the one that sticks readyRead
+    _lastPacketSizeRead = packetSizeWithHeader;
+    _lastPacketSockAddr = senderSockAddr;
+
+    auto it = _unfilteredHandlers.find(senderSockAddr);
+
+    if (it != _unfilteredHandlers.end()) {
+        // we have a registered unfiltered handler for this SockAddr - call that and return
+        if (it->second) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+            basePacket->setBufferIsPooled(isBufferPooled);
+            basePacket->setReceiveTime(receiveTime);
+            it->second(std::move(basePacket));
+        } else if (isBufferPooled) {
+            PacketBufferPool::release(std::move(buffer));
         }
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        return;
+    }
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr, true);
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        controlPacket->setBufferIsPooled(isBufferPooled);
+        controlPacket->setReceiveTime(receiveTime);
 
-            if (connection) {
-                connection->processControl(move(controlPacket));
-            }
+        // move this control packet to the matching connection, if there is one
+        auto connection = findOrCreateConnection(senderSockAddr, true);
 
-        } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            packet->setReceiveTime(receiveTime);
+        if (connection) {
+            connection->processControl(move(controlPacket));
+        }
 
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        packet->setBufferIsPooled(isBufferPooled);
+        packet->setReceiveTime(receiveTime);
 
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                auto connection = findOrCreateConnection(senderSockAddr, true);
+        // save the sequence number in case this is the packet that sticks readyRead
+        _lastReceivedSequenceNumber = packet->getSequenceNumber();
+
+        // call our verification operator to see if this packet is verified
+        if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
+            auto connection = findOrCreateConnection(senderSockAddr, true);
 
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
+            if (packet->isReliable()) {
+                // if this was a reliable packet then signal the matching connection with the sequence number
 
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
+                if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                              packet->getDataSize(),
+                                                                              packet->getPayloadSize())) {
+                    // the connection could not be created or indicated that we should not continue processing this packet
 #ifdef UDT_CONNECTION_DEBUG
-                        qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
-                            << ", type" << NLPacket::typeInHeader(*packet);
+                    qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
+                        << ", type" << NLPacket::typeInHeader(*packet);
 #endif
-                        continue;
-                    }
-                } else if (connection) {
-                    connection->recordReceivedUnreliablePackets(packet->getWireSize(),
-                                                                packet->getPayloadSize());
+                    return;
                 }
+            } else if (connection) {
+                connection->recordReceivedUnreliablePackets(packet->getWireSize(),
+                                                            packet->getPayloadSize());
+            }
 
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr, true);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
+            if (packet->isPartOfMessage()) {
+                auto connection = findOrCreateConnection(senderSockAddr, true);
+                if (connection) {
+                    connection->queueReceivedMessagePacket(std::move(packet));
                 }
+            } else if (_packetHandler) {
+                // call the verified packet callback to let it handle this packet
+                _packetHandler(std::move(packet));
             }
         }
     }
@@ -502,6 +643,9 @@ void Socket::connectToSendSignal(const SockAddr& destinationAddr, QObject* recei
 }
 
 void Socket::setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory) {
+    // new connections are created under the connections lock, existing ones keep their congestion control
+    Lock connectionsLock(_connectionsHashMutex);
+
     // swap the current unique_ptr for the new factory
     _ccFactory.swap(ccFactory);
 }
@@ -21,9 +21,11 @@
 #include <list>
 
 #include <QtCore/QObject>
+#include <QtCore/QSocketNotifier>
 #include <QtCore/QTimer>
 
 #include "../SockAddr.h"
+#include "BatchedDatagramIO.h"
 #include "TCPVegasCC.h"
 #include "Connection.h"
 #include "NetworkSocket.h"
@@ -82,7 +84,14 @@ public:
     void addUnfilteredHandler(const SockAddr& senderSockAddr, BasePacketHandler handler)
         { _unfilteredHandlers[senderSockAddr] = handler; }
     
+    // read and write UDP datagrams in batches where the platform supports it (Linux recvmmsg/sendmmsg)
+    void setBatchedIOEnabled(bool enabled);
+    bool isBatchedIOEnabled() const { return (bool)_batchedIO; }
+
     void setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory);
+
+    // the threads every connection's SendQueue runs on
+    SendQueueScheduler& getSendQueueScheduler() { return *_sendQueueScheduler; }
     void setConnectionMaxBandwidth(int maxBandwidth);
 
     void messageReceived(std::unique_ptr<Packet> packet);
@@ -115,6 +124,10 @@ private slots:
 
 private:
     void setSystemBufferSizes(SocketType socketType);
+    void updateBatchedIOSocketDescriptor();
+    void processReceivedDatagram(std::unique_ptr<char[]> buffer, int packetSizeWithHeader, const SockAddr& senderSockAddr,
+                                 p_high_resolution_clock::time_point receiveTime, bool isBufferPooled);
+    qint64 writeUnreliablePacketsBatched(std::list<std::unique_ptr<Packet>>& packets, const SockAddr& sockAddr);
     Connection* findOrCreateConnection(const SockAddr& sockAddr, bool filterCreation = false);
    
     // privatized methods used by UDTTest - they are private since they must be called on the Socket thread
@@ -133,6 +146,9 @@ private:
     MessageFailureHandler _messageFailureHandler;
     ConnectionCreationFilterOperator _connectionCreationFilterOperator;
 
+    // declared before the connections, so that it outlives their send queues
+    std::unique_ptr<SendQueueScheduler> _sendQueueScheduler;
+
     Mutex _unreliableSequenceNumbersMutex;
     Mutex _connectionsHashMutex;
 
@@ -142,6 +158,9 @@ private:
 
     QTimer* _readyReadBackupTimer { nullptr };
 
+    std::unique_ptr<BatchedDatagramIO> _batchedIO;
+    QSocketNotifier* _batchedReadNotifier { nullptr };
+
     int _maxBandwidth { -1 };
 
     std::unique_ptr<CongestionControlVirtualFactory> _ccFactory { new CongestionControlFactory<TCPVegasCC>() };
@@ -0,0 +1,208 @@
+//
+//  TimerWheel.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheel.h"
+
+#include <algorithm>
+#include <limits>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+using namespace udt;
+using namespace std::chrono;
+
+static_assert(TimerWheel::SLOTS_PER_LEVEL == 64, "the occupied slots of a level are kept in a 64 bit mask");
+
+static const uint64_t SLOT_MASK = TimerWheel::SLOTS_PER_LEVEL - 1;
+static const uint64_t MAX_TICKS_AHEAD = (uint64_t(1) << (TimerWheel::LEVEL_BITS * TimerWheel::NUM_LEVELS)) - 1;
+
+static int findFirstSetBit(uint64_t bits) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return (int)index;
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+static uint64_t rotateRight(uint64_t bits, int count) {
+    return count == 0 ? bits : (bits >> count) | (bits << (64 - count));
+}
+
+TimerWheel::TimerWheel(microseconds tick, TimePoint startTime) :
+    _tick(std::max(tick, microseconds(1))),
+    _startTime(startTime)
+{
+}
+
+void TimerWheel::schedule(Timer& timer, TimePoint time) {
+    if (timer.isScheduled()) {
+        remove(timer);
+    }
+
+    timer._expiryTick = std::min(getTickAtOrAfter(time), _currentTick + MAX_TICKS_AHEAD);
+    insert(timer);
+}
+
+void TimerWheel::cancel(Timer& timer) {
+    if (timer.isScheduled()) {
+        remove(timer);
+    }
+}
+
+void TimerWheel::advance(TimePoint now, const ExpiryHandler& handler) {
+    if (now < _startTime) {
+        return;
+    }
+
+    uint64_t nowTick = (uint64_t)(duration_cast<nanoseconds>(now - _startTime) / _tick);
+
+    // skip straight to the ticks that have something in their slots, rather than stepping through every one
+    while (_numTimers > 0) {
+        uint64_t nextTick = getNextEventTick();
+        if (nextTick > nowTick) {
+            break;
+        }
+        processTick(nextTick, handler);
+    }
+
+    _currentTick = std::max(_currentTick, nowTick + 1);
+}
+
+TimerWheel::TimePoint TimerWheel::getNextEventTime() const {
+    if (_numTimers == 0) {
+        return TimePoint::max();
+    }
+    return _startTime + duration_cast<TimePoint::duration>(_tick * (int64_t)getNextEventTick());
+}
+
+uint64_t TimerWheel::getTickAtOrAfter(TimePoint time) const {
+    if (time <= _startTime) {
+        return 0;
+    }
+
+    uint64_t elapsed = (uint64_t)duration_cast<nanoseconds>(time - _startTime).count();
+    uint64_t tick = (uint64_t)duration_cast<nanoseconds>(_tick).count();
+    return elapsed / tick + (elapsed % tick != 0 ? 1 : 0);
+}
+
+uint64_t TimerWheel::getNextEventTick() const {
+    uint64_t nextTick = std::numeric_limits<uint64_t>::max();
+
+    for (int level = 0; level < NUM_LEVELS; ++level) {
+        if (_occupiedSlots[level] == 0) {
+            continue;
+        }
+
+        // a slot is due when its level comes round to it, the first time at or after the current tick
+        int shift = LEVEL_BITS * level;
+        uint64_t firstBucket = (_currentTick + ((uint64_t(1) << shift) - 1)) >> shift;
+        uint64_t occupied = rotateRight(_occupiedSlots[level], (int)(firstBucket & SLOT_MASK));
+        uint64_t bucket = firstBucket + findFirstSetBit(occupied);
+
+        nextTick = std::min(nextTick, bucket << shift);
+    }
+
+    return nextTick;
+}
+
+TimerWheel::Timer*& TimerWheel::getListHead(const Timer& timer) {
+    return timer._level == Timer::EXPIRING ? _expiring : _slots[timer._level][timer._slotIndex];
+}
+
+void TimerWheel::insert(Timer& timer) {
+    // anything overdue goes in the slot of the next tick we process
+    uint64_t tick = std::max(timer._expiryTick, _currentTick);
+    uint64_t ticksAhead = tick - _currentTick;
+
+    int level = 0;
+    while (level < NUM_LEVELS - 1 && ticksAhead >= (uint64_t(1) << (LEVEL_BITS * (level + 1)))) {
+        ++level;
+    }
+
+    timer._level = level;
+    timer._slotIndex = (int)((tick >> (LEVEL_BITS * level)) & SLOT_MASK);
+
+    Timer*& head = getListHead(timer);
+    timer._previous = nullptr;
+    timer._next = head;
+    if (head) {
+        head->_previous = &timer;
+    }
+    head = &timer;
+
+    _occupiedSlots[level] |= uint64_t(1) << timer._slotIndex;
+    ++_numTimers;
+}
+
+void TimerWheel::remove(Timer& timer) {
+    Timer*& head = getListHead(timer);
+    if (timer._previous) {
+        timer._previous->_next = timer._next;
+    } else {
+        head = timer._next;
+    }
+    if (timer._next) {
+        timer._next->_previous = timer._previous;
+    }
+
+    if (!head && timer._level != Timer::EXPIRING) {
+        _occupiedSlots[timer._level] &= ~(uint64_t(1) << timer._slotIndex);
+    }
+
+    timer._previous = nullptr;
+    timer._next = nullptr;
+    timer._level = Timer::NOT_SCHEDULED;
+    --_numTimers;
+}
+
+void TimerWheel::processTick(uint64_t tick, const ExpiryHandler& handler) {
+    _currentTick = tick;
+
+    // move the timers of every level that comes round on this tick down to the levels below
+    for (int level = NUM_LEVELS - 1; level > 0; --level) {
+        int shift = LEVEL_BITS * level;
+        if ((tick & ((uint64_t(1) << shift) - 1)) != 0) {
+            continue;
+        }
+
+        int slotIndex = (int)((tick >> shift) & SLOT_MASK);
+        Timer* timer = _slots[level][slotIndex];
+        _slots[level][slotIndex] = nullptr;
+        _occupiedSlots[level] &= ~(uint64_t(1) << slotIndex);
+
+        while (timer) {
+            Timer* next = timer->_next;
+            --_numTimers;
+            insert(*timer);
+            timer = next;
+        }
+    }
+
+    // take the timers due now out of the wheel before handling them, so that the handler can schedule timers again
+    // (including these ones) or cancel those we haven't gotten to yet
+    int slotIndex = (int)(tick & SLOT_MASK);
+    for (Timer* timer = _slots[0][slotIndex]; timer; timer = timer->_next) {
+        timer->_level = Timer::EXPIRING;
+    }
+    _expiring = _slots[0][slotIndex];
+    _slots[0][slotIndex] = nullptr;
+    _occupiedSlots[0] &= ~(uint64_t(1) << slotIndex);
+
+    _currentTick = tick + 1;
+
+    while (Timer* timer = _expiring) {
+        remove(*timer);
+        handler(*timer);
+    }
+}
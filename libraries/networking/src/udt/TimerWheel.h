@@ -0,0 +1,95 @@
+//
+//  TimerWheel.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_udt_TimerWheel_h
+#define hifi_udt_TimerWheel_h
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace udt {
+
+// Hierarchical timer wheel of intrusive timers (Varghese & Lauck).
+//   Level 0 has a slot per tick, and each slot of a level spans a whole revolution of the level below. A timer sits in
+//   the lowest level that reaches its expiry, and moves down a level when the level below comes round to it, so
+//   scheduling, cancelling and expiring a timer are constant time however many timers there are.
+//   Timers never expire early: an expiry is rounded up to the next tick. Not thread safe.
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+
+    class Timer {
+    public:
+        Timer() = default;
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+        bool isScheduled() const { return _level != NOT_SCHEDULED; }
+
+    private:
+        static const int NOT_SCHEDULED = -1;
+        static const int EXPIRING = -2; // taken out of its slot to be expired by the current advance
+
+        Timer* _previous { nullptr };
+        Timer* _next { nullptr };
+        int _level { NOT_SCHEDULED };
+        int _slotIndex { 0 };
+        uint64_t _expiryTick { 0 };
+
+        friend class TimerWheel;
+    };
+
+    using ExpiryHandler = std::function<void(Timer& timer)>;
+
+    static const int LEVEL_BITS = 6;
+    static const int SLOTS_PER_LEVEL = 1 << LEVEL_BITS;
+    static const int NUM_LEVELS = 4;
+
+    TimerWheel(std::chrono::microseconds tick, TimePoint startTime = Clock::now());
+
+    std::chrono::microseconds getTick() const { return _tick; }
+    int getNumTimers() const { return _numTimers; }
+
+    // (re)schedules timer to expire at time, or at the furthest time the wheel reaches if that is beyond it
+    void schedule(Timer& timer, TimePoint time);
+    void cancel(Timer& timer);
+
+    // expires every timer due at or before now, in expiry order, handler may schedule timers again
+    void advance(TimePoint now, const ExpiryHandler& handler);
+
+    // when advance next has something to do, TimePoint::max() if there are no timers
+    TimePoint getNextEventTime() const;
+
+private:
+    uint64_t getTickAtOrAfter(TimePoint time) const;
+    uint64_t getNextEventTick() const;
+    Timer*& getListHead(const Timer& timer);
+    void insert(Timer& timer);
+    void remove(Timer& timer);
+    void processTick(uint64_t tick, const ExpiryHandler& handler);
+
+    std::chrono::microseconds _tick;
+    TimePoint _startTime;
+    uint64_t _currentTick { 0 }; // the next tick to process
+
+    std::array<std::array<Timer*, SLOTS_PER_LEVEL>, NUM_LEVELS> _slots {};
+    std::array<uint64_t, NUM_LEVELS> _occupiedSlots {}; // bitmask of the non-empty slots of each level
+    Timer* _expiring { nullptr };
+    int _numTimers { 0 };
+};
+
+}
+
+#endif // hifi_udt_TimerWheel_h
@@ -412,6 +412,46 @@ void Octree::eraseAllOctreeElements(bool createNewRoot) {
     }
 
     _isDirty = true;
+    recordPersistErase();
+}
+
+void Octree::setPersistChangesEnabled(bool enabled) {
+    _persistChangesEnabled = enabled;
+    _persistChangesComplete = true;
+    _persistChangedIDs.clear();
+    _persistDeletedIDs.clear();
+}
+
+bool Octree::takePersistChanges(QSet<QUuid>& changedIDs, QSet<QUuid>& deletedIDs) {
+    bool complete = _persistChangesComplete;
+    changedIDs.swap(_persistChangedIDs);
+    deletedIDs.swap(_persistDeletedIDs);
+    _persistChangedIDs.clear();
+    _persistDeletedIDs.clear();
+    _persistChangesComplete = true;
+    return complete;
+}
+
+void Octree::recordPersistChange(const QUuid& id) {
+    if (_persistChangesEnabled) {
+        _persistDeletedIDs.remove(id);
+        _persistChangedIDs.insert(id);
+    }
+}
+
+void Octree::recordPersistDelete(const QUuid& id) {
+    if (_persistChangesEnabled) {
+        _persistChangedIDs.remove(id);
+        _persistDeletedIDs.insert(id);
+    }
+}
+
+void Octree::recordPersistErase() {
+    if (_persistChangesEnabled) {
+        _persistChangesComplete = false;
+        _persistChangedIDs.clear();
+        _persistDeletedIDs.clear();
+    }
 }
 
 // Note: this is an expensive call. Don't call it unless you really need to reaverage the entire tree (from startElement)
@@ -819,22 +859,26 @@ bool Octree::readJSONFromStream(
         if (got == 0) {
             break;
         }
-        jsonBuffer += QByteArray(rawData, got);
+        jsonBuffer.append(rawData, got);
     }
 
+    delete[] rawData;
+
     OctreeEntitiesFileParser octreeParser;
     octreeParser.setRelativeURL(relativeURL);
     octreeParser.setEntitiesString(jsonBuffer);
 
+    return readFromParser(octreeParser, isImport);
+}
+
+bool Octree::readFromParser(OctreeEntitiesFileParser& parser, const bool isImport) {
     QVariantMap asMap;
-    if (!octreeParser.parseEntities(asMap)) {
-        qCritical() << "Couldn't parse Entities JSON:" << octreeParser.getErrorString().c_str();
+    if (!parser.parseEntities(asMap)) {
+        qCritical() << "Couldn't parse Entities JSON:" << parser.getErrorString().c_str();
         return false;
     }
 
-    bool success = readFromMap(asMap, isImport);
-    delete[] rawData;
-    return success;
+    return readFromMap(asMap, isImport);
 }
 
 bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& element, QString persistAsFileType) {
@@ -890,6 +934,18 @@ bool Octree::toJSONDocument(QJsonDocument* doc, const OctreeElementPointer& elem
     return true;
 }
 
+QString Octree::getJSONPrefix() const {
+    return QString("{\n  \"DataVersion\": %1,\n  \"Entities\": [").arg(_persistDataVersion);
+}
+
+QString Octree::getJSONSuffix() const {
+    // include the "bitstream" version
+    PacketType expectedType = expectedDataPacketType();
+    PacketVersion expectedVersion = versionForPacketType(expectedType);
+
+    return QString("\n    ],\n  \"Id\": \"%1\",\n  \"Version\": %2\n}\n").arg(_persistID.toString()).arg((int)expectedVersion);
+}
+
 bool Octree::toJSONString(QString& jsonString, const OctreeElementPointer& element) {
     OctreeElementPointer top;
     if (element) {
@@ -898,16 +954,21 @@ bool Octree::toJSONString(QString& jsonString, const OctreeElementPointer& eleme
         top = _rootElement;
     }
 
-    jsonString += QString("{\n  \"DataVersion\": %1,\n  \"Entities\": [").arg(_persistDataVersion);
+    jsonString += getJSONPrefix();
 
     writeToJSON(jsonString, top);
 
-    // include the "bitstream" version
-    PacketType expectedType = expectedDataPacketType();
-    PacketVersion expectedVersion = versionForPacketType(expectedType);
+    jsonString += getJSONSuffix();
 
-    jsonString += QString("\n    ],\n  \"Id\": \"%1\",\n  \"Version\": %2\n}\n").arg(_persistID.toString()).arg((int)expectedVersion);
+    return true;
+}
 
+bool Octree::writeToJSONStream(const std::function<void(const QString&)>& writeChunk, const OctreeElementPointer& element) {
+    QString jsonString;
+    if (!writeToJSON(jsonString, element)) {
+        return false;
+    }
+    writeChunk(jsonString);
     return true;
 }
 
@@ -930,24 +991,51 @@ bool Octree::toJSON(QByteArray* data, const OctreeElementPointer& element, bool
 bool Octree::writeToJSONFile(const char* fileName, const OctreeElementPointer& element, bool doGzip) {
     qCDebug(octree, "Saving JSON SVO to file %s...", fileName);
 
-    QByteArray jsonDataForFile;
-    if (!toJSON(&jsonDataForFile, element, doGzip)) {
-        return false;
+    OctreeElementPointer top;
+    if (element) {
+        top = element;
+    } else {
+        top = _rootElement;
     }
 
     QSaveFile persistFile(fileName);
-    bool success = false;
-    if (persistFile.open(QIODevice::WriteOnly)) {
-        if (persistFile.write(jsonDataForFile) != -1) {
-            success = persistFile.commit();
-            if (!success) {
-                qCritical() << "Failed to commit to JSON save file:" << persistFile.errorString();
-            }
+    if (!persistFile.open(QIODevice::WriteOnly)) {
+        qCritical("Failed to open JSON file for writing.");
+        return false;
+    }
+
+    // the JSON is compressed and written as it is produced, so that large trees are never held whole in memory
+    GzipStreamWriter gzipWriter(persistFile);
+    bool writeSucceeded = true;
+    auto writeChunk = [&](const QString& chunk) {
+        if (!writeSucceeded) {
+            return;
+        }
+        QByteArray data = chunk.toUtf8();
+        if (doGzip) {
+            writeSucceeded = gzipWriter.write(data);
         } else {
-            qCritical("Failed to write to JSON file.");
+            writeSucceeded = persistFile.write(data) == data.size();
         }
-    } else {
-        qCritical("Failed to open JSON file for writing.");
+    };
+
+    writeChunk(getJSONPrefix());
+    bool success = writeToJSONStream(writeChunk, top);
+    writeChunk(getJSONSuffix());
+
+    if (doGzip && writeSucceeded) {
+        writeSucceeded = gzipWriter.finish();
+    }
+
+    if (!success || !writeSucceeded) {
+        qCritical("Failed to write to JSON file.");
+        persistFile.cancelWriting();
+        return false;
+    }
+
+    success = persistFile.commit();
+    if (!success) {
+        qCritical() << "Failed to commit to JSON save file:" << persistFile.errorString();
     }
 
     return success;
@@ -12,12 +12,15 @@
 #ifndef hifi_Octree_h
 #define hifi_Octree_h
 
+#include <functional>
 #include <memory>
 #include <set>
 #include <stdint.h>
 
 #include <QHash>
 #include <QObject>
+#include <QSet>
+#include <QUuid>
 #include <QtCore/QJsonObject>
 
 #include <shared/ReadWriteLockable.h>
@@ -33,6 +36,7 @@
 class ReadBitstreamToTreeParams;
 class Octree;
 class OctreeElement;
+class OctreeEntitiesFileParser;
 class OctreePacketData;
 class Shape;
 using OctreePointer = std::shared_ptr<Octree>;
@@ -139,6 +143,14 @@ public:
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& sourceNode) { return 0; }
 
+    // Optional batched editing: decodeEditPacketData() decodes an edit without the tree lock and stages it, returning
+    // the bytes read, or 0 if the edit can't be staged and must go through processEditPacketData().  The staged edits
+    // are applied in order by applyDecodedEdits(), which must be called with the tree write lock held.
+    virtual int decodeEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                     const SharedNodePointer& sourceNode) { return 0; }
+    virtual int getNumDecodedEdits() const { return 0; }
+    virtual int applyDecodedEdits() { return 0; }
+
     virtual bool rootElementHasData() const { return false; }
     virtual void releaseSceneEncodeData(OctreeElementExtraEncodeData* extraEncodeData) const { }
 
@@ -210,6 +222,13 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) = 0;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) = 0;
+    /// Same as writeToJSON, handing the JSON to writeChunk a piece at a time instead of building it whole.
+    virtual bool writeToJSONStream(const std::function<void(const QString&)>& writeChunk, const OctreeElementPointer& element);
+    /// Writes each of the items with the given ids as a single line JSON object. Ids of missing items are skipped.
+    virtual bool writeItemsToJSON(const QSet<QUuid>& ids, QVector<QByteArray>& jsonItems) { return false; }
+    /// Writes the whole tree to a binary snapshot, which loads faster than JSON. Returns false if the tree has no
+    /// snapshot format.
+    virtual bool writeToSnapshotFile(const QString& filename) { return false; }
 
     // Octree importers
     bool readFromFile(const char* filename);
@@ -219,6 +238,11 @@ public:
     bool readJSONFromStream(uint64_t streamLength, QDataStream& inputStream, const bool isImport = false, const QUrl& urlString = QUrl());
     bool readJSONFromGzippedFile(QString qFileName);
     virtual bool readFromMap(QVariantMap& entityDescription, const bool isImport = false) = 0;
+    /// Same as readFromMap, with the items read from the parser. May read each item as it is parsed, instead of
+    /// building the whole map first, in which case items already read are kept if a later one fails to parse.
+    virtual bool readFromParser(OctreeEntitiesFileParser& parser, const bool isImport = false);
+    /// Called with the tree write-locked. Returns false, without changing the tree, if the snapshot can't be read.
+    virtual bool readFromSnapshotFile(const QString& filename) { return false; }
 
     uint64_t getOctreeElementsCount();
 
@@ -257,7 +281,15 @@ public:
     virtual quint64 getAverageFilterTime() const { return 0; }
 
     void incrementPersistDataVersion() { _persistDataVersion++; }
+    QUuid getPersistID() const { return _persistID; }
+    int getPersistDataVersion() const { return _persistDataVersion; }
 
+    // Incremental persistence: while enabled, the ids of the items added, edited or deleted are collected until they
+    // are taken by the persist thread, which journals them instead of rewriting the whole tree.
+    // Changes are recorded and taken with the tree write-locked.
+    void setPersistChangesEnabled(bool enabled);
+    /// Returns false if the changes can't be described item by item, because the whole tree was erased.
+    bool takePersistChanges(QSet<QUuid>& changedIDs, QSet<QUuid>& deletedIDs);
 
 protected:
     void deleteOctalCodeFromTreeRecursion(const OctreeElementPointer& element, void* extraData);
@@ -269,6 +301,13 @@ protected:
     int readElementData(const OctreeElementPointer& destinationElement, const unsigned char* nodeData,
                 int bufferSizeBytes, ReadBitstreamToTreeParams& args);
 
+    void recordPersistChange(const QUuid& id);
+    void recordPersistDelete(const QUuid& id);
+    void recordPersistErase();
+
+    QString getJSONPrefix() const;
+    QString getJSONSuffix() const;
+
     OctreeElementPointer _rootElement = nullptr;
 
     QUuid _persistID { QUuid::createUuid() };
@@ -277,6 +316,11 @@ protected:
     bool _isDirty;
     bool _shouldReaverage;
 
+    bool _persistChangesEnabled { false };
+    bool _persistChangesComplete { true };
+    QSet<QUuid> _persistChangedIDs;
+    QSet<QUuid> _persistDeletedIDs;
+
     bool _isViewing;
     bool _isServer;
 };
@@ -60,6 +60,43 @@ bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromFile(QString path) {
     return readOctreeDataInfoFromData(data);
 }
 
+OctreeUtils::SnapshotHeader OctreeUtils::RawOctreeData::toSnapshotHeader(quint32 formatVersion) const {
+    SnapshotHeader header;
+    header.magic = SNAPSHOT_MAGIC;
+    header.formatVersion = formatVersion;
+    header.dataVersion = dataVersion;
+    header.version = version;
+    QByteArray rfcID = id.toRfc4122();
+    memcpy(header.id, rfcID.constData(), sizeof(header.id));
+    return header;
+}
+
+bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromSnapshotHeader(const SnapshotHeader& header) {
+    if (header.magic != SNAPSHOT_MAGIC) {
+        return false;
+    }
+    id = QUuid::fromRfc4122(QByteArray::fromRawData(header.id, sizeof(header.id)));
+    dataVersion = header.dataVersion;
+    version = header.version;
+    return true;
+}
+
+// Reads the version info of a binary snapshot, without reading the rest of the file.
+bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromSnapshot(QString path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Cannot open snapshot file for reading: " << path;
+        return false;
+    }
+
+    SnapshotHeader header;
+    if (file.read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header)) {
+        return false;
+    }
+
+    return readOctreeDataInfoFromSnapshotHeader(header);
+}
+
 QByteArray OctreeUtils::RawOctreeData::toByteArray() {
     QByteArray jsonString;
 
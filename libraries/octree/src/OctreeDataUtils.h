@@ -24,6 +24,17 @@ constexpr Version INITIAL_VERSION = 0;
 
 //using PacketType = uint8_t;
 
+constexpr quint32 SNAPSHOT_MAGIC { 0x5345564F }; // "OVES"
+
+// SnapshotHeader starts the binary snapshots of an octree, so their version info can be read without the rest.
+struct SnapshotHeader {
+    quint32 magic;
+    quint32 formatVersion;
+    qint64 dataVersion;
+    qint64 version;
+    char id[16];
+};
+
 // RawOctreeData is an intermediate format between JSON and a fully deserialized Octree.
 class RawOctreeData {
 public:
@@ -43,6 +54,10 @@ public:
     bool readOctreeDataInfoFromData(QByteArray data);
     bool readOctreeDataInfoFromFile(QString path);
     bool readOctreeDataInfoFromMap(const QVariantMap& map);
+
+    SnapshotHeader toSnapshotHeader(quint32 formatVersion) const;
+    bool readOctreeDataInfoFromSnapshotHeader(const SnapshotHeader& header);
+    bool readOctreeDataInfoFromSnapshot(QString path);
 };
 
 class RawEntityData : public RawOctreeData {
@@ -12,6 +12,7 @@
 
 #include "OctreeEntitiesFileParser.h"
 
+#include <algorithm>
 #include <sstream>
 #include <cctype>
 
@@ -39,6 +40,35 @@ void OctreeEntitiesFileParser::setEntitiesString(const QByteArray& entitiesConte
 }
 
 bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
+    QVariantList entitiesValue;
+    EntityHandler appendEntity = [&entitiesValue](const QJsonObject& entity) {
+        entitiesValue.append(entity);
+        return true;
+    };
+    if (!parseObject(parsedEntities, &appendEntity)) {
+        return false;
+    }
+    if (parsedEntities.contains("Entities")) {
+        parsedEntities["Entities"] = std::move(entitiesValue);
+    }
+    return true;
+}
+
+bool OctreeEntitiesFileParser::parseHeader(QVariantMap& header) {
+    return parseObject(header, nullptr);
+}
+
+bool OctreeEntitiesFileParser::parseEntities(const EntityHandler& entityHandler) {
+    QVariantMap header;
+    return parseObject(header, &entityHandler);
+}
+
+// Parses the top-level object. The entities are skipped if entityHandler is null.
+bool OctreeEntitiesFileParser::parseObject(QVariantMap& parsedEntities, const EntityHandler* entityHandler) {
+    _position = 0;
+    _line = 1;
+    _errorString.clear();
+
     if (nextToken() != '{') {
         _errorString = "Text before start of object";
         return false;
@@ -86,12 +116,12 @@ bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
                 return false;
             }
 
-            QVariantList entitiesValue;
-            if (!readEntitiesArray(entitiesValue)) {
+            if (entityHandler ? !readEntitiesArray(*entityHandler) : !skipEntitiesArray()) {
                 return false;
             }
 
-            parsedEntities["Entities"] = std::move(entitiesValue);
+            // the entities are handed to entityHandler, only record that there are some
+            parsedEntities["Entities"] = QVariantList();
             gotEntities = true;
         } else if (key == "Id") {
             if (gotId) {
@@ -214,7 +244,26 @@ int OctreeEntitiesFileParser::readInteger() {
     return i;
 }
 
-bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
+bool OctreeEntitiesFileParser::skipEntitiesArray() {
+    if (nextToken() != '[') {
+        _errorString = "Entities entry is not an array";
+        return false;
+    }
+
+    int matchingBracket = findMatchingBrace('[', ']');
+    if (matchingBracket < 0) {
+        _errorString = "Unterminated entities array";
+        return false;
+    }
+
+    // keep the line count right for errors after the entities
+    const char* data = _entitiesContents.constData();
+    _line += (int)std::count(data + _position, data + matchingBracket, '\n');
+    _position = matchingBracket;
+    return true;
+}
+
+bool OctreeEntitiesFileParser::readEntitiesArray(const EntityHandler& entityHandler) {
     if (nextToken() != '[') {
         _errorString = "Entities entry is not an array";
         return false;
@@ -326,8 +375,12 @@ bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
             }
         }
 
-        entitiesArray.append(entityObject);
         _position = matchingBrace;
+        if (!entityHandler(entityObject)) {
+            _errorString = "Entity rejected";
+            return false;
+        }
+
         char c = nextToken();
         if (c == ']') {
             return true;
@@ -339,20 +392,16 @@ bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
     return true;
 }
 
-int OctreeEntitiesFileParser::findMatchingBrace() const {
+int OctreeEntitiesFileParser::findMatchingBrace(char openingBrace, char closingBrace) const {
     int index = _position;
     int nestCount = 1;
     while (index < _entitiesLength && nestCount != 0) {
-        switch (_entitiesContents[index++]) {
-        case '{':
+        char c = _entitiesContents[index++];
+        if (c == openingBrace) {
             ++nestCount;
-            break;
-
-        case '}':
+        } else if (c == closingBrace) {
             --nestCount;
-            break;
-
-        case '"':
+        } else if (c == '"') {
             // Skip string
             while (index < _entitiesLength) {
                 if (_entitiesContents[index] == '"') {
@@ -363,10 +412,6 @@ int OctreeEntitiesFileParser::findMatchingBrace() const {
                 }
                 ++index;
             }
-            break;
-
-        default:
-            break;
         }
     }
 
@@ -14,23 +14,36 @@
 #ifndef hifi_OctreeEntitiesFileParser_h
 #define hifi_OctreeEntitiesFileParser_h
 
+#include <functional>
+
 #include <QByteArray>
+#include <QJsonObject>
 #include <QUrl>
 #include <QVariant>
 
 class OctreeEntitiesFileParser {
 public:
+    /// Returns false to stop parsing.
+    using EntityHandler = std::function<bool(const QJsonObject& entity)>;
+
     void setEntitiesString(const QByteArray& entitiesContents);
     void setRelativeURL(const QUrl& relativeURL) { _relativeURL = relativeURL; }
     bool parseEntities(QVariantMap& parsedEntities);
     std::string getErrorString() const;
 
+    // Streaming alternative to parseEntities: parseHeader reads the top-level values, skipping over the entities, then
+    // parseEntities hands the entities to entityHandler one at a time as they are parsed, instead of collecting them.
+    bool parseHeader(QVariantMap& header);
+    bool parseEntities(const EntityHandler& entityHandler);
+
 private:
+    bool parseObject(QVariantMap& parsedEntities, const EntityHandler* entityHandler);
     int nextToken();
     std::string readString();
     int readInteger();
-    bool readEntitiesArray(QVariantList& entitiesArray);
-    int findMatchingBrace() const;
+    bool readEntitiesArray(const EntityHandler& entityHandler);
+    bool skipEntitiesArray();
+    int findMatchingBrace(char openingBrace = '{', char closingBrace = '}') const;
 
     QByteArray _entitiesContents;
     QUrl _relativeURL;
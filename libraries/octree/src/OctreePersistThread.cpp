@@ -23,6 +23,7 @@
 #include <QDir>
 #include <QDirIterator>
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QJsonDocument>
@@ -36,13 +37,21 @@
 #include "OctreeLogging.h"
 #include "OctreeUtils.h"
 #include "OctreeDataUtils.h"
+#include "OctreeEntitiesFileParser.h"
 
 constexpr std::chrono::seconds OctreePersistThread::DEFAULT_PERSIST_INTERVAL { 30 };
+constexpr std::chrono::minutes OctreePersistThread::DEFAULT_SNAPSHOT_INTERVAL { 10 };
 constexpr std::chrono::milliseconds TIME_BETWEEN_PROCESSING { 10 };
 
 constexpr int MAX_OCTREE_REPLACEMENT_BACKUP_FILES_COUNT { 20 };
 constexpr int64_t MAX_OCTREE_REPLACEMENT_BACKUP_FILES_SIZE_BYTES { 50 * 1000 * 1000 };
 
+// The journal is a line per record: a header naming the persist file it extends, then the items put or deleted since.
+constexpr int JOURNAL_FORMAT_VERSION { 1 };
+constexpr int64_t MAX_JOURNAL_SIZE_BYTES { 64 * 1000 * 1000 };
+
+constexpr qint64 PERSIST_FILE_CHUNK_SIZE_BYTES { 256 * 1024 };
+
 OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& filename, std::chrono::milliseconds persistInterval,
                                          bool debugTimestampNow, QString persistAsFileType) :
     _tree(tree),
@@ -60,6 +69,11 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     _filename = sansExt + "." + _persistAsFileType;
 }
 
+void OctreePersistThread::setIncrementalPersist(bool enabled, std::chrono::milliseconds snapshotInterval) {
+    _incrementalPersist = enabled;
+    _snapshotInterval = snapshotInterval;
+}
+
 void OctreePersistThread::start() {
     cleanupOldReplacementBackups();
 
@@ -72,29 +86,45 @@ void OctreePersistThread::start() {
 
     auto packet = NLPacket::create(PacketType::OctreeDataFileRequest, -1, true, false);
 
+    if (!_binarySnapshot && QFile::exists(getBinarySnapshotFilename())) {
+        QFile::remove(getBinarySnapshotFilename());
+    }
+
     OctreeUtils::RawOctreeData data;
-    qCDebug(octree) << "Reading octree data from" << _filename;
-    QFile file(_filename);
-    if (file.open(QIODevice::ReadOnly)) {
-        QByteArray jsonData(file.readAll());
-        file.close();
-        if (!gunzip(jsonData, _cachedJSONData)) {
-            _cachedJSONData = jsonData;
-        }
+    bool hasOctreeData { false };
+    if (_binarySnapshot && isBinarySnapshotCurrent() && data.readOctreeDataInfoFromSnapshot(getBinarySnapshotFilename())) {
+        // the snapshot is loaded instead of the persist file, which doesn't need to be parsed
+        qCDebug(octree) << "Reading octree data from" << getBinarySnapshotFilename();
+        _loadFromBinarySnapshot = true;
+        hasOctreeData = true;
+    } else {
+        qCDebug(octree) << "Reading octree data from" << _filename;
+        QFile file(_filename);
+        if (file.open(QIODevice::ReadOnly)) {
+            QByteArray jsonData(file.readAll());
+            file.close();
+            if (!gunzip(jsonData, _cachedJSONData)) {
+                _cachedJSONData = jsonData;
+            }
 
-        if (data.readOctreeDataInfoFromData(_cachedJSONData)) {
-            qCDebug(octree) << "Current octree data: ID(" << data.id << ") DataVersion(" << data.dataVersion << ")";
-            packet->writePrimitive(true);
-            auto id = data.id.toRfc4122();
-            packet->write(id);
-            packet->writePrimitive(data.dataVersion);
+            if (data.readOctreeDataInfoFromData(_cachedJSONData)) {
+                hasOctreeData = true;
+            } else {
+                _cachedJSONData.clear();
+                qCWarning(octree) << "No octree data found";
+            }
         } else {
-            _cachedJSONData.clear();
-            qCWarning(octree) << "No octree data found";
-            packet->writePrimitive(false);
+            qCWarning(octree) << "Couldn't access file" << _filename << file.errorString();
         }
+    }
+
+    if (hasOctreeData) {
+        qCDebug(octree) << "Current octree data: ID(" << data.id << ") DataVersion(" << data.dataVersion << ")";
+        packet->writePrimitive(true);
+        auto id = data.id.toRfc4122();
+        packet->write(id);
+        packet->writePrimitive(data.dataVersion);
     } else {
-        qCWarning(octree) << "Couldn't access file" << _filename << file.errorString();
         packet->writePrimitive(false);
     }
 
@@ -115,13 +145,18 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     bool hasValidOctreeData { false };
     if (includesNewData) {
         _cachedJSONData.clear();
+        _loadFromBinarySnapshot = false;
         replacementData = message->readAll();
         replaceData(replacementData);
         hasValidOctreeData = data.readOctreeDataInfoFromFile(_filename);
         qDebug() << "Got OctreeDataFileReply, new data sent";
     } else {
         qDebug() << "Got OctreeDataFileReply, current entity data is sufficient";
-        
+
+        if (_loadFromBinarySnapshot) {
+            hasValidOctreeData = data.readOctreeDataInfoFromSnapshot(getBinarySnapshotFilename());
+        }
+
         OctreeUtils::RawEntityData data;
         qCDebug(octree) << "Reading octree data from" << _filename;
         if (data.readOctreeDataInfoFromData(_cachedJSONData)) {
@@ -150,17 +185,32 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     }
 
     bool persistentFileRead;
+    bool replayedJournal { false };
 
     _tree->withWriteLock([&] {
         PerformanceWarning warn(true, "Loading Octree File", true);
 
-        if (_cachedJSONData.isEmpty()) {
+        QVariantMap journaledData;
+        if (_loadFromBinarySnapshot) {
+            persistentFileRead = _tree->readFromSnapshotFile(getBinarySnapshotFilename());
+            if (!persistentFileRead) {
+                qCWarning(octree) << "Couldn't load octree snapshot, reading" << _filename;
+                _loadFromBinarySnapshot = false;
+                persistentFileRead = _tree->readFromFile(_filename.toLocal8Bit().constData());
+            }
+        } else if (_cachedJSONData.isEmpty()) {
             persistentFileRead = _tree->readFromFile(_filename.toLocal8Bit().constData());
+        } else if (readJournaledData(journaledData)) {
+            persistentFileRead = _tree->readFromMap(journaledData);
+            replayedJournal = true;
         } else {
             QDataStream jsonStream(_cachedJSONData);
             persistentFileRead = _tree->readFromStream(-1, jsonStream);
         }
         _tree->pruneTree();
+
+        // start collecting changes once the loaded items have been added
+        _tree->setPersistChangesEnabled(_incrementalPersist);
     });
 
     _cachedJSONData.clear();
@@ -169,6 +219,28 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 
     _tree->clearDirtyBit(); // the tree is clean since we just loaded it
 
+    _lastSnapshot = std::chrono::steady_clock::now();
+    if (_loadFromBinarySnapshot) {
+        // no change was journaled since the snapshot, start a new journal extending the persist file
+        resetJournal();
+    } else if (_binarySnapshot && persistentFileRead && !replayedJournal) {
+        // convert the persist file just loaded, for the next startup
+        writeBinarySnapshot();
+    }
+    if (replayedJournal) {
+        if (_journalIsValid) {
+            _journalFile.setFileName(getJournalFilename());
+            if (!_journalFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+                qCWarning(octree) << "Couldn't reopen entity journal" << _journalFile.fileName() << _journalFile.errorString();
+                _journalIsValid = false;
+            }
+        }
+        if (!_journalIsValid) {
+            // fold the journal into a new persist file
+            _tree->setDirtyBit();
+        }
+    }
+
     unsigned long nodeCount = OctreeElement::getNodeCount();
     unsigned long internalNodeCount = OctreeElement::getInternalNodeCount();
     unsigned long leafNodeCount = OctreeElement::getLeafNodeCount();
@@ -214,6 +286,10 @@ QString OctreePersistThread::getPersistFileMimeType() const {
 void OctreePersistThread::replaceData(QByteArray data) {
     backupCurrentFile();
 
+    // the journal and the snapshot extend the data being replaced
+    QFile::remove(getJournalFilename());
+    QFile::remove(getBinarySnapshotFilename());
+
     QFile currentFile { _filename };
     if (currentFile.open(QIODevice::WriteOnly)) {
         currentFile.write(data);
@@ -305,10 +381,19 @@ void OctreePersistThread::cleanupOldReplacementBackups() {
 void OctreePersistThread::persist() {
     if (_tree->isDirty() && _initialLoadComplete) {
 
+        if (_incrementalPersist && _journalIsValid && appendToJournal()) {
+            return;
+        }
+
         _tree->withWriteLock([&] {
             qCDebug(octree) << "pruning Octree before saving...";
             _tree->pruneTree();
             qCDebug(octree) << "DONE pruning Octree before saving...";
+
+            // the new persist file includes every change journaled so far
+            QSet<QUuid> changedIDs;
+            QSet<QUuid> deletedIDs;
+            _tree->takePersistChanges(changedIDs, deletedIDs);
         });
 
         _tree->incrementPersistDataVersion();
@@ -317,25 +402,261 @@ void OctreePersistThread::persist() {
         if (_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
             _tree->clearDirtyBit(); // tree is clean after saving
             qCDebug(octree) << "DONE persisting Octree data to" << _filename;
+            resetJournal();
+            writeBinarySnapshot();
+            sendLatestEntityDataToDS();
         } else {
             qCWarning(octree) << "Failed to persist Octree data to" << _filename;
         }
+    }
+}
 
-        sendLatestEntityDataToDS();
+// Parses the persist file data and applies the journal to it. Returns false if there is no journal extending the
+// persist file, in which case the file is loaded on its own.
+bool OctreePersistThread::readJournaledData(QVariantMap& map) {
+    if (!QFile::exists(getJournalFilename())) {
+        return false;
+    }
+
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(_cachedJSONData);
+    if (!parser.parseEntities(map)) {
+        qCritical() << "Couldn't parse Entities JSON:" << parser.getErrorString().c_str();
+        return false;
     }
+
+    if (!replayJournal(getJournalFilename(), map)) {
+        return false;
+    }
+
+    // items can only be journaled on top of a persist file in the current format
+    _journalIsValid = _incrementalPersist && map["Version"].toInt() == (int)_tree->expectedVersion();
+    return true;
 }
 
+bool OctreePersistThread::replayJournal(const QString& journalFilename, QVariantMap& map) {
+    QFile journalFile(journalFilename);
+    if (!journalFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QJsonObject header = QJsonDocument::fromJson(journalFile.readLine()).object();
+    if (header["Journal"].toInt() != JOURNAL_FORMAT_VERSION || QUuid(header["Id"].toString()) != map["Id"].toUuid() ||
+        header["DataVersion"].toInt() != map["DataVersion"].toInt() || header["Version"].toInt() != map["Version"].toInt()) {
+        qCWarning(octree) << "Ignoring entity journal" << journalFilename << "that doesn't extend its persist file";
+        return false;
+    }
+
+    QVariantList items = map["Entities"].toList();
+    QHash<QUuid, int> itemIndices;
+    for (int i = 0; i < items.size(); ++i) {
+        itemIndices[items[i].toMap()["id"].toUuid()] = i;
+    }
+
+    int numPuts = 0;
+    int numDeletes = 0;
+    qint64 validLength = journalFile.pos();
+    while (!journalFile.atEnd()) {
+        QByteArray line = journalFile.readLine();
+        QJsonParseError error;
+        QJsonObject record = QJsonDocument::fromJson(line, &error).object();
+        if (!line.endsWith('\n') || error.error != QJsonParseError::NoError) {
+            // the server stopped while appending this record
+            qCWarning(octree) << "Entity journal ends with an incomplete record, dropping it";
+            break;
+        }
+
+        if (record.contains("put")) {
+            QVariantMap item = record["put"].toObject().toVariantMap();
+            QUuid id = item["id"].toUuid();
+            auto it = itemIndices.find(id);
+            if (it != itemIndices.end()) {
+                items[it.value()] = item;
+            } else {
+                itemIndices[id] = items.size();
+                items.push_back(item);
+            }
+            ++numPuts;
+        } else if (record.contains("delete")) {
+            auto it = itemIndices.find(QUuid(record["delete"].toString()));
+            if (it != itemIndices.end()) {
+                items[it.value()] = QVariant();
+                itemIndices.erase(it);
+            }
+            ++numDeletes;
+        }
+        validLength = journalFile.pos();
+    }
+
+    bool hasIncompleteRecord = validLength < journalFile.size();
+    journalFile.close();
+    if (hasIncompleteRecord) {
+        QFile::resize(journalFilename, validLength);
+    }
+
+    QVariantList journaledItems;
+    journaledItems.reserve(itemIndices.size());
+    for (const auto& item : items) {
+        if (item.isValid()) {
+            journaledItems.push_back(item);
+        }
+    }
+    map["Entities"] = journaledItems;
+
+    qCDebug(octree) << "Replayed entity journal:" << numPuts << "puts," << numDeletes << "deletes";
+    return true;
+}
+
+// Appends the items changed since the last persist to the journal. Returns false if the tree must be written whole.
+bool OctreePersistThread::appendToJournal() {
+    if (std::chrono::steady_clock::now() - _lastSnapshot > _snapshotInterval || _journalFile.size() > MAX_JOURNAL_SIZE_BYTES) {
+        return false;
+    }
+
+    QSet<QUuid> changedIDs;
+    QSet<QUuid> deletedIDs;
+    bool changesComplete { false };
+    _tree->withWriteLock([&] {
+        changesComplete = _tree->takePersistChanges(changedIDs, deletedIDs);
+        _tree->clearDirtyBit();
+    });
+
+    QVector<QByteArray> jsonItems;
+    if (!changesComplete || !_tree->writeItemsToJSON(changedIDs, jsonItems)) {
+        _tree->setDirtyBit();
+        return false;
+    }
+
+    QByteArray records;
+    for (const auto& id : deletedIDs) {
+        records += "{\"delete\":\"" + id.toString().toUtf8() + "\"}\n";
+    }
+    for (const auto& item : jsonItems) {
+        records += "{\"put\":" + item + "}\n";
+    }
+
+    if (_journalFile.write(records) != records.size() || !_journalFile.flush()) {
+        qCWarning(octree) << "Failed to append to entity journal" << _journalFile.fileName() << _journalFile.errorString();
+        // a partial record may have been written, start over from a new persist file
+        _journalIsValid = false;
+        _journalFile.close();
+        _tree->setDirtyBit();
+        return false;
+    }
+
+    qCDebug(octree) << "Journaled" << jsonItems.size() << "changed and" << deletedIDs.size() << "deleted entities to"
+        << _journalFile.fileName();
+    return true;
+}
+
+// Starts a journal extending the persist file just written, or removes it if persisting isn't incremental.
+void OctreePersistThread::resetJournal() {
+    _journalFile.close();
+    _journalIsValid = false;
+    _lastSnapshot = std::chrono::steady_clock::now();
+
+    if (!_incrementalPersist) {
+        if (QFile::exists(getJournalFilename())) {
+            QFile::remove(getJournalFilename());
+        }
+        return;
+    }
+
+    _journalFile.setFileName(getJournalFilename());
+    if (!_journalFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(octree) << "Couldn't create entity journal" << _journalFile.fileName() << _journalFile.errorString();
+        return;
+    }
+
+    QJsonObject header;
+    header["Journal"] = JOURNAL_FORMAT_VERSION;
+    header["Id"] = _tree->getPersistID().toString();
+    header["DataVersion"] = _tree->getPersistDataVersion();
+    header["Version"] = (int)_tree->expectedVersion();
+    QByteArray headerLine = QJsonDocument(header).toJson(QJsonDocument::Compact) + '\n';
+
+    _journalIsValid = _journalFile.write(headerLine) == headerLine.size() && _journalFile.flush();
+}
+
+// The snapshot is only loaded if it was written after the persist file, and no change was journaled since.
+bool OctreePersistThread::isBinarySnapshotCurrent() const {
+    QFileInfo snapshotInfo(getBinarySnapshotFilename());
+    QFileInfo persistFileInfo(_filename);
+    if (!snapshotInfo.exists() || !persistFileInfo.exists() || snapshotInfo.lastModified() < persistFileInfo.lastModified()) {
+        return false;
+    }
+
+    QFile journalFile(getJournalFilename());
+    if (journalFile.open(QIODevice::ReadOnly)) {
+        journalFile.readLine();
+        if (!journalFile.atEnd()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Writes a snapshot of the tree matching the persist file just written or loaded.
+void OctreePersistThread::writeBinarySnapshot() {
+    if (!_binarySnapshot) {
+        return;
+    }
+
+    qCDebug(octree) << "Saving Octree snapshot to:" << getBinarySnapshotFilename();
+    if (_tree->writeToSnapshotFile(getBinarySnapshotFilename())) {
+        qCDebug(octree) << "DONE saving Octree snapshot to" << getBinarySnapshotFilename();
+    } else {
+        qCWarning(octree) << "Failed to save Octree snapshot to" << getBinarySnapshotFilename();
+        // it would be ignored for being older than the persist file anyway
+        QFile::remove(getBinarySnapshotFilename());
+    }
+}
+
+// Sends the persist file as it was last written, gzipped as the DS stores it. The file is copied a chunk at a time
+// rather than serializing the tree again. Journaled changes reach the DS once they are folded into a new persist file.
 void OctreePersistThread::sendLatestEntityDataToDS() {
     qDebug() << "Sending latest entity data to DS";
     auto nodeList = DependencyManager::get<NodeList>();
     const DomainHandler& domainHandler = nodeList->getDomainHandler();
 
-    QByteArray data;
-    if (_tree->toJSON(&data, nullptr, true)) {
-        auto message = NLPacketList::create(PacketType::OctreeDataPersist, QByteArray(), true, true);
-        message->write(data);
+    QFile file(_filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        // nothing was persisted yet, the tree is whatever little was loaded without a file
+        QByteArray data;
+        if (_tree->toJSON(&data, nullptr, true)) {
+            auto message = NLPacketList::create(PacketType::OctreeDataPersist, QByteArray(), true, true);
+            message->write(data);
+            nodeList->sendPacketList(std::move(message), domainHandler.getSockAddr());
+        } else {
+            qCWarning(octree) << "Failed to persist octree to DS";
+        }
+        return;
+    }
+
+    // a .json persist file may still hold gzipped data, for example after its id was reset at load
+    static const QByteArray GZIP_MAGIC { "\x1f\x8b" };
+    bool isGzipped = file.peek(GZIP_MAGIC.size()) == GZIP_MAGIC;
+
+    auto message = NLPacketList::create(PacketType::OctreeDataPersist, QByteArray(), true, true);
+    GzipStreamWriter gzipWriter(*message);
+    bool success = true;
+    while (success && !file.atEnd()) {
+        QByteArray chunk = file.read(PERSIST_FILE_CHUNK_SIZE_BYTES);
+        if (chunk.isEmpty()) {
+            success = false;
+        } else if (isGzipped) {
+            success = message->write(chunk) == chunk.size();
+        } else {
+            success = gzipWriter.write(chunk);
+        }
+    }
+    if (success && !isGzipped) {
+        success = gzipWriter.finish();
+    }
+
+    if (success) {
         nodeList->sendPacketList(std::move(message), domainHandler.getSockAddr());
     } else {
-        qCWarning(octree) << "Failed to persist octree to DS";
+        qCWarning(octree) << "Failed to persist octree to DS, couldn't read" << _filename << file.errorString();
     }
 }
@@ -15,6 +15,7 @@
 #define hifi_OctreePersistThread_h
 
 #include <QString>
+#include <QtCore/QFile>
 #include <QtCore/QSharedPointer>
 #include <GenericThread.h>
 #include "Octree.h"
@@ -32,6 +33,7 @@ public:
     };
 
     static const std::chrono::seconds DEFAULT_PERSIST_INTERVAL;
+    static const std::chrono::minutes DEFAULT_SNAPSHOT_INTERVAL;
 
     OctreePersistThread(OctreePointer tree,
                         const QString& filename,
@@ -46,6 +48,19 @@ public:
     QString getPersistFileMimeType() const;
     QByteArray getPersistFileContents() const;
 
+    /// In incremental mode, each persist appends the items changed since the previous one to a journal next to the
+    /// persist file, and the whole tree is only rewritten every snapshotInterval or once the journal grows too large.
+    /// Must be called before start().
+    void setIncrementalPersist(bool enabled, std::chrono::milliseconds snapshotInterval = DEFAULT_SNAPSHOT_INTERVAL);
+
+    /// When enabled, a binary snapshot of the tree is written next to the persist file at every full write, and loaded
+    /// at startup instead of the persist file when it is up to date. Must be called before start().
+    void setBinarySnapshot(bool enabled) { _binarySnapshot = enabled; }
+
+    /// Applies the journal to the items of the persist file parsed into map, dropping a torn last record from the journal.
+    /// Returns false if the journal can't be read or doesn't extend that persist file.
+    static bool replayJournal(const QString& journalFilename, QVariantMap& map);
+
     void aboutToFinish(); /// call this to inform the persist thread that the owner is about to finish to support final persist
 
 public slots:
@@ -66,6 +81,15 @@ protected:
     void replaceData(QByteArray data);
     void sendLatestEntityDataToDS();
 
+    QString getJournalFilename() const { return _filename + ".journal"; }
+    bool readJournaledData(QVariantMap& map);
+    bool appendToJournal();
+    void resetJournal();
+
+    QString getBinarySnapshotFilename() const { return _filename + ".snapshot"; }
+    bool isBinarySnapshotCurrent() const;
+    void writeBinarySnapshot();
+
 private:
     OctreePointer _tree;
     QString _filename;
@@ -80,6 +104,15 @@ private:
 
     QString _persistAsFileType;
     QByteArray _cachedJSONData;
+
+    bool _incrementalPersist { false };
+    std::chrono::milliseconds _snapshotInterval { DEFAULT_SNAPSHOT_INTERVAL };
+    std::chrono::steady_clock::time_point _lastSnapshot;
+    QFile _journalFile;
+    bool _journalIsValid { false }; // the journal extends the current persist file, and can be appended to
+
+    bool _binarySnapshot { false };
+    bool _loadFromBinarySnapshot { false };
 };
 
 #endif // hifi_OctreePersistThread_h
@@ -66,6 +66,14 @@ public:
 #endif
 };
 
+class ScriptEngineCodeCacheStatistics {
+public:
+    uint64_t hits { 0 };
+    uint64_t misses { 0 };
+    uint64_t rejected { 0 };
+    uint64_t writes { 0 };
+};
+
 /**
  * @brief Provides an engine-independent interface for a scripting engine
  *
@@ -403,6 +411,15 @@ public:
      */
     virtual ScriptEngineMemoryStatistics getMemoryUsageStatistics() = 0;
 
+    /**
+     * @brief Return compiled code cache statistics.
+     *
+     * The compiled code cache is shared by all the engines of the process, so are its statistics.
+     *
+     * @return ScriptEngineCodeCacheStatistics Object containing the cache hits, misses, rejected entries and writes.
+     */
+    virtual ScriptEngineCodeCacheStatistics getCodeCacheStatistics() = 0;
+
     /**
      * @brief Start collecting object statistics that can later be reported with dumpHeapObjectStatistics().
      */
@@ -68,6 +68,16 @@ QVariantMap ScriptManagerScriptingInterface::getMemoryUsageStatistics() {
     return map;
 }
 
+QVariantMap ScriptManagerScriptingInterface::getCodeCacheStatistics() {
+    auto statistics = _manager->engine()->getCodeCacheStatistics();
+    QVariantMap map;
+    map.insert("hits", QVariant((qulonglong)(statistics.hits)));
+    map.insert("misses", QVariant((qulonglong)(statistics.misses)));
+    map.insert("rejected", QVariant((qulonglong)(statistics.rejected)));
+    map.insert("writes", QVariant((qulonglong)(statistics.writes)));
+    return map;
+}
+
 void ScriptManagerScriptingInterface::startCollectingObjectStatistics() {
     _manager->engine()->startCollectingObjectStatistics();
 }
@@ -533,6 +533,29 @@ public:
      */
     Q_INVOKABLE QVariantMap getMemoryUsageStatistics();
 
+    /*@jsdoc
+     * <p>Object containing compiled code cache statistics, counted across all the scripts of the application.</p>
+     * <table>
+     *   <thead>
+     *     <tr><th>Name</th><th>Type</th><th>Description</th></tr>
+     *   </thead>
+     *   <tbody>
+     *     <tr><td><code>hits</code></td><td>{number}</td><td>Scripts compiled from cached code.</td></tr>
+     *     <tr><td><code>misses</code></td><td>{number}</td><td>Scripts compiled from source because they weren't cached.</td></tr>
+     *     <tr><td><code>rejected</code></td><td>{number}</td><td>Cached code the scripting engine couldn't use, e.g., after an update.</td></tr>
+     *     <tr><td><code>writes</code></td><td>{number}</td><td>Compiled code written to the cache.</td></tr>
+     *   </tbody>
+     * </table>
+     * @typedef {object} Script.CodeCacheData
+     */
+
+    /*@jsdoc
+     * Returns compiled code cache statistics data.
+     * @function Script.getCodeCacheStatistics
+     * @Returns {Script.CodeCacheData} Object containing statistics about the compiled code cache.
+     */
+    Q_INVOKABLE QVariantMap getCodeCacheStatistics();
+
     /*@jsdoc
      * Start collecting object statistics that can later be reported with Script.dumpHeapObjectStatistics().
      * @function Script.startCollectingObjectStatistics
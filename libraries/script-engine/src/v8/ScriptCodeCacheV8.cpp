@@ -0,0 +1,129 @@
+//
+//  ScriptCodeCacheV8.cpp
+//  libraries/script-engine/src/v8
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ScriptCodeCacheV8.h"
+
+#include <memory>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+
+#include <PathUtils.h>
+#include <SharedUtil.h>
+
+#include "ScriptEngineLoggingV8.h"
+
+static const QString CODE_CACHE_DIRECTORY = "script_code_cache";
+static const QString CODE_CACHE_EXTENSION = ".v8cache";
+
+// small scripts, like the snippets evaluated by the script engine itself, compile faster than a cache file is read
+static const int MIN_CACHED_SOURCE_LENGTH = 1024;
+
+ScriptCodeCacheV8& ScriptCodeCacheV8::getInstance() {
+    static ScriptCodeCacheV8* instance = globalInstance<ScriptCodeCacheV8>("com.overte.ScriptCodeCacheV8");
+    return *instance;
+}
+
+ScriptCodeCacheV8::ScriptCodeCacheV8() :
+    _directory(PathUtils::getAppLocalDataFilePath(CODE_CACHE_DIRECTORY))
+{
+    if (!QDir().mkpath(_directory)) {
+        qCWarning(scriptengine_v8) << "Unable to create script code cache directory" << _directory;
+        _directory.clear();
+    }
+}
+
+v8::MaybeLocal<v8::Script> ScriptCodeCacheV8::compile(v8::Local<v8::Context> context, v8::Local<v8::String> source,
+                                                      v8::ScriptOrigin& scriptOrigin, const QString& url,
+                                                      const QString& sourceCode) {
+    if (_directory.isEmpty() || url.isEmpty() || sourceCode.length() < MIN_CACHED_SOURCE_LENGTH) {
+        return v8::Script::Compile(context, source, &scriptOrigin);
+    }
+
+    QByteArray sourceHash = QCryptographicHash::hash(sourceCode.toUtf8(), QCryptographicHash::Sha256);
+    QByteArray cachedData = read(url, sourceHash);
+    v8::Local<v8::Script> script;
+
+    if (!cachedData.isEmpty()) {
+        // the source takes ownership of the CachedData, which doesn't own the buffer
+        v8::ScriptCompiler::Source cachedSource(source, scriptOrigin, new v8::ScriptCompiler::CachedData(
+            reinterpret_cast<const uint8_t*>(cachedData.constData()), cachedData.size()));
+        auto result = v8::ScriptCompiler::Compile(context, &cachedSource, v8::ScriptCompiler::kConsumeCodeCache);
+        if (!cachedSource.GetCachedData()->rejected) {
+            _hits++;
+            return result;
+        }
+
+        // V8 compiled it from source after all, so replace the entry with one it can use
+        _rejected++;
+        if (result.ToLocal(&script)) {
+            write(url, sourceHash, script);
+        }
+        return result;
+    }
+
+    _misses++;
+    auto result = v8::Script::Compile(context, source, &scriptOrigin);
+    if (result.ToLocal(&script)) {
+        write(url, sourceHash, script);
+    }
+    return result;
+}
+
+ScriptEngineCodeCacheStatistics ScriptCodeCacheV8::getStatistics() const {
+    ScriptEngineCodeCacheStatistics statistics;
+    statistics.hits = _hits;
+    statistics.misses = _misses;
+    statistics.rejected = _rejected;
+    statistics.writes = _writes;
+    return statistics;
+}
+
+QString ScriptCodeCacheV8::getCacheFilePath(const QString& url) const {
+    QByteArray urlHash = QCryptographicHash::hash(url.toUtf8(), QCryptographicHash::Sha1);
+    return _directory + "/" + urlHash.toHex() + CODE_CACHE_EXTENSION;
+}
+
+QByteArray ScriptCodeCacheV8::read(const QString& url, const QByteArray& sourceHash) const {
+    QFile file(getCacheFilePath(url));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+
+    // each file holds the hash of the source it was compiled from, followed by V8's cached data
+    if (file.size() <= sourceHash.size() || file.read(sourceHash.size()) != sourceHash) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+void ScriptCodeCacheV8::write(const QString& url, const QByteArray& sourceHash, v8::Local<v8::Script> script) {
+    std::unique_ptr<v8::ScriptCompiler::CachedData> cachedData(
+        v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript()));
+    if (!cachedData || cachedData->length <= 0) {
+        return;
+    }
+
+    // QSaveFile replaces the file in one step, so other engines and processes never read a partial entry
+    QSaveFile file(getCacheFilePath(url));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    file.write(sourceHash);
+    file.write(reinterpret_cast<const char*>(cachedData->data), cachedData->length);
+    if (file.commit()) {
+        _writes++;
+    } else {
+        qCDebug(scriptengine_v8) << "Unable to write script code cache for" << url;
+    }
+}
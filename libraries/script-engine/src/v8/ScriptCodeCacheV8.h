@@ -0,0 +1,60 @@
+//
+//  ScriptCodeCacheV8.h
+//  libraries/script-engine/src/v8
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+/// @addtogroup ScriptEngine
+/// @{
+
+#ifndef hifi_ScriptCodeCacheV8_h
+#define hifi_ScriptCodeCacheV8_h
+
+#include <atomic>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include "v8.h"
+
+#include "../ScriptEngine.h"
+
+/// [V8] On-disk cache of V8 compiled code, shared by all the script engines of the process
+///
+/// Compiled code is stored per script URL along with a hash of the source it was compiled from, so a script whose
+/// contents change is simply recompiled and cached again. V8 checks the cached data against its own version and flags
+/// and rejects it if they don't match, in which case the script is compiled from source and the cache entry replaced.
+class ScriptCodeCacheV8 {
+public:
+    static ScriptCodeCacheV8& getInstance();
+
+    ScriptCodeCacheV8();
+
+    /// Compiles a script, using the cached compiled code for its URL if there is any, and caching it otherwise.
+    /// Must be called with the isolate locked and entered.
+    v8::MaybeLocal<v8::Script> compile(v8::Local<v8::Context> context, v8::Local<v8::String> source,
+                                       v8::ScriptOrigin& scriptOrigin, const QString& url, const QString& sourceCode);
+
+    ScriptEngineCodeCacheStatistics getStatistics() const;
+
+private:
+    QString getCacheFilePath(const QString& url) const;
+    QByteArray read(const QString& url, const QByteArray& sourceHash) const;
+    void write(const QString& url, const QByteArray& sourceHash, v8::Local<v8::Script> script);
+
+    QString _directory;
+
+    std::atomic<uint64_t> _hits { 0 };
+    std::atomic<uint64_t> _misses { 0 };
+    std::atomic<uint64_t> _rejected { 0 };
+    std::atomic<uint64_t> _writes { 0 };
+};
+
+#endif  // hifi_ScriptCodeCacheV8_h
+
+/// @}
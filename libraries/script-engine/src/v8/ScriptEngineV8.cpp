@@ -50,6 +50,7 @@
 #include "../ScriptValue.h"
 #include "../ScriptManagerScriptingInterface.h"
 
+#include "ScriptCodeCacheV8.h"
 #include "ScriptContextV8Wrapper.h"
 #include "ScriptObjectV8Proxy.h"
 #include "ScriptProgramV8Wrapper.h"
@@ -807,7 +808,8 @@ ScriptValue ScriptEngineV8::evaluate(const QString& sourceCode, const QString& f
     v8::Local<v8::Script> script;
     {
         v8::TryCatch tryCatch(getIsolate());
-        if (!v8::Script::Compile(context, v8::String::NewFromUtf8(getIsolate(), sourceCode.toStdString().c_str()).ToLocalChecked(), &scriptOrigin).ToLocal(&script)) {
+        if (!ScriptCodeCacheV8::getInstance().compile(context, v8::String::NewFromUtf8(getIsolate(), sourceCode.toStdString().c_str()).ToLocalChecked(),
+                                                      scriptOrigin, fileName, sourceCode).ToLocal(&script)) {
             QString errorMessage(QString("Error while compiling script: \"") + fileName + QString("\" ") + formatErrorMessageFromTryCatch(tryCatch));
             if (_manager) {
                 v8::Local<v8::Message> exceptionMessage = tryCatch.Message();
@@ -1577,6 +1579,10 @@ ScriptEngineMemoryStatistics ScriptEngineV8::getMemoryUsageStatistics() {
     return statistics;
 }
 
+ScriptEngineCodeCacheStatistics ScriptEngineV8::getCodeCacheStatistics() {
+    return ScriptCodeCacheV8::getInstance().getStatistics();
+}
+
 void ScriptEngineV8::startCollectingObjectStatistics() {
     auto heapProfiler = _v8Isolate->GetHeapProfiler();
     heapProfiler->StartTrackingHeapObjects();
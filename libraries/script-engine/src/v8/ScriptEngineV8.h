@@ -139,6 +139,7 @@ public:  // ScriptEngine implementation
     QString scriptValueDebugListMembersV8(const V8ScriptValue &v8Value);
     virtual void logBacktrace(const QString &title = QString("")) override;
     virtual ScriptEngineMemoryStatistics getMemoryUsageStatistics() override;
+    virtual ScriptEngineCodeCacheStatistics getCodeCacheStatistics() override;
     virtual void startCollectingObjectStatistics() override;
     virtual void dumpHeapObjectStatistics() override;
     virtual void startProfiling() override;
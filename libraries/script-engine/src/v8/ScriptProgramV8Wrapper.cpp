@@ -14,6 +14,7 @@
 
 #include "ScriptProgramV8Wrapper.h"
 
+#include "ScriptCodeCacheV8.h"
 #include "ScriptEngineV8.h"
 #include "ScriptValueV8Wrapper.h"
 #include "ScriptEngineLoggingV8.h"
@@ -50,7 +51,8 @@ bool ScriptProgramV8Wrapper::compile() {
     v8::TryCatch tryCatch(isolate);
     v8::ScriptOrigin scriptOrigin(isolate, v8::String::NewFromUtf8(isolate, _url.toStdString().c_str()).ToLocalChecked());
     v8::Local<v8::Script> script;
-    if (v8::Script::Compile(context, v8::String::NewFromUtf8(isolate, _source.toStdString().c_str()).ToLocalChecked(), &scriptOrigin).ToLocal(&script)) {
+    if (ScriptCodeCacheV8::getInstance().compile(context, v8::String::NewFromUtf8(isolate, _source.toStdString().c_str()).ToLocalChecked(),
+                                                 scriptOrigin, _url, _source).ToLocal(&script)) {
         qCDebug(scriptengine_v8) << "Script compilation successful: " << _url;
         _compileResult = ScriptSyntaxCheckResultV8Wrapper(ScriptSyntaxCheckResult::Valid);
         _value = V8ScriptProgram(_engine, script);
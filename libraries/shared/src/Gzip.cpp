@@ -13,6 +13,8 @@
 
 #include <zlib.h>
 
+#include <QIODevice>
+
 const int GZIP_WINDOWS_BIT = 31;
 const int GZIP_CHUNK_SIZE = 4096;
 const int DEFAULT_MEM_LEVEL = 8;
@@ -153,3 +155,71 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel) {
     deflateEnd(&strm);
     return status == Z_STREAM_END;
 }
+
+GzipStreamWriter::GzipStreamWriter(QIODevice& destination, int compressionLevel) :
+    _destination(destination),
+    _stream(new z_stream)
+{
+    _stream->zalloc = Z_NULL;
+    _stream->zfree = Z_NULL;
+    _stream->opaque = Z_NULL;
+    _stream->next_in = Z_NULL;
+    _stream->avail_in = 0;
+
+    int status = deflateInit2(_stream.get(),
+                              qMax(Z_DEFAULT_COMPRESSION, qMin(9, compressionLevel)),
+                              Z_DEFLATED,
+                              GZIP_WINDOWS_BIT,
+                              DEFAULT_MEM_LEVEL,
+                              Z_DEFAULT_STRATEGY);
+    _valid = (status == Z_OK);
+}
+
+GzipStreamWriter::~GzipStreamWriter() {
+    if (_valid) {
+        deflateEnd(_stream.get());
+    }
+}
+
+bool GzipStreamWriter::write(const QByteArray& data) {
+    if (!_valid) {
+        return false;
+    }
+
+    _stream->next_in = (unsigned char*)data.constData();
+    _stream->avail_in = (uInt)data.size();
+    return deflateInto(Z_NO_FLUSH);
+}
+
+bool GzipStreamWriter::finish() {
+    if (!_valid) {
+        return false;
+    }
+
+    _stream->next_in = Z_NULL;
+    _stream->avail_in = 0;
+    bool success = deflateInto(Z_FINISH);
+
+    deflateEnd(_stream.get());
+    _valid = false;
+    return success;
+}
+
+bool GzipStreamWriter::deflateInto(int flushOrFinish) {
+    int status;
+    do {
+        char out[GZIP_CHUNK_SIZE];
+        _stream->next_out = (unsigned char*)out;
+        _stream->avail_out = GZIP_CHUNK_SIZE;
+        status = deflate(_stream.get(), flushOrFinish);
+        if (status == Z_STREAM_ERROR) {
+            return false;
+        }
+        int available = (GZIP_CHUNK_SIZE - _stream->avail_out);
+        if (available > 0 && _destination.write(out, available) != available) {
+            return false;
+        }
+    } while (_stream->avail_out == 0);
+
+    return flushOrFinish != Z_FINISH || status == Z_STREAM_END;
+}
@@ -12,8 +12,13 @@
 #ifndef GZIP_H
 #define GZIP_H
 
+#include <memory>
+
 #include <QByteArray>
 
+class QIODevice;
+struct z_stream_s;
+
 // The compression level must be Z_DEFAULT_COMPRESSION (-1), or between 0 and
 // 9: 1 gives best speed, 9 gives best compression, 0 gives no
 // compression at all (the input data is simply copied a block at a
@@ -24,4 +29,22 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel = -1)
 
 bool gunzip(QByteArray source, QByteArray &destination);
 
+// Gzips data as it is written into a device, so that large documents can be compressed without holding them, or
+// their compressed form, in memory. finish() must be called once everything has been written.
+class GzipStreamWriter {
+public:
+    GzipStreamWriter(QIODevice& destination, int compressionLevel = -1);
+    ~GzipStreamWriter();
+
+    bool write(const QByteArray& data);
+    bool finish();
+
+private:
+    bool deflateInto(int flushOrFinish);
+
+    QIODevice& _destination;
+    std::unique_ptr<z_stream_s> _stream;
+    bool _valid { false };
+};
+
 #endif
@@ -1081,6 +1081,26 @@ void setMaxCores(uint8_t maxCores) {
 #endif
 }
 
+quint64 usecCurrentThreadCPUTime() {
+#ifdef Q_OS_WIN
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return 0;
+    }
+    // FILETIME counts 100 nanosecond intervals
+    auto toUsecs = [](const FILETIME& time) {
+        return (((quint64)time.dwHighDateTime << 32) | time.dwLowDateTime) / 10;
+    };
+    return toUsecs(kernelTime) + toUsecs(userTime);
+#else
+    struct timespec time;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) {
+        return 0;
+    }
+    return (quint64)time.tv_sec * USECS_PER_SECOND + (quint64)time.tv_nsec / NSECS_PER_USEC;
+#endif
+}
+
 bool processIsRunning(int64_t pid) {
 #ifdef Q_OS_WIN
     HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
@@ -85,6 +85,9 @@ typedef unsigned char nodeColor[BYTES_PER_COLOR + BYTES_PER_FLAGS];
 quint64 usecTimestampNow(bool wantDebug = false);
 void usecTimestampNowForceClockSkew(qint64 clockSkew);
 
+// CPU time, user and kernel, used by the calling thread since it started
+quint64 usecCurrentThreadCPUTime();
+
 inline bool afterUsecs(quint64& startUsecs, quint64 maxIntervalUecs) {
     auto now = usecTimestampNow();
     auto interval = now - startUsecs;
@@ -0,0 +1,132 @@
+//
+//  ShardedHash.h
+//  libraries/shared/src/shared
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_ShardedHash_h
+#define hifi_ShardedHash_h
+
+#include <array>
+
+#include <QtCore/QHash>
+#include <QtCore/QReadWriteLock>
+
+// ShardedHash is a QHash split into shards, each with its own lock, so that threads looking up different keys
+// rarely wait on each other or on a writer.
+// The shard locks are only held inside ShardedHash's methods, so it can be used under any other lock.
+template <typename Key, typename T, int NUM_SHARDS = 64>
+class ShardedHash {
+public:
+    // Returns a default-constructed T if there is no value for key.
+    T value(const Key& key) const {
+        const Shard& shard = getShard(key);
+        QReadLocker locker(&shard.lock);
+        return shard.hash.value(key);
+    }
+
+    bool contains(const Key& key) const {
+        const Shard& shard = getShard(key);
+        QReadLocker locker(&shard.lock);
+        return shard.hash.contains(key);
+    }
+
+    // Returns false, leaving the existing value, if there is already a value for key.
+    bool insert(const Key& key, const T& value) {
+        Shard& shard = getShard(key);
+        QWriteLocker locker(&shard.lock);
+        if (shard.hash.contains(key)) {
+            return false;
+        }
+        shard.hash.insert(key, value);
+        return true;
+    }
+
+    bool remove(const Key& key) {
+        Shard& shard = getShard(key);
+        QWriteLocker locker(&shard.lock);
+        return shard.hash.remove(key) > 0;
+    }
+
+    int size() const {
+        int size = 0;
+        for (const Shard& shard : _shards) {
+            QReadLocker locker(&shard.lock);
+            size += shard.hash.size();
+        }
+        return size;
+    }
+
+    // Calls f(value) on each value, with one shard read-locked at a time. f must not modify the ShardedHash.
+    template <typename F>
+    void forEach(F f) const {
+        for (const Shard& shard : _shards) {
+            QReadLocker locker(&shard.lock);
+            for (const T& value : shard.hash) {
+                f(value);
+            }
+        }
+    }
+
+    // Exchanges the contents with hash, with all the shards write-locked so that no thread sees a mix of both.
+    void swap(QHash<Key, T>& hash) {
+        for (Shard& shard : _shards) {
+            shard.lock.lockForWrite();
+        }
+        QHash<Key, T> previous;
+        previous.reserve(sizeLocked());
+        for (Shard& shard : _shards) {
+            insertAll(previous, shard.hash);
+            shard.hash.clear();
+        }
+        for (auto itr = hash.cbegin(); itr != hash.cend(); ++itr) {
+            getShard(itr.key()).hash.insert(itr.key(), itr.value());
+        }
+        for (Shard& shard : _shards) {
+            shard.lock.unlock();
+        }
+        hash.swap(previous);
+    }
+
+    QHash<Key, T> toHash() const {
+        QHash<Key, T> hash;
+        for (const Shard& shard : _shards) {
+            QReadLocker locker(&shard.lock);
+            insertAll(hash, shard.hash);
+        }
+        return hash;
+    }
+
+private:
+    // each shard on its own cache line, so that locking one doesn't slow down the others
+    struct alignas(64) Shard {
+        mutable QReadWriteLock lock;
+        QHash<Key, T> hash;
+    };
+
+    Shard& getShard(const Key& key) { return _shards[qHash(key) % NUM_SHARDS]; }
+    const Shard& getShard(const Key& key) const { return _shards[qHash(key) % NUM_SHARDS]; }
+
+    static void insertAll(QHash<Key, T>& destination, const QHash<Key, T>& source) {
+        for (auto itr = source.cbegin(); itr != source.cend(); ++itr) {
+            destination.insert(itr.key(), itr.value());
+        }
+    }
+
+    int sizeLocked() const {
+        int size = 0;
+        for (const Shard& shard : _shards) {
+            size += shard.hash.size();
+        }
+        return size;
+    }
+
+    std::array<Shard, NUM_SHARDS> _shards;
+};
+
+#endif // hifi_ShardedHash_h
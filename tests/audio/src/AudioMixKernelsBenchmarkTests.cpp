@@ -0,0 +1,161 @@
+//
+//  AudioMixKernelsBenchmarkTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixKernelsBenchmarkTests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <AudioConstants.h>
+#include <AudioMixKernels.h>
+
+QTEST_GUILESS_MAIN(AudioMixKernelsBenchmarkTests)
+
+// one network frame, plus an odd length to exercise the scalar tails
+static const int NUM_FRAMES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+static const int ODD_FRAMES = 37;
+static const float EPSILON = 1.0e-6f;
+
+static const float GAIN0 = 0.75f;
+static const float GAIN1 = 0.25f;
+
+static void mixMonoToStereoScalar(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+    for (int i = 0; i < numFrames; i++) {
+        float gain = (gain1 + win[i] * (gain0 - gain1)) * (1/32768.0f);
+        dst[2*i+0] += (float)src[i] * gain;
+        dst[2*i+1] += (float)src[i] * gain;
+    }
+}
+
+static void mixStereoScalar(const int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+    for (int i = 0; i < numFrames; i++) {
+        float gain = (gain1 + win[i] * (gain0 - gain1)) * (1/32768.0f);
+        dst[2*i+0] += (float)src[2*i+0] * gain;
+        dst[2*i+1] += (float)src[2*i+1] * gain;
+    }
+}
+
+static float maxError(const std::vector<float>& a, const std::vector<float>& b) {
+    float error = 0.0f;
+    for (size_t i = 0; i < a.size(); i++) {
+        error = std::max(error, std::fabs(a[i] - b[i]));
+    }
+    return error;
+}
+
+void AudioMixKernelsBenchmarkTests::initTestCase() {
+    std::mt19937 generator(1234);
+    std::uniform_int_distribution<int> distribution(INT16_MIN, INT16_MAX);
+
+    _input.resize(2 * NUM_FRAMES);
+    for (auto& sample : _input) {
+        sample = (int16_t)distribution(generator);
+    }
+
+    // same shape as the HRTF crossfade table, 1.0 -> 0.0
+    _window.resize(NUM_FRAMES);
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        _window[i] = 0.5f * (1.0f + cosf(3.14159265f * i / NUM_FRAMES));
+    }
+}
+
+void AudioMixKernelsBenchmarkTests::mixMonoToStereo() {
+    for (int numFrames : { NUM_FRAMES, ODD_FRAMES, 1, 0 }) {
+        std::vector<float> expected(2 * NUM_FRAMES, 0.5f);
+        std::vector<float> actual(expected);
+
+        mixMonoToStereoScalar(_input.data(), expected.data(), _window.data(), GAIN0, GAIN1, numFrames);
+        AudioMixKernels::mixMonoToStereo(_input.data(), actual.data(), _window.data(), GAIN0, GAIN1, numFrames);
+
+        QVERIFY(maxError(expected, actual) < EPSILON);
+    }
+}
+
+void AudioMixKernelsBenchmarkTests::mixStereo() {
+    for (int numFrames : { NUM_FRAMES, ODD_FRAMES, 1, 0 }) {
+        std::vector<float> expected(2 * NUM_FRAMES, 0.5f);
+        std::vector<float> actual(expected);
+
+        mixStereoScalar(_input.data(), expected.data(), _window.data(), GAIN0, GAIN1, numFrames);
+        AudioMixKernels::mixStereo(_input.data(), actual.data(), _window.data(), GAIN0, GAIN1, numFrames);
+
+        QVERIFY(maxError(expected, actual) < EPSILON);
+    }
+}
+
+void AudioMixKernelsBenchmarkTests::int16ToFloat() {
+    for (int numSamples : { NUM_FRAMES, ODD_FRAMES, 1, 0 }) {
+        std::vector<float> expected(NUM_FRAMES, 0.0f);
+        std::vector<float> actual(expected);
+
+        for (int i = 0; i < numSamples; i++) {
+            expected[i] = (float)_input[i] * (1/32768.0f);
+        }
+        AudioMixKernels::int16ToFloat(_input.data(), actual.data(), 1/32768.0f, numSamples);
+
+        QCOMPARE(maxError(expected, actual), 0.0f);
+    }
+}
+
+void AudioMixKernelsBenchmarkTests::isSilent() {
+    std::vector<float> samples(2 * NUM_FRAMES, 0.0f);
+    QVERIFY(AudioMixKernels::isSilent(samples.data(), (int)samples.size()));
+    QVERIFY(AudioMixKernels::isSilent(samples.data(), 0));
+
+    // a single nonzero sample anywhere, including the tail
+    for (int i : { 0, 7, 8, 100, 2 * NUM_FRAMES - 1 }) {
+        samples[i] = 1.0e-9f;
+        QVERIFY(!AudioMixKernels::isSilent(samples.data(), (int)samples.size()));
+        samples[i] = 0.0f;
+    }
+
+    // negative zero is silent
+    samples[3] = -0.0f;
+    QVERIFY(AudioMixKernels::isSilent(samples.data(), (int)samples.size()));
+}
+
+void AudioMixKernelsBenchmarkTests::benchmarkMixMonoToStereo() {
+    std::vector<float> output(2 * NUM_FRAMES, 0.0f);
+    QBENCHMARK {
+        AudioMixKernels::mixMonoToStereo(_input.data(), output.data(), _window.data(), GAIN0, GAIN1, NUM_FRAMES);
+    }
+}
+
+void AudioMixKernelsBenchmarkTests::benchmarkMixMonoToStereoScalar() {
+    std::vector<float> output(2 * NUM_FRAMES, 0.0f);
+    QBENCHMARK {
+        mixMonoToStereoScalar(_input.data(), output.data(), _window.data(), GAIN0, GAIN1, NUM_FRAMES);
+    }
+}
+
+void AudioMixKernelsBenchmarkTests::benchmarkMixStereo() {
+    std::vector<float> output(2 * NUM_FRAMES, 0.0f);
+    QBENCHMARK {
+        AudioMixKernels::mixStereo(_input.data(), output.data(), _window.data(), GAIN0, GAIN1, NUM_FRAMES);
+    }
+}
+
+void AudioMixKernelsBenchmarkTests::benchmarkInt16ToFloat() {
+    std::vector<float> output(2 * NUM_FRAMES, 0.0f);
+    QBENCHMARK {
+        AudioMixKernels::int16ToFloat(_input.data(), output.data(), 1/32768.0f, 2 * NUM_FRAMES);
+    }
+}
+
+void AudioMixKernelsBenchmarkTests::benchmarkIsSilent() {
+    // worst case, the whole frame is scanned
+    std::vector<float> output(2 * NUM_FRAMES, 0.0f);
+    bool silent = false;
+    QBENCHMARK {
+        silent = AudioMixKernels::isSilent(output.data(), 2 * NUM_FRAMES);
+    }
+    QVERIFY(silent);
+}
@@ -0,0 +1,39 @@
+//
+//  AudioMixKernelsBenchmarkTests.h
+//  tests/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixKernelsBenchmarkTests_h
+#define hifi_AudioMixKernelsBenchmarkTests_h
+
+#include <QtTest/QtTest>
+
+#include <vector>
+
+class AudioMixKernelsBenchmarkTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void mixMonoToStereo();
+    void mixStereo();
+    void int16ToFloat();
+    void isSilent();
+
+    void benchmarkMixMonoToStereo();
+    void benchmarkMixMonoToStereoScalar();
+    void benchmarkMixStereo();
+    void benchmarkInt16ToFloat();
+    void benchmarkIsSilent();
+
+private:
+    std::vector<int16_t> _input;
+    std::vector<float> _window;
+};
+
+#endif // hifi_AudioMixKernelsBenchmarkTests_h
@@ -0,0 +1,188 @@
+//
+//  LossListTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LossListTests.h"
+
+#include <random>
+#include <set>
+
+#include <udt/LossList.h>
+
+QTEST_MAIN(LossListTests)
+
+using namespace udt;
+
+// close enough to the end of the sequence number space for every test to wrap around it
+static const SequenceNumber BASE { SequenceNumber::MAX - 1000 };
+
+static SequenceNumber seq(int offset) {
+    return BASE + offset;
+}
+
+void LossListTests::testInsertAndRemove() {
+    LossList lossList;
+    lossList.append(seq(990), seq(1010));
+    QCOMPARE(lossList.getLength(), 21);
+
+    // overlapping and touching ranges are merged into one
+    lossList.insert(seq(980), seq(995));
+    lossList.insert(seq(1011), seq(1020));
+    QCOMPARE(lossList.getLength(), 41);
+    QCOMPARE(lossList.getFirstSequenceNumber(), seq(980));
+
+    // removing from the middle of a range splits it
+    QVERIFY(lossList.remove(seq(1000)));
+    QVERIFY(!lossList.remove(seq(1000)));
+    QCOMPARE(lossList.getLength(), 40);
+
+    lossList.remove(seq(970), seq(999));
+    QCOMPARE(lossList.getLength(), 20);
+    QCOMPARE(lossList.getFirstSequenceNumber(), seq(1001));
+
+    lossList.remove(seq(1005), seq(1008));
+    QCOMPARE(lossList.getLength(), 16);
+    QCOMPARE(lossList.popFirstSequenceNumber(), seq(1001));
+    QCOMPARE(lossList.popFirstSequenceNumber(), seq(1002));
+    QCOMPARE(lossList.popFirstSequenceNumber(), seq(1003));
+    QCOMPARE(lossList.popFirstSequenceNumber(), seq(1004));
+    QCOMPARE(lossList.popFirstSequenceNumber(), seq(1009));
+    QCOMPARE(lossList.getLength(), 11);
+
+    lossList.remove(seq(1010), seq(1020));
+    QVERIFY(lossList.isEmpty());
+}
+
+void LossListTests::testPopAcrossCompaction() {
+    const int NUM_RANGES = 100;
+
+    // single sequence number ranges, so that each pop removes a range and popped ranges pile up at the front
+    LossList lossList;
+    for (int i = 0; i < NUM_RANGES; ++i) {
+        lossList.append(seq(i * 20));
+    }
+    QCOMPARE(lossList.getLength(), NUM_RANGES);
+
+    for (int i = 0; i < NUM_RANGES; ++i) {
+        QCOMPARE(lossList.getFirstSequenceNumber(), seq(i * 20));
+        QCOMPARE(lossList.popFirstSequenceNumber(), seq(i * 20));
+        QCOMPARE(lossList.getLength(), NUM_RANGES - i - 1);
+
+        // the ranges still in the list must be found where they were, whether or not the front was reclaimed
+        if (i + 1 < NUM_RANGES) {
+            QVERIFY(!lossList.remove(seq(i * 20 + 10)));
+            QVERIFY(lossList.remove(seq((NUM_RANGES - 1) * 20)));
+            lossList.append(seq((NUM_RANGES - 1) * 20));
+        }
+    }
+    QVERIFY(lossList.isEmpty());
+
+    // an emptied list starts over
+    lossList.append(seq(5000));
+    QCOMPARE(lossList.getFirstSequenceNumber(), seq(5000));
+    QCOMPARE(lossList.getLength(), 1);
+}
+
+void LossListTests::testInsertIntoPoppedSlots() {
+    LossList lossList;
+    for (int i = 0; i < 10; ++i) {
+        lossList.append(seq(i * 100), seq(i * 100 + 9));
+    }
+
+    // pop the first three ranges, fewer than half, so they are left at the front
+    lossList.remove(seq(0), seq(299));
+    QCOMPARE(lossList.getLength(), 70);
+    QCOMPARE(lossList.getFirstSequenceNumber(), seq(300));
+
+    // ranges inserted before the first one take the slots of the popped ranges
+    lossList.insert(seq(250), seq(259));
+    lossList.insert(seq(150), seq(159));
+    lossList.insert(seq(50), seq(59));
+    QCOMPARE(lossList.getLength(), 100);
+    QCOMPARE(lossList.getFirstSequenceNumber(), seq(50));
+
+    // and once there are none left, insert at the front normally
+    lossList.insert(seq(10), seq(19));
+    QCOMPARE(lossList.getLength(), 110);
+
+    // removing part of the first range keeps the rest of it in place
+    lossList.remove(seq(10), seq(14));
+    QCOMPARE(lossList.getFirstSequenceNumber(), seq(15));
+
+    int expected[] = { 15, 16, 17, 18, 19, 50 };
+    for (int offset : expected) {
+        QCOMPARE(lossList.popFirstSequenceNumber(), seq(offset));
+    }
+    lossList.remove(seq(51), seq(59));
+    QCOMPARE(lossList.popFirstSequenceNumber(), seq(150));
+    QCOMPARE(lossList.getLength(), 89);
+}
+
+void LossListTests::testRandomOperations() {
+    const int RANGE = 2000;
+    const int NUM_STEPS = 20000;
+
+    LossList lossList;
+    std::set<int> expected;
+    std::mt19937 generator(1);
+
+    for (int step = 0; step < NUM_STEPS; ++step) {
+        int start = generator() % RANGE;
+        int end = std::min(start + (int)(generator() % 30), RANGE - 1);
+
+        switch (generator() % 6) {
+            case 0:
+            case 1:
+                lossList.insert(seq(start), seq(end));
+                for (int i = start; i <= end; ++i) {
+                    expected.insert(i);
+                }
+                break;
+            case 2: {
+                // appends have to come after everything in the list
+                int last = expected.empty() ? -1 : *expected.rbegin();
+                if (last < RANGE - 1) {
+                    start = last + 1 + (int)(generator() % 3);
+                    end = std::min(start + (int)(generator() % 5), RANGE - 1);
+                    if (start <= end) {
+                        lossList.append(seq(start), seq(end));
+                        for (int i = start; i <= end; ++i) {
+                            expected.insert(i);
+                        }
+                    }
+                }
+                break;
+            }
+            case 3:
+                QCOMPARE(lossList.remove(seq(start)), expected.erase(start) == 1);
+                break;
+            case 4:
+                lossList.remove(seq(start), seq(end));
+                expected.erase(expected.lower_bound(start), expected.upper_bound(end));
+                break;
+            default:
+                // pop a few from the front, which is what reclaims popped ranges
+                for (int i = generator() % 8; i > 0 && !expected.empty(); --i) {
+                    QCOMPARE(lossList.popFirstSequenceNumber(), seq(*expected.begin()));
+                    expected.erase(expected.begin());
+                }
+                break;
+        }
+
+        QCOMPARE(lossList.getLength(), (int)expected.size());
+        if (!expected.empty()) {
+            QCOMPARE(lossList.getFirstSequenceNumber(), seq(*expected.begin()));
+        }
+    }
+
+    for (int offset : expected) {
+        QCOMPARE(lossList.popFirstSequenceNumber(), seq(offset));
+    }
+    QVERIFY(lossList.isEmpty());
+}
@@ -0,0 +1,143 @@
+//
+//  PacketAuthenticationTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketAuthenticationTests.h"
+
+#include <algorithm>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QUuid>
+
+#include <HMACAuth.h>
+#include <NLPacket.h>
+
+QTEST_MAIN(PacketAuthenticationTests)
+
+const int NUM_BENCHMARK_PACKETS = 200000;
+
+static QByteArray sequentialBytes(int length) {
+    QByteArray bytes(length, 0);
+    for (int i = 0; i < length; ++i) {
+        bytes[i] = (char)i;
+    }
+    return bytes;
+}
+
+static QByteArray hashOf(HMACAuth& hmacAuth, const QByteArray& data) {
+    HMACAuth::HMACHash hash;
+    hmacAuth.calculateHash(hash, data.constData(), data.size());
+    return QByteArray((const char*)hash.data(), (int)hash.size());
+}
+
+void PacketAuthenticationTests::testSipHashVectors() {
+    // SipHash-2-4-128 reference vectors, with the key 00 01 .. 0f and the message 00 01 .. (length - 1)
+    HMACAuth sipHash(HMACAuth::SIPHASH);
+    QVERIFY(sipHash.setKey(sequentialBytes(16).constData(), 16));
+    QCOMPARE(hashOf(sipHash, sequentialBytes(0)).toHex(), QByteArray("a3817f04ba25a8e66df67214c7550293"));
+    QCOMPARE(hashOf(sipHash, sequentialBytes(1)).toHex(), QByteArray("da87c1d86b99af44347659119b22fc45"));
+    QCOMPARE(hashOf(sipHash, sequentialBytes(15)).toHex(), QByteArray("5493e99933b0a8117e08ec0f97cfc3d9"));
+    QCOMPARE(hashOf(sipHash, sequentialBytes(63)).toHex(), QByteArray("5150d1772f50834a503e069a973fbd7c"));
+
+    // SipHash only takes 16 byte keys
+    QVERIFY(!sipHash.setKey(sequentialBytes(8).constData(), 8));
+}
+
+void PacketAuthenticationTests::testStreamedHashMatches() {
+    QByteArray data = sequentialBytes(100);
+    for (auto authMethod : { HMACAuth::MD5, HMACAuth::SIPHASH }) {
+        HMACAuth hmacAuth(authMethod);
+        hmacAuth.setKey(QUuid::createUuid());
+        QByteArray hash = hashOf(hmacAuth, data);
+        QCOMPARE(hash.size(), NUM_BYTES_MD5_HASH);
+
+        // the keyed state is reused, so hashing again gives the same result
+        QCOMPARE(hashOf(hmacAuth, data), hash);
+
+        QVERIFY(hmacAuth.addData(data.constData(), 40));
+        QVERIFY(hmacAuth.addData(data.constData() + 40, data.size() - 40));
+        HMACAuth::HMACHash streamedHash = hmacAuth.result();
+        QCOMPARE(QByteArray((const char*)streamedHash.data(), (int)streamedHash.size()), hash);
+    }
+}
+
+void PacketAuthenticationTests::testPacketVerification() {
+    QUuid connectionSecret = QUuid::createUuid();
+    for (auto authMethod : { HMACAuth::MD5, HMACAuth::SIPHASH }) {
+        HMACAuth sendingAuth(authMethod);
+        sendingAuth.setKey(connectionSecret);
+        HMACAuth receivingAuth(authMethod);
+        receivingAuth.setKey(connectionSecret);
+
+        auto packet = NLPacket::create(PacketType::AvatarData);
+        QByteArray payload = sequentialBytes(200);
+        packet->write(payload);
+        packet->writeSourceID(1);
+        packet->writeVerificationHash(sendingAuth);
+
+        QVERIFY(NLPacket::verificationHashMatches(*packet, receivingAuth));
+        QCOMPARE(NLPacket::verificationHashInHeader(*packet), NLPacket::hashForPacketAndHMAC(*packet, receivingAuth));
+
+        // a different secret or a different payload fails
+        HMACAuth otherAuth(authMethod);
+        otherAuth.setKey(QUuid::createUuid());
+        QVERIFY(!NLPacket::verificationHashMatches(*packet, otherAuth));
+
+        packet->getData()[packet->getDataSize() - 1] ^= 1;
+        QVERIFY(!NLPacket::verificationHashMatches(*packet, receivingAuth));
+    }
+
+    // both ends have to use the same method
+    HMACAuth md5Auth(HMACAuth::MD5);
+    md5Auth.setKey(connectionSecret);
+    HMACAuth sipHashAuth(HMACAuth::SIPHASH);
+    sipHashAuth.setKey(connectionSecret);
+    auto packet = NLPacket::create(PacketType::AvatarData);
+    packet->write(sequentialBytes(200));
+    packet->writeVerificationHash(md5Auth);
+    QVERIFY(!NLPacket::verificationHashMatches(*packet, sipHashAuth));
+}
+
+void PacketAuthenticationTests::benchmarkHashThroughput() {
+    QUuid connectionSecret = QUuid::createUuid();
+
+    // a small packet like the mixers send most of, and a full one
+    for (int payloadSize : { 100, 1200 }) {
+        auto packet = NLPacket::create(PacketType::AvatarData);
+        packet->write(sequentialBytes(payloadSize));
+        packet->writeSourceID(1);
+
+        qint64 nsecs[2];
+        int i = 0;
+        for (auto authMethod : { HMACAuth::MD5, HMACAuth::SIPHASH }) {
+            HMACAuth hmacAuth(authMethod);
+            hmacAuth.setKey(connectionSecret);
+            packet->writeVerificationHash(hmacAuth);
+
+            QElapsedTimer timer;
+            timer.start();
+            int numVerified = 0;
+            for (int j = 0; j < NUM_BENCHMARK_PACKETS; ++j) {
+                numVerified += NLPacket::verificationHashMatches(*packet, hmacAuth) ? 1 : 0;
+            }
+            nsecs[i++] = std::max(timer.nsecsElapsed(), (qint64)1);
+            QCOMPARE(numVerified, NUM_BENCHMARK_PACKETS);
+        }
+
+        auto packetsPerSecond = [](qint64 nsecs) {
+            return (qint64)NUM_BENCHMARK_PACKETS * 1000000000 / nsecs;
+        };
+        auto megabytesPerSecond = [payloadSize](qint64 nsecs) {
+            return (double)NUM_BENCHMARK_PACKETS * payloadSize * 1000.0 / nsecs;
+        };
+        qDebug() << payloadSize << "byte payloads, HMAC-MD5 vs SipHash:";
+        qDebug() << "    packets/s:" << packetsPerSecond(nsecs[0]) << "vs" << packetsPerSecond(nsecs[1]);
+        qDebug() << "    MB/s:     " << megabytesPerSecond(nsecs[0]) << "vs" << megabytesPerSecond(nsecs[1]);
+    }
+}
@@ -0,0 +1,26 @@
+//
+//  PacketAuthenticationTests.h
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketAuthenticationTests_h
+#define hifi_PacketAuthenticationTests_h
+
+#include <QtTest/QtTest>
+
+class PacketAuthenticationTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testSipHashVectors();
+    void testStreamedHashMatches();
+    void testPacketVerification();
+    void benchmarkHashThroughput();
+};
+
+#endif // hifi_PacketAuthenticationTests_h
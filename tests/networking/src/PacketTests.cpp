@@ -14,6 +14,7 @@
 #include <test-utils/QTestExtensions.h>
 
 #include <NLPacket.h>
+#include <udt/PacketBufferPool.h>
 
 QTEST_MAIN(PacketTests)
 
@@ -185,3 +186,27 @@ void PacketTests::primitiveTest() {
     QCOMPARE(recvPacket->peekPrimitive(&noValue), 0);
     QCOMPARE(recvPacket->readPrimitive(&noValue), 0);
 }
+
+void PacketTests::pooledBufferTest() {
+    auto packet = NLPacket::create(PacketType::Unknown);
+    packet->write("somedata");
+
+    auto size = packet->getDataSize();
+    auto buffer = udt::PacketBufferPool::acquire();
+    memcpy(buffer.get(), packet->getData(), size);
+
+    int pooledBefore = udt::PacketBufferPool::getNumPooledBuffers();
+    {
+        auto readPacket = NLPacket::fromReceivedPacket(std::move(buffer), size, SockAddr());
+        readPacket->setBufferIsPooled(true);
+
+        QCOMPARE(readPacket->getType(), PacketType::Unknown);
+        COMPARE_DATA(readPacket->getPayload(), "somedata", 8);
+    }
+    QCOMPARE(udt::PacketBufferPool::getNumPooledBuffers(), pooledBefore + 1);
+
+    // the released buffer is the one handed out next
+    auto reused = udt::PacketBufferPool::acquire();
+    QCOMPARE(udt::PacketBufferPool::getNumPooledBuffers(), pooledBefore);
+    udt::PacketBufferPool::release(std::move(reused));
+}
@@ -36,6 +36,9 @@ private slots:
 
     // Test set/get packet type
     void packetTypeTest();
+
+    // Test received packets hand pooled buffers back to the PacketBufferPool
+    void pooledBufferTest();
 };
 
 #endif // hifi_PacketTests_h
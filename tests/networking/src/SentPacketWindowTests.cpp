@@ -0,0 +1,157 @@
+//
+//  SentPacketWindowTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SentPacketWindowTests.h"
+
+#include <vector>
+
+#include <udt/Packet.h>
+#include <udt/SentPacketWindow.h>
+
+QTEST_MAIN(SentPacketWindowTests)
+
+using namespace udt;
+
+// larger than the ring starts out, so that it has to grow
+static const int NUM_PACKETS = 1000;
+
+// adds NUM_PACKETS packets from firstSequenceNumber on, and returns them to compare against
+static std::vector<Packet*> addPackets(SentPacketWindow& window, SequenceNumber firstSequenceNumber, int step = 1) {
+    std::vector<Packet*> packets;
+    SequenceNumber sequenceNumber = firstSequenceNumber;
+    for (int i = 0; i < NUM_PACKETS; ++i, sequenceNumber += step) {
+        auto packet = Packet::create();
+        packets.push_back(packet.get());
+        window.add(sequenceNumber, std::move(packet));
+    }
+    return packets;
+}
+
+void SentPacketWindowTests::testAddAndAcknowledge() {
+    SentPacketWindow window;
+    SequenceNumber first { 100 };
+    auto packets = addPackets(window, first);
+
+    for (int i = 0; i < NUM_PACKETS; ++i) {
+        auto entry = window.find(first + i);
+        QVERIFY(entry);
+        QCOMPARE(entry->second.get(), packets[i]);
+        QCOMPARE((int)entry->first, 0);
+    }
+    QVERIFY(!window.find(first - 1));
+    QVERIFY(!window.find(first + NUM_PACKETS));
+
+    // ACKs remove everything up to and including the sequence number, and older ACKs do nothing
+    window.acknowledge(first + 499);
+    window.acknowledge(first + 10);
+    QVERIFY(!window.find(first));
+    QVERIFY(!window.find(first + 499));
+    QCOMPARE(window.find(first + 500)->second.get(), packets[500]);
+
+    window.acknowledge(first + NUM_PACKETS + 50);
+    QVERIFY(!window.find(first + NUM_PACKETS - 1));
+
+    // an emptied window starts over from whatever is added next
+    SequenceNumber next { 5000 };
+    auto packet = Packet::create();
+    auto packetPointer = packet.get();
+    window.add(next, std::move(packet));
+    QCOMPARE(window.find(next)->second.get(), packetPointer);
+
+    window.clear();
+    QVERIFY(!window.find(next));
+}
+
+void SentPacketWindowTests::testGrowth() {
+    SentPacketWindow window;
+    SequenceNumber first { 0 };
+
+    // keep some of the window ACKed while it grows, so that the packets move around the ring
+    std::vector<Packet*> packets;
+    SequenceNumber sequenceNumber = first;
+    for (int i = 0; i < NUM_PACKETS; ++i, ++sequenceNumber) {
+        auto packet = Packet::create();
+        packets.push_back(packet.get());
+        window.add(sequenceNumber, std::move(packet));
+
+        if (i == 100) {
+            window.acknowledge(first + 49);
+            window.find(first + 50)->first = 3;
+        }
+    }
+
+    QVERIFY(!window.find(first + 49));
+    for (int i = 50; i < NUM_PACKETS; ++i) {
+        auto entry = window.find(first + i);
+        QVERIFY(entry);
+        QCOMPARE(entry->second.get(), packets[i]);
+    }
+
+    // resend counts move along with their packets
+    QCOMPARE((int)window.find(first + 50)->first, 3);
+    QCOMPARE((int)window.find(first + 51)->first, 0);
+}
+
+void SentPacketWindowTests::testWraparound() {
+    SentPacketWindow window;
+
+    // start close enough to the end of the sequence number space for the window to wrap around it as it grows
+    SequenceNumber first { SequenceNumber::MAX - 300 };
+    auto packets = addPackets(window, first);
+
+    for (int i = 0; i < NUM_PACKETS; ++i) {
+        auto entry = window.find(first + i);
+        QVERIFY(entry);
+        QCOMPARE(entry->second.get(), packets[i]);
+    }
+
+    // ACK across the wraparound
+    window.acknowledge(first + 400);
+    QVERIFY(!window.find(SequenceNumber { SequenceNumber::MAX }));
+    QVERIFY(!window.find(SequenceNumber { 0 }));
+    QCOMPARE(window.find(first + 401)->second.get(), packets[401]);
+
+    // keep going around the ring, adding and ACKing as a connection does
+    SequenceNumber next = first + NUM_PACKETS;
+    SequenceNumber acknowledged = first + 400;
+    for (int i = 0; i < 10 * NUM_PACKETS; ++i, ++next) {
+        auto packet = Packet::create();
+        auto packetPointer = packet.get();
+        window.add(next, std::move(packet));
+        QCOMPARE(window.find(next)->second.get(), packetPointer);
+
+        if (i % 7 == 0) {
+            acknowledged += 7;
+            window.acknowledge(acknowledged);
+            QVERIFY(!window.find(acknowledged));
+            QVERIFY(window.find(acknowledged + 1));
+        }
+    }
+}
+
+void SentPacketWindowTests::testGaps() {
+    SentPacketWindow window;
+
+    // sequence numbers that are skipped take a slot but have no packet
+    SequenceNumber first { SequenceNumber::MAX - 500 };
+    auto packets = addPackets(window, first, 3);
+
+    for (int i = 0; i < NUM_PACKETS; ++i) {
+        SequenceNumber sequenceNumber = first + 3 * i;
+        QCOMPARE(window.find(sequenceNumber)->second.get(), packets[i]);
+        QVERIFY(!window.find(sequenceNumber + 1));
+        QVERIFY(!window.find(sequenceNumber + 2));
+    }
+
+    // ACKing a skipped sequence number removes the packets before it
+    window.acknowledge(first + 3 * 200 + 1);
+    QVERIFY(!window.find(first + 3 * 200));
+    QCOMPARE(window.find(first + 3 * 201)->second.get(), packets[201]);
+}
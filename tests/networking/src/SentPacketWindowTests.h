@@ -0,0 +1,26 @@
+//
+//  SentPacketWindowTests.h
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SentPacketWindowTests_h
+#define hifi_SentPacketWindowTests_h
+
+#include <QtTest/QtTest>
+
+class SentPacketWindowTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testAddAndAcknowledge();
+    void testGrowth();
+    void testWraparound();
+    void testGaps();
+};
+
+#endif // hifi_SentPacketWindowTests_h
@@ -0,0 +1,146 @@
+//
+//  TimerWheelTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheelTests.h"
+
+#include <random>
+#include <vector>
+
+#include <udt/TimerWheel.h>
+
+QTEST_MAIN(TimerWheelTests)
+
+using namespace udt;
+using namespace std::chrono;
+
+static const microseconds TICK { 100 };
+
+void TimerWheelTests::testExpiryOrder() {
+    auto start = TimerWheel::Clock::now();
+    TimerWheel wheel(TICK, start);
+
+    TimerWheel::Timer timers[3];
+    wheel.schedule(timers[0], start + milliseconds(3));
+    wheel.schedule(timers[1], start + microseconds(150));
+    wheel.schedule(timers[2], start + milliseconds(1));
+    QCOMPARE(wheel.getNumTimers(), 3);
+
+    // expiries are rounded up to the next tick
+    QCOMPARE(wheel.getNextEventTime(), start + microseconds(200));
+
+    std::vector<TimerWheel::Timer*> expired;
+    auto onExpiry = [&](TimerWheel::Timer& timer) { expired.push_back(&timer); };
+
+    wheel.advance(start + microseconds(199), onExpiry);
+    QVERIFY(expired.empty());
+
+    wheel.advance(start + milliseconds(5), onExpiry);
+    QCOMPARE((int)expired.size(), 3);
+    QCOMPARE(expired[0], &timers[1]);
+    QCOMPARE(expired[1], &timers[2]);
+    QCOMPARE(expired[2], &timers[0]);
+    QCOMPARE(wheel.getNumTimers(), 0);
+    QCOMPARE(wheel.getNextEventTime(), TimerWheel::TimePoint::max());
+    QVERIFY(!timers[0].isScheduled());
+}
+
+void TimerWheelTests::testCancelAndReschedule() {
+    auto start = TimerWheel::Clock::now();
+    TimerWheel wheel(TICK, start);
+
+    TimerWheel::Timer cancelled;
+    TimerWheel::Timer repeating;
+    wheel.schedule(cancelled, start + milliseconds(1));
+    wheel.schedule(repeating, start + milliseconds(1));
+    wheel.cancel(cancelled);
+    QVERIFY(!cancelled.isScheduled());
+
+    // a handler can schedule the timer it was called for again
+    int numExpiries = 0;
+    auto now = start;
+    auto onExpiry = [&](TimerWheel::Timer& timer) {
+        QCOMPARE(&timer, &repeating);
+        ++numExpiries;
+        wheel.schedule(timer, now + milliseconds(1));
+    };
+
+    for (int i = 1; i <= 10; ++i) {
+        now = start + milliseconds(i);
+        wheel.advance(now, onExpiry);
+        QCOMPARE(numExpiries, i);
+    }
+    QVERIFY(repeating.isScheduled());
+    QCOMPARE(wheel.getNumTimers(), 1);
+}
+
+void TimerWheelTests::testFarTimers() {
+    auto start = TimerWheel::Clock::now();
+    TimerWheel wheel(TICK, start);
+
+    // these sit in the upper levels of the wheel, and have to be moved down to expire on time
+    std::vector<milliseconds> delays { milliseconds(7), milliseconds(450), seconds(5), seconds(30), seconds(600) };
+    std::vector<TimerWheel::Timer> timers(delays.size());
+    for (size_t i = 0; i < delays.size(); ++i) {
+        wheel.schedule(timers[i], start + delays[i]);
+    }
+
+    for (size_t i = 0; i < delays.size(); ++i) {
+        bool didExpire = false;
+        auto onExpiry = [&](TimerWheel::Timer& timer) {
+            QCOMPARE(&timer, &timers[i]);
+            didExpire = true;
+        };
+
+        wheel.advance(start + delays[i] - TICK, onExpiry);
+        QVERIFY(!didExpire);
+        wheel.advance(start + delays[i], onExpiry);
+        QVERIFY(didExpire);
+    }
+}
+
+void TimerWheelTests::testRandomTimers() {
+    const int NUM_TIMERS = 200;
+    const int NUM_STEPS = 20000;
+
+    auto start = TimerWheel::Clock::now();
+    TimerWheel wheel(TICK, start);
+
+    std::vector<TimerWheel::Timer> timers(NUM_TIMERS);
+    std::vector<TimerWheel::TimePoint> expiries(NUM_TIMERS, TimerWheel::TimePoint::max());
+    std::mt19937 generator(1);
+    auto now = start;
+
+    for (int step = 0; step < NUM_STEPS; ++step) {
+        int index = generator() % NUM_TIMERS;
+        switch (generator() % 3) {
+            case 0:
+                expiries[index] = now + microseconds(generator() % 10000000);
+                wheel.schedule(timers[index], expiries[index]);
+                break;
+            case 1:
+                expiries[index] = TimerWheel::TimePoint::max();
+                wheel.cancel(timers[index]);
+                break;
+            default:
+                now += microseconds(generator() % 20000);
+                wheel.advance(now, [&](TimerWheel::Timer& timer) {
+                    auto& expiry = expiries[&timer - timers.data()];
+                    QVERIFY(expiry <= now); // never early
+                    expiry = TimerWheel::TimePoint::max();
+                });
+
+                // never more than a tick late
+                for (auto expiry : expiries) {
+                    QVERIFY(expiry == TimerWheel::TimePoint::max() || expiry > now - TICK);
+                }
+                break;
+        }
+    }
+}
@@ -0,0 +1,193 @@
+//
+//  EntityBVHBenchmarkTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityBVHBenchmarkTests.h"
+
+#include <algorithm>
+#include <random>
+
+#include <QtCore/QElapsedTimer>
+
+#include <DependencyManager.h>
+#include <EntityTree.h>
+#include <MovingEntitiesOperator.h>
+#include <NodeList.h>
+
+QTEST_MAIN(EntityBVHBenchmarkTests)
+
+const float CONTENT_SIZE = 2000.0f; // meters
+const int NUM_QUERIES = 2000;
+
+static PickFilter getSearchFilter() {
+    return PickFilter(PickFilter::getBitMask(PickFilter::DOMAIN_ENTITIES) | PickFilter::getBitMask(PickFilter::VISIBLE) |
+        PickFilter::getBitMask(PickFilter::INVISIBLE) | PickFilter::getBitMask(PickFilter::COLLIDABLE) |
+        PickFilter::getBitMask(PickFilter::NONCOLLIDABLE));
+}
+
+static glm::vec3 randomPosition(std::mt19937& random) {
+    std::uniform_real_distribution<float> coordinate(-0.5f * CONTENT_SIZE, 0.5f * CONTENT_SIZE);
+    return glm::vec3(coordinate(random), 0.05f * coordinate(random), coordinate(random));
+}
+
+static EntityTreePointer createTree(int numEntities, std::vector<EntityItemPointer>& entities) {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+
+    std::mt19937 random(numEntities);
+    std::uniform_real_distribution<float> dimension(0.25f, 4.0f);
+    entities.reserve(numEntities);
+    for (int i = 0; i < numEntities; ++i) {
+        EntityItemProperties properties;
+        properties.setType(EntityTypes::Box);
+        properties.setPosition(randomPosition(random));
+        properties.setDimensions(glm::vec3(dimension(random), dimension(random), dimension(random)));
+        EntityItemPointer entity = tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+        if (entity) {
+            entities.push_back(entity);
+        }
+    }
+    return tree;
+}
+
+class QueryResults {
+public:
+    std::vector<QVector<QUuid>> spheres;
+    std::vector<QVector<QUuid>> boxes;
+    std::vector<EntityItemID> rays;
+    std::vector<float> rayDistances;
+};
+
+static QueryResults runQueries(const EntityTreePointer& tree, int numQueries, qint64& sphereTime, qint64& boxTime,
+                               qint64& rayTime) {
+    QueryResults results;
+    PickFilter searchFilter = getSearchFilter();
+    QElapsedTimer timer;
+
+    std::mt19937 random(numQueries);
+    timer.start();
+    for (int i = 0; i < numQueries; ++i) {
+        QVector<QUuid> found;
+        tree->withReadLock([&] {
+            tree->evalEntitiesInSphere(randomPosition(random), 20.0f, searchFilter, found);
+        });
+        std::sort(found.begin(), found.end());
+        results.spheres.push_back(found);
+    }
+    sphereTime = timer.nsecsElapsed();
+
+    random.seed(numQueries);
+    timer.restart();
+    for (int i = 0; i < numQueries; ++i) {
+        QVector<QUuid> found;
+        tree->withReadLock([&] {
+            tree->evalEntitiesInBox(AABox(randomPosition(random), glm::vec3(40.0f, 20.0f, 40.0f)), searchFilter, found);
+        });
+        std::sort(found.begin(), found.end());
+        results.boxes.push_back(found);
+    }
+    boxTime = timer.nsecsElapsed();
+
+    random.seed(numQueries);
+    timer.restart();
+    for (int i = 0; i < numQueries; ++i) {
+        glm::vec3 origin = randomPosition(random);
+        glm::vec3 direction = glm::normalize(randomPosition(random) - origin);
+        OctreeElementPointer element;
+        float distance;
+        BoxFace face;
+        glm::vec3 surfaceNormal;
+        QVariantMap extraInfo;
+        results.rays.push_back(tree->evalRayIntersection(origin, direction, QVector<EntityItemID>(), QVector<EntityItemID>(),
+            searchFilter, element, distance, face, surfaceNormal, extraInfo, Octree::Lock));
+        results.rayDistances.push_back(distance);
+    }
+    rayTime = timer.nsecsElapsed();
+
+    return results;
+}
+
+static void compareResults(const QueryResults& octree, const QueryResults& bvh) {
+    QCOMPARE(bvh.spheres.size(), octree.spheres.size());
+    for (size_t i = 0; i < octree.spheres.size(); ++i) {
+        QCOMPARE(bvh.spheres[i], octree.spheres[i]);
+        QCOMPARE(bvh.boxes[i], octree.boxes[i]);
+        // the octree stops at the first element with a hit, which isn't always the nearest hit, as the BVH finds
+        QCOMPARE(bvh.rays[i].isNull(), octree.rays[i].isNull());
+        QVERIFY(bvh.rayDistances[i] <= octree.rayDistances[i]);
+    }
+}
+
+void EntityBVHBenchmarkTests::initTestCase() {
+    // EntityTree::addEntity() needs a NodeList, which doesn't have to be connected
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::Agent, INVALID_PORT);
+}
+
+void EntityBVHBenchmarkTests::testBVHMatchesOctree() {
+    const int NUM_ENTITIES = 3000;
+    const int NUM_TEST_QUERIES = 200;
+    std::vector<EntityItemPointer> entities;
+    EntityTreePointer tree = createTree(NUM_ENTITIES, entities);
+    QCOMPARE((int)entities.size(), NUM_ENTITIES);
+
+    qint64 sphereTime, boxTime, rayTime;
+    QueryResults octreeResults = runQueries(tree, NUM_TEST_QUERIES, sphereTime, boxTime, rayTime);
+    tree->setBVHEnabled(true);
+    QCOMPARE(tree->getBVHStats().numEntities, NUM_ENTITIES);
+    compareResults(octreeResults, runQueries(tree, NUM_TEST_QUERIES, sphereTime, boxTime, rayTime));
+
+    // move a third of the entities, which refits them in the BVH
+    std::mt19937 random(NUM_ENTITIES);
+    MovingEntitiesOperator moveOperator;
+    for (size_t i = 0; i < entities.size(); i += 3) {
+        entities[i]->setWorldPosition(randomPosition(random));
+        entities[i]->updateQueryAACube();
+        moveOperator.addEntityToMoveList(entities[i], entities[i]->getQueryAACube());
+    }
+    tree->withWriteLock([&] {
+        tree->recurseTreeWithOperator(&moveOperator);
+    });
+    QVERIFY(tree->getBVHStats().numRefits > 0);
+
+    QueryResults bvhResults = runQueries(tree, NUM_TEST_QUERIES, sphereTime, boxTime, rayTime);
+    tree->setBVHEnabled(false);
+    compareResults(runQueries(tree, NUM_TEST_QUERIES, sphereTime, boxTime, rayTime), bvhResults);
+}
+
+void EntityBVHBenchmarkTests::benchmarkQueries(int numEntities) {
+    std::vector<EntityItemPointer> entities;
+    EntityTreePointer tree = createTree(numEntities, entities);
+
+    qint64 octreeSphereTime, octreeBoxTime, octreeRayTime;
+    runQueries(tree, NUM_QUERIES, octreeSphereTime, octreeBoxTime, octreeRayTime);
+
+    tree->setBVHEnabled(true);
+    qint64 bvhSphereTime, bvhBoxTime, bvhRayTime;
+    // the first query builds the BVH, so run once to leave that out of the timing
+    runQueries(tree, 1, bvhSphereTime, bvhBoxTime, bvhRayTime);
+    runQueries(tree, NUM_QUERIES, bvhSphereTime, bvhBoxTime, bvhRayTime);
+
+    auto queriesPerSecond = [](qint64 nsecs) {
+        return nsecs > 0 ? (qint64)NUM_QUERIES * 1000000000 / nsecs : 0;
+    };
+    qDebug() << numEntities << "entities, queries per second, octree vs BVH:";
+    qDebug() << "    sphere:" << queriesPerSecond(octreeSphereTime) << "vs" << queriesPerSecond(bvhSphereTime);
+    qDebug() << "    box:   " << queriesPerSecond(octreeBoxTime) << "vs" << queriesPerSecond(bvhBoxTime);
+    qDebug() << "    ray:   " << queriesPerSecond(octreeRayTime) << "vs" << queriesPerSecond(bvhRayTime);
+}
+
+void EntityBVHBenchmarkTests::benchmark10kEntities() {
+    benchmarkQueries(10000);
+}
+
+void EntityBVHBenchmarkTests::benchmark100kEntities() {
+    benchmarkQueries(100000);
+}
@@ -0,0 +1,29 @@
+//
+//  EntityBVHBenchmarkTests.h
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityBVHBenchmarkTests_h
+#define hifi_EntityBVHBenchmarkTests_h
+
+#include <QtTest/QtTest>
+
+class EntityBVHBenchmarkTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testBVHMatchesOctree();
+    void benchmark10kEntities();
+    void benchmark100kEntities();
+
+private:
+    void benchmarkQueries(int numEntities);
+};
+
+#endif // hifi_EntityBVHBenchmarkTests_h
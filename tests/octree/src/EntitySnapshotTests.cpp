@@ -0,0 +1,222 @@
+//
+//  EntitySnapshotTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySnapshotTests.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+
+#include <DependencyManager.h>
+#include <EntitySnapshot.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+
+QTEST_MAIN(EntitySnapshotTests)
+
+const int NUM_BOXES = 100;
+const int DATA_VERSION = 12;
+
+// too long for the 16-bit lengths of the packet encoding, so that the entity is stored as JSON
+static QString makeLargeUserData() {
+    return "{\"text\":\"" + QString(70000, 'x') + "\"}";
+}
+
+static EntityTreePointer createTree() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+    return tree;
+}
+
+static QVector<EntityItemID> populateTree(const EntityTreePointer& tree) {
+    tree->setOctreeVersionInfo(QUuid::createUuid(), DATA_VERSION);
+    QVector<EntityItemID> ids;
+    auto addEntity = [&](const EntityItemProperties& properties) {
+        EntityItemID id(QUuid::createUuid());
+        if (tree->addEntity(id, properties)) {
+            ids.push_back(id);
+        }
+        return id;
+    };
+
+    EntityItemProperties parent;
+    parent.setType(EntityTypes::Model);
+    parent.setName("parent");
+    parent.setModelURL("https://example.com/parent.fbx");
+    parent.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    parent.setRotation(glm::angleAxis(0.5f, glm::vec3(0.0f, 1.0f, 0.0f)));
+    parent.setDimensions(glm::vec3(2.0f));
+    parent.setIsVisibleInSecondaryCamera(false);
+    EntityItemID parentID = addEntity(parent);
+
+    for (int i = 0; i < NUM_BOXES; ++i) {
+        EntityItemProperties box;
+        box.setType(EntityTypes::Box);
+        // names and scripts are shared by several entities, so that they share dictionary strings
+        box.setName("box " + QString::number(i % 10));
+        box.setScript(i % 2 ? "https://example.com/box.js" : "");
+        box.setPosition(glm::vec3((float)i, 0.5f * i, -(float)i));
+        box.setDimensions(glm::vec3(0.1f + 0.01f * i));
+        box.setColor(glm::u8vec3(i, 255 - i, 128));
+        box.setUserData("{\"index\":" + QString::number(i) + "}");
+        if (i % 5 == 0) {
+            box.setParentID(parentID);
+        }
+        addEntity(box);
+    }
+
+    EntityItemProperties large;
+    large.setType(EntityTypes::Box);
+    large.setName("large");
+    large.setUserData(makeLargeUserData());
+    addEntity(large);
+
+    return ids;
+}
+
+void EntitySnapshotTests::initTestCase() {
+    // EntityTree::addEntity() needs a NodeList, which doesn't have to be connected
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::Agent, INVALID_PORT);
+
+    QVERIFY(_dir.isValid());
+}
+
+QString EntitySnapshotTests::writeTestSnapshot() {
+    EntityTreePointer tree = createTree();
+    _ids = populateTree(tree);
+
+    QString filename = _dir.filePath(QUuid::createUuid().toString(QUuid::WithoutBraces) + ".snapshot");
+    bool written = tree->writeToSnapshotFile(filename);
+    tree->eraseAllOctreeElements(false);
+    return written ? filename : QString();
+}
+
+void EntitySnapshotTests::testTreeRoundTrip() {
+    EntityTreePointer tree = createTree();
+    QVector<EntityItemID> ids = populateTree(tree);
+    QCOMPARE(ids.size(), NUM_BOXES + 2);
+    QVERIFY(!EntitySnapshot::canEncode(tree->findEntityByID(ids.last())->getProperties()));
+
+    QString filename = _dir.filePath("roundTrip.snapshot");
+    QVERIFY(tree->writeToSnapshotFile(filename));
+
+    EntityTreePointer loadedTree = createTree();
+    bool loaded = false;
+    loadedTree->withWriteLock([&] {
+        loaded = loadedTree->readFromSnapshotFile(filename);
+    });
+    QVERIFY(loaded);
+
+    QCOMPARE(loadedTree->getPersistID(), tree->getPersistID());
+    QCOMPARE(loadedTree->getPersistDataVersion(), tree->getPersistDataVersion());
+
+    for (const auto& id : ids) {
+        EntityItemPointer entity = tree->findEntityByID(id);
+        EntityItemPointer loadedEntity = loadedTree->findEntityByID(id);
+        QVERIFY(loadedEntity);
+
+        EntityItemProperties properties = entity->getProperties();
+        EntityItemProperties loadedProperties = loadedEntity->getProperties();
+        QCOMPARE(loadedProperties.getType(), properties.getType());
+        QCOMPARE(loadedProperties.getName(), properties.getName());
+        QCOMPARE(loadedProperties.getScript(), properties.getScript());
+        QCOMPARE(loadedProperties.getServerScripts(), properties.getServerScripts());
+        QCOMPARE(loadedProperties.getModelURL(), properties.getModelURL());
+        QCOMPARE(loadedProperties.getUserData(), properties.getUserData());
+        QCOMPARE(loadedProperties.getParentID(), properties.getParentID());
+        QCOMPARE(loadedProperties.getCreated(), properties.getCreated());
+        QCOMPARE(loadedProperties.getPosition(), properties.getPosition());
+        QCOMPARE(loadedProperties.getRotation(), properties.getRotation());
+        QCOMPARE(loadedProperties.getDimensions(), properties.getDimensions());
+        QCOMPARE(loadedProperties.getColor(), properties.getColor());
+        QCOMPARE(loadedProperties.getIsVisibleInSecondaryCamera(), properties.getIsVisibleInSecondaryCamera());
+    }
+
+    tree->eraseAllOctreeElements(false);
+    loadedTree->eraseAllOctreeElements(false);
+}
+
+void EntitySnapshotTests::testJSONFallback() {
+    QString filename = writeTestSnapshot();
+    QVERIFY(!filename.isEmpty());
+
+    EntitySnapshot::Contents contents;
+    QVERIFY(EntitySnapshot::read(filename, contents));
+    QCOMPARE((int)contents.ids.size(), NUM_BOXES + 1);
+    QCOMPARE(contents.info.variantEntityData.size(), 1);
+
+    QVariantMap entity = contents.info.variantEntityData.first().toMap();
+    QCOMPARE(entity["name"].toString(), QString("large"));
+    QCOMPARE(entity["userData"].toString(), makeLargeUserData());
+}
+
+void EntitySnapshotTests::testRejectsTruncatedFile() {
+    QString filename = writeTestSnapshot();
+    QVERIFY(!filename.isEmpty());
+    qint64 size = QFileInfo(filename).size();
+
+    // shorter than the header, then missing the end of the last sections
+    for (qint64 truncatedSize : { (qint64)sizeof(OctreeUtils::SnapshotHeader) / 2, size / 2, size - 1 }) {
+        QVERIFY(QFile::resize(filename, truncatedSize));
+
+        EntitySnapshot::Contents contents;
+        QVERIFY(!EntitySnapshot::read(filename, contents));
+
+        EntityTreePointer tree = createTree();
+        bool loaded = true;
+        tree->withWriteLock([&] {
+            loaded = tree->readFromSnapshotFile(filename);
+        });
+        QVERIFY(!loaded);
+        for (const auto& id : _ids) {
+            QVERIFY(!tree->findEntityByID(id));
+        }
+    }
+}
+
+void EntitySnapshotTests::testRejectsCorruptHeader() {
+    QString filename = writeTestSnapshot();
+    QVERIFY(!filename.isEmpty());
+
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray original = file.readAll();
+    file.close();
+
+    // the file header follows the snapshot header with the entity and string counts, then the section table
+    const int countsOffset = sizeof(OctreeUtils::SnapshotHeader);
+    const int sectionsOffset = countsOffset + 2 * sizeof(quint64);
+    const quint64 pastEnd = original.size() + 1;
+    const quint32 wrongFormatVersion = EntitySnapshot::FORMAT_VERSION + 1;
+
+    struct Corruption {
+        int offset;
+        QByteArray bytes;
+    };
+    QVector<Corruption> corruptions {
+        { 0, QByteArray("XXXX") },
+        { (int)sizeof(quint32), QByteArray(reinterpret_cast<const char*>(&wrongFormatVersion), sizeof(quint32)) },
+        { countsOffset, QByteArray(reinterpret_cast<const char*>(&pastEnd), sizeof(quint64)) },
+        { sectionsOffset, QByteArray(reinterpret_cast<const char*>(&pastEnd), sizeof(quint64)) },
+        { sectionsOffset + (int)sizeof(quint64), QByteArray(reinterpret_cast<const char*>(&pastEnd), sizeof(quint64)) }
+    };
+
+    for (const auto& corruption : corruptions) {
+        QByteArray corrupt = original;
+        corrupt.replace(corruption.offset, corruption.bytes.size(), corruption.bytes);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QCOMPARE(file.write(corrupt), (qint64)corrupt.size());
+        file.close();
+
+        EntitySnapshot::Contents contents;
+        QVERIFY(!EntitySnapshot::read(filename, contents));
+    }
+}
@@ -0,0 +1,35 @@
+//
+//  EntitySnapshotTests.h
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitySnapshotTests_h
+#define hifi_EntitySnapshotTests_h
+
+#include <QtTest/QtTest>
+
+#include <EntityItemID.h>
+
+class EntitySnapshotTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testTreeRoundTrip();
+    void testJSONFallback();
+    void testRejectsTruncatedFile();
+    void testRejectsCorruptHeader();
+
+private:
+    QString writeTestSnapshot();
+
+    QTemporaryDir _dir;
+    QVector<EntityItemID> _ids;
+};
+
+#endif // hifi_EntitySnapshotTests_h
@@ -0,0 +1,165 @@
+//
+//  OctreeEntitiesFileParserBenchmarkTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeEntitiesFileParserBenchmarkTests.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QUuid>
+
+#include <OctreeEntitiesFileParser.h>
+
+QTEST_MAIN(OctreeEntitiesFileParserBenchmarkTests)
+
+// The default content is around 20 MB. Set OVERTE_PARSER_BENCHMARK_ENTITIES to benchmark larger content sets,
+// 300000 entities make a content set of around 300 MB.
+const int DEFAULT_NUM_ENTITIES = 20000;
+
+// Peak resident set size of the process in KB, or 0 where it isn't available.
+static qint64 getPeakRSS() {
+    QFile status("/proc/self/status");
+    if (status.open(QIODevice::ReadOnly)) {
+        for (QByteArray line = status.readLine(); !line.isEmpty(); line = status.readLine()) {
+            if (line.startsWith("VmHWM:")) {
+                return line.mid(6).trimmed().split(' ').first().toLongLong();
+            }
+        }
+    }
+    return 0;
+}
+
+// Resets the peak resident set size to the current one (Linux 4.0 and later), so that the peak of one benchmark isn't
+// carried over to the next.
+static bool resetPeakRSS() {
+    QFile clearRefs("/proc/self/clear_refs");
+    return clearRefs.open(QIODevice::WriteOnly) && clearRefs.write("5") == 1;
+}
+
+static QByteArray makeEntity(int index) {
+    QString entity = QString(
+        "{\n"
+        "      \"clientOnly\": false,\n"
+        "      \"created\": \"2026-01-01T00:00:00Z\",\n"
+        "      \"dimensions\": { \"x\": 1.5, \"y\": 2.25, \"z\": 0.75 },\n"
+        "      \"id\": \"%1\",\n"
+        "      \"lastEdited\": 1767225600000000,\n"
+        "      \"modelURL\": \"https://content.example.org/models/model%2.fbx\",\n"
+        "      \"name\": \"Entity %2\",\n"
+        "      \"position\": { \"x\": %3, \"y\": 1.5, \"z\": %4 },\n"
+        "      \"queryAACube\": { \"scale\": 2.8, \"x\": %3, \"y\": 0.1, \"z\": %4 },\n"
+        "      \"rotation\": { \"w\": 0.92, \"x\": 0, \"y\": 0.38, \"z\": 0 },\n"
+        "      \"script\": \"https://content.example.org/scripts/door.js\",\n"
+        "      \"shapeType\": \"simple-compound\",\n"
+        "      \"type\": \"Model\",\n"
+        "      \"userData\": \"{\\\"grabbableKey\\\":{\\\"grabbable\\\":true},\\\"note\\\":\\\"%5\\\"}\"\n"
+        "    }")
+        .arg(QUuid::createUuid().toString())
+        .arg(index % 500)
+        .arg(index % 1000)
+        .arg(index / 1000)
+        .arg(QString(400, 'x'));
+    return entity.toUtf8();
+}
+
+void OctreeEntitiesFileParserBenchmarkTests::initTestCase() {
+    _numEntities = qEnvironmentVariableIsSet("OVERTE_PARSER_BENCHMARK_ENTITIES")
+        ? qEnvironmentVariableIntValue("OVERTE_PARSER_BENCHMARK_ENTITIES") : DEFAULT_NUM_ENTITIES;
+    QVERIFY(_numEntities > 0);
+
+    _content = "{\n  \"DataVersion\": 7,\n  \"Entities\": [";
+    for (int i = 0; i < _numEntities; ++i) {
+        _content += (i > 0 ? ",\n    " : "\n    ") + makeEntity(i);
+    }
+    _content += QString("\n    ],\n  \"Id\": \"%1\",\n  \"Version\": 130\n}\n").arg(QUuid::createUuid().toString()).toUtf8();
+
+    if (!resetPeakRSS()) {
+        qWarning() << "The peak RSS can't be reset here, each benchmark's peak includes those of the ones before it";
+    }
+    qDebug() << "Content set of" << _numEntities << "entities," << _content.size() / (1024 * 1024) << "MB";
+}
+
+void OctreeEntitiesFileParserBenchmarkTests::init() {
+    resetPeakRSS();
+    _baselineRSS = getPeakRSS();
+}
+
+void OctreeEntitiesFileParserBenchmarkTests::testStreamingMatchesCollecting() {
+    QByteArray content = "{ \"DataVersion\": 3, \"Entities\": [" + makeEntity(0) + ", " + makeEntity(1) +
+        "], \"Id\": \"{a1b2c3d4-0000-0000-0000-000000000001}\", \"Paths\": { \"/\": \"/0,0,0/0,0,0,1\" }, \"Version\": 42 }";
+
+    OctreeEntitiesFileParser collectingParser;
+    collectingParser.setEntitiesString(content);
+    QVariantMap collected;
+    QVERIFY(collectingParser.parseEntities(collected));
+
+    OctreeEntitiesFileParser streamingParser;
+    streamingParser.setEntitiesString(content);
+    QVariantMap header;
+    QVERIFY(streamingParser.parseHeader(header));
+    QCOMPARE(header["DataVersion"], collected["DataVersion"]);
+    QCOMPARE(header["Id"], collected["Id"]);
+    QCOMPARE(header["Version"], collected["Version"]);
+    QCOMPARE(header["Paths"].toMap(), collected["Paths"].toMap());
+
+    QVariantList collectedEntities = collected["Entities"].toList();
+    int index = 0;
+    QVERIFY(streamingParser.parseEntities([&](const QJsonObject& entity) {
+        return index < collectedEntities.size() && entity.toVariantMap() == collectedEntities[index++].toMap();
+    }));
+    QCOMPARE(index, collectedEntities.size());
+
+    // a truncated entities array is caught before any entity is handed out
+    OctreeEntitiesFileParser truncatedParser;
+    truncatedParser.setEntitiesString(content.left(content.indexOf("], \"Id\"")));
+    QVERIFY(!truncatedParser.parseHeader(header));
+}
+
+void OctreeEntitiesFileParserBenchmarkTests::benchmarkStreaming() {
+    QElapsedTimer timer;
+    timer.start();
+
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(_content);
+    QVariantMap header;
+    QVERIFY(parser.parseHeader(header));
+
+    // each entity is converted like EntityTree::readFromParser does, then dropped
+    int numEntities = 0;
+    QVERIFY(parser.parseEntities([&](const QJsonObject& entity) {
+        QVariantMap entityMap = entity.toVariantMap();
+        numEntities += entityMap.contains("id") ? 1 : 0;
+        return true;
+    }));
+    QCOMPARE(numEntities, _numEntities);
+
+    qDebug() << "Streaming parse:" << timer.elapsed() << "ms, peak RSS" << (getPeakRSS() - _baselineRSS) / 1024
+        << "MB above the content";
+}
+
+void OctreeEntitiesFileParserBenchmarkTests::benchmarkCollecting() {
+    QElapsedTimer timer;
+    timer.start();
+
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(_content);
+    QVariantMap parsed;
+    QVERIFY(parser.parseEntities(parsed));
+
+    // as EntityTree::readFromMap does, while the whole list is still held
+    int numEntities = 0;
+    for (const auto& entity : parsed["Entities"].toList()) {
+        QVariantMap entityMap = entity.toMap();
+        numEntities += entityMap.contains("id") ? 1 : 0;
+    }
+    QCOMPARE(numEntities, _numEntities);
+
+    qDebug() << "Collecting parse:" << timer.elapsed() << "ms, peak RSS" << (getPeakRSS() - _baselineRSS) / 1024
+        << "MB above the content";
+}
@@ -0,0 +1,33 @@
+//
+//  OctreeEntitiesFileParserBenchmarkTests.h
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeEntitiesFileParserBenchmarkTests_h
+#define hifi_OctreeEntitiesFileParserBenchmarkTests_h
+
+#include <QtTest/QtTest>
+
+class OctreeEntitiesFileParserBenchmarkTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void testStreamingMatchesCollecting();
+
+    void benchmarkStreaming();
+    void benchmarkCollecting();
+
+private:
+    QByteArray _content;
+    int _numEntities { 0 };
+    qint64 _baselineRSS { 0 };
+};
+
+#endif // hifi_OctreeEntitiesFileParserBenchmarkTests_h
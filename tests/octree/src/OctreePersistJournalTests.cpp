@@ -0,0 +1,145 @@
+//
+//  OctreePersistJournalTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreePersistJournalTests.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <OctreePersistThread.h>
+
+QTEST_MAIN(OctreePersistJournalTests)
+
+const int DATA_VERSION = 7;
+const int ENTITY_VERSION = 42;
+
+static QVariantMap makeItem(const QUuid& id, const QString& name) {
+    QVariantMap item;
+    item["id"] = id;
+    item["name"] = name;
+    return item;
+}
+
+static QVariantMap findItem(const QVariantList& items, const QUuid& id) {
+    for (const auto& item : items) {
+        if (item.toMap()["id"].toUuid() == id) {
+            return item.toMap();
+        }
+    }
+    return QVariantMap();
+}
+
+static QByteArray makeHeader(int journalVersion, const QUuid& id, int dataVersion, int version) {
+    QJsonObject header;
+    header["Journal"] = journalVersion;
+    header["Id"] = id.toString();
+    header["DataVersion"] = dataVersion;
+    header["Version"] = version;
+    return QJsonDocument(header).toJson(QJsonDocument::Compact) + '\n';
+}
+
+void OctreePersistJournalTests::init() {
+    QVERIFY(_dir.isValid());
+    _journalFilename = _dir.filePath("models.json.gz.journal");
+    QFile::remove(_journalFilename);
+
+    _id = QUuid::createUuid();
+    _keptItem = QUuid::createUuid();
+    _editedItem = QUuid::createUuid();
+    _deletedItem = QUuid::createUuid();
+}
+
+QVariantMap OctreePersistJournalTests::makePersistedMap() const {
+    QVariantMap map;
+    map["Id"] = _id;
+    map["DataVersion"] = DATA_VERSION;
+    map["Version"] = ENTITY_VERSION;
+    map["Entities"] = QVariantList {
+        makeItem(_keptItem, "kept"),
+        makeItem(_editedItem, "before edit"),
+        makeItem(_deletedItem, "deleted")
+    };
+    return map;
+}
+
+void OctreePersistJournalTests::writeJournal(const QByteArray& content) {
+    QFile journal(_journalFilename);
+    QVERIFY(journal.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QCOMPARE(journal.write(content), (qint64)content.size());
+}
+
+void OctreePersistJournalTests::replaysPutsAndDeletes() {
+    QUuid addedItem = QUuid::createUuid();
+    writeJournal(makeHeader(1, _id, DATA_VERSION, ENTITY_VERSION) +
+                 "{\"put\":{\"id\":\"" + _editedItem.toString().toUtf8() + "\",\"name\":\"after edit\"}}\n" +
+                 "{\"delete\":\"" + _deletedItem.toString().toUtf8() + "\"}\n" +
+                 "{\"put\":{\"id\":\"" + addedItem.toString().toUtf8() + "\",\"name\":\"added\"}}\n");
+    qint64 journalSize = QFileInfo(_journalFilename).size();
+
+    QVariantMap map = makePersistedMap();
+    QVERIFY(OctreePersistThread::replayJournal(_journalFilename, map));
+
+    QVariantList items = map["Entities"].toList();
+    QCOMPARE(items.size(), 3);
+    QCOMPARE(findItem(items, _keptItem)["name"].toString(), QString("kept"));
+    QCOMPARE(findItem(items, _editedItem)["name"].toString(), QString("after edit"));
+    QVERIFY(findItem(items, _deletedItem).isEmpty());
+    QCOMPARE(findItem(items, addedItem)["name"].toString(), QString("added"));
+
+    // a complete journal is left as it is, so that it can be appended to
+    QCOMPARE(QFileInfo(_journalFilename).size(), journalSize);
+}
+
+void OctreePersistJournalTests::truncatesTornRecord() {
+    QByteArray completeRecords = makeHeader(1, _id, DATA_VERSION, ENTITY_VERSION) +
+        "{\"delete\":\"" + _deletedItem.toString().toUtf8() + "\"}\n";
+    writeJournal(completeRecords + "{\"put\":{\"id\":\"" + _editedItem.toString().toUtf8() + "\",\"na");
+
+    QVariantMap map = makePersistedMap();
+    QVERIFY(OctreePersistThread::replayJournal(_journalFilename, map));
+
+    QVariantList items = map["Entities"].toList();
+    QCOMPARE(items.size(), 2);
+    QVERIFY(findItem(items, _deletedItem).isEmpty());
+    QCOMPARE(findItem(items, _editedItem)["name"].toString(), QString("before edit"));
+
+    // the torn record is dropped from the file, so that new records follow the last complete one
+    QFile journal(_journalFilename);
+    QVERIFY(journal.open(QIODevice::ReadOnly));
+    QCOMPARE(journal.readAll(), completeRecords);
+}
+
+void OctreePersistJournalTests::rejectsMismatchedHeader() {
+    QByteArray record = "{\"delete\":\"" + _deletedItem.toString().toUtf8() + "\"}\n";
+    QVector<QByteArray> headers {
+        makeHeader(2, _id, DATA_VERSION, ENTITY_VERSION),
+        makeHeader(1, QUuid::createUuid(), DATA_VERSION, ENTITY_VERSION),
+        makeHeader(1, _id, DATA_VERSION + 1, ENTITY_VERSION),
+        makeHeader(1, _id, DATA_VERSION, ENTITY_VERSION - 1),
+        "{\"Journal\":1,\"Id\":\"" + _id.toString().toUtf8() + "\",\"Data\n"
+    };
+
+    for (const auto& header : headers) {
+        writeJournal(header + record);
+
+        QVariantMap map = makePersistedMap();
+        QVERIFY(!OctreePersistThread::replayJournal(_journalFilename, map));
+        QCOMPARE(map, makePersistedMap());
+        QCOMPARE(QFileInfo(_journalFilename).size(), (qint64)(header + record).size());
+    }
+}
+
+void OctreePersistJournalTests::rejectsMissingJournal() {
+    QVariantMap map = makePersistedMap();
+    QVERIFY(!OctreePersistThread::replayJournal(_journalFilename, map));
+    QCOMPARE(map, makePersistedMap());
+}
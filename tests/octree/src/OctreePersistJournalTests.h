@@ -0,0 +1,38 @@
+//
+//  OctreePersistJournalTests.h
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreePersistJournalTests_h
+#define hifi_OctreePersistJournalTests_h
+
+#include <QtTest/QtTest>
+
+class OctreePersistJournalTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void replaysPutsAndDeletes();
+    void truncatesTornRecord();
+    void rejectsMismatchedHeader();
+    void rejectsMissingJournal();
+
+private:
+    QVariantMap makePersistedMap() const;
+    void writeJournal(const QByteArray& content);
+
+    QTemporaryDir _dir;
+    QString _journalFilename;
+    QUuid _id;
+    QUuid _keptItem;
+    QUuid _editedItem;
+    QUuid _deletedItem;
+};
+
+#endif // hifi_OctreePersistJournalTests_h
@@ -0,0 +1,51 @@
+//
+//  GzipTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GzipTests.h"
+
+#include <QtCore/QBuffer>
+
+#include <Gzip.h>
+
+QTEST_MAIN(GzipTests)
+
+void GzipTests::streamWriterRoundTrip() {
+    QByteArray expected;
+    QByteArray compressed;
+    QBuffer buffer(&compressed);
+    buffer.open(QIODevice::WriteOnly);
+
+    GzipStreamWriter writer(buffer);
+    for (int i = 0; i < 10000; ++i) {
+        QByteArray chunk = QString("{ \"id\": %1, \"name\": \"entity %1\" },\n").arg(i).toUtf8();
+        expected += chunk;
+        QVERIFY(writer.write(chunk));
+    }
+    QVERIFY(writer.finish());
+    QVERIFY(compressed.size() < expected.size());
+
+    QByteArray uncompressed;
+    QVERIFY(gunzip(compressed, uncompressed));
+    QCOMPARE(uncompressed, expected);
+}
+
+void GzipTests::streamWriterEmpty() {
+    QByteArray compressed;
+    QBuffer buffer(&compressed);
+    buffer.open(QIODevice::WriteOnly);
+
+    GzipStreamWriter writer(buffer);
+    QVERIFY(writer.finish());
+    QVERIFY(!writer.write("too late"));
+
+    QByteArray uncompressed;
+    QVERIFY(gunzip(compressed, uncompressed));
+    QVERIFY(uncompressed.isEmpty());
+}
@@ -0,0 +1,159 @@
+//
+//  ShardedHashTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ShardedHashTests.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QThread>
+#include <QtCore/QUuid>
+
+#include <shared/ShardedHash.h>
+
+QTEST_MAIN(ShardedHashTests)
+
+using Value = std::shared_ptr<int>;
+
+// the EntityTree's index before ShardedHash: one lock for the whole hash
+class LockedHash {
+public:
+    Value value(const QUuid& key) const {
+        QReadLocker locker(&_lock);
+        return _hash.value(key);
+    }
+    bool insert(const QUuid& key, const Value& value) {
+        QWriteLocker locker(&_lock);
+        if (_hash.contains(key)) {
+            return false;
+        }
+        _hash.insert(key, value);
+        return true;
+    }
+    bool remove(const QUuid& key) {
+        QWriteLocker locker(&_lock);
+        return _hash.remove(key) > 0;
+    }
+
+private:
+    mutable QReadWriteLock _lock;
+    QHash<QUuid, Value> _hash;
+};
+
+void ShardedHashTests::insertRemoveTest() {
+    ShardedHash<QUuid, Value> hash;
+    std::vector<QUuid> keys;
+    for (int i = 0; i < 1000; ++i) {
+        keys.push_back(QUuid::createUuid());
+        QVERIFY(hash.insert(keys.back(), std::make_shared<int>(i)));
+    }
+    QCOMPARE(hash.size(), 1000);
+
+    // an existing value is kept
+    QVERIFY(!hash.insert(keys[10], std::make_shared<int>(-1)));
+    QCOMPARE(*hash.value(keys[10]), 10);
+
+    QVERIFY(hash.remove(keys[10]));
+    QVERIFY(!hash.remove(keys[10]));
+    QVERIFY(!hash.contains(keys[10]));
+    QVERIFY(!hash.value(keys[10]));
+    QCOMPARE(hash.size(), 999);
+
+    int sum = 0;
+    hash.forEach([&](const Value& value) {
+        sum += *value;
+    });
+    QCOMPARE(sum, 999 * 1000 / 2 - 10);
+}
+
+void ShardedHashTests::swapTest() {
+    ShardedHash<QUuid, Value> hash;
+    QUuid oldKey = QUuid::createUuid();
+    hash.insert(oldKey, std::make_shared<int>(1));
+
+    QHash<QUuid, Value> contents;
+    for (int i = 0; i < 100; ++i) {
+        contents.insert(QUuid::createUuid(), std::make_shared<int>(i));
+    }
+    QHash<QUuid, Value> expected = contents;
+
+    hash.swap(contents);
+    QCOMPARE(contents.size(), 1);
+    QVERIFY(contents.contains(oldKey));
+    QCOMPARE(hash.size(), 100);
+    QVERIFY(!hash.contains(oldKey));
+    QCOMPARE(hash.toHash(), expected);
+}
+
+template <typename Hash>
+static double lookupsPerSecond(Hash& hash, const std::vector<QUuid>& keys, int numReaders, int durationMsecs) {
+    std::atomic<bool> running { true };
+    std::atomic<quint64> numLookups { 0 };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numReaders; ++i) {
+        threads.emplace_back([&, i] {
+            quint64 lookups = 0;
+            size_t index = i * 7919;
+            while (running) {
+                hash.value(keys[index++ % keys.size()]);
+                ++lookups;
+            }
+            numLookups += lookups;
+        });
+    }
+
+    // the edit load: entities are added and deleted as fast as possible
+    threads.emplace_back([&] {
+        Value value = std::make_shared<int>(0);
+        while (running) {
+            QUuid key = QUuid::createUuid();
+            hash.insert(key, value);
+            hash.remove(key);
+        }
+    });
+
+    QElapsedTimer timer;
+    timer.start();
+    QThread::msleep(durationMsecs);
+    running = false;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return (double)numLookups * 1000.0 / (double)timer.elapsed();
+}
+
+void ShardedHashTests::contentionBenchmark() {
+    const int NUM_KEYS = 100000;
+    const int DURATION_MSECS = 500;
+    const int numReaders = std::max(2, QThread::idealThreadCount() - 1);
+
+    std::vector<QUuid> keys;
+    keys.reserve(NUM_KEYS);
+    ShardedHash<QUuid, Value> shardedHash;
+    LockedHash lockedHash;
+    for (int i = 0; i < NUM_KEYS; ++i) {
+        keys.push_back(QUuid::createUuid());
+        Value value = std::make_shared<int>(i);
+        shardedHash.insert(keys.back(), value);
+        lockedHash.insert(keys.back(), value);
+    }
+
+    double lockedRate = lookupsPerSecond(lockedHash, keys, numReaders, DURATION_MSECS);
+    double shardedRate = lookupsPerSecond(shardedHash, keys, numReaders, DURATION_MSECS);
+    qDebug() << numReaders << "readers and one writer:";
+    qDebug() << "    single lock:" << (quint64)lockedRate << "lookups/sec";
+    qDebug() << "    sharded:    " << (quint64)shardedRate << "lookups/sec";
+    QCOMPARE(shardedHash.size(), NUM_KEYS);
+}
@@ -0,0 +1,27 @@
+//
+//  ShardedHashTests.h
+//  tests/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ShardedHashTests_h
+#define hifi_ShardedHashTests_h
+
+#include <QtTest/QtTest>
+
+class ShardedHashTests : public QObject {
+    Q_OBJECT
+private slots:
+    void insertRemoveTest();
+    void swapTest();
+
+    // lookups from several threads while another thread adds and removes entries, as the entity server's
+    // send threads and scripts look up entities while edits come in
+    void contentionBenchmark();
+};
+
+#endif // hifi_ShardedHashTests_h
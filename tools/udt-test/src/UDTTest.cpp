@@ -14,6 +14,7 @@
 
 #include <QtCore/QDebug>
 
+#include <udt/BBRCC.h>
 #include <udt/Constants.h>
 #include <udt/Packet.h>
 #include <udt/PacketList.h>
@@ -56,6 +57,14 @@ const QCommandLineOption MESSAGE_SEED {
 const QCommandLineOption STATS_INTERVAL {
     "stats-interval", "stats output interval (default is 100ms)", "milliseconds"
 };
+const QCommandLineOption CONGESTION_CONTROL {
+    "congestion-control", "congestion control used by the sender, vegas or bbr (default is vegas). To compare them on a "
+    "long-fat or bufferbloated link, shape the sender's interface with netem, e.g. "
+    "tc qdisc add dev <if> root netem delay 50ms rate 100mbit limit 2000", "vegas|bbr"
+};
+const QCommandLineOption LOSS_RATE {
+    "loss", "percentage of received data packets to drop, to test recovery from loss (e.g. 1, 5 or 20, default is 0)", "percent"
+};
 
 const QStringList CLIENT_STATS_TABLE_HEADERS {
     "Send (Mb/s)", "Est. Max (Mb/s)", "RTT (ms)", "CW (P)", "Period (us)",
@@ -128,6 +137,20 @@ UDTTest::UDTTest(int& argc, char** argv) :
         }
     }
     
+    if (_argumentParser.isSet(CONGESTION_CONTROL)) {
+        QString congestionControl = _argumentParser.value(CONGESTION_CONTROL);
+
+        if (congestionControl == "bbr") {
+            _socket.setCongestionControlFactory(std::unique_ptr<udt::CongestionControlVirtualFactory>(
+                new udt::CongestionControlFactory<udt::BBRCC>()));
+        } else if (congestionControl != "vegas") {
+            qCritical() << "Unknown congestion control" << congestionControl << "- use vegas or bbr.";
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        }
+
+        qDebug() << "Sending with" << congestionControl << "congestion control";
+    }
+
     if (_argumentParser.isSet(MAX_SEND_BYTES)) {
         _maxSendBytes = _argumentParser.value(MAX_SEND_BYTES).toInt();
     }
@@ -171,7 +194,18 @@ UDTTest::UDTTest(int& argc, char** argv) :
     if (!_target.isNull()) {
         sendInitialPackets();
     } else {
-        // this is a receiver - in case there are ordered packets (messages) being sent to us make sure that we handle them
+        // this is a receiver - drop the requested share of data packets before the connection sees them, so that the
+        // sender has to recover them through NAKs and timeouts
+        if (_argumentParser.isSet(LOSS_RATE)) {
+            _lossRate = _argumentParser.value(LOSS_RATE).toFloat() / 100.0f;
+            qDebug() << "Dropping" << QString("%1%").arg(_lossRate * 100.0f) << "of received data packets";
+
+            _socket.setPacketFilterOperator([this](const udt::Packet& packet) {
+                return _lossDistribution(_lossGenerator) >= _lossRate;
+            });
+        }
+
+        // in case there are ordered packets (messages) being sent to us make sure that we handle them
         // so that they can be verified
         _socket.setMessageHandler(
             [this](std::unique_ptr<udt::Packet> packet) {
@@ -225,7 +259,7 @@ void UDTTest::parseArguments() {
     _argumentParser.addOptions({
         PORT_OPTION, TARGET_OPTION, PACKET_SIZE, MIN_PACKET_SIZE, MAX_PACKET_SIZE,
         MAX_SEND_BYTES, MAX_SEND_PACKETS, UNRELIABLE_PACKETS, ORDERED_PACKETS,
-        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL
+        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL, CONGESTION_CONTROL, LOSS_RATE
     });
     
     if (!_argumentParser.parse(arguments())) {
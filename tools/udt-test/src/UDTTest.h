@@ -72,6 +72,10 @@ private:
     int _totalQueuedBytes { 0 }; // keeps track of the number of bytes we have already queued
     
     int _statsInterval { 100 }; // recording interval for stats in milliseconds
+
+    float _lossRate { 0.0f }; // share of received data packets dropped by a receiver
+    std::mt19937 _lossGenerator { _randomDevice() }; // only used from the socket's thread, by the packet filter
+    std::uniform_real_distribution<float> _lossDistribution { 0.0f, 1.0f };
 };
 
 #endif // hifi_UDTTest_h